@@ -554,6 +554,21 @@ void wlan_ipa_reg_send_to_nw_cb(struct wlan_ipa_priv *ipa_ctx,
 	ipa_ctx->send_to_nw = cb;
 }
 
+/**
+ * wlan_ipa_reg_send_to_nw_list_cb() - Register cb to send a list of IPA Rx
+ * packets to network
+ * @ipa_ctx: IPA context
+ * @cb: callback, invoked in bottom half context
+ *
+ * Return: None
+ */
+static inline
+void wlan_ipa_reg_send_to_nw_list_cb(struct wlan_ipa_priv *ipa_ctx,
+				     wlan_ipa_send_to_nw_list cb)
+{
+	ipa_ctx->send_to_nw_list = cb;
+}
+
 /**
  * wlan_ipa_set_mcc_mode() - Set MCC mode
  * @ipa_ctx: IPA context
@@ -256,6 +256,17 @@ void ipa_reg_sap_xmit_cb(struct wlan_objmgr_pdev *pdev,
 void ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 			   wlan_ipa_send_to_nw cb);
 
+/**
+ * ipa_reg_send_to_nw_list_cb() - Register cb to send a list of IPA Rx
+ * packets to network
+ * @pdev: pdev obj
+ * @cb: callback
+ *
+ * Return: None
+ */
+void ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				wlan_ipa_send_to_nw_list cb);
+
 /**
  * ipa_set_mcc_mode() - Set MCC mode
  * @pdev: pdev obj
@@ -492,6 +503,8 @@ bool ipa_is_ready(void);
 #else /* Not IPA_OFFLOAD */
 typedef QDF_STATUS (*wlan_ipa_softap_xmit)(qdf_nbuf_t nbuf, qdf_netdev_t dev);
 typedef void (*wlan_ipa_send_to_nw)(qdf_nbuf_t nbuf, qdf_netdev_t dev);
+typedef void (*wlan_ipa_send_to_nw_list)(qdf_nbuf_t nbuf_list,
+					 qdf_netdev_t dev);
 
 #endif /* IPA_OFFLOAD */
 #endif /* end  of _WLAN_IPA_MAIN_H_ */
@@ -78,6 +78,14 @@
 
 #define IPA_WLAN_RX_SOFTIRQ_THRESH 32
 
+/*
+ * Maximum number of rx exception packets delivered per interface in one
+ * run of the rx exception bottom half, and maximum number of packets
+ * pending per interface before new ones are dropped.
+ */
+#define WLAN_IPA_RX_EXCEP_BUDGET            64
+#define WLAN_IPA_RX_EXCEP_MAX_PENDING       1024
+
 #define WLAN_IPA_UC_BW_MONITOR_LEVEL        3
 
 /**
@@ -325,6 +333,8 @@ struct wlan_ipa_priv;
  * @ifa_address: Interface address
  * @stats: Interface stats
  * @bssid: BSSID. valid only for sta iface ctx;
+ * @rx_excep_q: Rx exception packets pending delivery to the network stack,
+ *	protected by the rx_excep_lock of @ipa_ctx
  */
 struct wlan_ipa_iface_context {
 	struct wlan_ipa_priv *ipa_ctx;
@@ -340,6 +350,7 @@ struct wlan_ipa_iface_context {
 	uint32_t ifa_address;
 	struct wlan_ipa_iface_stats stats;
 	struct qdf_mac_addr bssid;
+	qdf_nbuf_queue_t rx_excep_q;
 };
 
 /**
@@ -585,6 +596,8 @@ struct wlan_ipa_tx_desc {
 
 typedef QDF_STATUS (*wlan_ipa_softap_xmit)(qdf_nbuf_t nbuf, qdf_netdev_t dev);
 typedef void (*wlan_ipa_send_to_nw)(qdf_nbuf_t nbuf, qdf_netdev_t dev);
+typedef void (*wlan_ipa_send_to_nw_list)(qdf_nbuf_t nbuf_list,
+					 qdf_netdev_t dev);
 
 /* IPA private context structure definition */
 struct wlan_ipa_priv {
@@ -690,6 +703,10 @@ struct wlan_ipa_priv {
 
 	wlan_ipa_softap_xmit softap_xmit;
 	wlan_ipa_send_to_nw send_to_nw;
+	/* Rx exception packets are batched only if send_to_nw_list is set */
+	wlan_ipa_send_to_nw_list send_to_nw_list;
+	qdf_spinlock_t rx_excep_lock;
+	qdf_bh_t rx_excep_flush_bh;
 	ipa_uc_offload_control_req ipa_tx_op;
 
 	qdf_event_t ipa_resource_comp;
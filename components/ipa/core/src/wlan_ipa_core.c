@@ -931,6 +931,174 @@ wlan_ipa_send_skb_to_network(qdf_nbuf_t skb,
 	ipa_ctx->ipa_rx_net_send_count++;
 }
 
+/**
+ * wlan_ipa_drop_skb_list() - Drop a list of rx exception packets
+ * @ipa_ctx: IPA context
+ * @skb_list: network buffer list
+ *
+ * Return: None
+ */
+static void wlan_ipa_drop_skb_list(struct wlan_ipa_priv *ipa_ctx,
+				   qdf_nbuf_t skb_list)
+{
+	qdf_nbuf_t skb, next;
+
+	for (skb = skb_list; skb; skb = next) {
+		next = qdf_nbuf_next(skb);
+		ipa_ctx->ipa_rx_internal_drop_count++;
+		dev_kfree_skb_any(skb);
+	}
+}
+
+/**
+ * wlan_ipa_send_skb_list_to_network() - Send a list of skb to kernel
+ * @ipa_ctx: IPA context
+ * @skb_list: network buffer list
+ * @num: number of network buffers in @skb_list
+ * @iface_ctx: IPA interface context all of @skb_list is received on
+ *
+ * The netdev of @iface_ctx is read under its interface_lock and held while
+ * the list is delivered, as the interface may be cleaned up meanwhile.
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_send_skb_list_to_network(struct wlan_ipa_priv *ipa_ctx,
+				  qdf_nbuf_t skb_list, uint32_t num,
+				  struct wlan_ipa_iface_context *iface_ctx)
+{
+	qdf_netdev_t dev;
+	qdf_nbuf_t skb;
+
+	qdf_spin_lock_bh(&iface_ctx->interface_lock);
+	dev = iface_ctx->dev;
+	if (dev)
+		dev_hold(dev);
+	qdf_spin_unlock_bh(&iface_ctx->interface_lock);
+
+	if (!dev) {
+		ipa_debug_rl("Invalid interface");
+		wlan_ipa_drop_skb_list(ipa_ctx, skb_list);
+		return;
+	}
+
+	for (skb = skb_list; skb; skb = qdf_nbuf_next(skb))
+		skb->destructor = wlan_ipa_uc_rt_debug_destructor;
+
+	ipa_ctx->send_to_nw_list(skb_list, dev);
+	ipa_ctx->ipa_rx_net_send_count += num;
+
+	dev_put(dev);
+}
+
+/**
+ * wlan_ipa_rx_excep_flush_bh() - deliver the pending rx exception packets
+ * @data: IPA context
+ *
+ * Delivers up to WLAN_IPA_RX_EXCEP_BUDGET packets of each interface as
+ * one list, and reschedules itself if any interface has more pending.
+ *
+ * Return: None
+ */
+static void wlan_ipa_rx_excep_flush_bh(void *data)
+{
+	struct wlan_ipa_priv *ipa_ctx = data;
+	struct wlan_ipa_iface_context *iface_ctx;
+	qdf_nbuf_t head, tail, skb;
+	bool more = false;
+	uint32_t num;
+	int i;
+
+	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
+		iface_ctx = &ipa_ctx->iface_context[i];
+		if (!qdf_nbuf_queue_len(&iface_ctx->rx_excep_q))
+			continue;
+
+		head = NULL;
+		tail = NULL;
+		qdf_spin_lock_bh(&ipa_ctx->rx_excep_lock);
+		for (num = 0; num < WLAN_IPA_RX_EXCEP_BUDGET; num++) {
+			skb = qdf_nbuf_queue_remove(&iface_ctx->rx_excep_q);
+			if (!skb)
+				break;
+			qdf_nbuf_set_next(skb, NULL);
+			if (tail)
+				qdf_nbuf_set_next(tail, skb);
+			else
+				head = skb;
+			tail = skb;
+		}
+		if (qdf_nbuf_queue_len(&iface_ctx->rx_excep_q))
+			more = true;
+		qdf_spin_unlock_bh(&ipa_ctx->rx_excep_lock);
+
+		if (head)
+			wlan_ipa_send_skb_list_to_network(ipa_ctx, head, num,
+							  iface_ctx);
+	}
+
+	if (more)
+		qdf_sched_bh(&ipa_ctx->rx_excep_flush_bh);
+}
+
+/**
+ * wlan_ipa_rx_excep_deliver() - deliver an rx exception packet
+ * @ipa_ctx: IPA context
+ * @iface_ctx: IPA interface context @skb is received on
+ * @skb: network buffer
+ *
+ * If the network stack accepts lists of packets, the packet is queued on
+ * its interface and delivered in a batch from the rx exception bottom
+ * half. Packets are dropped rather than queued once
+ * WLAN_IPA_RX_EXCEP_MAX_PENDING are pending on the interface.
+ *
+ * Return: None
+ */
+static void wlan_ipa_rx_excep_deliver(struct wlan_ipa_priv *ipa_ctx,
+				      struct wlan_ipa_iface_context *iface_ctx,
+				      qdf_nbuf_t skb)
+{
+	if (!ipa_ctx->send_to_nw_list) {
+		wlan_ipa_send_skb_to_network(skb, iface_ctx);
+		return;
+	}
+
+	qdf_spin_lock_bh(&ipa_ctx->rx_excep_lock);
+	if (qdf_nbuf_queue_len(&iface_ctx->rx_excep_q) >=
+	    WLAN_IPA_RX_EXCEP_MAX_PENDING) {
+		qdf_spin_unlock_bh(&ipa_ctx->rx_excep_lock);
+		ipa_debug_rl("rx exception backlog full on iface %u",
+			     iface_ctx->iface_id);
+		ipa_ctx->ipa_rx_internal_drop_count++;
+		dev_kfree_skb_any(skb);
+		return;
+	}
+	qdf_nbuf_queue_add(&iface_ctx->rx_excep_q, skb);
+	qdf_spin_unlock_bh(&ipa_ctx->rx_excep_lock);
+
+	qdf_sched_bh(&ipa_ctx->rx_excep_flush_bh);
+}
+
+/**
+ * wlan_ipa_rx_excep_drop_iface() - drop the pending rx exception packets
+ * @iface_ctx: IPA interface context
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_rx_excep_drop_iface(struct wlan_ipa_iface_context *iface_ctx)
+{
+	struct wlan_ipa_priv *ipa_ctx = iface_ctx->ipa_ctx;
+	qdf_nbuf_t skb;
+
+	qdf_spin_lock_bh(&ipa_ctx->rx_excep_lock);
+	while ((skb = qdf_nbuf_queue_remove(&iface_ctx->rx_excep_q))) {
+		ipa_ctx->ipa_rx_internal_drop_count++;
+		dev_kfree_skb_any(skb);
+	}
+	qdf_spin_unlock_bh(&ipa_ctx->rx_excep_lock);
+}
+
 /**
  * wlan_ipa_eapol_intrabss_fwd_check() - Check if eapol pkt intrabss fwd is
  *  allowed or not
@@ -1085,7 +1253,7 @@ static void __wlan_ipa_w2i_cb(void *priv, qdf_ipa_dp_evt_type_t evt,
 				     session_id);
 		}
 
-		wlan_ipa_send_skb_to_network(skb, iface_context);
+		wlan_ipa_rx_excep_deliver(ipa_ctx, iface_context, skb);
 		break;
 
 	default:
@@ -1489,6 +1657,7 @@ static void wlan_ipa_cleanup_iface(struct wlan_ipa_iface_context *iface_context)
 	iface_context->device_mode = QDF_MAX_NO_OF_MODE;
 	iface_context->session_id = WLAN_IPA_MAX_SESSION;
 	qdf_spin_unlock_bh(&iface_context->interface_lock);
+	wlan_ipa_rx_excep_drop_iface(iface_context);
 	iface_context->ifa_address = 0;
 	qdf_zero_macaddr(&iface_context->bssid);
 	if (!iface_context->ipa_ctx->num_iface) {
@@ -3100,9 +3269,13 @@ QDF_STATUS wlan_ipa_setup(struct wlan_ipa_priv *ipa_ctx,
 		iface_context->device_mode = QDF_MAX_NO_OF_MODE;
 		iface_context->session_id = WLAN_IPA_MAX_SESSION;
 		qdf_spinlock_create(&iface_context->interface_lock);
+		qdf_nbuf_queue_init(&iface_context->rx_excep_q);
 	}
 
 	qdf_create_work(0, &ipa_ctx->pm_work, wlan_ipa_pm_flush, ipa_ctx);
+	qdf_spinlock_create(&ipa_ctx->rx_excep_lock);
+	qdf_create_bh(&ipa_ctx->rx_excep_flush_bh,
+		      wlan_ipa_rx_excep_flush_bh, ipa_ctx);
 	qdf_spinlock_create(&ipa_ctx->pm_lock);
 	qdf_spinlock_create(&ipa_ctx->q_lock);
 	qdf_spinlock_create(&ipa_ctx->enable_disable_lock);
@@ -3174,6 +3347,8 @@ ipa_wdi_destroy:
 	wlan_ipa_wdi_destroy_rm(ipa_ctx);
 
 fail_setup_rm:
+	qdf_destroy_bh(&ipa_ctx->rx_excep_flush_bh);
+	qdf_spinlock_destroy(&ipa_ctx->rx_excep_lock);
 	qdf_spinlock_destroy(&ipa_ctx->pm_lock);
 	qdf_spinlock_destroy(&ipa_ctx->q_lock);
 	qdf_spinlock_destroy(&ipa_ctx->enable_disable_lock);
@@ -3241,6 +3416,11 @@ QDF_STATUS wlan_ipa_cleanup(struct wlan_ipa_priv *ipa_ctx)
 
 	wlan_ipa_flush(ipa_ctx);
 
+	qdf_destroy_bh(&ipa_ctx->rx_excep_flush_bh);
+	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++)
+		wlan_ipa_rx_excep_drop_iface(&ipa_ctx->iface_context[i]);
+	qdf_spinlock_destroy(&ipa_ctx->rx_excep_lock);
+
 	qdf_spinlock_destroy(&ipa_ctx->pm_lock);
 	qdf_spinlock_destroy(&ipa_ctx->q_lock);
 	qdf_spinlock_destroy(&ipa_ctx->enable_disable_lock);
@@ -163,6 +163,20 @@ void ucfg_ipa_reg_sap_xmit_cb(struct wlan_objmgr_pdev *pdev,
 void ucfg_ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 				wlan_ipa_send_to_nw cb);
 
+/**
+ * ucfg_ipa_reg_send_to_nw_list_cb() - Register cb to send a list of IPA Rx
+ * packets to network
+ * @pdev: pdev obj
+ * @cb: callback, invoked in bottom half context
+ *
+ * Once registered, IPA Rx exception packets are delivered in batches
+ * through @cb instead of one by one through the send_to_nw callback.
+ *
+ * Return: None
+ */
+void ucfg_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				     wlan_ipa_send_to_nw_list cb);
+
 /**
  * ucfg_ipa_set_mcc_mode() - Set MCC mode
  * @pdev: pdev obj
@@ -476,6 +490,12 @@ void ucfg_ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 {
 }
 
+static inline
+void ucfg_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				     wlan_ipa_send_to_nw_list cb)
+{
+}
+
 static inline
 void ucfg_ipa_set_mcc_mode(struct wlan_objmgr_pdev *pdev, bool mcc_mode)
 {
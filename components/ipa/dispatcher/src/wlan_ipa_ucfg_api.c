@@ -102,6 +102,12 @@ void ucfg_ipa_reg_send_to_nw_cb(struct wlan_objmgr_pdev *pdev,
 
 }
 
+void ucfg_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev,
+				     wlan_ipa_send_to_nw_list cb)
+{
+	return ipa_reg_send_to_nw_list_cb(pdev, cb);
+}
+
 void ucfg_ipa_set_mcc_mode(struct wlan_objmgr_pdev *pdev, bool mcc_mode)
 {
 	return ipa_set_mcc_mode(pdev, mcc_mode);
@@ -30,10 +30,16 @@
 #define PKT_CAPTURE_RX_SHUTDOWN_EVENT 0x04
 
 /*
- * Maximum number of packets to be allocated for
- * Packet Capture Monitor thread.
+ * Number of slots in the per vdev ring of packets pending for the
+ * Packet Capture Monitor thread, must be a power of 2.
  */
-#define MAX_MON_PKT_SIZE 4000
+#define PKT_CAPTURE_MON_RING_SIZE 4096
+#if PKT_CAPTURE_MON_RING_SIZE & (PKT_CAPTURE_MON_RING_SIZE - 1)
+#error "PKT_CAPTURE_MON_RING_SIZE must be a power of 2"
+#endif
+
+/* Maximum number of ring slots the mon thread consumes per lock hold */
+#define PKT_CAPTURE_MON_BATCH_SIZE 64
 
 /* timeout in msec to wait for mon thread to suspend */
 #define PKT_CAPTURE_SUSPEND_TIMEOUT 200
@@ -47,7 +53,6 @@ typedef void (*pkt_capture_mon_thread_cb)(
 
 /*
  * struct pkt_capture_mon_pkt - mon packet wrapper for mon data from TXRX
- * @list: List for storing mon packets
  * @context: Callback context
  * @pdev: pointer to pdev handle
  * @monpkt: Mon skb
@@ -60,7 +65,6 @@ typedef void (*pkt_capture_mon_thread_cb)(
  * @callback: Mon callback
  */
 struct pkt_capture_mon_pkt {
-	struct list_head list;
 	void *context;
 	void *pdev;
 	void *monpkt;
@@ -83,10 +87,12 @@ struct pkt_capture_mon_pkt {
  * @mon_shutdown: Completion for packet capture MON thread shutdown
  * @mon_wait_queue: Waitq for packet capture MON thread
  * @mon_event_flag: Mon event flag
- * @mon_thread_queue: MON buffer queue
  * @mon_queue_lock: Spinlock to synchronize between tasklet and thread
- * @mon_pkt_freeq_lock: Lock to synchronize free buffer queue access
- * @mon_pkt_freeq: Free message queue for packet capture MON processing
+ * @mon_ring: ring of PKT_CAPTURE_MON_RING_SIZE packet slots
+ * @mon_ring_head: free running index of the next slot to be processed,
+ *	only advanced by the MON thread
+ * @mon_ring_tail: free running index of the next slot to be filled
+ * @mon_ring_drop_cnt: packets dropped because the ring was full
  * @is_mon_thread_suspended: flag to check mon thread suspended or not
  */
 struct pkt_capture_mon_context {
@@ -99,15 +105,14 @@ struct pkt_capture_mon_context {
 	struct completion mon_shutdown;
 	wait_queue_head_t mon_wait_queue;
 	unsigned long mon_event_flag;
-	struct list_head mon_thread_queue;
 
 	/* Spinlock to synchronize between tasklet and thread */
 	spinlock_t mon_queue_lock;
 
-	/* Lock to synchronize free buffer queue access */
-	spinlock_t mon_pkt_freeq_lock;
-
-	struct list_head mon_pkt_freeq;
+	struct pkt_capture_mon_pkt *mon_ring;
+	uint32_t mon_ring_head;
+	uint32_t mon_ring_tail;
+	uint32_t mon_ring_drop_cnt;
 	bool is_mon_thread_suspended;
 };
 
@@ -147,7 +152,8 @@ void pkt_capture_resume_mon_thread(struct wlan_objmgr_vdev *vdev);
  * pkt_capture_drop_monpkt() - API to drop pending mon packets
  * mon_ctx: pointer to packet capture mon context
  *
- * This api drops all the pending packets in the queue.
+ * This api drops all the pending packets in the ring. It must only be
+ * called once the mon thread is closed.
  *
  * Return: None
  */
@@ -158,10 +164,15 @@ void pkt_capture_drop_monpkt(struct pkt_capture_mon_context *mon_ctx);
  * @vdev: pointer to vdev object manager
  * @pkt: MON pkt pointer containing to mon data message buffer
  *
- * Return: None
+ * Copies @pkt into the next free slot of the mon ring. If the ring is
+ * full the packet is not queued and accounted as dropped, the caller
+ * keeps ownership of @pkt->monpkt and is expected to free it.
+ *
+ * Return: QDF_STATUS_SUCCESS if queued, QDF_STATUS_E_RESOURCES if the
+ *	   ring is full, QDF_STATUS_E_INVAL on bad arguments
  */
-void pkt_capture_indicate_monpkt(struct wlan_objmgr_vdev *vdev,
-				 struct pkt_capture_mon_pkt *pkt);
+QDF_STATUS pkt_capture_indicate_monpkt(struct wlan_objmgr_vdev *vdev,
+				       const struct pkt_capture_mon_pkt *pkt);
 
 /**
  * pkt_capture_wakeup_mon_thread() - wakeup packet capture mon thread
@@ -207,25 +218,13 @@ QDF_STATUS
 pkt_capture_alloc_mon_thread(struct pkt_capture_mon_context *mon_ctx);
 
 /**
- * pkt_capture_alloc_mon_pkt() - API to return next available mon packet
- * @vdev: pointer to vdev object manager
- *
- * This api returns next available mon packet buffer used for mon data
- * processing.
- *
- * Return: Pointer to pkt_capture_mon_pkt
- */
-struct pkt_capture_mon_pkt *
-pkt_capture_alloc_mon_pkt(struct wlan_objmgr_vdev *vdev);
-
-/**
- * pkt_capture_free_mon_pkt_freeq() - free mon packet free queue
+ * pkt_capture_free_mon_ring() - free mon packet ring
  * @mon_ctx: pointer to packet capture mon context
  *
- * This API does mem free of the buffers available in free mon packet
- * queue which is used for mon Data processing.
+ * This API does mem free of the ring used for mon Data processing. All
+ * the pending packets must have been dropped before.
  *
  * Return: None
  */
-void pkt_capture_free_mon_pkt_freeq(struct pkt_capture_mon_context *mon_ctx);
+void pkt_capture_free_mon_ring(struct pkt_capture_mon_context *mon_ctx);
 #endif /* _WLAN_PKT_CAPTURE_MON_THREAD_H_ */
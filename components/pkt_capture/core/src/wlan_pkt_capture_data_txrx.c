@@ -713,7 +713,7 @@ void pkt_capture_datapkt_process(
 		uint8_t tx_retry_cnt)
 {
 	uint8_t drop_count;
-	struct pkt_capture_mon_pkt *pkt;
+	struct pkt_capture_mon_pkt pkt;
 	pkt_capture_mon_thread_cb callback = NULL;
 	struct wlan_objmgr_vdev *vdev;
 
@@ -722,10 +722,6 @@ void pkt_capture_datapkt_process(
 	if (!vdev)
 		goto drop_rx_buf;
 
-	pkt = pkt_capture_alloc_mon_pkt(vdev);
-	if (!pkt)
-		goto drop_rx_buf;
-
 	switch (type) {
 	case TXRX_PROCESS_TYPE_DATA_RX:
 		callback = pkt_capture_rx_data_cb;
@@ -735,21 +731,21 @@ void pkt_capture_datapkt_process(
 		callback = pkt_capture_tx_data_cb;
 		break;
 	default:
-		return;
+		goto drop_rx_buf;
 	}
 
-	pkt->callback = callback;
-	pkt->context = (void *)vdev;
-	pkt->pdev = (void *)pdev;
-	pkt->monpkt = (void *)mon_buf_list;
-	pkt->vdev_id = vdev_id;
-	pkt->tid = tid;
-	pkt->status = status;
-	pkt->pkt_format = pkt_format;
-	qdf_mem_copy(pkt->bssid, bssid, QDF_MAC_ADDR_SIZE);
-	pkt->tx_retry_cnt = tx_retry_cnt;
-	pkt_capture_indicate_monpkt(vdev, pkt);
-	return;
+	pkt.callback = callback;
+	pkt.context = (void *)vdev;
+	pkt.pdev = (void *)pdev;
+	pkt.monpkt = (void *)mon_buf_list;
+	pkt.vdev_id = vdev_id;
+	pkt.tid = tid;
+	pkt.status = status;
+	pkt.pkt_format = pkt_format;
+	qdf_mem_copy(pkt.bssid, bssid, QDF_MAC_ADDR_SIZE);
+	pkt.tx_retry_cnt = tx_retry_cnt;
+	if (QDF_IS_STATUS_SUCCESS(pkt_capture_indicate_monpkt(vdev, &pkt)))
+		return;
 
 drop_rx_buf:
 	drop_count = pkt_capture_drop_nbuf_list(mon_buf_list);
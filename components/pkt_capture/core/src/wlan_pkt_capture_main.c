@@ -378,7 +378,7 @@ pkt_capture_vdev_create_notification(struct wlan_objmgr_vdev *vdev, void *arg)
 	return status;
 
 open_mon_thread_fail:
-	pkt_capture_free_mon_pkt_freeq(mon_ctx);
+	pkt_capture_free_mon_ring(mon_ctx);
 destroy_mon_context:
 	pkt_capture_mon_context_destroy(vdev_priv);
 destroy_pkt_capture_cb_context:
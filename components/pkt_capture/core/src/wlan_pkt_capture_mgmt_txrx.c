@@ -130,8 +130,9 @@ pkt_capture_mgmtpkt_process(struct wlan_objmgr_psoc *psoc,
 			    qdf_nbuf_t nbuf, uint8_t status)
 {
 	struct wlan_objmgr_vdev *vdev;
-	struct pkt_capture_mon_pkt *pkt;
+	struct pkt_capture_mon_pkt pkt;
 	uint32_t headroom;
+	QDF_STATUS qdf_status;
 
 	vdev = wlan_objmgr_get_vdev_by_opmode_from_psoc(psoc,
 							QDF_STA_MODE,
@@ -147,22 +148,20 @@ pkt_capture_mgmtpkt_process(struct wlan_objmgr_psoc *psoc,
 	headroom = qdf_nbuf_headroom(nbuf);
 	qdf_nbuf_update_radiotap(txrx_status, nbuf, headroom);
 
-	pkt = pkt_capture_alloc_mon_pkt(vdev);
-	if (!pkt) {
-		wlan_objmgr_vdev_release_ref(vdev, WLAN_PKT_CAPTURE_ID);
-		return QDF_STATUS_E_FAILURE;
-	}
-
-	pkt->callback = pkt_capture_mgmtpkt_cb;
-	pkt->context = psoc;
-	pkt->monpkt = nbuf;
-	pkt->vdev_id = WLAN_INVALID_VDEV_ID;
-	pkt->tid = WLAN_INVALID_TID;
-	pkt->status = txrx_status->chan_freq;
-	pkt->pkt_format = PKTCAPTURE_PKT_FORMAT_80211;
-	pkt_capture_indicate_monpkt(vdev, pkt);
+	qdf_mem_zero(&pkt, sizeof(pkt));
+	pkt.callback = pkt_capture_mgmtpkt_cb;
+	pkt.context = psoc;
+	pkt.monpkt = nbuf;
+	pkt.vdev_id = WLAN_INVALID_VDEV_ID;
+	pkt.tid = WLAN_INVALID_TID;
+	pkt.status = txrx_status->chan_freq;
+	pkt.pkt_format = PKTCAPTURE_PKT_FORMAT_80211;
+	qdf_status = pkt_capture_indicate_monpkt(vdev, &pkt);
 
 	wlan_objmgr_vdev_release_ref(vdev, WLAN_PKT_CAPTURE_ID);
+	if (QDF_IS_STATUS_ERROR(qdf_status))
+		return QDF_STATUS_E_FAILURE;
+
 	return QDF_STATUS_SUCCESS;
 }
 
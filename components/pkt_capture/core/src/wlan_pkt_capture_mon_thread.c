@@ -68,145 +68,107 @@ void pkt_capture_mon(struct pkt_capture_cb_context *cb_ctx, qdf_nbuf_t msdu,
 	}
 }
 
-void pkt_capture_free_mon_pkt_freeq(struct pkt_capture_mon_context *mon_ctx)
+void pkt_capture_free_mon_ring(struct pkt_capture_mon_context *mon_ctx)
 {
-	struct pkt_capture_mon_pkt *pkt;
+	struct pkt_capture_mon_pkt *ring;
 
-	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	while (!list_empty(&mon_ctx->mon_pkt_freeq)) {
-		pkt = list_entry((&mon_ctx->mon_pkt_freeq)->next,
-				 typeof(*pkt), list);
-		list_del(&pkt->list);
-		spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
-		qdf_mem_free(pkt);
-		spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	}
-	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
+	spin_lock_bh(&mon_ctx->mon_queue_lock);
+	ring = mon_ctx->mon_ring;
+	mon_ctx->mon_ring = NULL;
+	mon_ctx->mon_ring_head = 0;
+	mon_ctx->mon_ring_tail = 0;
+	spin_unlock_bh(&mon_ctx->mon_queue_lock);
+
+	if (ring)
+		qdf_mem_vfree(ring);
 }
 
 /**
- * pkt_capture_alloc_mon_pkt_freeq() - Function to allocate free buffer queue
+ * pkt_capture_alloc_mon_ring() - Function to allocate mon packet ring
  * @mon_ctx: pointer to packet capture mon context
  *
- * This API allocates MAX_MON_PKT_SIZE number of mon packets
- * which are used for mon data processing.
+ * This API allocates PKT_CAPTURE_MON_RING_SIZE mon packet slots in one
+ * chunk, so that queueing a mon packet does not need any allocation or
+ * free list handling. The ring spans many pages, so it is allocated from
+ * virtually contiguous memory.
  *
  * Return: QDF_STATUS
  */
 static QDF_STATUS
-pkt_capture_alloc_mon_pkt_freeq(struct pkt_capture_mon_context *mon_ctx)
+pkt_capture_alloc_mon_ring(struct pkt_capture_mon_context *mon_ctx)
 {
-	struct pkt_capture_mon_pkt *pkt, *tmp;
-	int i;
-
-	for (i = 0; i < MAX_MON_PKT_SIZE; i++) {
-		pkt = qdf_mem_malloc(sizeof(*pkt));
-		if (!pkt) {
-			pkt_capture_err("mon packet freeq allocation fail");
-			goto free;
-		}
-		spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-		list_add_tail(&pkt->list,
-			      &mon_ctx->mon_pkt_freeq);
-		spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	}
+	mon_ctx->mon_ring = qdf_mem_valloc(PKT_CAPTURE_MON_RING_SIZE *
+					   sizeof(*mon_ctx->mon_ring));
+	if (!mon_ctx->mon_ring)
+		return QDF_STATUS_E_NOMEM;
 
-	return QDF_STATUS_SUCCESS;
-free:
-	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	list_for_each_entry_safe(pkt, tmp,
-				 &mon_ctx->mon_pkt_freeq,
-				 list) {
-		list_del(&pkt->list);
-		spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
-		qdf_mem_free(pkt);
-		spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	}
-	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
+	mon_ctx->mon_ring_head = 0;
+	mon_ctx->mon_ring_tail = 0;
+	mon_ctx->mon_ring_drop_cnt = 0;
 
-	return QDF_STATUS_E_NOMEM;
+	return QDF_STATUS_SUCCESS;
 }
 
 /**
- * pkt_capture_free_mon_pkt() - api to release mon packet to the freeq
+ * pkt_capture_mon_ring_slot() - get the mon ring slot of a ring index
  * @mon_ctx: Pointer to packet capture mon context
- * @pkt: MON packet buffer to be returned to free queue.
+ * @idx: free running ring index
  *
- * This api returns the mon packet used for mon data to the free queue
- *
- * Return: None
+ * Return: Pointer to pkt_capture_mon_pkt
  */
-static void
-pkt_capture_free_mon_pkt(struct pkt_capture_mon_context *mon_ctx,
-			 struct pkt_capture_mon_pkt *pkt)
+static inline struct pkt_capture_mon_pkt *
+pkt_capture_mon_ring_slot(struct pkt_capture_mon_context *mon_ctx,
+			  uint32_t idx)
 {
-	memset(pkt, 0, sizeof(*pkt));
-	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	list_add_tail(&pkt->list, &mon_ctx->mon_pkt_freeq);
-	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
+	return &mon_ctx->mon_ring[idx & (PKT_CAPTURE_MON_RING_SIZE - 1)];
 }
 
-struct pkt_capture_mon_pkt *
-pkt_capture_alloc_mon_pkt(struct wlan_objmgr_vdev *vdev)
+QDF_STATUS pkt_capture_indicate_monpkt(struct wlan_objmgr_vdev *vdev,
+				       const struct pkt_capture_mon_pkt *pkt)
 {
 	struct pkt_capture_vdev_priv *vdev_priv;
 	struct pkt_capture_mon_context *mon_ctx;
-	struct pkt_capture_mon_pkt *pkt;
+	uint32_t drop_cnt;
 
 	if (!vdev) {
 		pkt_capture_err("vdev is NULL");
-		return NULL;
+		return QDF_STATUS_E_INVAL;
 	}
 
 	vdev_priv = pkt_capture_vdev_get_priv(vdev);
 	if (!vdev_priv) {
 		pkt_capture_err("packet capture vdev priv is NULL");
-		return NULL;
+		return QDF_STATUS_E_INVAL;
 	}
 
 	mon_ctx = vdev_priv->mon_ctx;
 	if (!mon_ctx) {
 		pkt_capture_err("packet capture mon context is NULL");
-		return NULL;
-	}
-
-	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	if (list_empty(&mon_ctx->mon_pkt_freeq)) {
-		spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
-		return NULL;
+		return QDF_STATUS_E_INVAL;
 	}
 
-	pkt = list_first_entry(&mon_ctx->mon_pkt_freeq,
-			       struct pkt_capture_mon_pkt, list);
-	list_del(&pkt->list);
-	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
-
-	return pkt;
-}
-
-void pkt_capture_indicate_monpkt(struct wlan_objmgr_vdev *vdev,
-				 struct pkt_capture_mon_pkt *pkt)
-{
-	struct pkt_capture_vdev_priv *vdev_priv;
-	struct pkt_capture_mon_context *mon_ctx;
-
-	if (!vdev) {
-		pkt_capture_err("vdev is NULL");
-		return;
+	spin_lock_bh(&mon_ctx->mon_queue_lock);
+	if (qdf_unlikely(!mon_ctx->mon_ring ||
+			 mon_ctx->mon_ring_tail - mon_ctx->mon_ring_head >=
+			 PKT_CAPTURE_MON_RING_SIZE)) {
+		drop_cnt = ++mon_ctx->mon_ring_drop_cnt;
+		spin_unlock_bh(&mon_ctx->mon_queue_lock);
+		/* shed the load, the mon thread catches up on its own */
+		if (!(drop_cnt & (PKT_CAPTURE_MON_RING_SIZE - 1)))
+			pkt_capture_debug("mon ring full, %u pkts dropped",
+					  drop_cnt);
+		return QDF_STATUS_E_RESOURCES;
 	}
+	*pkt_capture_mon_ring_slot(mon_ctx, mon_ctx->mon_ring_tail) = *pkt;
+	mon_ctx->mon_ring_tail++;
+	spin_unlock_bh(&mon_ctx->mon_queue_lock);
 
-	vdev_priv = pkt_capture_vdev_get_priv(vdev);
-	if (!vdev_priv) {
-		pkt_capture_err("packet capture vdev priv is NULL");
-		return;
-	}
-	mon_ctx = vdev_priv->mon_ctx;
+	/* the thread is already posted if the bit is set, skip the wakeup */
+	if (!test_and_set_bit(PKT_CAPTURE_RX_POST_EVENT,
+			      &mon_ctx->mon_event_flag))
+		wake_up_interruptible(&mon_ctx->mon_wait_queue);
 
-	spin_lock_bh(&mon_ctx->mon_queue_lock);
-	list_add_tail(&pkt->list, &mon_ctx->mon_thread_queue);
-	spin_unlock_bh(&mon_ctx->mon_queue_lock);
-	set_bit(PKT_CAPTURE_RX_POST_EVENT, &mon_ctx->mon_event_flag);
-	wake_up_interruptible(&mon_ctx->mon_wait_queue);
+	return QDF_STATUS_SUCCESS;
 }
 
 void pkt_capture_wakeup_mon_thread(struct wlan_objmgr_vdev *vdev)
@@ -234,8 +196,10 @@ void pkt_capture_wakeup_mon_thread(struct wlan_objmgr_vdev *vdev)
  * pkt_capture_process_from_queue() - function to process pending mon packets
  * @mon_ctx: Pointer to packet capture mon context
  *
- * This api traverses the pending buffer list and calling the callback.
- * This callback would essentially send the packet to HDD.
+ * This api traverses the pending mon ring slots and calls the callback.
+ * This callback would essentially send the packet to HDD. Slots are
+ * processed in place, up to PKT_CAPTURE_MON_BATCH_SIZE per lock hold,
+ * and handed back to the producers by advancing the ring head.
  *
  * Return: None
  */
@@ -243,24 +207,31 @@ static void
 pkt_capture_process_from_queue(struct pkt_capture_mon_context *mon_ctx)
 {
 	struct pkt_capture_mon_pkt *pkt;
-	uint8_t vdev_id;
-	uint8_t tid;
+	uint32_t head, tail, end;
 
 	spin_lock_bh(&mon_ctx->mon_queue_lock);
-	while (!list_empty(&mon_ctx->mon_thread_queue)) {
-		pkt = list_first_entry(&mon_ctx->mon_thread_queue,
-				       struct pkt_capture_mon_pkt, list);
-		list_del(&pkt->list);
-		spin_unlock_bh(&mon_ctx->mon_queue_lock);
-		vdev_id = pkt->vdev_id;
-		tid = pkt->tid;
-		pkt->callback(pkt->context, pkt->pdev, pkt->monpkt, vdev_id,
-			      tid, pkt->status, pkt->pkt_format, pkt->bssid,
-			      pkt->tx_retry_cnt);
-		pkt_capture_free_mon_pkt(mon_ctx, pkt);
+	head = mon_ctx->mon_ring_head;
+	tail = mon_ctx->mon_ring_tail;
+	spin_unlock_bh(&mon_ctx->mon_queue_lock);
+
+	while (head != tail) {
+		end = tail;
+		if (end - head > PKT_CAPTURE_MON_BATCH_SIZE)
+			end = head + PKT_CAPTURE_MON_BATCH_SIZE;
+
+		for (; head != end; head++) {
+			pkt = pkt_capture_mon_ring_slot(mon_ctx, head);
+			pkt->callback(pkt->context, pkt->pdev, pkt->monpkt,
+				      pkt->vdev_id, pkt->tid, pkt->status,
+				      pkt->pkt_format, pkt->bssid,
+				      pkt->tx_retry_cnt);
+		}
+
 		spin_lock_bh(&mon_ctx->mon_queue_lock);
+		mon_ctx->mon_ring_head = head;
+		tail = mon_ctx->mon_ring_tail;
+		spin_unlock_bh(&mon_ctx->mon_queue_lock);
 	}
-	spin_unlock_bh(&mon_ctx->mon_queue_lock);
 }
 
 /**
@@ -315,6 +286,12 @@ static int pkt_capture_mon_thread(void *arg)
 
 		clear_bit(PKT_CAPTURE_RX_POST_EVENT,
 			  &mon_ctx->mon_event_flag);
+		/*
+		 * order the clear before the ring is drained, otherwise a
+		 * producer seeing the bit still set skips the wakeup and its
+		 * slot waits for the next post
+		 */
+		smp_mb__after_atomic();
 		while (true) {
 			if (test_bit(PKT_CAPTURE_RX_SHUTDOWN_EVENT,
 				     &mon_ctx->mon_event_flag)) {
@@ -367,7 +344,10 @@ void pkt_capture_close_mon_thread(struct pkt_capture_mon_context *mon_ctx)
 	wait_for_completion(&mon_ctx->mon_shutdown);
 	mon_ctx->mon_thread = NULL;
 	pkt_capture_drop_monpkt(mon_ctx);
-	pkt_capture_free_mon_pkt_freeq(mon_ctx);
+	if (mon_ctx->mon_ring_drop_cnt)
+		pkt_capture_info("mon ring full drops: %u",
+				 mon_ctx->mon_ring_drop_cnt);
+	pkt_capture_free_mon_ring(mon_ctx);
 }
 
 QDF_STATUS
@@ -392,32 +372,25 @@ pkt_capture_open_mon_thread(struct pkt_capture_mon_context *mon_ctx)
 
 void pkt_capture_drop_monpkt(struct pkt_capture_mon_context *mon_ctx)
 {
-	struct pkt_capture_mon_pkt *pkt, *tmp;
-	struct list_head local_list;
+	struct pkt_capture_mon_pkt *pkt;
+	uint32_t head, tail;
 	qdf_nbuf_t buf, next_buf;
 
-	INIT_LIST_HEAD(&local_list);
 	spin_lock_bh(&mon_ctx->mon_queue_lock);
-	if (list_empty(&mon_ctx->mon_thread_queue)) {
-		spin_unlock_bh(&mon_ctx->mon_queue_lock);
-		return;
-	}
-	list_for_each_entry_safe(pkt, tmp,
-				 &mon_ctx->mon_thread_queue,
-				 list)
-		list_move_tail(&pkt->list, &local_list);
-
+	head = mon_ctx->mon_ring_head;
+	tail = mon_ctx->mon_ring_tail;
+	mon_ctx->mon_ring_head = tail;
 	spin_unlock_bh(&mon_ctx->mon_queue_lock);
 
-	list_for_each_entry_safe(pkt, tmp, &local_list, list) {
-		list_del(&pkt->list);
+	for (; head != tail; head++) {
+		pkt = pkt_capture_mon_ring_slot(mon_ctx, head);
 		buf = pkt->monpkt;
 		while (buf) {
 			next_buf = qdf_nbuf_queue_next(buf);
 			qdf_nbuf_free(buf);
 			buf = next_buf;
 		}
-		pkt_capture_free_mon_pkt(mon_ctx, pkt);
+		pkt->monpkt = NULL;
 	}
 }
 
@@ -496,11 +469,6 @@ pkt_capture_alloc_mon_thread(struct pkt_capture_mon_context *mon_ctx)
 	init_completion(&mon_ctx->mon_shutdown);
 	mon_ctx->mon_event_flag = 0;
 	spin_lock_init(&mon_ctx->mon_queue_lock);
-	spin_lock_init(&mon_ctx->mon_pkt_freeq_lock);
-	INIT_LIST_HEAD(&mon_ctx->mon_thread_queue);
-	spin_lock_bh(&mon_ctx->mon_pkt_freeq_lock);
-	INIT_LIST_HEAD(&mon_ctx->mon_pkt_freeq);
-	spin_unlock_bh(&mon_ctx->mon_pkt_freeq_lock);
 
-	return pkt_capture_alloc_mon_pkt_freeq(mon_ctx);
+	return pkt_capture_alloc_mon_ring(mon_ctx);
 }
@@ -26,6 +26,8 @@
 #include "wlan_tdls_peer.h"
 #include "wlan_tdls_ct.h"
 #include "wlan_tdls_cmds_process.h"
+#include "qdf_util.h"
+#include <linux/interrupt.h>
 
 bool tdls_is_vdev_authenticated(struct wlan_objmgr_vdev *vdev)
 {
@@ -118,6 +120,43 @@ void tdls_discovery_timeout_peer_cb(void *user_data)
 	return;
 }
 
+/**
+ * tdls_ct_cache_bss_mac() - cache the BSS peer mac for the datapath
+ * @tdls_vdev: tdls vdev object
+ *
+ * Return: None
+ */
+static void tdls_ct_cache_bss_mac(struct tdls_vdev_priv_obj *tdls_vdev)
+{
+	struct wlan_objmgr_peer *bss_peer;
+	struct qdf_mac_addr bss_mac;
+
+	qdf_zero_macaddr(&bss_mac);
+	bss_peer = wlan_objmgr_vdev_try_get_bsspeer(tdls_vdev->vdev,
+						    WLAN_TDLS_NB_ID);
+	if (bss_peer) {
+		qdf_mem_copy(bss_mac.bytes, bss_peer->macaddr,
+			     QDF_MAC_ADDR_SIZE);
+		wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
+	}
+
+	qdf_copy_macaddr(&tdls_vdev->ct_bss_mac, &bss_mac);
+}
+
+/**
+ * tdls_ct_next_period() - start a new sampling period of the counters
+ * @tdls_vdev: tdls vdev object
+ *
+ * Each CPU drops the counts of the previous period when it counts its
+ * next pkt, so the counters are never written by another CPU.
+ *
+ * Return: None
+ */
+static void tdls_ct_next_period(struct tdls_vdev_priv_obj *tdls_vdev)
+{
+	WRITE_ONCE(tdls_vdev->ct_gen, tdls_vdev->ct_gen + 1);
+}
+
 /**
  * tdls_reset_tx_rx() - reset tx/rx counters for all tdls peers
  * @tdls_vdev: TDLS vdev object
@@ -167,6 +206,8 @@ void tdls_implicit_enable(struct tdls_vdev_priv_obj *tdls_vdev)
 
 	tdls_peer_reset_discovery_processed(tdls_vdev);
 	tdls_reset_tx_rx(tdls_vdev);
+	tdls_ct_next_period(tdls_vdev);
+	tdls_ct_cache_bss_mac(tdls_vdev);
 	/* TODO check whether tdls power save prohibited */
 
 	/* Restart the connection tracker timer */
@@ -174,13 +215,69 @@ void tdls_implicit_enable(struct tdls_vdev_priv_obj *tdls_vdev)
 			   tdls_vdev->threshold_config.tx_period_t);
 }
 
+/**
+ * tdls_ct_fold_shard() - add the counters of a CPU to the sample
+ * @mac_table: sample, one entry per peer
+ * @mac_entries: number of valid @mac_table entries
+ * @shard: counters of the CPU
+ * @gen: sampling period being folded
+ *
+ * The counters are read while their CPU may still update them. A pkt
+ * counted after the copy is lost, as the CPU drops the counters once the
+ * next period starts.
+ *
+ * Return: None
+ */
+static void tdls_ct_fold_shard(struct tdls_conn_tracker_mac_table *mac_table,
+			       uint8_t *mac_entries,
+			       struct tdls_ct_shard *shard, uint32_t gen)
+{
+	struct tdls_conn_tracker_mac_table tbl[WLAN_TDLS_CT_HASH_SIZE];
+	uint8_t i, j;
+
+	/* no pkt counted by the CPU in this period */
+	if (READ_ONCE(shard->gen) != gen)
+		return;
+
+	/* pairs with the smp_wmb() in tdls_ct_count() */
+	smp_rmb();
+	qdf_mem_copy(tbl, shard->tbl, sizeof(tbl));
+
+	for (j = 0; j < WLAN_TDLS_CT_HASH_SIZE; j++) {
+		if (qdf_is_macaddr_zero(&tbl[j].mac_address))
+			continue;
+
+		for (i = 0; i < *mac_entries; i++) {
+			if (qdf_is_macaddr_equal(&mac_table[i].mac_address,
+						 &tbl[j].mac_address))
+				break;
+		}
+
+		/* If we have more than 8 peers within 30 mins. we will
+		 *  stop tracking till the old entries are removed
+		 */
+		if (i == *mac_entries) {
+			if (i == WLAN_TDLS_CT_TABLE_SIZE)
+				continue;
+			qdf_mem_zero(&mac_table[i], sizeof(mac_table[i]));
+			qdf_copy_macaddr(&mac_table[i].mac_address,
+					 &tbl[j].mac_address);
+			(*mac_entries)++;
+		}
+
+		mac_table[i].tx_packet_cnt += tbl[j].tx_packet_cnt;
+		mac_table[i].rx_packet_cnt += tbl[j].rx_packet_cnt;
+	}
+}
+
 /**
  * tdls_ct_sampling_tx_rx() - collect tx/rx traffic sample
  * @tdls_vdev_obj: tdls vdev object
  * @tdls_soc_obj: tdls soc object
  *
  * Function to update data traffic information in tdls connection
- * tracker data structure for connection tracker operation
+ * tracker data structure for connection tracker operation. The counters
+ * of every CPU are folded per peer, then the next period is started.
  *
  * Return: None
  */
@@ -188,35 +285,22 @@ static void tdls_ct_sampling_tx_rx(struct tdls_vdev_priv_obj *tdls_vdev,
 				   struct tdls_soc_priv_obj *tdls_soc)
 {
 	struct tdls_peer *curr_peer;
-	uint8_t mac[QDF_MAC_ADDR_SIZE];
 	uint8_t mac_cnt;
-	uint8_t mac_entries;
+	uint8_t mac_entries = 0;
 	struct tdls_conn_tracker_mac_table mac_table[WLAN_TDLS_CT_TABLE_SIZE];
+	unsigned int cpu;
 
-	qdf_spin_lock_bh(&tdls_soc->tdls_ct_spinlock);
-
-	if (0 == tdls_vdev->valid_mac_entries) {
-		qdf_spin_unlock_bh(&tdls_soc->tdls_ct_spinlock);
-		return;
-	}
-
-	mac_entries = QDF_MIN(tdls_vdev->valid_mac_entries,
-			      WLAN_TDLS_CT_TABLE_SIZE);
-
-	qdf_mem_copy(mac_table, tdls_vdev->ct_peer_table,
-	       (sizeof(struct tdls_conn_tracker_mac_table)) * mac_entries);
-
-	qdf_mem_zero(tdls_vdev->ct_peer_table,
-	       (sizeof(struct tdls_conn_tracker_mac_table)) * mac_entries);
+	tdls_ct_cache_bss_mac(tdls_vdev);
 
-	tdls_vdev->valid_mac_entries = 0;
-
-	qdf_spin_unlock_bh(&tdls_soc->tdls_ct_spinlock);
+	for (cpu = 0; cpu < nr_cpu_ids; cpu++)
+		tdls_ct_fold_shard(mac_table, &mac_entries,
+				   &tdls_vdev->ct_shards[cpu],
+				   tdls_vdev->ct_gen);
+	tdls_ct_next_period(tdls_vdev);
 
 	for (mac_cnt = 0; mac_cnt < mac_entries; mac_cnt++) {
-		qdf_mem_copy(mac, mac_table[mac_cnt].mac_address.bytes,
-		       QDF_MAC_ADDR_SIZE);
-		curr_peer = tdls_get_peer(tdls_vdev, mac);
+		curr_peer = tdls_get_peer(tdls_vdev,
+					  mac_table[mac_cnt].mac_address.bytes);
 		if (curr_peer) {
 			curr_peer->tx_pkt =
 			mac_table[mac_cnt].tx_packet_cnt;
@@ -226,16 +310,75 @@ static void tdls_ct_sampling_tx_rx(struct tdls_vdev_priv_obj *tdls_vdev,
 	}
 }
 
+/**
+ * tdls_ct_count() - count a pkt of a peer in the current sampling period
+ * @tdls_vdev: tdls vdev object
+ * @mac_addr: peer mac address
+ * @tx: count a tx pkt, else an rx pkt
+ *
+ * The pkt is counted in the counters of the current CPU, with bottom
+ * halves disabled so that the caller neither migrates nor gets
+ * interrupted by another datapath caller on the same CPU. Only that CPU
+ * writes its counters, so no lock or atomic operation is needed. A peer
+ * that collides with another one probes the next slots, so up to
+ * WLAN_TDLS_CT_HASH_SIZE peers are counted per CPU and period.
+ *
+ * Return: None
+ */
+static void tdls_ct_count(struct tdls_vdev_priv_obj *tdls_vdev,
+			  struct qdf_mac_addr *mac_addr, bool tx)
+{
+	struct tdls_ct_shard *shard;
+	struct tdls_conn_tracker_mac_table *ctr;
+	uint32_t gen;
+	uint8_t idx, i;
+
+	if (qdf_is_macaddr_equal(&tdls_vdev->ct_bss_mac, mac_addr))
+		return;
+
+	idx = mac_addr->bytes[4] ^ mac_addr->bytes[5];
+
+	local_bh_disable();
+	shard = &tdls_vdev->ct_shards[qdf_get_cpu()];
+
+	/* first pkt of the period: drop the counts already folded */
+	gen = READ_ONCE(tdls_vdev->ct_gen);
+	if (shard->gen != gen) {
+		qdf_mem_zero(shard->tbl, sizeof(shard->tbl));
+		/* the counters are cleared before they are tagged with gen */
+		smp_wmb();
+		WRITE_ONCE(shard->gen, gen);
+	}
+
+	for (i = 0; i < WLAN_TDLS_CT_HASH_SIZE; i++) {
+		ctr = &shard->tbl[(idx + i) & (WLAN_TDLS_CT_HASH_SIZE - 1)];
+		if (qdf_is_macaddr_zero(&ctr->mac_address)) {
+			qdf_copy_macaddr(&ctr->mac_address, mac_addr);
+			break;
+		}
+		if (qdf_is_macaddr_equal(&ctr->mac_address, mac_addr))
+			break;
+	}
+
+	/* counters full, as with the 8 peer table: not counted */
+	if (i == WLAN_TDLS_CT_HASH_SIZE)
+		goto out;
+
+	if (tx)
+		ctr->tx_packet_cnt++;
+	else
+		ctr->rx_packet_cnt++;
+
+out:
+	local_bh_enable();
+}
+
 void tdls_update_rx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 				 struct qdf_mac_addr *mac_addr,
 				 struct qdf_mac_addr *dest_mac_addr)
 {
 	struct tdls_vdev_priv_obj *tdls_vdev_obj;
 	struct tdls_soc_priv_obj *tdls_soc_obj;
-	uint8_t mac_cnt;
-	uint8_t valid_mac_entries;
-	struct tdls_conn_tracker_mac_table *mac_table;
-	struct wlan_objmgr_peer *bss_peer;
 
 	if (QDF_STATUS_SUCCESS != tdls_get_vdev_objects(vdev, &tdls_vdev_obj,
 							&tdls_soc_obj))
@@ -254,40 +397,7 @@ void tdls_update_rx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 			 QDF_MAC_ADDR_SIZE))
 		return;
 
-	bss_peer = wlan_objmgr_vdev_try_get_bsspeer(vdev, WLAN_TDLS_NB_ID);
-	if (bss_peer) {
-		if (!qdf_mem_cmp(bss_peer->macaddr, mac_addr,
-				 QDF_MAC_ADDR_SIZE)) {
-			wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-			return;
-		}
-		wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-	}
-	qdf_spin_lock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	valid_mac_entries = tdls_vdev_obj->valid_mac_entries;
-	mac_table = tdls_vdev_obj->ct_peer_table;
-
-	for (mac_cnt = 0; mac_cnt < valid_mac_entries; mac_cnt++) {
-		if (qdf_mem_cmp(mac_table[mac_cnt].mac_address.bytes,
-		    mac_addr, QDF_MAC_ADDR_SIZE) == 0) {
-			mac_table[mac_cnt].rx_packet_cnt++;
-			goto rx_cnt_return;
-		}
-	}
-
-	/* If we have more than 8 peers within 30 mins. we will
-	 *  stop tracking till the old entries are removed
-	 */
-	if (mac_cnt < WLAN_TDLS_CT_TABLE_SIZE) {
-		qdf_mem_copy(mac_table[mac_cnt].mac_address.bytes,
-		       mac_addr, QDF_MAC_ADDR_SIZE);
-		tdls_vdev_obj->valid_mac_entries = mac_cnt+1;
-		mac_table[mac_cnt].rx_packet_cnt = 1;
-	}
-
-rx_cnt_return:
-	qdf_spin_unlock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	return;
+	tdls_ct_count(tdls_vdev_obj, mac_addr, false);
 }
 
 void tdls_update_tx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
@@ -295,10 +405,6 @@ void tdls_update_tx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 {
 	struct tdls_vdev_priv_obj *tdls_vdev_obj;
 	struct tdls_soc_priv_obj *tdls_soc_obj;
-	uint8_t mac_cnt;
-	uint8_t valid_mac_entries;
-	struct tdls_conn_tracker_mac_table *mac_table;
-	struct wlan_objmgr_peer *bss_peer;
 
 	if (QDF_STATUS_SUCCESS != tdls_get_vdev_objects(vdev, &tdls_vdev_obj,
 							&tdls_soc_obj))
@@ -313,42 +419,8 @@ void tdls_update_tx_pkt_cnt(struct wlan_objmgr_vdev *vdev,
 	if (!qdf_mem_cmp(vdev->vdev_mlme.macaddr, mac_addr,
 			 QDF_MAC_ADDR_SIZE))
 		return;
-	bss_peer = wlan_objmgr_vdev_try_get_bsspeer(vdev, WLAN_TDLS_NB_ID);
-	if (bss_peer) {
-		if (!qdf_mem_cmp(bss_peer->macaddr, mac_addr,
-				 QDF_MAC_ADDR_SIZE)) {
-			wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-			return;
-		}
-		wlan_objmgr_peer_release_ref(bss_peer, WLAN_TDLS_NB_ID);
-	}
-
-	qdf_spin_lock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	mac_table = tdls_vdev_obj->ct_peer_table;
-
-	valid_mac_entries = tdls_vdev_obj->valid_mac_entries;
-
-	for (mac_cnt = 0; mac_cnt < valid_mac_entries; mac_cnt++) {
-		if (qdf_mem_cmp(mac_table[mac_cnt].mac_address.bytes,
-		    mac_addr, QDF_MAC_ADDR_SIZE) == 0) {
-			mac_table[mac_cnt].tx_packet_cnt++;
-			goto tx_cnt_return;
-		}
-	}
-
-	/* If we have more than 8 peers within 30 mins. we will
-	 *  stop tracking till the old entries are removed
-	 */
-	if (mac_cnt < WLAN_TDLS_CT_TABLE_SIZE) {
-		qdf_mem_copy(mac_table[mac_cnt].mac_address.bytes,
-			mac_addr, QDF_MAC_ADDR_SIZE);
-		mac_table[mac_cnt].tx_packet_cnt = 1;
-		tdls_vdev_obj->valid_mac_entries++;
-	}
 
-tx_cnt_return:
-	qdf_spin_unlock_bh(&tdls_soc_obj->tdls_ct_spinlock);
-	return;
+	tdls_ct_count(tdls_vdev_obj, mac_addr, true);
 }
 
 void tdls_implicit_send_discovery_request(
@@ -212,10 +212,16 @@ static QDF_STATUS tdls_vdev_init(struct tdls_vdev_priv_obj *vdev_obj)
 		user_config->tdls_rssi_teardown_threshold;
 	config->rssi_delta = user_config->tdls_rssi_delta;
 
+	vdev_obj->ct_shards = qdf_mem_malloc(nr_cpu_ids *
+					     sizeof(*vdev_obj->ct_shards));
+	if (!vdev_obj->ct_shards)
+		return QDF_STATUS_E_NOMEM;
+
 	for (i = 0; i < WLAN_TDLS_PEER_LIST_SIZE; i++) {
 		qdf_list_create(&vdev_obj->peer_list[i],
 				WLAN_TDLS_PEER_SUB_LIST_SIZE);
 	}
+
 	qdf_mc_timer_init(&vdev_obj->peer_update_timer, QDF_TIMER_TYPE_SW,
 			  tdls_ct_handler, vdev_obj->vdev);
 	qdf_mc_timer_init(&vdev_obj->peer_discovery_timer, QDF_TIMER_TYPE_SW,
@@ -234,6 +240,9 @@ static void tdls_vdev_deinit(struct tdls_vdev_priv_obj *vdev_obj)
 
 	tdls_peer_idle_timers_destroy(vdev_obj);
 	tdls_free_peer_list(vdev_obj);
+
+	qdf_mem_free(vdev_obj->ct_shards);
+	vdev_obj->ct_shards = NULL;
 }
 
 QDF_STATUS tdls_vdev_obj_create_notification(struct wlan_objmgr_vdev *vdev,
@@ -59,6 +59,9 @@
 #define TDLS_DISCOVERY_TIMEOUT_BEFORE_UPDATE     1000
 #define TDLS_SCAN_REJECT_MAX            5
 
+/* Connection tracker counter slots per CPU, must be a power of 2 */
+#define WLAN_TDLS_CT_HASH_SIZE          16
+
 #define tdls_debug(params...) \
 	QDF_TRACE_DEBUG(QDF_MODULE_ID_TDLS, params)
 #define tdls_debug_rl(params...) \
@@ -131,6 +134,17 @@ struct tdls_conn_tracker_mac_table {
 	uint32_t peer_timestamp_ms;
 };
 
+/**
+ * struct tdls_ct_shard - connection tracker counters of one CPU
+ * @gen: sampling period @tbl counts, only written by the CPU
+ * @tbl: per peer tx/rx counters, open addressed by peer mac hash. A zero
+ *	mac address marks a free slot. Only written by the CPU.
+ */
+struct tdls_ct_shard {
+	uint32_t gen;
+	struct tdls_conn_tracker_mac_table tbl[WLAN_TDLS_CT_HASH_SIZE];
+};
+
 /**
  * struct tdls_set_state_db - to record set tdls state command, we need to
  * set correct tdls state to firmware:
@@ -181,7 +195,6 @@ struct tdls_set_state_info {
  * @tdls_del_all_peers:store eWNI_SME_DEL_ALL_TDLS_PEERS
  * @tdls_update_dp_vdev_flags store CDP_UPDATE_TDLS_FLAGS
  * @tdls_idle_peer_data: provide information about idle peer
- * @tdls_ct_spinlock: connection tracker spin lock
  * @tdls_osif_init_cb: Callback to initialize the tdls private
  * @tdls_osif_deinit_cb: Callback to deinitialize the tdls private
  */
@@ -223,7 +236,6 @@ struct tdls_soc_priv_obj {
 	uint16_t tdls_update_peer_state;
 	uint16_t tdls_del_all_peers;
 	uint32_t tdls_update_dp_vdev_flags;
-	qdf_spinlock_t tdls_ct_spinlock;
 	tdls_vdev_init_cb tdls_osif_init_cb;
 	tdls_vdev_deinit_cb tdls_osif_deinit_cb;
 };
@@ -238,8 +250,10 @@ struct tdls_soc_priv_obj {
  * @discovery_peer_cnt: discovery peer count
  * @discovery_sent_cnt: discovery sent count
  * @curr_candidate: current candidate
- * @ct_peer_table: linear mac address table for counting the packets
- * @valid_mac_entries: number of valid mac entry in @ct_peer_mac_table
+ * @ct_shards: per-CPU packet counters, indexed by CPU id and folded into
+ *	the peers every sampling period
+ * @ct_gen: current sampling period, only written by the connection tracker
+ * @ct_bss_mac: BSS peer mac, whose traffic is not counted
  * @magic: magic
  * @tx_queue: tx frame queue
  */
@@ -252,9 +266,9 @@ struct tdls_vdev_priv_obj {
 	int32_t discovery_peer_cnt;
 	uint32_t discovery_sent_cnt;
 	struct tdls_peer *curr_candidate;
-	struct tdls_conn_tracker_mac_table
-			ct_peer_table[WLAN_TDLS_CT_TABLE_SIZE];
-	uint8_t valid_mac_entries;
+	struct tdls_ct_shard *ct_shards;
+	uint32_t ct_gen;
+	struct qdf_mac_addr ct_bss_mac;
 	uint32_t magic;
 	uint8_t session_id;
 	qdf_list_t tx_queue;
@@ -237,14 +237,11 @@ static QDF_STATUS tdls_global_init(struct tdls_soc_priv_obj *soc_obj)
 	soc_obj->tdls_external_peer_count = 0;
 	soc_obj->tdls_disable_in_progress = false;
 
-	qdf_spinlock_create(&soc_obj->tdls_ct_spinlock);
-
 	return QDF_STATUS_SUCCESS;
 }
 
 static QDF_STATUS tdls_global_deinit(struct tdls_soc_priv_obj *soc_obj)
 {
-	qdf_spinlock_destroy(&soc_obj->tdls_ct_spinlock);
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -61,12 +61,15 @@ enum cfg_sub_20_channel_width {
  * @dfs_pri_multiplier: dfs radar pri multiplier
  * @uc_offload_enabled: IPA Micro controller data path offload enable flag
  * @enable_rxthread: Rx processing in thread from TXRX
+ * @num_ol_rx_threads: number of Rx threads when @enable_rxthread is set
  * @tx_flow_stop_queue_th: Threshold to stop queue in percentage
  * @tx_flow_start_queue_offset: Start queue offset in percentage
  * @enable_dp_rx_threads: enable dp rx threads
+ * @dp_rx_flow_steering: steer rx flows across dp rx threads by flow hash
  * @is_lpass_enabled: Indicate whether LPASS is enabled or not
  * @tx_chain_mask_cck: Tx chain mask enabled or not
  * @sub_20_channel_width: Sub 20 MHz ch width, ini intersected with fw cap
+ * @rx_paddr_cookie: track rx buffers by a cookie in their paddr
  * @is_fw_timeout: Indicate whether crash host when fw timesout or not
  * @ito_repeat_count: Indicates ito repeated count
  * @force_target_assert_enabled: Indicate whether target assert enabled or not
@@ -86,16 +89,19 @@ struct cds_config_info {
 	uint8_t reorder_offload;
 	uint8_t uc_offload_enabled;
 	bool enable_rxthread;
+	uint8_t num_ol_rx_threads;
 #if defined(QCA_LL_TX_FLOW_CONTROL_V2) || defined(QCA_LL_PDEV_TX_FLOW_CONTROL)
 	uint32_t tx_flow_stop_queue_th;
 	uint32_t tx_flow_start_queue_offset;
 #endif
 	uint8_t enable_dp_rx_threads;
+	bool dp_rx_flow_steering;
 #ifdef WLAN_FEATURE_LPSS
 	bool is_lpass_enabled;
 #endif
 	enum cfg_sub_20_channel_width sub_20_channel_width;
 	uint8_t max_msdus_per_rxinorderind;
+	bool rx_paddr_cookie;
 	bool self_recovery_enabled;
 	bool fw_timeout_crash;
 	struct ol_tx_sched_wrr_ac_specs_t ac_specs[QCA_WLAN_AC_ALL];
@@ -37,6 +37,7 @@
 #include <linux/wakelock.h>
 #endif
 #include <qdf_types.h>
+#include <qdf_nbuf.h>
 #include "qdf_lock.h"
 #include "qdf_mc_timer.h"
 #include "cds_config.h"
@@ -54,6 +55,9 @@
 ** OL Rx thread.
 */
 #define CDS_MAX_OL_RX_PKT 4000
+
+/* Maximum number of OL Rx thread instances */
+#define CDS_MAX_OL_RX_THREADS 4
 #endif
 
 typedef void (*cds_ol_rx_thread_cb)(void *context,
@@ -78,6 +82,42 @@ struct cds_ol_rx_pkt {
 
 };
 
+#ifdef QCA_CONFIG_SMP
+struct _cds_sched_context;
+
+/**
+ * struct cds_ol_rx_thread - OL Rx thread instance
+ * @id: index of the instance in the scheduler context
+ * @sched_ctx: scheduler context owning the instance
+ * @task: thread handle
+ * @thread_lock: synchronizes suspend with resume
+ * @start_event: completed by the thread on startup
+ * @suspend_event: completed by the thread once suspended
+ * @resume_event: completed to resume the suspended thread
+ * @shutdown: completed by the thread on exit
+ * @wait_queue: wait queue of the thread
+ * @event_flag: RX_*_EVENT bits
+ * @pkt_queue: indications wrapped in a struct cds_ol_rx_pkt
+ * @nbuf_queue: unwrapped nbuf lists, see cds_indicate_rx_nbuf_list()
+ * @queue_lock: protects @pkt_queue and @nbuf_queue
+ */
+struct cds_ol_rx_thread {
+	uint8_t id;
+	struct _cds_sched_context *sched_ctx;
+	struct task_struct *task;
+	spinlock_t thread_lock;
+	struct completion start_event;
+	struct completion suspend_event;
+	struct completion resume_event;
+	struct completion shutdown;
+	wait_queue_head_t wait_queue;
+	unsigned long event_flag;
+	struct list_head pkt_queue;
+	qdf_nbuf_queue_t nbuf_queue;
+	spinlock_t queue_lock;
+};
+#endif
+
 /*
 ** CDS Scheduler context
 ** The scheduler context contains the following:
@@ -88,33 +128,15 @@ struct cds_ol_rx_pkt {
 */
 typedef struct _cds_sched_context {
 #ifdef QCA_CONFIG_SMP
-	spinlock_t ol_rx_thread_lock;
-
-	/* OL Rx thread handle */
-	struct task_struct *ol_rx_thread;
-
-	/* Handle of Event for Rx thread to signal startup */
-	struct completion ol_rx_start_event;
-
-	/* Completion object to suspend OL rx thread */
-	struct completion ol_suspend_rx_event;
+	/* OL Rx thread instances, rx is steered to them by sta and tid */
+	struct cds_ol_rx_thread ol_rx_threads[CDS_MAX_OL_RX_THREADS];
 
-	/* Completion object to resume OL rx thread */
-	struct completion ol_resume_rx_event;
+	/* Number of OL Rx thread instances running */
+	uint8_t num_ol_rx_threads;
 
-	/* Completion object for OL Rxthread shutdown */
-	struct completion ol_rx_shutdown;
-
-	/* Waitq for OL Rx thread */
-	wait_queue_head_t ol_rx_wait_queue;
-
-	unsigned long ol_rx_event_flag;
-
-	/* Rx buffer queue */
-	struct list_head ol_rx_thread_queue;
-
-	/* Spinlock to synchronize between tasklet and thread */
-	spinlock_t ol_rx_queue_lock;
+	/* Handler of the nbuf lists queued by cds_indicate_rx_nbuf_list() */
+	cds_ol_rx_thread_cb ol_rx_cb;
+	void *ol_rx_cb_context;
 
 	/* Lock to synchronize free buffer queue access */
 	spinlock_t cds_ol_rx_pkt_freeq_lock;
@@ -275,6 +297,33 @@ void cds_drop_rxpkt_by_staid(p_cds_sched_context pSchedContext, uint16_t staId);
 void cds_indicate_rxpkt(p_cds_sched_context pSchedContext,
 			struct cds_ol_rx_pkt *pkt);
 
+/**
+ * cds_indicate_rx_nbuf_list() - queue an rx nbuf list to an OL Rx thread
+ * @sched_ctx: pointer to the global CDS Sched Context
+ * @nbuf_list: nbuf list chained through qdf_nbuf_next()
+ * @staid: station the frames are destined to
+ * @tid: TID the frames belong to
+ *
+ * Queues @nbuf_list without a struct cds_ol_rx_pkt wrapper to the OL Rx
+ * thread @staid and @tid are steered to. The thread hands it to the
+ * handler registered through cds_register_ol_rx_cb().
+ *
+ * Return: QDF_STATUS_SUCCESS if queued, otherwise the caller still owns
+ *	   @nbuf_list
+ */
+QDF_STATUS cds_indicate_rx_nbuf_list(p_cds_sched_context sched_ctx,
+				     qdf_nbuf_t nbuf_list, uint16_t staid,
+				     uint8_t tid);
+
+/**
+ * cds_register_ol_rx_cb() - register the handler of queued rx nbuf lists
+ * @cb: handler, NULL to deregister
+ * @context: context passed to @cb
+ *
+ * Return: None
+ */
+void cds_register_ol_rx_cb(cds_ol_rx_thread_cb cb, void *context);
+
 /**
  * cds_close_rx_thread() - close the Rx thread
  *
@@ -375,6 +424,35 @@ void cds_indicate_rxpkt(p_cds_sched_context pSchedContext,
 {
 }
 
+/**
+ * cds_indicate_rx_nbuf_list() - queue an rx nbuf list to an OL Rx thread
+ * @sched_ctx: pointer to the global CDS Sched Context
+ * @nbuf_list: nbuf list chained through qdf_nbuf_next()
+ * @staid: station the frames are destined to
+ * @tid: TID the frames belong to
+ *
+ * Return: QDF_STATUS_E_NOSUPPORT
+ */
+static inline
+QDF_STATUS cds_indicate_rx_nbuf_list(p_cds_sched_context sched_ctx,
+				     qdf_nbuf_t nbuf_list, uint16_t staid,
+				     uint8_t tid)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+/**
+ * cds_register_ol_rx_cb() - register the handler of queued rx nbuf lists
+ * @cb: handler, NULL to deregister
+ * @context: context passed to @cb
+ *
+ * Return: None
+ */
+static inline
+void cds_register_ol_rx_cb(cds_ol_rx_thread_cb cb, void *context)
+{
+}
+
 /**
  * cds_close_rx_thread() - close the Rx thread
  *
@@ -543,9 +621,18 @@ void cds_shutdown_notifier_purge(void);
 void cds_shutdown_notifier_call(void);
 
 /**
- * cds_resume_rx_thread() - resume rx thread by completing its resume event
+ * cds_suspend_rx_thread() - suspend all the OL Rx threads
+ * @timeout_ms: time to wait for each thread to suspend
+ *
+ * Return: QDF_STATUS_SUCCESS if all the threads suspended, otherwise all
+ *	   the threads asked to suspend are resumed again
+ */
+QDF_STATUS cds_suspend_rx_thread(uint32_t timeout_ms);
+
+/**
+ * cds_resume_rx_thread() - resume rx threads by completing their resume event
  *
- * Resume RX thread by completing RX thread resume event
+ * Resume the OL Rx threads by completing their resume events
  *
  * Return: None
  */
@@ -80,6 +80,19 @@
 #define cds_enter() QDF_TRACE_ENTER(QDF_MODULE_ID_QDF, "enter")
 #define cds_exit() QDF_TRACE_EXIT(QDF_MODULE_ID_QDF, "exit")
 
+/**
+ * cds_test_expect() - check a condition in a unit test
+ * @cond: condition expected to hold
+ * @errors: error count of the test, incremented if @cond does not hold
+ */
+#define cds_test_expect(cond, errors) \
+do { \
+	if (!(cond)) { \
+		cds_nofl_err("FAIL: %s:%d: " #cond, __func__, __LINE__); \
+		(errors)++; \
+	} \
+} while (false)
+
 /**
  * enum cds_band_type - Band type - 2g, 5g or all
  * CDS_BAND_ALL: Both 2G and 5G are valid.
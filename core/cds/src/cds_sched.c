@@ -61,6 +61,7 @@ static p_cds_sched_context gp_cds_sched_context;
 static int cds_ol_rx_thread(void *arg);
 static uint32_t affine_cpu;
 static QDF_STATUS cds_alloc_ol_rx_pkt_freeq(p_cds_sched_context pSchedContext);
+static QDF_STATUS cds_ol_rx_threads_start(p_cds_sched_context sched_ctx);
 
 #define CDS_CORE_PER_CLUSTER (4)
 /*Maximum 2 clusters supported*/
@@ -83,6 +84,61 @@ int cds_set_cpus_allowed_ptr_with_mask(struct task_struct *task,
 	return set_cpus_allowed_ptr(task, new_mask);
 }
 
+/**
+ * cds_ol_rx_threads_set_mask() - affine all the OL Rx threads to a cpu mask
+ * @sched_ctx: wlan scheduler context
+ * @new_mask: cpu mask to affine the threads to
+ *
+ * Return: None
+ */
+static void cds_ol_rx_threads_set_mask(p_cds_sched_context sched_ctx,
+				       qdf_cpu_mask *new_mask)
+{
+	struct task_struct *task;
+	uint8_t i;
+
+	for (i = 0; i < sched_ctx->num_ol_rx_threads; i++) {
+		task = sched_ctx->ol_rx_threads[i].task;
+		if (task)
+			cds_set_cpus_allowed_ptr_with_mask(task, new_mask);
+	}
+}
+
+/**
+ * cds_ol_rx_threads_set_cpu() - affine each OL Rx thread to a single cpu
+ * @sched_ctx: wlan scheduler context
+ * @cpu: cpu to affine the first thread to
+ *
+ * The other threads are affined to the online cpus following @cpu, so
+ * that they do not share a cpu as long as there are enough of them.
+ *
+ * Return: 0 on success
+ */
+static int cds_ol_rx_threads_set_cpu(p_cds_sched_context sched_ctx,
+				     unsigned long cpu)
+{
+	struct task_struct *task;
+	unsigned long thread_cpu = cpu;
+	uint8_t i;
+	int ret;
+
+	for (i = 0; i < sched_ctx->num_ol_rx_threads; i++) {
+		task = sched_ctx->ol_rx_threads[i].task;
+		if (!task)
+			continue;
+
+		ret = cds_set_cpus_allowed_ptr_with_cpu(task, thread_cpu);
+		if (ret)
+			return ret;
+
+		thread_cpu = cpumask_next(thread_cpu, cpu_online_mask);
+		if (thread_cpu >= nr_cpu_ids)
+			thread_cpu = cpu;
+	}
+
+	return 0;
+}
+
 void cds_set_rx_thread_cpu_mask(uint8_t cpu_affinity_mask)
 {
 	p_cds_sched_context sched_context = get_cds_sched_ctxt();
@@ -207,8 +263,7 @@ static int cds_sched_find_attach_cpu(p_cds_sched_context pSchedContext,
 			dp_txrx_set_cpu_mask(cds_get_context(QDF_MODULE_ID_SOC),
 					     &new_mask);
 		else
-			cds_set_cpus_allowed_ptr_with_mask(pSchedContext->ol_rx_thread,
-							   &new_mask);
+			cds_ol_rx_threads_set_mask(pSchedContext, &new_mask);
 	}
 
 	return 0;
@@ -255,7 +310,7 @@ void cds_sched_handle_rx_thread_affinity_req(bool high_throughput)
 	qdf_cpu_mask new_mask;
 	unsigned char core_affine_count = 0;
 
-	if (!pschedcontext || !pschedcontext->ol_rx_thread)
+	if (!pschedcontext || !pschedcontext->num_ol_rx_threads)
 		return;
 
 	if (cds_is_load_or_unload_in_progress()) {
@@ -298,8 +353,7 @@ affine_thread:
 	mutex_lock(&pschedcontext->affinity_lock);
 	if (!cpumask_equal(&pschedcontext->rx_thread_cpu_mask, &new_mask)) {
 		cpumask_copy(&pschedcontext->rx_thread_cpu_mask, &new_mask);
-		cds_set_cpus_allowed_ptr_with_mask(pschedcontext->ol_rx_thread,
-						   &new_mask);
+		cds_ol_rx_threads_set_mask(pschedcontext, &new_mask);
 	}
 	mutex_unlock(&pschedcontext->affinity_lock);
 }
@@ -378,7 +432,7 @@ static void __cds_cpu_hotplug_notify(uint32_t cpu, bool cpu_up)
 	p_cds_sched_context pSchedContext = get_cds_sched_ctxt();
 	int i;
 
-	if (!pSchedContext || !pSchedContext->ol_rx_thread)
+	if (!pSchedContext || !pSchedContext->num_ol_rx_threads)
 		return;
 
 	if (cds_is_load_or_unload_in_progress() || cds_is_driver_recovering())
@@ -417,9 +471,7 @@ static void __cds_cpu_hotplug_notify(uint32_t cpu, bool cpu_up)
 	if (pref_cpu == 0)
 		return;
 
-	if (pSchedContext->ol_rx_thread &&
-	    !cds_set_cpus_allowed_ptr_with_cpu(pSchedContext->ol_rx_thread,
-					       pref_cpu))
+	if (!cds_ol_rx_threads_set_cpu(pSchedContext, pref_cpu))
 		affine_cpu = pref_cpu;
 }
 
@@ -485,16 +537,7 @@ QDF_STATUS cds_sched_open(void *p_cds_context,
 	}
 	qdf_mem_zero(pSchedContext, sizeof(cds_sched_context));
 #ifdef QCA_CONFIG_SMP
-	spin_lock_init(&pSchedContext->ol_rx_thread_lock);
-	init_waitqueue_head(&pSchedContext->ol_rx_wait_queue);
-	init_completion(&pSchedContext->ol_rx_start_event);
-	init_completion(&pSchedContext->ol_suspend_rx_event);
-	init_completion(&pSchedContext->ol_resume_rx_event);
-	init_completion(&pSchedContext->ol_rx_shutdown);
-	pSchedContext->ol_rx_event_flag = 0;
-	spin_lock_init(&pSchedContext->ol_rx_queue_lock);
 	spin_lock_init(&pSchedContext->cds_ol_rx_pkt_freeq_lock);
-	INIT_LIST_HEAD(&pSchedContext->ol_rx_thread_queue);
 	spin_lock_bh(&pSchedContext->cds_ol_rx_pkt_freeq_lock);
 	INIT_LIST_HEAD(&pSchedContext->cds_ol_rx_pkt_freeq);
 	spin_unlock_bh(&pSchedContext->cds_ol_rx_pkt_freeq_lock);
@@ -511,19 +554,8 @@ QDF_STATUS cds_sched_open(void *p_cds_context,
 	gp_cds_sched_context = pSchedContext;
 
 #ifdef QCA_CONFIG_SMP
-	pSchedContext->ol_rx_thread = kthread_create(cds_ol_rx_thread,
-						       pSchedContext,
-						       "cds_ol_rx_thread");
-	if (IS_ERR(pSchedContext->ol_rx_thread)) {
-
-		cds_alert("Could not Create CDS OL RX Thread");
+	if (cds_ol_rx_threads_start(pSchedContext) != QDF_STATUS_SUCCESS)
 		goto OL_RX_THREAD_START_FAILURE;
-
-	}
-	wake_up_process(pSchedContext->ol_rx_thread);
-	cds_debug("CDS OL RX thread Created");
-	wait_for_completion_interruptible(&pSchedContext->ol_rx_start_event);
-	cds_debug("CDS OL Rx Thread has started");
 #endif
 	/* We're good now: Let's get the ball rolling!!! */
 	cds_debug("CDS Scheduler successfully Opened");
@@ -651,13 +683,47 @@ struct cds_ol_rx_pkt *cds_alloc_ol_rx_pkt(p_cds_sched_context pSchedContext)
 	return pkt;
 }
 
+/**
+ * cds_ol_rx_thread_select() - select the OL Rx thread of a sta and tid
+ * @sched_ctx: Pointer to the global CDS Sched Context
+ * @staid: Station Id
+ * @tid: TID
+ *
+ * All the frames of a sta and tid go to the same thread, which keeps
+ * them in order.
+ *
+ * Return: OL Rx thread instance
+ */
+static inline struct cds_ol_rx_thread *
+cds_ol_rx_thread_select(p_cds_sched_context sched_ctx, uint16_t staid,
+			uint8_t tid)
+{
+	if (sched_ctx->num_ol_rx_threads <= 1)
+		return &sched_ctx->ol_rx_threads[0];
+
+	return &sched_ctx->ol_rx_threads[(staid + tid) %
+					 sched_ctx->num_ol_rx_threads];
+}
+
+/**
+ * cds_ol_rx_thread_post() - wake up an OL Rx thread to process its queues
+ * @rx_thread: OL Rx thread instance
+ *
+ * Return: none
+ */
+static inline void cds_ol_rx_thread_post(struct cds_ol_rx_thread *rx_thread)
+{
+	set_bit(RX_POST_EVENT, &rx_thread->event_flag);
+	wake_up_interruptible(&rx_thread->wait_queue);
+}
+
 /**
  * cds_indicate_rxpkt() - indicate rx data packet
  * @Arg: Pointer to the global CDS Sched Context
  * @pkt: CDS data message buffer
  *
- * This api enqueues the rx packet into ol_rx_thread_queue and notifies
- * cds_ol_rx_thread()
+ * This api enqueues the rx packet into the queue of the OL Rx thread
+ * pkt->staId is steered to and notifies cds_ol_rx_thread()
  *
  * Return: none
  */
@@ -665,17 +731,186 @@ void
 cds_indicate_rxpkt(p_cds_sched_context pSchedContext,
 		   struct cds_ol_rx_pkt *pkt)
 {
-	spin_lock_bh(&pSchedContext->ol_rx_queue_lock);
-	list_add_tail(&pkt->list, &pSchedContext->ol_rx_thread_queue);
-	spin_unlock_bh(&pSchedContext->ol_rx_queue_lock);
-	set_bit(RX_POST_EVENT, &pSchedContext->ol_rx_event_flag);
-	wake_up_interruptible(&pSchedContext->ol_rx_wait_queue);
+	struct cds_ol_rx_thread *rx_thread;
+
+	rx_thread = cds_ol_rx_thread_select(pSchedContext, pkt->staId, 0);
+
+	spin_lock_bh(&rx_thread->queue_lock);
+	list_add_tail(&pkt->list, &rx_thread->pkt_queue);
+	spin_unlock_bh(&rx_thread->queue_lock);
+	cds_ol_rx_thread_post(rx_thread);
+}
+
+/*
+ * An nbuf list is queued by its head nbuf, the rest of the list is moved
+ * to the ext list of the head meanwhile. The head records the station in
+ * QDF_NBUF_CB_RX_PEER_ID() and whether the rest of the list was moved in
+ * QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(): 1 if the head is alone, more
+ * otherwise.
+ */
+
+/**
+ * cds_ol_rx_nbuf_list_restore() - undo the ext list move of a queued head
+ * @head: head nbuf taken off an nbuf_queue
+ *
+ * Return: none
+ */
+static void cds_ol_rx_nbuf_list_restore(qdf_nbuf_t head)
+{
+	qdf_nbuf_t next;
+
+	if (QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head) <= 1)
+		return;
+
+	next = qdf_nbuf_get_ext_list(head);
+	qdf_nbuf_append_ext_list(head, NULL, 0);
+	qdf_nbuf_set_next(head, next);
+}
+
+QDF_STATUS cds_indicate_rx_nbuf_list(p_cds_sched_context sched_ctx,
+				     qdf_nbuf_t nbuf_list, uint16_t staid,
+				     uint8_t tid)
+{
+	struct cds_ol_rx_thread *rx_thread;
+	qdf_nbuf_queue_t local_queue;
+	qdf_nbuf_t head, next;
+
+	if (qdf_unlikely(!nbuf_list))
+		return QDF_STATUS_E_INVAL;
+
+	qdf_nbuf_queue_init(&local_queue);
+	head = nbuf_list;
+
+	/* A head already using its ext list is queued on its own */
+	while (qdf_unlikely(qdf_nbuf_get_ext_list(head))) {
+		next = qdf_nbuf_next(head);
+		QDF_NBUF_CB_RX_PEER_ID(head) = staid;
+		QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head) = 1;
+		qdf_nbuf_queue_add(&local_queue, head);
+		head = next;
+		if (!head)
+			goto enqueue;
+	}
+
+	next = qdf_nbuf_next(head);
+	QDF_NBUF_CB_RX_PEER_ID(head) = staid;
+	QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head) = next ? 2 : 1;
+	if (next)
+		qdf_nbuf_append_ext_list(head, next, 0);
+	qdf_nbuf_queue_add(&local_queue, head);
+
+enqueue:
+	rx_thread = cds_ol_rx_thread_select(sched_ctx, staid, tid);
+
+	spin_lock_bh(&rx_thread->queue_lock);
+	qdf_nbuf_queue_append(&rx_thread->nbuf_queue, &local_queue);
+	spin_unlock_bh(&rx_thread->queue_lock);
+	cds_ol_rx_thread_post(rx_thread);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void cds_register_ol_rx_cb(cds_ol_rx_thread_cb cb, void *context)
+{
+	p_cds_sched_context sched_ctx = get_cds_sched_ctxt();
+
+	if (!sched_ctx)
+		return;
+
+	sched_ctx->ol_rx_cb_context = context;
+	sched_ctx->ol_rx_cb = cb;
+}
+
+/**
+ * cds_ol_rx_threads_stop() - shut down the OL Rx threads
+ * @sched_ctx: Pointer to the global CDS Sched Context
+ *
+ * The frames left in the queues of the threads are not dropped.
+ *
+ * Return: none
+ */
+static void cds_ol_rx_threads_stop(p_cds_sched_context sched_ctx)
+{
+	struct cds_ol_rx_thread *rx_thread;
+	uint8_t i;
+
+	for (i = 0; i < sched_ctx->num_ol_rx_threads; i++) {
+		rx_thread = &sched_ctx->ol_rx_threads[i];
+		if (!rx_thread->task)
+			continue;
+
+		set_bit(RX_SHUTDOWN_EVENT, &rx_thread->event_flag);
+		cds_ol_rx_thread_post(rx_thread);
+		wait_for_completion(&rx_thread->shutdown);
+		rx_thread->task = NULL;
+	}
+}
+
+/**
+ * cds_ol_rx_threads_start() - create and start the OL Rx threads
+ * @sched_ctx: Pointer to the global CDS Sched Context
+ *
+ * The number of threads is taken from the num_ol_rx_threads ini, capped
+ * at CDS_MAX_OL_RX_THREADS.
+ *
+ * Return: qdf status
+ */
+static QDF_STATUS cds_ol_rx_threads_start(p_cds_sched_context sched_ctx)
+{
+	struct cds_config_info *cds_cfg = cds_get_ini_config();
+	struct cds_ol_rx_thread *rx_thread;
+	uint8_t num_threads = 1;
+	uint8_t i;
+
+	if (cds_cfg && cds_cfg->num_ol_rx_threads)
+		num_threads = QDF_MIN(cds_cfg->num_ol_rx_threads,
+				      CDS_MAX_OL_RX_THREADS);
+
+	for (i = 0; i < num_threads; i++) {
+		rx_thread = &sched_ctx->ol_rx_threads[i];
+		rx_thread->id = i;
+		rx_thread->sched_ctx = sched_ctx;
+		spin_lock_init(&rx_thread->thread_lock);
+		init_waitqueue_head(&rx_thread->wait_queue);
+		init_completion(&rx_thread->start_event);
+		init_completion(&rx_thread->suspend_event);
+		init_completion(&rx_thread->resume_event);
+		init_completion(&rx_thread->shutdown);
+		rx_thread->event_flag = 0;
+		spin_lock_init(&rx_thread->queue_lock);
+		INIT_LIST_HEAD(&rx_thread->pkt_queue);
+		qdf_nbuf_queue_init(&rx_thread->nbuf_queue);
+
+		if (!i)
+			rx_thread->task = kthread_create(cds_ol_rx_thread,
+							 rx_thread,
+							 "cds_ol_rx_thread");
+		else
+			rx_thread->task = kthread_create(cds_ol_rx_thread,
+							 rx_thread,
+							 "cds_ol_rx_thread_%u",
+							 i);
+		if (IS_ERR(rx_thread->task)) {
+			cds_alert("Could not Create CDS OL RX Thread %u", i);
+			rx_thread->task = NULL;
+			cds_ol_rx_threads_stop(sched_ctx);
+			sched_ctx->num_ol_rx_threads = 0;
+			return QDF_STATUS_E_RESOURCES;
+		}
+		sched_ctx->num_ol_rx_threads++;
+		wake_up_process(rx_thread->task);
+		wait_for_completion_interruptible(&rx_thread->start_event);
+	}
+
+	cds_debug("%u CDS OL Rx threads have started", num_threads);
+
+	return QDF_STATUS_SUCCESS;
 }
 
 /**
  * cds_close_rx_thread() - close the Rx thread
  *
- * This api closes the Rx thread:
+ * This api closes the OL Rx threads:
  *
  * Return: qdf status
  */
@@ -688,50 +923,57 @@ QDF_STATUS cds_close_rx_thread(void)
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	if (!gp_cds_sched_context->ol_rx_thread)
+	if (!gp_cds_sched_context->num_ol_rx_threads)
 		return QDF_STATUS_SUCCESS;
 
-	/* Shut down Tlshim Rx thread */
-	set_bit(RX_SHUTDOWN_EVENT, &gp_cds_sched_context->ol_rx_event_flag);
-	set_bit(RX_POST_EVENT, &gp_cds_sched_context->ol_rx_event_flag);
-	wake_up_interruptible(&gp_cds_sched_context->ol_rx_wait_queue);
-	wait_for_completion(&gp_cds_sched_context->ol_rx_shutdown);
-	gp_cds_sched_context->ol_rx_thread = NULL;
+	/* Shut down Tlshim Rx threads */
+	cds_ol_rx_threads_stop(gp_cds_sched_context);
 	cds_drop_rxpkt_by_staid(gp_cds_sched_context, WLAN_MAX_STA_COUNT);
 	cds_free_ol_rx_pkt_freeq(gp_cds_sched_context);
 	qdf_cpuhp_unregister(&gp_cds_sched_context->cpuhp_event_handle);
+	gp_cds_sched_context->num_ol_rx_threads = 0;
 
 	return QDF_STATUS_SUCCESS;
 } /* cds_close_rx_thread */
 
 /**
- * cds_drop_rxpkt_by_staid() - api to drop pending rx packets for a sta
- * @pSchedContext: Pointer to the global CDS Sched Context
- * @staId: Station Id
- *
- * This api drops queued packets for a station, to drop all the pending
- * packets the caller has to send WLAN_MAX_STA_COUNT as staId.
+ * cds_ol_rx_thread_drop() - drop pending rx packets of an OL Rx thread
+ * @rx_thread: OL Rx thread instance
+ * @staid: Station Id, WLAN_MAX_STA_COUNT for all the stations
  *
  * Return: none
  */
-void cds_drop_rxpkt_by_staid(p_cds_sched_context pSchedContext, uint16_t staId)
+static void cds_ol_rx_thread_drop(struct cds_ol_rx_thread *rx_thread,
+				  uint16_t staid)
 {
 	struct list_head local_list;
 	struct cds_ol_rx_pkt *pkt, *tmp;
+	qdf_nbuf_queue_t keep_queue, drop_queue;
 	qdf_nbuf_t buf, next_buf;
 
 	INIT_LIST_HEAD(&local_list);
-	spin_lock_bh(&pSchedContext->ol_rx_queue_lock);
-	if (list_empty(&pSchedContext->ol_rx_thread_queue)) {
-		spin_unlock_bh(&pSchedContext->ol_rx_queue_lock);
-		return;
-	}
-	list_for_each_entry_safe(pkt, tmp, &pSchedContext->ol_rx_thread_queue,
-								list) {
-		if (pkt->staId == staId || staId == WLAN_MAX_STA_COUNT)
+	qdf_nbuf_queue_init(&keep_queue);
+	qdf_nbuf_queue_init(&drop_queue);
+
+	spin_lock_bh(&rx_thread->queue_lock);
+	list_for_each_entry_safe(pkt, tmp, &rx_thread->pkt_queue, list) {
+		if (pkt->staId == staid || staid == WLAN_MAX_STA_COUNT)
 			list_move_tail(&pkt->list, &local_list);
 	}
-	spin_unlock_bh(&pSchedContext->ol_rx_queue_lock);
+	while ((buf = qdf_nbuf_queue_remove(&rx_thread->nbuf_queue))) {
+		if (QDF_NBUF_CB_RX_PEER_ID(buf) == staid ||
+		    staid == WLAN_MAX_STA_COUNT)
+			qdf_nbuf_queue_add(&drop_queue, buf);
+		else
+			qdf_nbuf_queue_add(&keep_queue, buf);
+	}
+	rx_thread->nbuf_queue = keep_queue;
+	spin_unlock_bh(&rx_thread->queue_lock);
+
+	while ((buf = qdf_nbuf_queue_remove(&drop_queue))) {
+		cds_ol_rx_nbuf_list_restore(buf);
+		qdf_nbuf_list_free(buf);
+	}
 
 	list_for_each_entry_safe(pkt, tmp, &local_list, list) {
 		list_del(&pkt->list);
@@ -741,41 +983,78 @@ void cds_drop_rxpkt_by_staid(p_cds_sched_context pSchedContext, uint16_t staId)
 			qdf_nbuf_free(buf);
 			buf = next_buf;
 		}
-		cds_free_ol_rx_pkt(pSchedContext, pkt);
+		cds_free_ol_rx_pkt(rx_thread->sched_ctx, pkt);
 	}
 }
 
 /**
- * cds_rx_from_queue() - function to process pending Rx packets
+ * cds_drop_rxpkt_by_staid() - api to drop pending rx packets for a sta
  * @pSchedContext: Pointer to the global CDS Sched Context
+ * @staId: Station Id
  *
- * This api traverses the pending buffer list and calling the callback.
- * This callback would essentially send the packet to HDD.
+ * This api drops queued packets for a station, to drop all the pending
+ * packets the caller has to send WLAN_MAX_STA_COUNT as staId.
  *
  * Return: none
  */
-static void cds_rx_from_queue(p_cds_sched_context pSchedContext)
+void cds_drop_rxpkt_by_staid(p_cds_sched_context pSchedContext, uint16_t staId)
 {
-	struct cds_ol_rx_pkt *pkt;
+	uint8_t i;
+
+	for (i = 0; i < pSchedContext->num_ol_rx_threads; i++)
+		cds_ol_rx_thread_drop(&pSchedContext->ol_rx_threads[i], staId);
+}
+
+/**
+ * cds_rx_from_queue() - function to process pending Rx packets
+ * @rx_thread: OL Rx thread instance
+ *
+ * This api takes all the pending buffers of the thread at once and calls
+ * their callbacks, the nbuf lists first as they were queued ahead of any
+ * flush indication. This callback would essentially send the packet to
+ * HDD.
+ *
+ * Return: none
+ */
+static void cds_rx_from_queue(struct cds_ol_rx_thread *rx_thread)
+{
+	p_cds_sched_context sched_ctx = rx_thread->sched_ctx;
+	struct list_head local_list;
+	struct cds_ol_rx_pkt *pkt, *tmp;
+	qdf_nbuf_queue_t local_queue;
+	cds_ol_rx_thread_cb cb;
+	qdf_nbuf_t nbuf_list;
 	uint16_t sta_id;
 
-	spin_lock_bh(&pSchedContext->ol_rx_queue_lock);
-	while (!list_empty(&pSchedContext->ol_rx_thread_queue)) {
-		pkt = list_first_entry(&pSchedContext->ol_rx_thread_queue,
-				       struct cds_ol_rx_pkt, list);
+	INIT_LIST_HEAD(&local_list);
+
+	spin_lock_bh(&rx_thread->queue_lock);
+	local_queue = rx_thread->nbuf_queue;
+	qdf_nbuf_queue_init(&rx_thread->nbuf_queue);
+	list_splice_init(&rx_thread->pkt_queue, &local_list);
+	spin_unlock_bh(&rx_thread->queue_lock);
+
+	cb = sched_ctx->ol_rx_cb;
+	while ((nbuf_list = qdf_nbuf_queue_remove(&local_queue))) {
+		sta_id = QDF_NBUF_CB_RX_PEER_ID(nbuf_list);
+		cds_ol_rx_nbuf_list_restore(nbuf_list);
+		if (qdf_likely(cb))
+			cb(sched_ctx->ol_rx_cb_context, nbuf_list, sta_id);
+		else
+			qdf_nbuf_list_free(nbuf_list);
+	}
+
+	list_for_each_entry_safe(pkt, tmp, &local_list, list) {
 		list_del(&pkt->list);
-		spin_unlock_bh(&pSchedContext->ol_rx_queue_lock);
 		sta_id = pkt->staId;
 		pkt->callback(pkt->context, pkt->Rxpkt, sta_id);
-		cds_free_ol_rx_pkt(pSchedContext, pkt);
-		spin_lock_bh(&pSchedContext->ol_rx_queue_lock);
+		cds_free_ol_rx_pkt(sched_ctx, pkt);
 	}
-	spin_unlock_bh(&pSchedContext->ol_rx_queue_lock);
 }
 
 /**
  * cds_ol_rx_thread() - cds main tlshim rx thread
- * @Arg: pointer to the global CDS Sched Context
+ * @Arg: pointer to the OL Rx thread instance
  *
  * This api is the thread handler for Tlshim Data packet processing.
  *
@@ -783,7 +1062,7 @@ static void cds_rx_from_queue(p_cds_sched_context pSchedContext)
  */
 static int cds_ol_rx_thread(void *arg)
 {
-	p_cds_sched_context pSchedContext = (p_cds_sched_context) arg;
+	struct cds_ol_rx_thread *rx_thread = arg;
 	bool shutdown = false;
 	int status;
 
@@ -798,62 +1077,110 @@ static int cds_ol_rx_thread(void *arg)
 
 	qdf_set_wake_up_idle(true);
 
-	complete(&pSchedContext->ol_rx_start_event);
+	complete(&rx_thread->start_event);
 
 	while (!shutdown) {
-		status =
-			wait_event_interruptible(pSchedContext->ol_rx_wait_queue,
-						 test_bit(RX_POST_EVENT,
-							  &pSchedContext->ol_rx_event_flag)
-						 || test_bit(RX_SUSPEND_EVENT,
-							     &pSchedContext->ol_rx_event_flag));
+		status = wait_event_interruptible(
+				rx_thread->wait_queue,
+				test_bit(RX_POST_EVENT,
+					 &rx_thread->event_flag) ||
+				test_bit(RX_SUSPEND_EVENT,
+					 &rx_thread->event_flag));
 		if (status == -ERESTARTSYS)
 			break;
 
-		clear_bit(RX_POST_EVENT, &pSchedContext->ol_rx_event_flag);
+		clear_bit(RX_POST_EVENT, &rx_thread->event_flag);
 		while (true) {
 			if (test_bit(RX_SHUTDOWN_EVENT,
-				     &pSchedContext->ol_rx_event_flag)) {
+				     &rx_thread->event_flag)) {
 				clear_bit(RX_SHUTDOWN_EVENT,
-					  &pSchedContext->ol_rx_event_flag);
+					  &rx_thread->event_flag);
 				if (test_bit(RX_SUSPEND_EVENT,
-					     &pSchedContext->ol_rx_event_flag)) {
+					     &rx_thread->event_flag)) {
 					clear_bit(RX_SUSPEND_EVENT,
-						  &pSchedContext->ol_rx_event_flag);
-					complete
-						(&pSchedContext->ol_suspend_rx_event);
+						  &rx_thread->event_flag);
+					complete(&rx_thread->suspend_event);
 				}
-				cds_debug("Shutting down OL RX Thread");
+				cds_debug("Shutting down OL RX Thread %u",
+					  rx_thread->id);
 				shutdown = true;
 				break;
 			}
-			cds_rx_from_queue(pSchedContext);
+			cds_rx_from_queue(rx_thread);
 
 			if (test_bit(RX_SUSPEND_EVENT,
-				     &pSchedContext->ol_rx_event_flag)) {
+				     &rx_thread->event_flag)) {
 				clear_bit(RX_SUSPEND_EVENT,
-					  &pSchedContext->ol_rx_event_flag);
-				spin_lock(&pSchedContext->ol_rx_thread_lock);
-				INIT_COMPLETION
-					(pSchedContext->ol_resume_rx_event);
-				complete(&pSchedContext->ol_suspend_rx_event);
-				spin_unlock(&pSchedContext->ol_rx_thread_lock);
+					  &rx_thread->event_flag);
+				spin_lock(&rx_thread->thread_lock);
+				complete(&rx_thread->suspend_event);
+				spin_unlock(&rx_thread->thread_lock);
 				wait_for_completion_interruptible
-					(&pSchedContext->ol_resume_rx_event);
+					(&rx_thread->resume_event);
 			}
 			break;
 		}
 	}
 
-	cds_debug("Exiting CDS OL rx thread");
-	complete_and_exit(&pSchedContext->ol_rx_shutdown, 0);
+	cds_debug("Exiting CDS OL rx thread %u", rx_thread->id);
+	complete_and_exit(&rx_thread->shutdown, 0);
 
 	return 0;
 }
 
+QDF_STATUS cds_suspend_rx_thread(uint32_t timeout_ms)
+{
+	p_cds_sched_context sched_ctx = get_cds_sched_ctxt();
+	struct cds_ol_rx_thread *rx_thread;
+	uint8_t i, j;
+
+	if (!sched_ctx)
+		return QDF_STATUS_E_INVAL;
+
+	/*
+	 * The resume event is armed here rather than by the thread, so a
+	 * resume issued before a thread gets to park is never lost.
+	 */
+	for (i = 0; i < sched_ctx->num_ol_rx_threads; i++) {
+		rx_thread = &sched_ctx->ol_rx_threads[i];
+		spin_lock(&rx_thread->thread_lock);
+		INIT_COMPLETION(rx_thread->suspend_event);
+		INIT_COMPLETION(rx_thread->resume_event);
+		spin_unlock(&rx_thread->thread_lock);
+		set_bit(RX_SUSPEND_EVENT, &rx_thread->event_flag);
+		wake_up_interruptible(&rx_thread->wait_queue);
+	}
+
+	for (i = 0; i < sched_ctx->num_ol_rx_threads; i++) {
+		rx_thread = &sched_ctx->ol_rx_threads[i];
+		if (!wait_for_completion_timeout(&rx_thread->suspend_event,
+						 msecs_to_jiffies(timeout_ms)))
+			goto resume;
+	}
+
+	return QDF_STATUS_SUCCESS;
+
+resume:
+	cds_err("OL Rx thread %u failed to suspend", i);
+	/*
+	 * Any thread may still pick up the suspend request after the bit is
+	 * cleared, so resume every thread which was asked to suspend. A
+	 * thread which never parks is left with a completed resume event,
+	 * which the next suspend rearms.
+	 */
+	for (j = 0; j < sched_ctx->num_ol_rx_threads; j++) {
+		rx_thread = &sched_ctx->ol_rx_threads[j];
+		clear_bit(RX_SUSPEND_EVENT, &rx_thread->event_flag);
+		complete(&rx_thread->resume_event);
+	}
+
+	return QDF_STATUS_E_TIMEOUT;
+}
+
 void cds_resume_rx_thread(void)
 {
 	p_cds_sched_context cds_sched_context;
+	uint8_t i;
 
 	cds_sched_context = get_cds_sched_ctxt();
 	if (!cds_sched_context) {
@@ -861,7 +1188,8 @@ void cds_resume_rx_thread(void)
 		return;
 	}
 
-	complete(&cds_sched_context->ol_resume_rx_event);
+	for (i = 0; i < cds_sched_context->num_ol_rx_threads; i++)
+		complete(&cds_sched_context->ol_rx_threads[i].resume_event);
 }
 #endif
 
@@ -566,6 +566,39 @@ void htt_rx_detach(struct htt_pdev_t *pdev);
 
 int htt_htc_attach(struct htt_pdev_t *pdev, uint16_t service_id);
 
+#ifdef WLAN_RX_LATENCY_HIST
+/**
+ * htt_rx_lat_ind_ts_set() - note the receipt time of T2H messages
+ * @pdev: htt pdev handle
+ *
+ * Return: none
+ */
+static inline void htt_rx_lat_ind_ts_set(struct htt_pdev_t *pdev)
+{
+	pdev->rx_lat_ind_ts = ktime_get_ns();
+}
+
+/**
+ * htt_rx_lat_ind_ts_get() - get the receipt time of the current T2H message
+ * @pdev: htt pdev handle
+ *
+ * Return: receipt time in ns
+ */
+static inline uint64_t htt_rx_lat_ind_ts_get(struct htt_pdev_t *pdev)
+{
+	return pdev->rx_lat_ind_ts;
+}
+#else
+static inline void htt_rx_lat_ind_ts_set(struct htt_pdev_t *pdev)
+{
+}
+
+static inline uint64_t htt_rx_lat_ind_ts_get(struct htt_pdev_t *pdev)
+{
+	return 0;
+}
+#endif
+
 void htt_t2h_msg_handler(void *context, HTC_PACKET *pkt);
 #ifdef WLAN_FEATURE_FASTPATH
 void htt_t2h_msg_handler_fast(void *htt_pdev, qdf_nbuf_t *cmpl_msdus,
@@ -634,6 +667,57 @@ htt_rx_hash_list_insert(struct htt_pdev_t *pdev,
 qdf_nbuf_t
 htt_rx_hash_list_lookup(struct htt_pdev_t *pdev, qdf_dma_addr_t paddr);
 
+/**
+ * htt_rx_hash_stats_display() - display rx buffer lookup stats
+ * @pdev: pdev handle
+ *
+ * Return: None
+ */
+#ifdef WLAN_FULL_REORDER_OFFLOAD
+void htt_rx_hash_stats_display(struct htt_pdev_t *pdev);
+#else
+static inline void htt_rx_hash_stats_display(struct htt_pdev_t *pdev)
+{
+}
+#endif
+
+#if defined(WLAN_FULL_REORDER_OFFLOAD) && defined(HTT_RX_PADDR_COOKIE)
+/**
+ * htt_rx_paddr_cookie_insert() - track an rx buffer by a paddr cookie
+ * @pdev: pdev handle
+ * @paddr: paddr to be posted in the rx ring, the cookie is added to it
+ * @netbuf: rx buffer
+ *
+ * Called from the rx ring refill context only.
+ *
+ * Return: true if the buffer got a cookie, false if it has to be tracked
+ *	   in the rx hash table (cookies disabled or all in use)
+ */
+bool htt_rx_paddr_cookie_insert(struct htt_pdev_t *pdev,
+				qdf_dma_addr_t *paddr, qdf_nbuf_t netbuf);
+
+/**
+ * htt_rx_paddr_cookie_lookup() - get the rx buffer of a paddr cookie
+ * @pdev: pdev handle
+ * @paddr: paddr from the rx indication, with its cookie
+ *
+ * Called from the rx indication context only, when cookies are enabled.
+ * The buffer is looked up in the hash table and the cookie array if the
+ * cookie does not match @paddr.
+ *
+ * Return: rx buffer, NULL if there is none for @paddr
+ */
+qdf_nbuf_t htt_rx_paddr_cookie_lookup(struct htt_pdev_t *pdev,
+				      qdf_dma_addr_t paddr);
+#else
+static inline bool
+htt_rx_paddr_cookie_insert(struct htt_pdev_t *pdev,
+			   qdf_dma_addr_t *paddr, qdf_nbuf_t netbuf)
+{
+	return false;
+}
+#endif
+
 #ifdef IPA_OFFLOAD
 int
 htt_tx_ipa_uc_attach(struct htt_pdev_t *pdev,
@@ -1011,6 +1095,50 @@ static inline qdf_dma_addr_t htt_paddr_trim_to_37(qdf_dma_addr_t paddr)
 }
 #endif /* HTT_PADDR64 */
 
+#ifdef HTT_RX_PADDR_COOKIE
+#ifndef HTT_PADDR64
+#error "HTT_RX_PADDR_COOKIE requires HTT_PADDR64"
+#endif
+/*
+ * Rx buffer paddr cookie: bits 37..47 of the paddrs posted in the rx ring
+ * are not part of the physical address. The target is only required to
+ * give back bits 0..36 and the marking in bits 48..63, so cookies are
+ * off unless enabled by ini for targets known to echo bits 37..47.
+ * A non zero cookie is the index of the rx buffer in the cookie array,
+ * cookie 0 means the buffer is in the rx hash table. A cookie whose
+ * entry does not match the paddr falls back to a search of the hash
+ * table and the cookie array.
+ */
+#define HTT_RX_PADDR_COOKIE_SHIFT 37
+#define HTT_RX_PADDR_COOKIE_BITS 11
+#define HTT_RX_PADDR_COOKIE_NUM (1 << HTT_RX_PADDR_COOKIE_BITS)
+#define HTT_RX_PADDR_COOKIE_MASK (HTT_RX_PADDR_COOKIE_NUM - 1)
+
+static inline uint32_t htt_rx_paddr_cookie_get(qdf_dma_addr_t paddr)
+{
+	return (uint32_t)(paddr >> HTT_RX_PADDR_COOKIE_SHIFT) &
+		HTT_RX_PADDR_COOKIE_MASK;
+}
+
+static inline qdf_dma_addr_t
+htt_rx_paddr_cookie_set(qdf_dma_addr_t paddr, uint32_t cookie)
+{
+	return paddr | ((qdf_dma_addr_t)cookie << HTT_RX_PADDR_COOKIE_SHIFT);
+}
+
+/* clear the marking bits of a paddr but keep its cookie */
+static inline qdf_dma_addr_t htt_rx_paddr_trim_marking(qdf_dma_addr_t paddr)
+{
+	return paddr & (0x1fffffffff | ((qdf_dma_addr_t)
+		HTT_RX_PADDR_COOKIE_MASK << HTT_RX_PADDR_COOKIE_SHIFT));
+}
+#else
+static inline qdf_dma_addr_t htt_rx_paddr_trim_marking(qdf_dma_addr_t paddr)
+{
+	return htt_paddr_trim_to_37(paddr);
+}
+#endif /* HTT_RX_PADDR_COOKIE */
+
 #ifdef WLAN_FULL_REORDER_OFFLOAD
 #ifdef ENABLE_DEBUG_ADDRESS_MARKING
 static inline qdf_dma_addr_t
@@ -1034,7 +1162,7 @@ htt_rx_paddr_unmark_high_bits(qdf_dma_addr_t paddr)
 		}
 
 		/* clear markings  for further use */
-		paddr = htt_paddr_trim_to_37(paddr);
+		paddr = htt_rx_paddr_trim_marking(paddr);
 	}
 	return paddr;
 }
@@ -1095,6 +1223,10 @@ htt_rx_in_order_netbuf_pop(htt_pdev_handle pdev, qdf_dma_addr_t paddr)
 {
 	HTT_ASSERT1(htt_rx_in_order_ring_elems(pdev) != 0);
 	pdev->rx_ring.fill_cnt--;
+#ifdef HTT_RX_PADDR_COOKIE
+	if (pdev->rx_ring.cookie.entries)
+		return htt_rx_paddr_cookie_lookup(pdev, paddr);
+#endif
 	paddr = htt_paddr_trim_to_37(paddr);
 	return htt_rx_hash_list_lookup(pdev, paddr);
 }
@@ -455,7 +455,9 @@ moretofill:
 		paddr = qdf_nbuf_get_frag_paddr(rx_netbuf, 0);
 		paddr_marked = htt_rx_paddr_mark_high_bits(paddr);
 		if (pdev->cfg.is_full_reorder_offload) {
-			if (qdf_unlikely(htt_rx_hash_list_insert(
+			if (!htt_rx_paddr_cookie_insert(pdev, &paddr_marked,
+							rx_netbuf) &&
+			    qdf_unlikely(htt_rx_hash_list_insert(
 					pdev, paddr_marked, rx_netbuf))) {
 				QDF_TRACE(QDF_MODULE_ID_HTT,
 					  QDF_TRACE_LEVEL_ERROR,
@@ -1130,7 +1132,9 @@ htt_rx_hash_list_insert(struct htt_pdev_t *pdev,
 			goto hli_end;
 		}
 		hash_element->fromlist = 0;
+		pdev->rx_ring.hash_stats.hash_alloc++;
 	}
+	pdev->rx_ring.hash_stats.hash_insert++;
 
 	hash_element->netbuf = netbuf;
 	hash_element->paddr = paddr;
@@ -1152,16 +1156,18 @@ hli_end:
 
 /*
  * Given a physical address this function will find the corresponding network
- *  buffer from the hash table.
+ *  buffer from the hash table, NULL if there is none.
  *  paddr is already stripped off of higher marking bits.
  */
-qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
-				   qdf_dma_addr_t     paddr)
+static qdf_nbuf_t htt_rx_hash_list_find(struct htt_pdev_t *pdev,
+					qdf_dma_addr_t paddr)
 {
 	uint32_t i;
 	struct htt_list_node *list_iter = NULL;
 	qdf_nbuf_t netbuf = NULL;
 	struct htt_rx_hash_entry *hash_entry;
+	struct htt_rx_hash_stats *stats = &pdev->rx_ring.hash_stats;
+	uint32_t depth = 0;
 
 	qdf_spin_lock_bh(&pdev->rx_ring.rx_hash_lock);
 
@@ -1178,6 +1184,7 @@ qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
 			      pdev->rx_ring.listnode_offset);
 
 		HTT_RX_HASH_COOKIE_CHECK(hash_entry);
+		depth++;
 
 		if (hash_entry->paddr == paddr) {
 			/* Found the entry corresponding to paddr */
@@ -1200,9 +1207,13 @@ qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
 				qdf_mem_free(hash_entry);
 
 			htt_rx_dbg_rxbuf_reset(pdev, netbuf);
+			stats->hash_hit++;
 			break;
 		}
 	}
+	stats->hash_depth += depth;
+	if (depth > stats->hash_depth_max)
+		stats->hash_depth_max = depth;
 
 	RX_HASH_LOG(qdf_print("rx hash: paddr 0x%llx, netbuf %pK, bucket %d\n",
 			      (unsigned long long)paddr, netbuf, (int)i));
@@ -1210,6 +1221,14 @@ qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
 
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 
+	return netbuf;
+}
+
+qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
+				   qdf_dma_addr_t paddr)
+{
+	qdf_nbuf_t netbuf = htt_rx_hash_list_find(pdev, paddr);
+
 	if (!netbuf) {
 		qdf_print("rx hash: no entry found for %llx!\n",
 			  (unsigned long long)paddr);
@@ -1219,6 +1238,289 @@ qdf_nbuf_t htt_rx_hash_list_lookup(struct htt_pdev_t *pdev,
 	return netbuf;
 }
 
+#ifdef HTT_RX_PADDR_COOKIE
+bool htt_rx_paddr_cookie_insert(struct htt_pdev_t *pdev,
+				qdf_dma_addr_t *paddr, qdf_nbuf_t netbuf)
+{
+	struct htt_rx_paddr_cookie_entry *entry;
+	uint32_t cons = pdev->rx_ring.cookie.free_cons;
+	uint32_t cookie;
+
+	if (!pdev->rx_ring.cookie.entries || pdev->rx_ring.cookie.disabled)
+		return false;
+
+	/* pairs with the release in htt_rx_paddr_cookie_put */
+	if (cons == smp_load_acquire(&pdev->rx_ring.cookie.free_prod)) {
+		pdev->rx_ring.hash_stats.cookie_empty++;
+		return false;
+	}
+
+	cookie = pdev->rx_ring.cookie.free_ring[cons &
+						HTT_RX_PADDR_COOKIE_MASK];
+	pdev->rx_ring.cookie.free_cons = cons + 1;
+
+	entry = &pdev->rx_ring.cookie.entries[cookie];
+	entry->paddr = htt_paddr_trim_to_37(*paddr);
+	entry->netbuf = netbuf;
+	*paddr = htt_rx_paddr_cookie_set(*paddr, cookie);
+
+	return true;
+}
+
+/**
+ * htt_rx_paddr_cookie_put() - take the rx buffer out of a paddr cookie
+ * @pdev: pdev handle
+ * @cookie: paddr cookie owning an rx buffer
+ *
+ * Return: the rx buffer, the cookie is handed back to the refill context
+ */
+static qdf_nbuf_t htt_rx_paddr_cookie_put(struct htt_pdev_t *pdev,
+					  uint32_t cookie)
+{
+	struct htt_rx_paddr_cookie_entry *entry;
+	qdf_nbuf_t netbuf;
+	uint32_t prod;
+
+	entry = &pdev->rx_ring.cookie.entries[cookie];
+	netbuf = entry->netbuf;
+	/*
+	 * set netbuf to NULL to trace if freed entry
+	 * is getting unmapped in hash deinit.
+	 */
+	entry->netbuf = NULL;
+	htt_rx_dbg_rxbuf_reset(pdev, netbuf);
+	pdev->rx_ring.hash_stats.cookie_hit++;
+
+	prod = pdev->rx_ring.cookie.free_prod;
+	pdev->rx_ring.cookie.free_ring[prod & HTT_RX_PADDR_COOKIE_MASK] =
+		cookie;
+	smp_store_release(&pdev->rx_ring.cookie.free_prod, prod + 1);
+
+	return netbuf;
+}
+
+/**
+ * htt_rx_paddr_cookie_find() - search the paddr cookies for an rx buffer
+ * @pdev: pdev handle
+ * @paddr: rx buffer paddr, without marking bits
+ *
+ * Slow path for indications whose cookie was not echoed back as posted.
+ *
+ * Return: cookie owning the rx buffer at @paddr, 0 if none
+ */
+static uint32_t htt_rx_paddr_cookie_find(struct htt_pdev_t *pdev,
+					 qdf_dma_addr_t paddr)
+{
+	struct htt_rx_paddr_cookie_entry *entry;
+	uint32_t cookie;
+
+	for (cookie = 1; cookie < HTT_RX_PADDR_COOKIE_NUM; cookie++) {
+		entry = &pdev->rx_ring.cookie.entries[cookie];
+		if (entry->netbuf && entry->paddr == paddr)
+			return cookie;
+	}
+
+	return 0;
+}
+
+qdf_nbuf_t htt_rx_paddr_cookie_lookup(struct htt_pdev_t *pdev,
+				      qdf_dma_addr_t paddr)
+{
+	struct htt_rx_paddr_cookie_entry *entry;
+	uint32_t cookie = htt_rx_paddr_cookie_get(paddr);
+	qdf_nbuf_t netbuf;
+
+	paddr = htt_paddr_trim_to_37(paddr);
+	if (cookie) {
+		entry = &pdev->rx_ring.cookie.entries[cookie];
+		if (qdf_likely(entry->netbuf && entry->paddr == paddr))
+			return htt_rx_paddr_cookie_put(pdev, cookie);
+	}
+
+	netbuf = htt_rx_hash_list_find(pdev, paddr);
+	if (qdf_likely(netbuf && !cookie))
+		return netbuf;
+
+	/*
+	 * The cookie does not match the paddr, so the target did not give
+	 * back the bits 37..47 it was posted with. Stop handing out new
+	 * cookies and find the buffer the slow way.
+	 */
+	pdev->rx_ring.hash_stats.cookie_err++;
+	if (!pdev->rx_ring.cookie.disabled) {
+		qdf_print("rx cookie %u: mismatch for %llx, disabling cookies\n",
+			  cookie, (unsigned long long)paddr);
+		pdev->rx_ring.cookie.disabled = true;
+	}
+
+	if (netbuf)
+		return netbuf;
+
+	cookie = htt_rx_paddr_cookie_find(pdev, paddr);
+	if (cookie)
+		return htt_rx_paddr_cookie_put(pdev, cookie);
+
+	qdf_print("rx cookie: no entry found for %llx!\n",
+		  (unsigned long long)paddr);
+	cds_trigger_recovery(QDF_RX_HASH_NO_ENTRY_FOUND);
+
+	return NULL;
+}
+
+/**
+ * htt_rx_paddr_cookie_init() - allocate the rx buffer paddr cookies
+ * @pdev: pdev handle
+ *
+ * Cookies are only used when enabled by ini, as they rely on the target
+ * giving back the bits 37..47 of the posted paddrs.
+ *
+ * Return: 0 on success, 1 on failure
+ */
+static int htt_rx_paddr_cookie_init(struct htt_pdev_t *pdev)
+{
+	struct cds_config_info *cds_cfg = cds_get_ini_config();
+	uint32_t cookie;
+
+	if (!cds_cfg || !cds_cfg->rx_paddr_cookie)
+		return 0;
+
+	pdev->rx_ring.cookie.disabled = false;
+	pdev->rx_ring.cookie.entries =
+		qdf_mem_malloc(HTT_RX_PADDR_COOKIE_NUM *
+			       sizeof(*pdev->rx_ring.cookie.entries));
+	if (!pdev->rx_ring.cookie.entries)
+		return 1;
+
+	pdev->rx_ring.cookie.free_ring =
+		qdf_mem_malloc(HTT_RX_PADDR_COOKIE_NUM *
+			       sizeof(*pdev->rx_ring.cookie.free_ring));
+	if (!pdev->rx_ring.cookie.free_ring) {
+		qdf_mem_free(pdev->rx_ring.cookie.entries);
+		pdev->rx_ring.cookie.entries = NULL;
+		return 1;
+	}
+
+	/* cookie 0 is reserved for buffers in the hash table */
+	for (cookie = 1; cookie < HTT_RX_PADDR_COOKIE_NUM; cookie++)
+		pdev->rx_ring.cookie.free_ring[cookie - 1] = cookie;
+	pdev->rx_ring.cookie.free_cons = 0;
+	pdev->rx_ring.cookie.free_prod = HTT_RX_PADDR_COOKIE_NUM - 1;
+
+	return 0;
+}
+
+/**
+ * htt_rx_paddr_cookie_deinit() - free the rx buffer paddr cookies
+ * @pdev: pdev handle
+ * @ipa_smmu: rx buffers are mapped in the IPA SMMU
+ *
+ * Frees the rx buffers which are still owned by a cookie.
+ *
+ * Return: None
+ */
+static void htt_rx_paddr_cookie_deinit(struct htt_pdev_t *pdev, bool ipa_smmu)
+{
+	struct htt_rx_paddr_cookie_entry *entry;
+	qdf_mem_info_t mem_map_table = {0};
+	uint32_t cookie;
+
+	if (!pdev->rx_ring.cookie.entries)
+		return;
+
+	for (cookie = 1; cookie < HTT_RX_PADDR_COOKIE_NUM; cookie++) {
+		entry = &pdev->rx_ring.cookie.entries[cookie];
+		if (!entry->netbuf)
+			continue;
+
+		if (ipa_smmu) {
+			qdf_update_mem_map_table(pdev->osdev, &mem_map_table,
+						 QDF_NBUF_CB_PADDR(entry->netbuf),
+						 HTT_RX_BUF_SIZE);
+			cds_smmu_map_unmap(false, 1, &mem_map_table);
+		}
+#ifdef DEBUG_DMA_DONE
+		qdf_nbuf_unmap(pdev->osdev, entry->netbuf,
+			       QDF_DMA_BIDIRECTIONAL);
+#else
+		qdf_nbuf_unmap(pdev->osdev, entry->netbuf,
+			       QDF_DMA_FROM_DEVICE);
+#endif
+		qdf_nbuf_free(entry->netbuf);
+		entry->netbuf = NULL;
+	}
+
+	qdf_mem_free(pdev->rx_ring.cookie.free_ring);
+	pdev->rx_ring.cookie.free_ring = NULL;
+	qdf_mem_free(pdev->rx_ring.cookie.entries);
+	pdev->rx_ring.cookie.entries = NULL;
+}
+
+/**
+ * htt_rx_paddr_cookie_smmu_map() - IPA SMMU map/unmap cookie rx buffers
+ * @map: map or unmap
+ * @pdev: pdev handle
+ *
+ * Return: 0 on success, error code from the SMMU map/unmap otherwise
+ */
+static int htt_rx_paddr_cookie_smmu_map(bool map, struct htt_pdev_t *pdev)
+{
+	struct htt_rx_paddr_cookie_entry *entry;
+	qdf_mem_info_t mem_map_table = {0};
+	uint32_t cookie;
+	int ret;
+
+	if (!pdev->rx_ring.cookie.entries)
+		return 0;
+
+	for (cookie = 1; cookie < HTT_RX_PADDR_COOKIE_NUM; cookie++) {
+		entry = &pdev->rx_ring.cookie.entries[cookie];
+		if (!entry->netbuf)
+			continue;
+
+		qdf_update_mem_map_table(pdev->osdev, &mem_map_table,
+					 QDF_NBUF_CB_PADDR(entry->netbuf),
+					 HTT_RX_BUF_SIZE);
+		ret = cds_smmu_map_unmap(map, 1, &mem_map_table);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+#else
+static inline int htt_rx_paddr_cookie_init(struct htt_pdev_t *pdev)
+{
+	return 0;
+}
+
+static inline void
+htt_rx_paddr_cookie_deinit(struct htt_pdev_t *pdev, bool ipa_smmu)
+{
+}
+
+static inline int htt_rx_paddr_cookie_smmu_map(bool map,
+					       struct htt_pdev_t *pdev)
+{
+	return 0;
+}
+#endif /* HTT_RX_PADDR_COOKIE */
+
+void htt_rx_hash_stats_display(struct htt_pdev_t *pdev)
+{
+	struct htt_rx_hash_stats *stats = &pdev->rx_ring.hash_stats;
+	uint32_t avg_depth = 0;
+
+	if (stats->hash_hit)
+		avg_depth = qdf_do_div(stats->hash_depth, stats->hash_hit);
+
+	qdf_nofl_info("rx cookie: hit %u err %u empty %u",
+		      stats->cookie_hit, stats->cookie_err,
+		      stats->cookie_empty);
+	qdf_nofl_info("rx hash: insert %u alloc %u hit %u depth avg %u max %u",
+		      stats->hash_insert, stats->hash_alloc, stats->hash_hit,
+		      avg_depth, stats->hash_depth_max);
+}
+
 /*
  * Initialization function of the rx buffer hash table. This function will
  * allocate a hash table of a certain pre-determined size and initialize all
@@ -1293,6 +1595,9 @@ static int htt_rx_hash_init(struct htt_pdev_t *pdev)
 hi_end:
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 
+	if (!rc && htt_rx_paddr_cookie_init(pdev))
+		qdf_print("rx paddr cookie alloc failed, using hash only\n");
+
 	return rc;
 }
 
@@ -1320,6 +1625,8 @@ static void htt_rx_hash_deinit(struct htt_pdev_t *pdev)
 	pdev->rx_ring.hash_table = NULL;
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 
+	htt_rx_paddr_cookie_deinit(pdev, ipa_smmu);
+
 	for (i = 0; i < RX_NUM_HASH_BUCKETS; i++) {
 		/* Free the hash entries in hash bucket i */
 		list_iter = hash_table[i]->listhead.next;
@@ -1362,6 +1669,31 @@ static void htt_rx_hash_deinit(struct htt_pdev_t *pdev)
 	qdf_spinlock_destroy(&pdev->rx_ring.rx_hash_lock);
 }
 
+uint32_t htt_rx_ring_deficit(htt_pdev_handle pdev)
+{
+	int fill_level = pdev->rx_ring.fill_level;
+	int owed;
+
+	if (fill_level <= 0)
+		return 0;
+
+	/*
+	 * With full reorder offload buffers are popped through the hash
+	 * table and only the refill debt tracks what the ring is short of.
+	 */
+	if (pdev->cfg.is_full_reorder_offload)
+		owed = qdf_atomic_read(&pdev->rx_ring.refill_debt);
+	else
+		owed = fill_level - pdev->rx_ring.fill_cnt;
+
+	if (owed <= 0)
+		return 0;
+	if (owed > fill_level)
+		owed = fill_level;
+
+	return owed * 100 / fill_level;
+}
+
 int htt_rx_msdu_buff_in_order_replenish(htt_pdev_handle pdev, uint32_t num)
 {
 	int filled = 0;
@@ -2332,6 +2664,9 @@ static QDF_STATUS htt_rx_hash_smmu_map(bool map, struct htt_pdev_t *pdev)
 
 	qdf_spin_unlock_bh(&pdev->rx_ring.rx_hash_lock);
 
+	if (htt_rx_paddr_cookie_smmu_map(map, pdev))
+		return QDF_STATUS_E_FAILURE;
+
 	return QDF_STATUS_SUCCESS;
 }
 
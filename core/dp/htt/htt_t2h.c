@@ -755,6 +755,9 @@ void htt_t2h_msg_handler(void *context, HTC_PACKET *pkt)
 		qdf_nbuf_free(htt_t2h_msg);
 		return;
 	}
+
+	htt_rx_lat_ind_ts_set(pdev);
+
 #ifdef HTT_RX_RESTORE
 	if (qdf_unlikely(pdev->rx_ring.rx_reset)) {
 		qdf_print("rx restore ..\n");
@@ -1112,6 +1115,8 @@ void htt_t2h_msg_handler_fast(void *context, qdf_nbuf_t *cmpl_msdus,
 	uint32_t msg_len;
 	struct ol_txrx_soc_t *soc = cds_get_context(QDF_MODULE_ID_SOC);
 
+	htt_rx_lat_ind_ts_set(pdev);
+
 	for (i = 0; i < num_cmpls; i++) {
 		htt_t2h_msg = cmpl_msdus[i];
 		msg_len = qdf_nbuf_len(htt_t2h_msg);
@@ -112,6 +112,38 @@ struct htt_rx_hash_bucket {
 #endif
 };
 
+/**
+ * struct htt_rx_paddr_cookie_entry - rx buffer tracked by a paddr cookie
+ * @paddr: physical address of the buffer, without marking bits
+ * @netbuf: rx buffer, NULL if the cookie is free
+ */
+struct htt_rx_paddr_cookie_entry {
+	qdf_dma_addr_t paddr;
+	qdf_nbuf_t netbuf;
+};
+
+/**
+ * struct htt_rx_hash_stats - rx buffer paddr to netbuf lookup stats
+ * @cookie_hit: buffers found through their paddr cookie
+ * @cookie_err: paddr cookies without a matching buffer
+ * @cookie_empty: buffers posted without cookie as all were in use
+ * @hash_insert: buffers tracked in the hash table
+ * @hash_alloc: hash entries allocated as the bucket pool was empty
+ * @hash_hit: buffers found in the hash table
+ * @hash_depth: hash entries walked by all lookups
+ * @hash_depth_max: longest hash bucket walk of a lookup
+ */
+struct htt_rx_hash_stats {
+	uint32_t cookie_hit;
+	uint32_t cookie_err;
+	uint32_t cookie_empty;
+	uint32_t hash_insert;
+	uint32_t hash_alloc;
+	uint32_t hash_hit;
+	uint64_t hash_depth;
+	uint32_t hash_depth_max;
+};
+
 /*
  * Micro controller datapath offload
  * WLAN TX resources
@@ -369,6 +401,23 @@ struct htt_pdev_t {
 		qdf_spinlock_t rx_hash_lock;
 		struct htt_rx_hash_bucket **hash_table;
 		uint32_t listnode_offset;
+		struct htt_rx_hash_stats hash_stats;
+#ifdef HTT_RX_PADDR_COOKIE
+		/*
+		 * paddr cookie -> rx buffer array. Free cookies are passed
+		 * from the rx indication context (free_prod) to the refill
+		 * context (free_cons) through free_ring without a lock.
+		 * entries is NULL unless enabled by ini, disabled is set
+		 * once the target gave back a cookie not matching its paddr.
+		 */
+		struct {
+			struct htt_rx_paddr_cookie_entry *entries;
+			uint16_t *free_ring;
+			uint32_t free_prod;
+			uint32_t free_cons;
+			bool disabled;
+		} cookie;
+#endif
 		bool smmu_map;
 	} rx_ring;
 
@@ -387,6 +436,10 @@ struct htt_pdev_t {
 	long rx_fw_desc_offset;
 	int rx_mpdu_range_offset_words;
 	int rx_ind_msdu_byte_idx;
+#ifdef WLAN_RX_LATENCY_HIST
+	/* receipt time in ns of the T2H message being processed */
+	uint64_t rx_lat_ind_ts;
+#endif
 
 	struct {
 		int size;       /* of each HTT tx desc */
@@ -144,6 +144,22 @@
 		CFG_INI_BOOL("gEnablePeerUnmapConfSupport", \
 		false, "enable PEER UNMAP CONF support")
 
+/*
+ * <ini>
+ * gEnableRxPaddrCookie - Track rx buffers by a cookie in their paddr
+ * @Default: 0
+ *
+ * With full reorder offload, carry an rx buffer index in the bits 37..47
+ * of the paddrs posted to the target instead of looking the buffers up
+ * in the rx hash table. Only enable it for targets which give back these
+ * bits unchanged in the rx in-order indication.
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_PADDR_COOKIE \
+		CFG_INI_BOOL("gEnableRxPaddrCookie", \
+		false, "Track rx buffers by a paddr cookie")
+
 #define CFG_LEGACY_DP_ALL \
 	CFG(CFG_DP_FLOW_STEERING_ENABLED) \
 	CFG(CFG_DP_CE_CLASSIFY_ENABLE) \
@@ -152,6 +168,7 @@
 	CFG(CFG_DP_ENABLE_TX_SCHED_WRR_VI) \
 	CFG(CFG_DP_ENABLE_TX_SCHED_WRR_BE) \
 	CFG(CFG_DP_ENABLE_TX_SCHED_WRR_BK) \
-	CFG(CFG_DP_ENABLE_PEER_UMAP_CONF_SUPPORT)
+	CFG(CFG_DP_ENABLE_PEER_UMAP_CONF_SUPPORT) \
+	CFG(CFG_DP_RX_PADDR_COOKIE)
 
 #endif
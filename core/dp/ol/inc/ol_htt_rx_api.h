@@ -901,6 +901,24 @@ int htt_rx_msdu_buff_in_order_replenish(htt_pdev_handle pdev, uint32_t num)
 }
 #endif
 
+/**
+ * htt_rx_ring_deficit() - share of the rx ring waiting to be replenished
+ * @pdev: the HTT instance the rx data is received on
+ *
+ * A large deficit means the target is consuming rx buffers faster than
+ * the host hands them back, which is an early sign of an rx burst.
+ *
+ * Return: rx buffers owed to the ring, in percent of the ring fill level
+ */
+#ifndef CONFIG_HL_SUPPORT
+uint32_t htt_rx_ring_deficit(htt_pdev_handle pdev);
+#else
+static inline uint32_t htt_rx_ring_deficit(htt_pdev_handle pdev)
+{
+	return 0;
+}
+#endif
+
 /**
  * @brief Links list of MSDUs into an single MPDU. Updates RX stats
  * @details
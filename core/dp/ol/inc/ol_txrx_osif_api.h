@@ -71,7 +71,7 @@ qdf_nbuf_t ol_txrx_osif_tso_segment(ol_txrx_vdev_handle txrx_vdev,
 
 qdf_nbuf_t ol_tx_data(struct cdp_soc_t *soc, uint8_t vdev_id, qdf_nbuf_t skb);
 
-void ol_rx_data_process(struct ol_txrx_peer_t *peer,
+void ol_rx_data_process(struct ol_txrx_peer_t *peer, uint8_t tid,
 			qdf_nbuf_t rx_buf_list);
 
 void ol_txrx_flush_rx_frames(struct ol_txrx_peer_t *peer,
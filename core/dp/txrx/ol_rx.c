@@ -39,6 +39,7 @@
 #include <ol_txrx_encap.h>      /* ol_rx_decap_info_t, etc */
 #endif
 #include <ol_rx.h>
+#include <ol_rx_latency.h>
 
 /* FIX THIS: txrx should not include private header files of other modules */
 #include <htt_types.h>
@@ -121,7 +122,7 @@ void ol_rx_ind_record_event(uint32_t value, enum ol_rx_ind_record_type type)
 
 #endif /* OL_RX_INDICATION_RECORD */
 
-void ol_rx_data_process(struct ol_txrx_peer_t *peer,
+void ol_rx_data_process(struct ol_txrx_peer_t *peer, uint8_t tid,
 			qdf_nbuf_t rx_buf_list);
 
 #ifdef WDI_EVENT_ENABLE
@@ -937,7 +938,7 @@ ol_rx_offload_deliver_ind_handler(ol_txrx_pdev_handle pdev,
 					&tid, &fw_desc, &head_buf, &tail_buf)) {
 			peer = ol_txrx_peer_find_by_id(pdev, peer_id);
 			if (peer) {
-				ol_rx_data_process(peer, head_buf);
+				ol_rx_data_process(peer, tid, head_buf);
 			} else {
 				buf = head_buf;
 				while (1) {
@@ -1483,7 +1484,7 @@ DONE:
 			  ol_txrx_frm_dump_tcp_seq | ol_txrx_frm_dump_contents,
 			  0 /* don't print contents */);
 
-	ol_rx_data_process(peer, deliver_list_head);
+	ol_rx_data_process(peer, tid, deliver_list_head);
 }
 #endif
 
@@ -1705,6 +1706,8 @@ ol_rx_in_order_indication_handler(ol_txrx_pdev_handle pdev,
 	/*Loop msdu to fill tstamp with tsf64 time in ol_rx_timestamp*/
 	ol_rx_timestamp_update(pdev, head_msdu, tail_msdu);
 
+	ol_rx_lat_stamp(vdev, tid, head_msdu, htt_rx_lat_ind_ts_get(htt_pdev));
+
 	peer->rx_opt_proc(vdev, peer, tid, head_msdu);
 }
 #endif
@@ -1799,7 +1802,7 @@ ol_rx_in_order_deliver(struct ol_txrx_vdev_t *vdev,
 			  ol_txrx_frm_dump_tcp_seq | ol_txrx_frm_dump_contents,
 			  0 /* don't print contents */);
 
-	ol_rx_data_process(peer, msdu_list);
+	ol_rx_data_process(peer, tid, msdu_list);
 }
 #endif
 
@@ -1843,7 +1846,7 @@ ol_rx_offload_paddr_deliver_ind_handler(htt_pdev_handle htt_pdev,
 				QDF_TRACE_DEFAULT_PDEV_ID,
 				qdf_nbuf_data_addr(head_buf),
 				sizeof(qdf_nbuf_data(head_buf)), QDF_RX));
-			ol_rx_data_process(peer, head_buf);
+			ol_rx_data_process(peer, tid, head_buf);
 		} else {
 			buf = head_buf;
 			while (1) {
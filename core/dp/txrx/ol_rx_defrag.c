@@ -190,27 +190,6 @@ ol_rx_frag_restructure(
 		     HTT_RX_IND_HL_BYTES);
 }
 
-/**
- * ol_rx_get_desc_len() - point to payload for HL
- * @htt_pdev: the HTT instance the rx data was received on
- * @wbuf: buffer containing the MSDU payload
- * @rx_desc_old_position: rx MSDU descriptor
- *
- * Return: Return the HL rx desc size
- */
-static
-int ol_rx_get_desc_len(htt_pdev_handle htt_pdev,
-			qdf_nbuf_t wbuf,
-			void **rx_desc_old_position)
-{
-	int rx_desc_len = 0;
-	*rx_desc_old_position = htt_rx_msdu_desc_retrieve(htt_pdev, wbuf);
-	rx_desc_len = htt_rx_msdu_rx_desc_size_hl(htt_pdev,
-			*rx_desc_old_position);
-
-	return rx_desc_len;
-}
-
 /**
  * ol_rx_defrag_push_rx_desc() - point to payload for HL
  * @nbuf: buffer containing the MSDU payload
@@ -272,14 +251,6 @@ ol_rx_frag_restructure(
 	/* no op */
 }
 
-static inline
-int ol_rx_get_desc_len(htt_pdev_handle htt_pdev,
-			qdf_nbuf_t wbuf,
-			void **rx_desc_old_position)
-{
-	return 0;
-}
-
 static inline
 void ol_rx_defrag_push_rx_desc(qdf_nbuf_t nbuf,
 			void *rx_desc_old_position,
@@ -685,6 +656,85 @@ void ol_rx_defrag_waitlist_flush(struct ol_txrx_pdev_t *pdev)
 	}
 }
 
+/**
+ * ol_rx_defrag_strip_hdrs() - strip per-fragment headers ahead of recombine
+ * @htt_pdev: htt pdev handle
+ * @frag_list: decapped fragments of one MSDU, chained through next
+ * @hdrsize: 802.11 header size
+ *
+ * The first fragment keeps its rx desc and 802.11 header; every other
+ * fragment is reduced to its payload so the chain can be MIC'd and joined
+ * in place.
+ *
+ * Return: None
+ */
+void ol_rx_defrag_strip_hdrs(htt_pdev_handle htt_pdev,
+			     qdf_nbuf_t frag_list, uint16_t hdrsize)
+{
+	qdf_nbuf_t msdu;
+
+	for (msdu = qdf_nbuf_next(frag_list); msdu;
+	     msdu = qdf_nbuf_next(msdu)) {
+		htt_rx_msdu_desc_free(htt_pdev, msdu);
+		ol_rx_frag_pull_hdr(htt_pdev, msdu, hdrsize);
+	}
+}
+
+/**
+ * ol_rx_defrag_join() - join a stripped fragment chain into one MSDU
+ * @htt_pdev: htt pdev handle
+ * @frag_list: fragment chain produced by ol_rx_defrag_strip_hdrs()
+ *
+ * The first fragment is grown once to hold the whole payload, so each
+ * remaining fragment is copied exactly once instead of the head being
+ * reallocated for every fragment appended to it.
+ *
+ * Return: recombined MSDU, or NULL if the fragments had to be dropped
+ */
+qdf_nbuf_t ol_rx_defrag_join(htt_pdev_handle htt_pdev, qdf_nbuf_t frag_list)
+{
+	qdf_nbuf_t tmp;
+	qdf_nbuf_t msdu = qdf_nbuf_next(frag_list);
+	qdf_nbuf_t rx_nbuf = frag_list;
+	struct ieee80211_frame *wh;
+	uint32_t len = 0;
+	uint32_t tailroom;
+
+	for (tmp = msdu; tmp; tmp = qdf_nbuf_next(tmp))
+		len += ol_rx_defrag_len(tmp);
+
+	qdf_nbuf_set_next(rx_nbuf, NULL);
+	tailroom = qdf_nbuf_tailroom(rx_nbuf);
+	if (len > tailroom) {
+		/* the rx desc in the headroom moves along with the data */
+		rx_nbuf = qdf_nbuf_realloc_tailroom(rx_nbuf, len - tailroom);
+		if (!rx_nbuf) {
+			/* head fragment already freed by the realloc */
+			ol_rx_frames_free(htt_pdev, msdu);
+			return NULL;
+		}
+	}
+
+	while (msdu) {
+		tmp = qdf_nbuf_next(msdu);
+		qdf_nbuf_set_next(msdu, NULL);
+		if (!ol_rx_defrag_concat(rx_nbuf, msdu)) {
+			ol_rx_frames_free(htt_pdev, tmp);
+			htt_rx_desc_frame_free(htt_pdev, rx_nbuf);
+			qdf_nbuf_free(msdu);
+			/* msdu rx desc already freed above */
+			return NULL;
+		}
+		msdu = tmp;
+	}
+	wh = (struct ieee80211_frame *)ol_rx_frag_get_mac_hdr(htt_pdev,
+							      rx_nbuf);
+	wh->i_fc[1] &= ~IEEE80211_FC1_MORE_FRAG;
+	*(uint16_t *) wh->i_seq &= ~IEEE80211_SEQ_FRAG_MASK;
+
+	return rx_nbuf;
+}
+
 /*
  * Handling security checking and processing fragments
  */
@@ -808,23 +858,30 @@ ol_rx_defrag(ol_txrx_pdev_handle pdev,
 		break;
 	}
 
-	msdu = ol_rx_defrag_decap_recombine(htt_pdev, frag_list, hdr_space);
-	if (!msdu)
-		return;
+	ol_rx_defrag_strip_hdrs(htt_pdev, frag_list, hdr_space);
 
+	/*
+	 * Verify the MIC across the fragment chain before joining it, so a
+	 * forged frame is dropped without paying for the copy.
+	 */
 	if (tkip_demic) {
 		qdf_mem_copy(key,
 			     peer->security[index].michael_key,
 			     sizeof(peer->security[index].michael_key));
-		if (!ol_rx_frag_tkip_demic(pdev, key, msdu, hdr_space)) {
-			htt_rx_desc_frame_free(htt_pdev, msdu);
+		if (!ol_rx_frag_tkip_demic(pdev, key, frag_list, hdr_space)) {
 			ol_rx_err(pdev->ctrl_pdev,
 				  vdev->vdev_id, peer->mac_addr.raw, tid, 0,
-				  OL_RX_DEFRAG_ERR, msdu, NULL, 0);
+				  OL_RX_DEFRAG_ERR, frag_list, NULL, 0);
+			ol_rx_frames_free(htt_pdev, frag_list);
 			ol_txrx_err("TKIP demic failed");
 			return;
 		}
 	}
+
+	msdu = ol_rx_defrag_join(htt_pdev, frag_list);
+	if (!msdu)
+		return;
+
 	wh = (struct ieee80211_frame *)ol_rx_frag_get_mac_hdr(htt_pdev, msdu);
 	if (DEFRAG_IEEE80211_QOS_HAS_SEQ(wh))
 		ol_rx_defrag_qos_decap(pdev, msdu, hdr_space);
@@ -927,8 +984,82 @@ ol_rx_frag_wep_decap(ol_txrx_pdev_handle pdev, qdf_nbuf_t msdu, uint16_t hdrlen)
 	return OL_RX_DEFRAG_OK;
 }
 
+/**
+ * ol_rx_defrag_chain_len() - total length of a fragment chain
+ * @nbuf: first buffer of the chain
+ *
+ * Return: sum of the buffer lengths along the qdf_nbuf_next() chain
+ */
+static uint32_t ol_rx_defrag_chain_len(qdf_nbuf_t nbuf)
+{
+	uint32_t len = 0;
+
+	for (; nbuf; nbuf = qdf_nbuf_next(nbuf))
+		len += ol_rx_defrag_len(nbuf);
+
+	return len;
+}
+
+/**
+ * ol_rx_defrag_chain_copydata() - copy bytes out of a fragment chain
+ * @nbuf: first buffer of the chain
+ * @offset: offset of the first byte to copy, relative to the chain start
+ * @len: number of bytes to copy
+ * @to: destination buffer
+ *
+ * The copied range may span any number of buffers.
+ *
+ * Return: None
+ */
+static void ol_rx_defrag_chain_copydata(qdf_nbuf_t nbuf, uint32_t offset,
+					uint32_t len, uint8_t *to)
+{
+	uint32_t buf_len, chunk;
+
+	for (; nbuf && len; nbuf = qdf_nbuf_next(nbuf)) {
+		buf_len = ol_rx_defrag_len(nbuf);
+		if (offset >= buf_len) {
+			offset -= buf_len;
+			continue;
+		}
+		chunk = qdf_min(buf_len - offset, len);
+		ol_rx_defrag_copydata(nbuf, offset, chunk, (caddr_t)to);
+		to += chunk;
+		len -= chunk;
+		offset = 0;
+	}
+}
+
+/**
+ * ol_rx_defrag_chain_trim_tail() - drop bytes from the end of a chain
+ * @nbuf: first buffer of the chain
+ * @chain_len: total length of the chain
+ * @len: number of bytes to drop
+ *
+ * Buffers emptied by the trim stay on the chain with zero length.
+ *
+ * Return: None
+ */
+static void ol_rx_defrag_chain_trim_tail(qdf_nbuf_t nbuf, uint32_t chain_len,
+					 uint32_t len)
+{
+	uint32_t keep = chain_len - len;
+	uint32_t buf_len;
+
+	for (; nbuf; nbuf = qdf_nbuf_next(nbuf)) {
+		buf_len = ol_rx_defrag_len(nbuf);
+		if (buf_len <= keep) {
+			keep -= buf_len;
+			continue;
+		}
+		qdf_nbuf_trim_tail(nbuf, buf_len - keep);
+		keep = 0;
+	}
+}
+
 /*
- * Verify and strip MIC from the frame.
+ * Verify and strip MIC from the frame. The frame may still be split
+ * across a chain of fragments whose 802.11 headers have been stripped.
  */
 int
 ol_rx_frag_tkip_demic(ol_txrx_pdev_handle pdev, const uint8_t *key,
@@ -947,19 +1078,23 @@ ol_rx_frag_tkip_demic(ol_txrx_pdev_handle pdev, const uint8_t *key,
 			       &rx_desc_old_position,
 			       &ind_old_position, &rx_desc_len);
 
-	pktlen = ol_rx_defrag_len(msdu) - rx_desc_len;
+	pktlen = ol_rx_defrag_chain_len(msdu) - rx_desc_len;
+	if (pktlen < hdrlen + f_tkip.ic_miclen)
+		return OL_RX_DEFRAG_ERR;
 
 	status = ol_rx_defrag_mic(pdev, key, msdu, hdrlen,
 				  pktlen - (hdrlen + f_tkip.ic_miclen), mic);
 	if (status != OL_RX_DEFRAG_OK)
 		return OL_RX_DEFRAG_ERR;
 
-	ol_rx_defrag_copydata(msdu, pktlen - f_tkip.ic_miclen + rx_desc_len,
-			      f_tkip.ic_miclen, (caddr_t) mic0);
+	ol_rx_defrag_chain_copydata(msdu,
+				    pktlen - f_tkip.ic_miclen + rx_desc_len,
+				    f_tkip.ic_miclen, mic0);
 	if (qdf_mem_cmp(mic, mic0, f_tkip.ic_miclen))
 		return OL_RX_DEFRAG_ERR;
 
-	qdf_nbuf_trim_tail(msdu, f_tkip.ic_miclen);
+	ol_rx_defrag_chain_trim_tail(msdu, pktlen + rx_desc_len,
+				     f_tkip.ic_miclen);
 	return OL_RX_DEFRAG_OK;
 }
 
@@ -1071,6 +1206,61 @@ void ol_rx_defrag_michdr(const struct ieee80211_frame *wh0, uint8_t hdr[])
 	hdr[13] = hdr[14] = hdr[15] = 0;        /* reserved */
 }
 
+void ol_rx_michael_init(struct ol_rx_michael *m, const uint8_t *key)
+{
+	m->l = get_le32(key);
+	m->r = get_le32(key + 4);
+	m->tail_len = 0;
+}
+
+void ol_rx_michael_update(struct ol_rx_michael *m,
+			  const uint8_t *data, uint32_t len)
+{
+	uint32_t l, r;
+
+	if (m->tail_len) {
+		/* complete the block left over from the previous buffer */
+		while (m->tail_len < sizeof(uint32_t) && len) {
+			m->tail[m->tail_len++] = *data++;
+			len--;
+		}
+		if (m->tail_len < sizeof(uint32_t))
+			return;
+
+		m->l ^= get_le32(m->tail);
+		michael_block(m->l, m->r);
+		m->tail_len = 0;
+	}
+
+	l = m->l;
+	r = m->r;
+	while (len >= sizeof(uint32_t)) {
+		l ^= get_le32(data);
+		michael_block(l, r);
+		data += sizeof(uint32_t);
+		len -= sizeof(uint32_t);
+	}
+	m->l = l;
+	m->r = r;
+
+	while (len--)
+		m->tail[m->tail_len++] = *data++;
+}
+
+void ol_rx_michael_final(struct ol_rx_michael *m, uint8_t mic[])
+{
+	uint8_t last[sizeof(uint32_t)] = { 0, };
+
+	/* Last block and padding (0x5a, 4..7 x 0) */
+	qdf_mem_copy(last, m->tail, m->tail_len);
+	last[m->tail_len] = 0x5a;
+	m->l ^= get_le32(last);
+	michael_block(m->l, m->r);
+	michael_block(m->l, m->r);
+	put_le32(mic, m->l);
+	put_le32(mic + 4, m->r);
+}
+
 /*
  * Michael_mic for defragmentation
  */
@@ -1081,13 +1271,12 @@ ol_rx_defrag_mic(ol_txrx_pdev_handle pdev,
 		 uint16_t off, uint16_t data_len, uint8_t mic[])
 {
 	uint8_t hdr[16] = { 0, };
-	uint32_t l, r;
+	struct ol_rx_michael m;
 	const uint8_t *data;
 	uint32_t space;
 	void *rx_desc_old_position = NULL;
 	void *ind_old_position = NULL;
 	int rx_desc_len = 0;
-	htt_pdev_handle htt_pdev = pdev->htt_pdev;
 
 	ol_rx_frag_desc_adjust(pdev,
 			       wbuf,
@@ -1096,107 +1285,36 @@ ol_rx_defrag_mic(ol_txrx_pdev_handle pdev,
 
 	ol_rx_defrag_michdr((struct ieee80211_frame *)(qdf_nbuf_data(wbuf) +
 						       rx_desc_len), hdr);
-	l = get_le32(key);
-	r = get_le32(key + 4);
+	ol_rx_michael_init(&m, key);
 
 	/* Michael MIC pseudo header: DA, SA, 3 x 0, Priority */
-	l ^= get_le32(hdr);
-	michael_block(l, r);
-	l ^= get_le32(&hdr[4]);
-	michael_block(l, r);
-	l ^= get_le32(&hdr[8]);
-	michael_block(l, r);
-	l ^= get_le32(&hdr[12]);
-	michael_block(l, r);
+	ol_rx_michael_update(&m, hdr, sizeof(hdr));
 
 	/* first buffer has special handling */
-	data = (uint8_t *) qdf_nbuf_data(wbuf) + rx_desc_len + off;
-	space = ol_rx_defrag_len(wbuf) - rx_desc_len - off;
+	space = ol_rx_defrag_len(wbuf) - rx_desc_len;
+	if (space < off)
+		return OL_RX_DEFRAG_ERR;
+
+	data = (uint8_t *)qdf_nbuf_data(wbuf) + rx_desc_len + off;
+	space -= off;
 	for (;; ) {
 		if (space > data_len)
 			space = data_len;
 
-		/* collect 32-bit blocks from current buffer */
-		while (space >= sizeof(uint32_t)) {
-			l ^= get_le32(data);
-			michael_block(l, r);
-			data += sizeof(uint32_t);
-			space -= sizeof(uint32_t);
-			data_len -= sizeof(uint32_t);
-		}
-		if (data_len < sizeof(uint32_t))
+		ol_rx_michael_update(&m, data, space);
+		data_len -= space;
+		if (!data_len)
 			break;
 
+		/* remaining fragments hold payload only */
 		wbuf = qdf_nbuf_next(wbuf);
 		if (!wbuf)
 			return OL_RX_DEFRAG_ERR;
 
-		rx_desc_len = ol_rx_get_desc_len(htt_pdev, wbuf,
-						 &rx_desc_old_position);
-
-		if (space != 0) {
-			const uint8_t *data_next;
-			/*
-			 * Block straddles buffers, split references.
-			 */
-			data_next =
-				(uint8_t *) qdf_nbuf_data(wbuf) + rx_desc_len;
-			if ((ol_rx_defrag_len(wbuf) - rx_desc_len) <
-			    sizeof(uint32_t) - space) {
-				return OL_RX_DEFRAG_ERR;
-			}
-			switch (space) {
-			case 1:
-				l ^= get_le32_split(data[0], data_next[0],
-						    data_next[1], data_next[2]);
-				data = data_next + 3;
-				space = (ol_rx_defrag_len(wbuf) - rx_desc_len)
-					- 3;
-				break;
-			case 2:
-				l ^= get_le32_split(data[0], data[1],
-						    data_next[0], data_next[1]);
-				data = data_next + 2;
-				space = (ol_rx_defrag_len(wbuf) - rx_desc_len)
-					- 2;
-				break;
-			case 3:
-				l ^= get_le32_split(data[0], data[1], data[2],
-						    data_next[0]);
-				data = data_next + 1;
-				space = (ol_rx_defrag_len(wbuf) - rx_desc_len)
-					- 1;
-				break;
-			}
-			michael_block(l, r);
-			data_len -= sizeof(uint32_t);
-		} else {
-			/*
-			 * Setup for next buffer.
-			 */
-			data = (uint8_t *) qdf_nbuf_data(wbuf) + rx_desc_len;
-			space = ol_rx_defrag_len(wbuf) - rx_desc_len;
-		}
-	}
-	/* Last block and padding (0x5a, 4..7 x 0) */
-	switch (data_len) {
-	case 0:
-		l ^= get_le32_split(0x5a, 0, 0, 0);
-		break;
-	case 1:
-		l ^= get_le32_split(data[0], 0x5a, 0, 0);
-		break;
-	case 2:
-		l ^= get_le32_split(data[0], data[1], 0x5a, 0);
-		break;
-	case 3:
-		l ^= get_le32_split(data[0], data[1], data[2], 0x5a);
-		break;
+		data = (uint8_t *)qdf_nbuf_data(wbuf);
+		space = ol_rx_defrag_len(wbuf);
 	}
-	michael_block(l, r);
-	michael_block(l, r);
-	put_le32(mic, l);
-	put_le32(mic + 4, r);
+	ol_rx_michael_final(&m, mic);
 
 	return OL_RX_DEFRAG_OK;
 }
@@ -1227,33 +1345,9 @@ qdf_nbuf_t
 ol_rx_defrag_decap_recombine(htt_pdev_handle htt_pdev,
 			     qdf_nbuf_t frag_list, uint16_t hdrsize)
 {
-	qdf_nbuf_t tmp;
-	qdf_nbuf_t msdu = frag_list;
-	qdf_nbuf_t rx_nbuf = frag_list;
-	struct ieee80211_frame *wh;
+	ol_rx_defrag_strip_hdrs(htt_pdev, frag_list, hdrsize);
 
-	msdu = qdf_nbuf_next(msdu);
-	qdf_nbuf_set_next(rx_nbuf, NULL);
-	while (msdu) {
-		htt_rx_msdu_desc_free(htt_pdev, msdu);
-		tmp = qdf_nbuf_next(msdu);
-		qdf_nbuf_set_next(msdu, NULL);
-		ol_rx_frag_pull_hdr(htt_pdev, msdu, hdrsize);
-		if (!ol_rx_defrag_concat(rx_nbuf, msdu)) {
-			ol_rx_frames_free(htt_pdev, tmp);
-			htt_rx_desc_frame_free(htt_pdev, rx_nbuf);
-			qdf_nbuf_free(msdu);
-			/* msdu rx desc already freed above */
-			return NULL;
-		}
-		msdu = tmp;
-	}
-	wh = (struct ieee80211_frame *)ol_rx_frag_get_mac_hdr(htt_pdev,
-							      rx_nbuf);
-	wh->i_fc[1] &= ~IEEE80211_FC1_MORE_FRAG;
-	*(uint16_t *) wh->i_seq &= ~IEEE80211_SEQ_FRAG_MASK;
-
-	return rx_nbuf;
+	return ol_rx_defrag_join(htt_pdev, frag_list);
 }
 
 void ol_rx_defrag_nwifi_to_8023(ol_txrx_pdev_handle pdev, qdf_nbuf_t msdu)
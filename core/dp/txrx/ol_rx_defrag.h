@@ -106,12 +106,79 @@ qdf_nbuf_t
 ol_rx_defrag_decap_recombine(htt_pdev_handle htt_pdev,
 			     qdf_nbuf_t frag_list, uint16_t hdrsize);
 
+void ol_rx_defrag_strip_hdrs(htt_pdev_handle htt_pdev,
+			     qdf_nbuf_t frag_list, uint16_t hdrsize);
+
+qdf_nbuf_t ol_rx_defrag_join(htt_pdev_handle htt_pdev, qdf_nbuf_t frag_list);
+
+/**
+ * ol_rx_defrag_mic() - compute the TKIP Michael MIC of a frame
+ * @pdev: txrx pdev handle
+ * @key: 8 byte Michael key
+ * @wbuf: first buffer of the frame, holding the rx desc and 802.11 header
+ * @off: offset of the MIC'd payload from the 802.11 header
+ * @data_len: number of payload bytes to cover
+ * @mic: buffer to receive the 8 byte MIC
+ *
+ * The payload may continue in buffers chained through qdf_nbuf_next();
+ * those buffers are expected to carry payload only, with their rx desc
+ * and 802.11 header already stripped.
+ *
+ * Return: OL_RX_DEFRAG_OK on success, OL_RX_DEFRAG_ERR if the chain is
+ *	   shorter than @off + @data_len
+ */
 int
 ol_rx_defrag_mic(ol_txrx_pdev_handle pdev,
 		 const uint8_t *key,
 		 qdf_nbuf_t wbuf,
 		 uint16_t off, uint16_t data_len, uint8_t mic[]);
 
+/**
+ * struct ol_rx_michael - incremental Michael MIC state
+ * @l: left half of the Michael state
+ * @r: right half of the Michael state
+ * @tail: bytes not yet forming a complete 32-bit block
+ * @tail_len: number of valid bytes in @tail
+ */
+struct ol_rx_michael {
+	uint32_t l;
+	uint32_t r;
+	uint8_t tail[sizeof(uint32_t)];
+	uint8_t tail_len;
+};
+
+/**
+ * ol_rx_michael_init() - start a Michael MIC computation
+ * @m: Michael state
+ * @key: 8 byte Michael key
+ *
+ * Return: None
+ */
+void ol_rx_michael_init(struct ol_rx_michael *m, const uint8_t *key);
+
+/**
+ * ol_rx_michael_update() - feed data into a Michael MIC computation
+ * @m: Michael state
+ * @data: data to feed
+ * @len: length of @data
+ *
+ * Blocks straddling two calls are carried over in @m, so a frame can be
+ * fed one fragment at a time regardless of the fragment sizes.
+ *
+ * Return: None
+ */
+void ol_rx_michael_update(struct ol_rx_michael *m,
+			  const uint8_t *data, uint32_t len);
+
+/**
+ * ol_rx_michael_final() - pad and finish a Michael MIC computation
+ * @m: Michael state
+ * @mic: buffer to receive the 8 byte MIC
+ *
+ * Return: None
+ */
+void ol_rx_michael_final(struct ol_rx_michael *m, uint8_t mic[]);
+
 void
 ol_rx_reorder_flush_frag(htt_pdev_handle htt_pdev,
 			 struct ol_txrx_peer_t *peer,
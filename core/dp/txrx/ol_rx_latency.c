@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <qdf_nbuf.h>           /* qdf_nbuf_t */
+#include <qdf_mem.h>            /* qdf_mem_zero */
+#include <qdf_atomic.h>         /* qdf_atomic_add */
+#include <ol_cfg.h>             /* ol_cfg_is_ptp_rx_opt_enabled */
+#include <ol_txrx_types.h>      /* ol_txrx_vdev_t */
+#include <ol_txrx.h>            /* ol_txrx_get_vdev_from_vdev_id */
+#include <ol_rx_latency.h>
+
+/*
+ * The stamp lives in the skb timestamp, which is otherwise unused on the
+ * rx path unless PTP rx timestamping is enabled. The low bits of the ns
+ * value carry the TID and a marker, which costs 256 ns of resolution.
+ */
+#define OL_RX_LAT_TID_MASK	0x1f
+#define OL_RX_LAT_MARK_MASK	0xe0
+#define OL_RX_LAT_MARK		0xa0
+#define OL_RX_LAT_META_MASK	(OL_RX_LAT_TID_MASK | OL_RX_LAT_MARK_MASK)
+
+static const char * const ol_rx_lat_stage_name[OL_RX_LAT_STAGE_MAX] = {
+	[OL_RX_LAT_STAGE_HTT] = "htt",
+	[OL_RX_LAT_STAGE_RXQ] = "rxq",
+	[OL_RX_LAT_STAGE_HDD] = "hdd",
+	[OL_RX_LAT_STAGE_STACK] = "stack",
+};
+
+static inline uint64_t ol_rx_lat_now(void)
+{
+	return ktime_get_ns();
+}
+
+static inline void ol_rx_lat_set(qdf_nbuf_t nbuf, uint64_t ts, uint8_t tid)
+{
+	nbuf->tstamp = ns_to_ktime((ts & ~(uint64_t)OL_RX_LAT_META_MASK) |
+				   OL_RX_LAT_MARK | tid);
+}
+
+static inline bool ol_rx_lat_get(qdf_nbuf_t nbuf, uint64_t *ts,
+				 uint8_t *tid)
+{
+	uint64_t val = ktime_to_ns(nbuf->tstamp);
+
+	if ((val & OL_RX_LAT_MARK_MASK) != OL_RX_LAT_MARK)
+		return false;
+
+	*tid = val & OL_RX_LAT_TID_MASK;
+	if (*tid >= OL_TXRX_NUM_EXT_TIDS)
+		return false;
+
+	*ts = val & ~(uint64_t)OL_RX_LAT_META_MASK;
+	return true;
+}
+
+/**
+ * ol_rx_lat_add() - account msdus into a histogram bucket
+ * @vdev: vdev owning the histograms
+ * @stage: stage
+ * @tid: extended TID
+ * @delta_ns: latency of the stage in ns
+ * @cnt: number of msdus
+ *
+ * Return: none
+ */
+static void ol_rx_lat_add(struct ol_txrx_vdev_t *vdev,
+			  enum ol_rx_lat_stage stage, uint8_t tid,
+			  uint64_t delta_ns, uint32_t cnt)
+{
+	uint32_t bucket;
+
+	do_div(delta_ns, NSEC_PER_USEC);
+	if (delta_ns >> 32)
+		bucket = OL_RX_LAT_HIST_BUCKETS - 1;
+	else
+		bucket = qdf_min_t(uint32_t, fls((uint32_t)delta_ns),
+				   OL_RX_LAT_HIST_BUCKETS - 1);
+
+	qdf_atomic_add(cnt, &vdev->rx_lat.bucket[stage][tid][bucket]);
+}
+
+/**
+ * ol_rx_lat_vdev() - get a vdev whose msdus carry latency stamps
+ * @vdev_id: vdev id
+ *
+ * Return: vdev, or NULL if the vdev does not exist or the skb timestamp is
+ * owned by PTP rx timestamping
+ */
+static struct ol_txrx_vdev_t *ol_rx_lat_vdev(uint8_t vdev_id)
+{
+	struct ol_txrx_vdev_t *vdev;
+
+	vdev = (struct ol_txrx_vdev_t *)ol_txrx_get_vdev_from_vdev_id(vdev_id);
+	if (qdf_unlikely(!vdev))
+		return NULL;
+
+	if (ol_cfg_is_ptp_rx_opt_enabled(vdev->pdev->ctrl_pdev))
+		return NULL;
+
+	return vdev;
+}
+
+void ol_rx_lat_stamp(struct ol_txrx_vdev_t *vdev, uint8_t tid,
+		     qdf_nbuf_t msdu_list, uint64_t ind_ts)
+{
+	qdf_nbuf_t msdu;
+	uint64_t now;
+	uint32_t cnt = 0;
+
+	if (!vdev || tid >= OL_TXRX_NUM_EXT_TIDS)
+		return;
+
+	/* Stamps are consumed and cleared by the STA and SAP rx callbacks */
+	if (vdev->opmode != wlan_op_mode_sta &&
+	    vdev->opmode != wlan_op_mode_ap)
+		return;
+
+	if (ol_cfg_is_ptp_rx_opt_enabled(vdev->pdev->ctrl_pdev))
+		return;
+
+	now = ol_rx_lat_now();
+	for (msdu = msdu_list; msdu; msdu = qdf_nbuf_next(msdu)) {
+		ol_rx_lat_set(msdu, now, tid);
+		cnt++;
+	}
+
+	if (ind_ts && ind_ts <= now)
+		ol_rx_lat_add(vdev, OL_RX_LAT_STAGE_HTT, tid, now - ind_ts,
+			      cnt);
+}
+
+void ol_rx_lat_record(uint8_t vdev_id, qdf_nbuf_t nbuf,
+		      enum ol_rx_lat_stage stage)
+{
+	struct ol_txrx_vdev_t *vdev;
+	uint64_t ts, now;
+	uint8_t tid;
+
+	vdev = ol_rx_lat_vdev(vdev_id);
+	if (!vdev || !ol_rx_lat_get(nbuf, &ts, &tid))
+		return;
+
+	now = ol_rx_lat_now();
+	if (now >= ts)
+		ol_rx_lat_add(vdev, stage, tid, now - ts, 1);
+
+	ol_rx_lat_set(nbuf, now, tid);
+}
+
+int ol_rx_lat_handoff(uint8_t vdev_id, qdf_nbuf_t nbuf, uint64_t *ts)
+{
+	struct ol_txrx_vdev_t *vdev;
+	uint64_t stamp, now;
+	uint8_t tid;
+
+	vdev = ol_rx_lat_vdev(vdev_id);
+	if (!vdev || !ol_rx_lat_get(nbuf, &stamp, &tid))
+		return -1;
+
+	now = ol_rx_lat_now();
+	if (now >= stamp)
+		ol_rx_lat_add(vdev, OL_RX_LAT_STAGE_HDD, tid, now - stamp, 1);
+
+	/* Let the network stack timestamp the skb itself */
+	nbuf->tstamp = ns_to_ktime(0);
+	*ts = now;
+
+	return tid;
+}
+
+void ol_rx_lat_delivered(uint8_t vdev_id, int tid, uint64_t ts)
+{
+	struct ol_txrx_vdev_t *vdev;
+	uint64_t now;
+
+	if (tid < 0)
+		return;
+
+	vdev = ol_rx_lat_vdev(vdev_id);
+	if (!vdev)
+		return;
+
+	now = ol_rx_lat_now();
+	if (now >= ts)
+		ol_rx_lat_add(vdev, OL_RX_LAT_STAGE_STACK, tid, now - ts, 1);
+}
+
+int ol_rx_lat_hist_print(uint8_t vdev_id, char *buf, int size)
+{
+	struct ol_txrx_vdev_t *vdev;
+	qdf_atomic_t *bucket;
+	int len, stage, tid, i;
+
+	vdev = (struct ol_txrx_vdev_t *)ol_txrx_get_vdev_from_vdev_id(vdev_id);
+	if (!vdev)
+		return 0;
+
+	len = scnprintf(buf, size,
+			"rx latency vdev %u, log2(us) buckets 0..%u\n",
+			vdev_id, OL_RX_LAT_HIST_BUCKETS - 1);
+
+	for (stage = 0; stage < OL_RX_LAT_STAGE_MAX; stage++) {
+		for (tid = 0; tid < OL_TXRX_NUM_EXT_TIDS; tid++) {
+			bucket = vdev->rx_lat.bucket[stage][tid];
+			for (i = 0; i < OL_RX_LAT_HIST_BUCKETS; i++)
+				if (qdf_atomic_read(&bucket[i]))
+					break;
+			if (i == OL_RX_LAT_HIST_BUCKETS)
+				continue;
+
+			len += scnprintf(buf + len, size - len, "%s tid %d:",
+					 ol_rx_lat_stage_name[stage], tid);
+			for (i = 0; i < OL_RX_LAT_HIST_BUCKETS; i++)
+				len += scnprintf(buf + len, size - len, " %u",
+						 qdf_atomic_read(&bucket[i]));
+			len += scnprintf(buf + len, size - len, "\n");
+		}
+	}
+
+	return len;
+}
+
+void ol_rx_lat_hist_clear(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_txrx_vdev_t *vdev;
+
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem)
+		qdf_mem_zero(&vdev->rx_lat, sizeof(vdev->rx_lat));
+}
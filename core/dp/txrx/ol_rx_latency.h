@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: ol_rx_latency.h
+ *
+ * Per-stage rx latency histograms. Each msdu popped from an in-order
+ * indication is stamped with the time and its TID; every later stage
+ * records the time elapsed since the previous stamp into a per vdev/TID
+ * log2 histogram and re-stamps the msdu. The stamp is cleared before the
+ * msdu is handed to the network stack.
+ */
+
+#ifndef _OL_RX_LATENCY__H_
+#define _OL_RX_LATENCY__H_
+
+#include <qdf_nbuf.h>           /* qdf_nbuf_t */
+#include <ol_txrx_types.h>      /* ol_txrx_vdev_t, ol_rx_lat_stage */
+
+#ifdef WLAN_RX_LATENCY_HIST
+/**
+ * ol_rx_lat_stamp() - stamp msdus of an in-order indication
+ * @vdev: vdev the msdus belong to
+ * @tid: extended TID of the indication
+ * @msdu_list: NULL terminated list of msdus
+ * @ind_ts: time in ns the HTT T2H message was received, 0 if unknown
+ *
+ * Records the OL_RX_LAT_STAGE_HTT stage for all msdus of the list.
+ *
+ * Return: none
+ */
+void ol_rx_lat_stamp(struct ol_txrx_vdev_t *vdev, uint8_t tid,
+		     qdf_nbuf_t msdu_list, uint64_t ind_ts);
+
+/**
+ * ol_rx_lat_record() - record a stage for a stamped msdu and re-stamp it
+ * @vdev_id: vdev id
+ * @nbuf: msdu
+ * @stage: stage which ends now
+ *
+ * Return: none
+ */
+void ol_rx_lat_record(uint8_t vdev_id, qdf_nbuf_t nbuf,
+		      enum ol_rx_lat_stage stage);
+
+/**
+ * ol_rx_lat_handoff() - record the HDD stage and clear the stamp
+ * @vdev_id: vdev id
+ * @nbuf: msdu about to be delivered to the network stack
+ * @ts: filled with the handoff time, to be passed to ol_rx_lat_delivered()
+ *
+ * Return: TID of the msdu, or -1 if it was not stamped
+ */
+int ol_rx_lat_handoff(uint8_t vdev_id, qdf_nbuf_t nbuf, uint64_t *ts);
+
+/**
+ * ol_rx_lat_delivered() - record the network stack delivery stage
+ * @vdev_id: vdev id
+ * @tid: TID returned by ol_rx_lat_handoff()
+ * @ts: handoff time returned by ol_rx_lat_handoff()
+ *
+ * Return: none
+ */
+void ol_rx_lat_delivered(uint8_t vdev_id, int tid, uint64_t ts);
+
+/**
+ * ol_rx_lat_hist_print() - print the non-empty histograms of a vdev
+ * @vdev_id: vdev id
+ * @buf: output buffer
+ * @size: size of @buf
+ *
+ * Return: number of characters written to @buf
+ */
+int ol_rx_lat_hist_print(uint8_t vdev_id, char *buf, int size);
+
+/**
+ * ol_rx_lat_hist_clear() - reset the histograms of all vdevs of a pdev
+ * @pdev: txrx pdev
+ *
+ * Return: none
+ */
+void ol_rx_lat_hist_clear(struct ol_txrx_pdev_t *pdev);
+#else
+static inline
+void ol_rx_lat_stamp(struct ol_txrx_vdev_t *vdev, uint8_t tid,
+		     qdf_nbuf_t msdu_list, uint64_t ind_ts)
+{
+}
+
+static inline
+void ol_rx_lat_record(uint8_t vdev_id, qdf_nbuf_t nbuf,
+		      enum ol_rx_lat_stage stage)
+{
+}
+
+static inline
+int ol_rx_lat_handoff(uint8_t vdev_id, qdf_nbuf_t nbuf, uint64_t *ts)
+{
+	return -1;
+}
+
+static inline
+void ol_rx_lat_delivered(uint8_t vdev_id, int tid, uint64_t ts)
+{
+}
+
+static inline int ol_rx_lat_hist_print(uint8_t vdev_id, char *buf, int size)
+{
+	return 0;
+}
+
+static inline void ol_rx_lat_hist_clear(struct ol_txrx_pdev_t *pdev)
+{
+}
+#endif /* WLAN_RX_LATENCY_HIST */
+
+#endif /* _OL_RX_LATENCY__H_ */
@@ -33,6 +33,7 @@
 #include <ol_txrx_encap.h>      /* OL_TX_RESTORE_HDR, etc */
 #endif
 #include <ol_txrx.h>
+#include <ol_tx_latency.h>      /* ol_tx_lat_desc_init */
 
 #ifdef QCA_SUPPORT_TXDESC_SANITY_CHECKS
 static inline void ol_tx_desc_sanity_checks(struct ol_txrx_pdev_t *pdev,
@@ -233,25 +234,11 @@ static
 struct ol_tx_desc_t *ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev,
 					     struct ol_txrx_vdev_t *vdev)
 {
-	struct ol_tx_desc_t *tx_desc = NULL;
+	struct ol_tx_desc_t *tx_desc;
+
+	if (!ol_tx_desc_alloc_bulk(pdev, vdev, &tx_desc, 1))
+		return NULL;
 
-	qdf_spin_lock_bh(&pdev->tx_mutex);
-	if (pdev->tx_desc.freelist) {
-		tx_desc = ol_tx_get_desc_global_pool(pdev);
-		if (!tx_desc) {
-			qdf_spin_unlock_bh(&pdev->tx_mutex);
-			return NULL;
-		}
-		ol_tx_desc_dup_detect_set(pdev, tx_desc);
-		ol_tx_do_pdev_flow_control_pause(pdev);
-		ol_tx_desc_sanity_checks(pdev, tx_desc);
-		ol_tx_desc_compute_delay(tx_desc);
-		ol_tx_desc_vdev_update(tx_desc, vdev);
-		ol_tx_desc_count_inc(vdev);
-		ol_tx_desc_update_tx_ts(tx_desc);
-		qdf_atomic_inc(&tx_desc->ref_cnt);
-	}
-	qdf_spin_unlock_bh(&pdev->tx_mutex);
 	return tx_desc;
 }
 
@@ -271,62 +258,225 @@ ol_tx_desc_alloc_wrapper(struct ol_txrx_pdev_t *pdev,
 	return ol_tx_desc_alloc(pdev, vdev);
 }
 
+uint32_t ol_tx_desc_alloc_bulk(struct ol_txrx_pdev_t *pdev,
+			       struct ol_txrx_vdev_t *vdev,
+			       struct ol_tx_desc_t **tx_descs, uint32_t num)
+{
+	struct ol_tx_desc_t *tx_desc;
+	uint32_t cnt;
+
+	qdf_spin_lock_bh(&pdev->tx_mutex);
+	for (cnt = 0; cnt < num && pdev->tx_desc.freelist; cnt++) {
+		tx_desc = ol_tx_get_desc_global_pool(pdev);
+		if (!tx_desc)
+			break;
+		ol_tx_desc_dup_detect_set(pdev, tx_desc);
+		ol_tx_do_pdev_flow_control_pause(pdev);
+		ol_tx_desc_sanity_checks(pdev, tx_desc);
+		ol_tx_desc_compute_delay(tx_desc);
+		ol_tx_desc_vdev_update(tx_desc, vdev);
+		ol_tx_desc_count_inc(vdev);
+		ol_tx_desc_update_tx_ts(tx_desc);
+		qdf_atomic_inc(&tx_desc->ref_cnt);
+		tx_descs[cnt] = tx_desc;
+	}
+	qdf_spin_unlock_bh(&pdev->tx_mutex);
+
+	return cnt;
+}
+
 #else
 /**
- * ol_tx_desc_alloc() -allocate tx descriptor
+ * ol_tx_flow_pool_mag_usable() - check if the pool magazines can be used
+ * @pool: flow pool
+ *
+ * Descriptors cached in the magazines are not accounted in avail_desc, so
+ * they are only used while the pool is unpaused and has no overflow
+ * descriptors to give back to the global pool.
+ *
+ * Return: true if the magazines can be used
+ */
+static inline bool ol_tx_flow_pool_mag_usable(struct ol_tx_flow_pool_t *pool)
+{
+	return pool->status == FLOW_POOL_ACTIVE_UNPAUSED &&
+	       !pool->overflow_desc;
+}
+
+/**
+ * ol_tx_flow_pool_pause_check() - pause netif queues on pool depletion
+ * @pdev: pdev handle
+ * @vdev: vdev handle
+ * @pool: flow pool
+ *
+ * Called with the flow pool lock held, after a descriptor was taken.
+ * Pausing the pool deactivates its magazines.
+ *
+ * Return: true if the magazines were deactivated and have to be drained
+ *	   once the flow pool lock is released
+ */
+static inline bool
+ol_tx_flow_pool_pause_check(struct ol_txrx_pdev_t *pdev,
+			    struct ol_txrx_vdev_t *vdev,
+			    struct ol_tx_flow_pool_t *pool)
+{
+	bool drain = false;
+
+	if (qdf_unlikely(pool->avail_desc < pool->stop_th &&
+			(pool->avail_desc >= pool->stop_priority_th) &&
+			(pool->status == FLOW_POOL_ACTIVE_UNPAUSED))) {
+		pool->status = FLOW_POOL_NON_PRIO_PAUSED;
+		drain = pool->mag_active;
+		pool->mag_active = false;
+		/* pause network NON PRIORITY queues */
+		pdev->pause_cb(vdev->vdev_id,
+			       WLAN_STOP_NON_PRIORITY_QUEUE,
+			       WLAN_DATA_FLOW_CONTROL);
+	} else if (qdf_unlikely((pool->avail_desc <
+					pool->stop_priority_th) &&
+			pool->status == FLOW_POOL_NON_PRIO_PAUSED)) {
+		pool->status = FLOW_POOL_ACTIVE_PAUSED;
+		/* pause priority queue */
+		pdev->pause_cb(vdev->vdev_id,
+			       WLAN_NETIF_PRIORITY_QUEUE_OFF,
+			       WLAN_DATA_FLOW_CONTROL_PRIORITY);
+	}
+
+	return drain;
+}
+
+/**
+ * ol_tx_flow_pool_mag_alloc() - allocate descriptors from the CPU magazine
+ * @pdev: pdev handle
+ * @pool: flow pool
+ * @tx_descs: array filled with the allocated descriptors
+ * @num: number of descriptors requested
+ *
+ * An empty magazine is refilled with OL_TX_FLOW_POOL_MAG_XCHG descriptors
+ * from the pool freelist, as long as the pool stays above its start
+ * threshold. Otherwise, or if the pool got paused or overflowed meanwhile,
+ * the magazines of the pool are deactivated and drained, so the
+ * descriptors are allocated from the pool freelist with exact stop
+ * threshold checks.
+ *
+ * Return: number of descriptors allocated, 0 if the pool freelist has
+ *	   to be used
+ */
+static uint32_t ol_tx_flow_pool_mag_alloc(struct ol_txrx_pdev_t *pdev,
+					  struct ol_tx_flow_pool_t *pool,
+					  struct ol_tx_desc_t **tx_descs,
+					  uint32_t num)
+{
+	struct ol_tx_flow_pool_mag *mag;
+	bool drain = false;
+	uint32_t cnt = 0;
+
+	if (!pool->mag_active)
+		return 0;
+
+	mag = &pool->mags[qdf_get_cpu()];
+	qdf_spin_lock_bh(&mag->lock);
+	if (qdf_unlikely(!ol_tx_flow_pool_mag_usable(pool))) {
+		drain = pool->mag_active;
+	} else if (!mag->cnt) {
+		qdf_spin_lock_bh(&pool->flow_pool_lock);
+		if (pool->mag_active && ol_tx_flow_pool_mag_usable(pool) &&
+		    pool->avail_desc >=
+		    pool->start_th + OL_TX_FLOW_POOL_MAG_XCHG) {
+			while (mag->cnt < OL_TX_FLOW_POOL_MAG_XCHG)
+				mag->descs[mag->cnt++] =
+					ol_tx_get_desc_flow_pool(pool);
+			pool->mag_xchg++;
+		} else {
+			drain = pool->mag_active;
+		}
+		qdf_spin_unlock_bh(&pool->flow_pool_lock);
+	}
+
+	while (!drain && cnt < num && mag->cnt) {
+		tx_descs[cnt] = mag->descs[--mag->cnt];
+		ol_tx_desc_dup_detect_set(pdev, tx_descs[cnt]);
+		cnt++;
+	}
+	qdf_spin_unlock_bh(&mag->lock);
+
+	if (qdf_unlikely(drain))
+		ol_tx_flow_pool_mag_drain(pdev, pool);
+
+	return cnt;
+}
+
+/**
+ * ol_tx_desc_alloc_pool() - allocate tx descriptors from a flow pool
  * @pdev: pdev handler
  * @vdev: vdev handler
  * @pool: flow pool
+ * @tx_descs: array filled with the allocated descriptors
+ * @num: number of descriptors requested
  *
- * Return: tx descriptor or NULL
+ * Return: number of descriptors allocated
  */
-static
-struct ol_tx_desc_t *ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev,
+static uint32_t ol_tx_desc_alloc_pool(struct ol_txrx_pdev_t *pdev,
 				      struct ol_txrx_vdev_t *vdev,
-				      struct ol_tx_flow_pool_t *pool)
+				      struct ol_tx_flow_pool_t *pool,
+				      struct ol_tx_desc_t **tx_descs,
+				      uint32_t num)
 {
-	struct ol_tx_desc_t *tx_desc = NULL;
+	struct ol_tx_desc_t *tx_desc;
+	bool drain = false;
+	uint32_t cnt, i;
 
 	if (!pool) {
 		pdev->pool_stats.pkt_drop_no_pool++;
-		goto end;
+		return 0;
 	}
 
-	qdf_spin_lock_bh(&pool->flow_pool_lock);
-	if (pool->avail_desc) {
-		tx_desc = ol_tx_get_desc_flow_pool(pool);
-		ol_tx_desc_dup_detect_set(pdev, tx_desc);
-		if (qdf_unlikely(pool->avail_desc < pool->stop_th &&
-				(pool->avail_desc >= pool->stop_priority_th) &&
-				(pool->status == FLOW_POOL_ACTIVE_UNPAUSED))) {
-			pool->status = FLOW_POOL_NON_PRIO_PAUSED;
-			/* pause network NON PRIORITY queues */
-			pdev->pause_cb(vdev->vdev_id,
-				       WLAN_STOP_NON_PRIORITY_QUEUE,
-				       WLAN_DATA_FLOW_CONTROL);
-		} else if (qdf_unlikely((pool->avail_desc <
-						pool->stop_priority_th) &&
-				pool->status == FLOW_POOL_NON_PRIO_PAUSED)) {
-			pool->status = FLOW_POOL_ACTIVE_PAUSED;
-			/* pause priority queue */
-			pdev->pause_cb(vdev->vdev_id,
-				       WLAN_NETIF_PRIORITY_QUEUE_OFF,
-				       WLAN_DATA_FLOW_CONTROL_PRIORITY);
+	cnt = ol_tx_flow_pool_mag_alloc(pdev, pool, tx_descs, num);
+	if (!cnt) {
+		qdf_spin_lock_bh(&pool->flow_pool_lock);
+		for (; cnt < num && pool->avail_desc; cnt++) {
+			tx_descs[cnt] = ol_tx_get_desc_flow_pool(pool);
+			ol_tx_desc_dup_detect_set(pdev, tx_descs[cnt]);
+			if (ol_tx_flow_pool_pause_check(pdev, vdev, pool))
+				drain = true;
 		}
-
+		if (!cnt)
+			pool->pkt_drop_no_desc++;
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 
+		if (qdf_unlikely(drain))
+			ol_tx_flow_pool_mag_drain(pdev, pool);
+	}
+
+	for (i = 0; i < cnt; i++) {
+		tx_desc = tx_descs[i];
 		ol_tx_desc_sanity_checks(pdev, tx_desc);
 		ol_tx_desc_compute_delay(tx_desc);
 		ol_tx_desc_update_tx_ts(tx_desc);
 		ol_tx_desc_vdev_update(tx_desc, vdev);
 		qdf_atomic_inc(&tx_desc->ref_cnt);
-	} else {
-		pool->pkt_drop_no_desc++;
-		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 	}
 
-end:
+	return cnt;
+}
+
+/**
+ * ol_tx_desc_alloc() -allocate tx descriptor
+ * @pdev: pdev handler
+ * @vdev: vdev handler
+ * @pool: flow pool
+ *
+ * Return: tx descriptor or NULL
+ */
+static
+struct ol_tx_desc_t *ol_tx_desc_alloc(struct ol_txrx_pdev_t *pdev,
+				      struct ol_txrx_vdev_t *vdev,
+				      struct ol_tx_flow_pool_t *pool)
+{
+	struct ol_tx_desc_t *tx_desc;
+
+	if (!ol_tx_desc_alloc_pool(pdev, vdev, pool, &tx_desc, 1))
+		return NULL;
+
 	return tx_desc;
 }
 
@@ -358,6 +508,13 @@ ol_tx_desc_alloc_wrapper(struct ol_txrx_pdev_t *pdev,
 	return ol_tx_desc_alloc(pdev, vdev, vdev->pool);
 }
 #endif
+
+uint32_t ol_tx_desc_alloc_bulk(struct ol_txrx_pdev_t *pdev,
+			       struct ol_txrx_vdev_t *vdev,
+			       struct ol_tx_desc_t **tx_descs, uint32_t num)
+{
+	return ol_tx_desc_alloc_pool(pdev, vdev, vdev->pool, tx_descs, num);
+}
 #endif
 
 /**
@@ -533,13 +690,23 @@ static void ol_tx_desc_free_common(struct ol_txrx_pdev_t *pdev,
  */
 void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
 {
+	ol_tx_desc_free_bulk(pdev, &tx_desc, 1);
+}
+
+void ol_tx_desc_free_bulk(struct ol_txrx_pdev_t *pdev,
+			  struct ol_tx_desc_t **tx_descs, uint32_t num)
+{
+	uint32_t i;
+
 	qdf_spin_lock_bh(&pdev->tx_mutex);
 
-	ol_tx_desc_free_common(pdev, tx_desc);
+	for (i = 0; i < num; i++) {
+		ol_tx_desc_free_common(pdev, tx_descs[i]);
 
-	ol_tx_put_desc_global_pool(pdev, tx_desc);
-	ol_tx_desc_vdev_rm(tx_desc);
-	ol_tx_do_pdev_flow_control_unpause(pdev);
+		ol_tx_put_desc_global_pool(pdev, tx_descs[i]);
+		ol_tx_desc_vdev_rm(tx_descs[i]);
+		ol_tx_do_pdev_flow_control_unpause(pdev);
+	}
 
 	qdf_spin_unlock_bh(&pdev->tx_mutex);
 }
@@ -580,22 +747,36 @@ static inline bool ol_tx_update_free_desc_to_pool(struct ol_txrx_pdev_t *pdev,
 #endif
 
 /**
- * ol_tx_desc_free() - put descriptor to pool freelist
- * @pdev: pdev handle
- * @tx_desc: tx descriptor
+ * ol_tx_flow_pool_mag_enable_check() - reactivate the pool magazines
+ * @pool: flow pool
+ *
+ * Called with the flow pool lock held, after descriptors were returned to
+ * the pool freelist.
  *
  * Return: None
  */
-void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
+static inline void
+ol_tx_flow_pool_mag_enable_check(struct ol_tx_flow_pool_t *pool)
 {
-	bool distribute_desc = false;
-	struct ol_tx_flow_pool_t *pool = tx_desc->pool;
-
-	qdf_spin_lock_bh(&pool->flow_pool_lock);
-
-	ol_tx_desc_free_common(pdev, tx_desc);
-	distribute_desc = ol_tx_update_free_desc_to_pool(pdev, tx_desc);
+	if (qdf_unlikely(!pool->mag_active) && pool->mags &&
+	    !pool->mag_disabled && ol_tx_flow_pool_mag_usable(pool) &&
+	    pool->avail_desc >= pool->start_th + 2 * OL_TX_FLOW_POOL_MAG_SIZE)
+		pool->mag_active = true;
+}
 
+/**
+ * ol_tx_flow_pool_unpause_check() - unpause netif queues on pool refill
+ * @pdev: pdev handle
+ * @pool: flow pool
+ *
+ * Called with the flow pool lock held, after a descriptor was returned.
+ *
+ * Return: true if the pool is invalid and got all its descriptors back,
+ *	   i.e. it has to be freed once the flow pool lock is released
+ */
+static bool ol_tx_flow_pool_unpause_check(struct ol_txrx_pdev_t *pdev,
+					  struct ol_tx_flow_pool_t *pool)
+{
 	switch (pool->status) {
 	case FLOW_POOL_ACTIVE_PAUSED:
 		if (pool->avail_desc > pool->start_priority_th) {
@@ -615,12 +796,8 @@ void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
 		}
 		break;
 	case FLOW_POOL_INVALID:
-		if (pool->avail_desc == pool->flow_pool_size) {
-			qdf_spin_unlock_bh(&pool->flow_pool_lock);
-			ol_tx_free_invalid_flow_pool(pool);
-			qdf_print("pool is INVALID State!!");
-			return;
-		}
+		if (pool->avail_desc == pool->flow_pool_size)
+			return true;
 		break;
 	case FLOW_POOL_ACTIVE_UNPAUSED:
 		break;
@@ -629,11 +806,195 @@ void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
 		break;
 	};
 
+	return false;
+}
+
+/**
+ * ol_tx_flow_pool_mag_put() - return magazine descriptors to the pool
+ * @pdev: pdev handle
+ * @pool: flow pool
+ * @mag: magazine of @pool, with its lock held
+ * @keep: number of descriptors to leave in @mag
+ * @distribute_desc: set if descriptors went back to the global pool
+ * @free_pool: set if @pool is invalid and got all its descriptors back
+ *
+ * The descriptors go through the same overflow accounting and netif
+ * unpause checks as descriptors freed straight to the pool freelist.
+ * Called with the flow pool lock held.
+ *
+ * Return: None
+ */
+static void ol_tx_flow_pool_mag_put(struct ol_txrx_pdev_t *pdev,
+				    struct ol_tx_flow_pool_t *pool,
+				    struct ol_tx_flow_pool_mag *mag,
+				    uint16_t keep, bool *distribute_desc,
+				    bool *free_pool)
+{
+	while (mag->cnt > keep) {
+		if (ol_tx_update_free_desc_to_pool(pdev,
+						   mag->descs[--mag->cnt]))
+			*distribute_desc = true;
+		if (ol_tx_flow_pool_unpause_check(pdev, pool))
+			*free_pool = true;
+	}
+}
+
+void ol_tx_flow_pool_mag_drain(struct ol_txrx_pdev_t *pdev,
+			       struct ol_tx_flow_pool_t *pool)
+{
+	struct ol_tx_flow_pool_mag *mag;
+	bool distribute_desc = false;
+	bool free_pool = false;
+	unsigned int cpu;
+
+	if (!pool->mags)
+		return;
+
+	/* Nested locks: maintain magazine lock->flow_pool_lock */
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	pool->mag_active = false;
+	pool->mag_drain++;
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
 
+	for (cpu = 0; cpu < nr_cpu_ids; cpu++) {
+		mag = &pool->mags[cpu];
+		qdf_spin_lock_bh(&mag->lock);
+		if (mag->cnt) {
+			qdf_spin_lock_bh(&pool->flow_pool_lock);
+			ol_tx_flow_pool_mag_put(pdev, pool, mag, 0,
+						&distribute_desc, &free_pool);
+			qdf_spin_unlock_bh(&pool->flow_pool_lock);
+		}
+		qdf_spin_unlock_bh(&mag->lock);
+	}
+
+	if (qdf_unlikely(free_pool)) {
+		ol_tx_free_invalid_flow_pool(pool);
+		qdf_print("pool is INVALID State!!");
+	}
+
+	if (unlikely(distribute_desc))
+		ol_tx_distribute_descs_to_deficient_pools_from_global_pool();
+}
+
+/**
+ * ol_tx_flow_pool_mag_free() - free descriptors to the CPU magazine
+ * @pdev: pdev handle
+ * @pool: flow pool of the descriptors
+ * @tx_descs: descriptors to be freed
+ * @num: number of descriptors
+ *
+ * A full magazine gives OL_TX_FLOW_POOL_MAG_XCHG descriptors back to the
+ * pool freelist. If the pool got paused or overflowed since the magazines
+ * were activated, they are drained instead, so the pool accounting and
+ * netif queues are updated for every cached descriptor.
+ *
+ * Return: number of descriptors freed, the remaining ones have to be
+ *	   returned to the pool freelist
+ */
+static uint32_t ol_tx_flow_pool_mag_free(struct ol_txrx_pdev_t *pdev,
+					 struct ol_tx_flow_pool_t *pool,
+					 struct ol_tx_desc_t **tx_descs,
+					 uint32_t num)
+{
+	struct ol_tx_flow_pool_mag *mag;
+	bool distribute_desc = false;
+	bool free_pool = false;
+	uint32_t cnt;
+
+	if (!pool->mag_active)
+		return 0;
+
+	mag = &pool->mags[qdf_get_cpu()];
+	qdf_spin_lock_bh(&mag->lock);
+	/* pairs with the deactivation in ol_tx_flow_pool_mag_drain() */
+	if (!pool->mag_active) {
+		qdf_spin_unlock_bh(&mag->lock);
+		return 0;
+	}
+
+	if (qdf_unlikely(!ol_tx_flow_pool_mag_usable(pool))) {
+		qdf_spin_unlock_bh(&mag->lock);
+		ol_tx_flow_pool_mag_drain(pdev, pool);
+		return 0;
+	}
+
+	for (cnt = 0; cnt < num; cnt++) {
+		if (qdf_unlikely(mag->cnt == OL_TX_FLOW_POOL_MAG_SIZE)) {
+			qdf_spin_lock_bh(&pool->flow_pool_lock);
+			ol_tx_flow_pool_mag_put(pdev, pool, mag,
+						OL_TX_FLOW_POOL_MAG_SIZE -
+						OL_TX_FLOW_POOL_MAG_XCHG,
+						&distribute_desc, &free_pool);
+			pool->mag_xchg++;
+			qdf_spin_unlock_bh(&pool->flow_pool_lock);
+		}
+		ol_tx_desc_free_common(pdev, tx_descs[cnt]);
+		mag->descs[mag->cnt++] = tx_descs[cnt];
+	}
+	qdf_spin_unlock_bh(&mag->lock);
+
+	/*
+	 * free_pool can't be set here: the pool does not get all its
+	 * descriptors back while @tx_descs are being freed to it.
+	 */
 	if (unlikely(distribute_desc))
 		ol_tx_distribute_descs_to_deficient_pools_from_global_pool();
 
+	return cnt;
+}
+
+/**
+ * ol_tx_desc_free() - put descriptor to pool freelist
+ * @pdev: pdev handle
+ * @tx_desc: tx descriptor
+ *
+ * Return: None
+ */
+void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc)
+{
+	ol_tx_desc_free_bulk(pdev, &tx_desc, 1);
+}
+
+void ol_tx_desc_free_bulk(struct ol_txrx_pdev_t *pdev,
+			  struct ol_tx_desc_t **tx_descs, uint32_t num)
+{
+	bool distribute_desc = false;
+	bool free_pool;
+	struct ol_tx_flow_pool_t *pool;
+	uint32_t i = 0, run;
+
+	/* take the pool lock once per run of descriptors of the same pool */
+	while (i < num) {
+		pool = tx_descs[i]->pool;
+		free_pool = false;
+
+		for (run = 1; i + run < num; run++)
+			if (tx_descs[i + run]->pool != pool)
+				break;
+		i += ol_tx_flow_pool_mag_free(pdev, pool, &tx_descs[i], run);
+		if (i == num || tx_descs[i]->pool != pool)
+			continue;
+
+		qdf_spin_lock_bh(&pool->flow_pool_lock);
+		do {
+			ol_tx_desc_free_common(pdev, tx_descs[i]);
+			if (ol_tx_update_free_desc_to_pool(pdev, tx_descs[i]))
+				distribute_desc = true;
+			free_pool = ol_tx_flow_pool_unpause_check(pdev, pool);
+		} while (++i < num && !free_pool &&
+			 tx_descs[i]->pool == pool);
+		ol_tx_flow_pool_mag_enable_check(pool);
+		qdf_spin_unlock_bh(&pool->flow_pool_lock);
+
+		if (qdf_unlikely(free_pool)) {
+			ol_tx_free_invalid_flow_pool(pool);
+			qdf_print("pool is INVALID State!!");
+		}
+	}
+
+	if (unlikely(distribute_desc))
+		ol_tx_distribute_descs_to_deficient_pools_from_global_pool();
 }
 #endif
 
@@ -742,6 +1103,7 @@ struct ol_tx_desc_t *ol_tx_desc_ll(struct ol_txrx_pdev_t *pdev,
 	} else {
 		tx_desc->pkt_type = OL_TX_FRM_STD;
 	}
+	ol_tx_lat_desc_init(tx_desc);
 
 	type = ol_tx_get_ext_header_type(vdev, netbuf);
 
@@ -857,6 +1219,7 @@ ol_tx_desc_hl(
 	tx_desc->netbuf = netbuf;
 	/* fix this - get pkt_type from msdu_info */
 	tx_desc->pkt_type = OL_TX_FRM_STD;
+	ol_tx_lat_desc_init(tx_desc);
 
 #ifdef QCA_SUPPORT_SW_TXRX_ENCAP
 	tx_desc->orig_l2_hdr_bytes = 0;
@@ -870,6 +1233,8 @@ void ol_tx_desc_frame_list_free(struct ol_txrx_pdev_t *pdev,
 				ol_tx_desc_list *tx_descs, int had_error)
 {
 	struct ol_tx_desc_t *tx_desc, *tmp;
+	struct ol_tx_desc_t *free_descs[OL_TX_DESC_BULK_MAX];
+	uint32_t num_free = 0;
 	qdf_nbuf_t msdus = NULL;
 
 	TAILQ_FOREACH_SAFE(tx_desc, tx_descs, tx_desc_list_elem, tmp) {
@@ -892,12 +1257,18 @@ void ol_tx_desc_frame_list_free(struct ol_txrx_pdev_t *pdev,
 					       QDF_DMA_TO_DEVICE);
 		}
 
-		/* free the tx desc */
-		ol_tx_desc_free(pdev, tx_desc);
+		/* free the tx descs as a batch */
+		free_descs[num_free++] = tx_desc;
+		if (num_free == OL_TX_DESC_BULK_MAX) {
+			ol_tx_desc_free_bulk(pdev, free_descs, num_free);
+			num_free = 0;
+		}
 		/* link the netbuf into a list to free as a batch */
 		qdf_nbuf_set_next(msdu, msdus);
 		msdus = msdu;
 	}
+	if (num_free)
+		ol_tx_desc_free_bulk(pdev, free_descs, num_free);
 	/* free the netbufs as a batch */
 	qdf_nbuf_tx_free(msdus, had_error);
 }
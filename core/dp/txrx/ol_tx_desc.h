@@ -34,11 +34,32 @@
 #define MOD_BY_8	0x7
 #define MOD_BY_32	0x1F
 
+/* max number of tx descriptors allocated/freed under one pool lock hold */
+#define OL_TX_DESC_BULK_MAX	16
+
 struct ol_tx_desc_t *
 ol_tx_desc_alloc_wrapper(struct ol_txrx_pdev_t *pdev,
 			 struct ol_txrx_vdev_t *vdev,
 			 struct ol_txrx_msdu_info_t *msdu_info);
 
+/**
+ * ol_tx_desc_alloc_bulk() - allocate data tx descriptors in bulk
+ * @pdev: pdev handle
+ * @vdev: vdev the descriptors are allocated for
+ * @tx_descs: array filled with the allocated descriptors
+ * @num: number of descriptors requested
+ *
+ * Takes up to @num descriptors from the vdev flow pool (or the global
+ * pool without flow control v2) with a single pool lock acquisition.
+ * The descriptors are in the same state as returned by
+ * ol_tx_desc_alloc_wrapper() for a data frame.
+ *
+ * Return: number of descriptors allocated, 0 if the pool is empty
+ */
+uint32_t ol_tx_desc_alloc_bulk(struct ol_txrx_pdev_t *pdev,
+			       struct ol_txrx_vdev_t *vdev,
+			       struct ol_tx_desc_t **tx_descs, uint32_t num);
+
 
 /**
  * @brief Allocate and initialize a tx descriptor for a LL system.
@@ -227,6 +248,20 @@ void *ol_ath_get_bcn_header(struct cdp_cfg *cfg_pdev, A_UINT32 vdev_id);
  */
 void ol_tx_desc_free(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_t *tx_desc);
 
+/**
+ * ol_tx_desc_free_bulk() - free tx descriptors in bulk
+ * @pdev: pdev handle
+ * @tx_descs: descriptors to be freed
+ * @num: number of descriptors
+ *
+ * Same as ol_tx_desc_free() for each descriptor, but the pool lock is
+ * taken once per run of descriptors belonging to the same pool.
+ *
+ * Return: None
+ */
+void ol_tx_desc_free_bulk(struct ol_txrx_pdev_t *pdev,
+			  struct ol_tx_desc_t **tx_descs, uint32_t num);
+
 #if defined(FEATURE_TSO)
 struct qdf_tso_seg_elem_t *ol_tso_alloc_segment(struct ol_txrx_pdev_t *pdev);
 
@@ -301,6 +336,22 @@ int ol_tx_distribute_descs_to_deficient_pools_from_global_pool(void)
 #endif
 
 int ol_tx_free_invalid_flow_pool(struct ol_tx_flow_pool_t *pool);
+
+/**
+ * ol_tx_flow_pool_mag_drain() - return magazine descriptors to the pool
+ * @pdev: pdev handle
+ * @pool: flow pool
+ *
+ * Deactivates the per-CPU magazines of @pool and frees all descriptors
+ * cached in them like ol_tx_desc_free() does, so that avail_desc accounts
+ * for every free descriptor of the pool, overflow descriptors go back to
+ * the global pool and paused netif queues are woken up. An invalid pool
+ * which gets all its descriptors back is freed.
+ *
+ * Return: none
+ */
+void ol_tx_flow_pool_mag_drain(struct ol_txrx_pdev_t *pdev,
+			       struct ol_tx_flow_pool_t *pool);
 /**
  * ol_tx_get_desc_flow_pool() - get descriptor from flow pool
  * @pool: flow pool
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <qdf_nbuf.h>           /* qdf_nbuf_get_priority */
+#include <qdf_mem.h>            /* qdf_mem_zero */
+#include <qdf_atomic.h>         /* qdf_atomic_inc */
+#include <ol_txrx_types.h>      /* ol_txrx_vdev_t, ol_tx_desc_t */
+#include <ol_txrx.h>            /* ol_txrx_get_vdev_from_vdev_id */
+#include <ol_tx_latency.h>
+
+static const char * const ol_tx_lat_stage_name[OL_TX_LAT_STAGE_MAX] = {
+	[OL_TX_LAT_STAGE_TXQ] = "txq",
+	[OL_TX_LAT_STAGE_FW] = "fw",
+	[OL_TX_LAT_STAGE_TOTAL] = "total",
+};
+
+static const char * const ol_tx_lat_ac_name[TXRX_NUM_WMM_AC] = {
+	[TXRX_WMM_AC_BE] = "be",
+	[TXRX_WMM_AC_BK] = "bk",
+	[TXRX_WMM_AC_VI] = "vi",
+	[TXRX_WMM_AC_VO] = "vo",
+};
+
+/**
+ * ol_tx_lat_add() - account an msdu into a histogram bucket
+ * @vdev: vdev owning the histograms
+ * @stage: stage
+ * @ac: access category
+ * @start: start time of the stage in ns
+ * @end: end time of the stage in ns
+ *
+ * Return: none
+ */
+static void ol_tx_lat_add(struct ol_txrx_vdev_t *vdev,
+			  enum ol_tx_lat_stage stage, uint8_t ac,
+			  uint64_t start, uint64_t end)
+{
+	uint64_t delta_ns;
+	uint32_t bucket;
+
+	if (end < start)
+		return;
+
+	delta_ns = end - start;
+	do_div(delta_ns, NSEC_PER_USEC);
+	if (delta_ns >> 32)
+		bucket = OL_TX_LAT_HIST_BUCKETS - 1;
+	else
+		bucket = qdf_min_t(uint32_t, fls((uint32_t)delta_ns),
+				   OL_TX_LAT_HIST_BUCKETS - 1);
+
+	qdf_atomic_inc(&vdev->tx_lat.bucket[stage][ac][bucket]);
+}
+
+void ol_tx_lat_desc_init(struct ol_tx_desc_t *tx_desc)
+{
+	uint64_t now = ol_tx_lat_now();
+
+	tx_desc->lat_start_ts = now;
+	tx_desc->lat_ts = now;
+	tx_desc->lat_ac =
+		TXRX_TID_TO_WMM_AC(qdf_nbuf_get_priority(tx_desc->netbuf) &
+				   0x7);
+}
+
+void ol_tx_lat_download(struct ol_tx_desc_t *tx_desc)
+{
+	uint64_t now;
+
+	if (!tx_desc->lat_ts || !tx_desc->vdev)
+		return;
+
+	now = ol_tx_lat_now();
+	ol_tx_lat_add(tx_desc->vdev, OL_TX_LAT_STAGE_TXQ, tx_desc->lat_ac,
+		      tx_desc->lat_ts, now);
+	tx_desc->lat_ts = now;
+}
+
+void ol_tx_lat_complete(struct ol_tx_desc_t *tx_desc, uint64_t now)
+{
+	struct ol_txrx_vdev_t *vdev = tx_desc->vdev;
+
+	if (!tx_desc->lat_ts)
+		return;
+
+	if (vdev) {
+		ol_tx_lat_add(vdev, OL_TX_LAT_STAGE_FW, tx_desc->lat_ac,
+			      tx_desc->lat_ts, now);
+		ol_tx_lat_add(vdev, OL_TX_LAT_STAGE_TOTAL, tx_desc->lat_ac,
+			      tx_desc->lat_start_ts, now);
+	}
+
+	/* Descriptors may be reused for frames which are not tracked */
+	tx_desc->lat_ts = 0;
+}
+
+uint32_t ol_tx_lat_percentile(uint8_t vdev_id, enum ol_tx_lat_stage stage,
+			      uint8_t ac, uint8_t pct)
+{
+	struct ol_txrx_vdev_t *vdev;
+	uint32_t bucket[OL_TX_LAT_HIST_BUCKETS];
+	uint64_t total = 0, target, sum = 0;
+	int i;
+
+	if (stage >= OL_TX_LAT_STAGE_MAX || ac >= TXRX_NUM_WMM_AC)
+		return 0;
+
+	vdev = (struct ol_txrx_vdev_t *)ol_txrx_get_vdev_from_vdev_id(vdev_id);
+	if (!vdev)
+		return 0;
+
+	for (i = 0; i < OL_TX_LAT_HIST_BUCKETS; i++) {
+		bucket[i] = qdf_atomic_read(&vdev->tx_lat.bucket[stage][ac][i]);
+		total += bucket[i];
+	}
+	if (!total)
+		return 0;
+
+	target = total * qdf_min_t(uint8_t, pct, 100) + 99;
+	do_div(target, 100);
+	for (i = 0; i < OL_TX_LAT_HIST_BUCKETS - 1; i++) {
+		sum += bucket[i];
+		if (sum >= target)
+			break;
+	}
+
+	return 1 << i;
+}
+
+int ol_tx_lat_hist_print(uint8_t vdev_id, char *buf, int size)
+{
+	struct ol_txrx_vdev_t *vdev;
+	qdf_atomic_t *bucket;
+	int len, stage, ac, i;
+
+	vdev = (struct ol_txrx_vdev_t *)ol_txrx_get_vdev_from_vdev_id(vdev_id);
+	if (!vdev)
+		return 0;
+
+	len = scnprintf(buf, size,
+			"tx latency vdev %u, log2(us) buckets 0..%u\n",
+			vdev_id, OL_TX_LAT_HIST_BUCKETS - 1);
+
+	for (stage = 0; stage < OL_TX_LAT_STAGE_MAX; stage++) {
+		for (ac = 0; ac < TXRX_NUM_WMM_AC; ac++) {
+			bucket = vdev->tx_lat.bucket[stage][ac];
+			for (i = 0; i < OL_TX_LAT_HIST_BUCKETS; i++)
+				if (qdf_atomic_read(&bucket[i]))
+					break;
+			if (i == OL_TX_LAT_HIST_BUCKETS)
+				continue;
+
+			len += scnprintf(buf + len, size - len, "%s ac %s:",
+					 ol_tx_lat_stage_name[stage],
+					 ol_tx_lat_ac_name[ac]);
+			for (i = 0; i < OL_TX_LAT_HIST_BUCKETS; i++)
+				len += scnprintf(buf + len, size - len, " %u",
+						 qdf_atomic_read(&bucket[i]));
+			len += scnprintf(buf + len, size - len, "\n");
+		}
+	}
+
+	return len;
+}
+
+void ol_tx_lat_hist_clear(struct ol_txrx_pdev_t *pdev)
+{
+	struct ol_txrx_vdev_t *vdev;
+
+	TAILQ_FOREACH(vdev, &pdev->vdev_list, vdev_list_elem)
+		qdf_mem_zero(&vdev->tx_lat, sizeof(vdev->tx_lat));
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: ol_tx_latency.h
+ *
+ * Per-stage tx latency histograms. txrx stamps the tx descriptor at
+ * setup along with the access category of the frame priority, and moves
+ * the stamp along at download and completion, recording every stage into
+ * a per vdev/AC log2 histogram. Completions are stamped once per HTT
+ * completion indication. The frames themselves are not touched.
+ */
+
+#ifndef _OL_TX_LATENCY__H_
+#define _OL_TX_LATENCY__H_
+
+#include <ol_txrx_types.h>      /* ol_tx_desc_t, ol_tx_lat_stage */
+
+#ifdef WLAN_TX_LATENCY_HIST
+/**
+ * ol_tx_lat_now() - get the time base of the tx latency histograms
+ *
+ * Return: monotonic time in ns
+ */
+static inline uint64_t ol_tx_lat_now(void)
+{
+	return ktime_get_ns();
+}
+
+/**
+ * ol_tx_lat_desc_init() - start tracking a tx descriptor
+ * @tx_desc: tx descriptor, with its vdev and netbuf set
+ *
+ * The timestamps are kept in the descriptor, the netbuf is not touched.
+ * The access category is taken from the netbuf priority, which HDD has
+ * already downgraded if admission control required it.
+ *
+ * Return: none
+ */
+void ol_tx_lat_desc_init(struct ol_tx_desc_t *tx_desc);
+
+/**
+ * ol_tx_lat_download() - record the OL_TX_LAT_STAGE_TXQ stage
+ * @tx_desc: tx descriptor about to be downloaded to the target
+ *
+ * Return: none
+ */
+void ol_tx_lat_download(struct ol_tx_desc_t *tx_desc);
+
+/**
+ * ol_tx_lat_complete() - record the completion stages of a tx descriptor
+ * @tx_desc: completed tx descriptor
+ * @now: time the completion indication was received, from ol_tx_lat_now()
+ *
+ * Return: none
+ */
+void ol_tx_lat_complete(struct ol_tx_desc_t *tx_desc, uint64_t now);
+
+/**
+ * ol_tx_lat_percentile() - get a latency percentile of a histogram
+ * @vdev_id: vdev id
+ * @stage: stage
+ * @ac: access category, enum txrx_wmm_ac
+ * @pct: percentile, 1 to 100
+ *
+ * Return: upper bound in us of the bucket holding the percentile, or 0 if
+ * the histogram is empty
+ */
+uint32_t ol_tx_lat_percentile(uint8_t vdev_id, enum ol_tx_lat_stage stage,
+			      uint8_t ac, uint8_t pct);
+
+/**
+ * ol_tx_lat_hist_print() - print the non-empty histograms of a vdev
+ * @vdev_id: vdev id
+ * @buf: output buffer
+ * @size: size of @buf
+ *
+ * Return: number of characters written to @buf
+ */
+int ol_tx_lat_hist_print(uint8_t vdev_id, char *buf, int size);
+
+/**
+ * ol_tx_lat_hist_clear() - reset the histograms of all vdevs of a pdev
+ * @pdev: txrx pdev
+ *
+ * Return: none
+ */
+void ol_tx_lat_hist_clear(struct ol_txrx_pdev_t *pdev);
+#else
+static inline uint64_t ol_tx_lat_now(void)
+{
+	return 0;
+}
+
+static inline void ol_tx_lat_desc_init(struct ol_tx_desc_t *tx_desc)
+{
+}
+
+static inline void ol_tx_lat_download(struct ol_tx_desc_t *tx_desc)
+{
+}
+
+static inline
+void ol_tx_lat_complete(struct ol_tx_desc_t *tx_desc, uint64_t now)
+{
+}
+
+static inline
+uint32_t ol_tx_lat_percentile(uint8_t vdev_id, enum ol_tx_lat_stage stage,
+			      uint8_t ac, uint8_t pct)
+{
+	return 0;
+}
+
+static inline int ol_tx_lat_hist_print(uint8_t vdev_id, char *buf, int size)
+{
+	return 0;
+}
+
+static inline void ol_tx_lat_hist_clear(struct ol_txrx_pdev_t *pdev)
+{
+}
+#endif /* WLAN_TX_LATENCY_HIST */
+
+#endif /* _OL_TX_LATENCY__H_ */
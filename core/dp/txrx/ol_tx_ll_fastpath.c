@@ -29,6 +29,7 @@
 #include <ol_txrx_internal.h>   /* TXRX_ASSERT1 */
 #include <ol_tx_desc.h>         /* ol_tx_desc */
 #include <ol_tx_send.h>         /* ol_tx_send */
+#include <ol_tx_latency.h>      /* ol_tx_lat_desc_init */
 #include <ol_txrx.h>
 
 /* internal header files relevant only for HL systems */
@@ -154,33 +155,109 @@ ol_tx_tso_adjust_pkt_dnld_len(qdf_nbuf_t msdu,
 #endif
 
 /**
- * ol_tx_prepare_ll_fast() Alloc and prepare Tx descriptor
+ * struct ol_tx_desc_bulk - tx descriptors allocated for a msdu list
+ * @descs: descriptors taken from the flow pool
+ * @cnt: number of descriptors in @descs
+ * @idx: index of the next unused descriptor in @descs
+ */
+struct ol_tx_desc_bulk {
+	struct ol_tx_desc_t *descs[OL_TX_DESC_BULK_MAX];
+	uint32_t cnt;
+	uint32_t idx;
+};
+
+/**
+ * ol_tx_desc_bulk_get() - get a tx descriptor for the next msdu
+ * @pdev: pointer to ol pdev handle
+ * @vdev: pointer to ol vdev handle
+ * @bulk: descriptors allocated for the msdu list
+ * @num_pending: number of descriptors still needed for the msdu list,
+ *	including this one
+ *
+ * Refills @bulk from the flow pool with a single lock acquisition when
+ * all its descriptors are used.
+ *
+ * Return: tx descriptor, NULL if the flow pool is empty
+ */
+static inline struct ol_tx_desc_t *
+ol_tx_desc_bulk_get(struct ol_txrx_pdev_t *pdev, ol_txrx_vdev_handle vdev,
+		    struct ol_tx_desc_bulk *bulk, uint32_t num_pending)
+{
+	if (qdf_unlikely(bulk->idx == bulk->cnt)) {
+		bulk->idx = 0;
+		if (num_pending > OL_TX_DESC_BULK_MAX)
+			num_pending = OL_TX_DESC_BULK_MAX;
+		bulk->cnt = ol_tx_desc_alloc_bulk(pdev, vdev, bulk->descs,
+						  num_pending);
+		if (qdf_unlikely(!bulk->cnt))
+			return NULL;
+	}
+
+	return bulk->descs[bulk->idx++];
+}
+
+/**
+ * ol_tx_desc_bulk_put() - return the unused tx descriptors to the pool
+ * @pdev: pointer to ol pdev handle
+ * @bulk: descriptors allocated for the msdu list
+ *
+ * Return: None
+ */
+static inline void
+ol_tx_desc_bulk_put(struct ol_txrx_pdev_t *pdev, struct ol_tx_desc_bulk *bulk)
+{
+	if (bulk->idx < bulk->cnt)
+		ol_tx_desc_free_bulk(pdev, &bulk->descs[bulk->idx],
+				     bulk->cnt - bulk->idx);
+	bulk->idx = 0;
+	bulk->cnt = 0;
+}
+
+/**
+ * ol_tx_msdu_list_len() - number of msdus in a msdu list
+ * @msdu_list: msdu list
+ *
+ * Return: length of the list
+ */
+static inline uint32_t ol_tx_msdu_list_len(qdf_nbuf_t msdu_list)
+{
+	uint32_t len = 0;
+
+	for (; msdu_list; msdu_list = qdf_nbuf_next(msdu_list))
+		len++;
+
+	return len;
+}
+
+/**
+ * ol_tx_prepare_ll_fast() Prepare Tx descriptor
  *
- * Allocate and prepare Tx descriptor with msdu and fragment descritor
+ * Prepare Tx descriptor with msdu and fragment descritor
  * inforamtion.
  *
  * @pdev: pointer to ol pdev handle
  * @vdev: pointer to ol vdev handle
  * @msdu: linked list of msdu packets
+ * @tx_desc: Tx descriptor allocated for the msdu
  * @pkt_download_len: packet download length
  * @ep_id: endpoint ID
  * @msdu_info: Handle to msdu_info
  *
- * Return: Pointer to Tx descriptor
+ * Return: Pointer to Tx descriptor, NULL if it could not be prepared
+ *	   (the Tx descriptor is freed then)
  */
 static inline struct ol_tx_desc_t *
 ol_tx_prepare_ll_fast(struct ol_txrx_pdev_t *pdev,
 		      ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu,
+		      struct ol_tx_desc_t *tx_desc,
 		      uint32_t *pkt_download_len, uint32_t ep_id,
 		      struct ol_txrx_msdu_info_t *msdu_info)
 {
-	struct ol_tx_desc_t *tx_desc = NULL;
 	uint32_t *htt_tx_desc;
 	void *htc_hdr_vaddr;
 	u_int32_t num_frags, i;
 	enum extension_header_type type;
 
-	tx_desc = ol_tx_desc_alloc_wrapper(pdev, vdev, msdu_info);
 	if (qdf_unlikely(!tx_desc))
 		return NULL;
 
@@ -196,6 +273,7 @@ ol_tx_prepare_ll_fast(struct ol_txrx_pdev_t *pdev,
 	} else {
 		tx_desc->pkt_type = OL_TX_FRM_STD;
 	}
+	ol_tx_lat_desc_init(tx_desc);
 
 	htt_tx_desc = tx_desc->htt_tx_desc;
 
@@ -340,6 +418,8 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 	uint32_t ep_id = HTT_EPID_GET(pdev->htt_pdev);
 	struct ol_txrx_msdu_info_t msdu_info;
 	uint32_t tso_msdu_stats_idx = 0;
+	struct ol_tx_desc_bulk bulk = { .cnt = 0, .idx = 0 };
+	uint32_t msdus_pending = ol_tx_msdu_list_len(msdu_list);
 
 	qdf_mem_zero(&msdu_info, sizeof(msdu_info));
 	msdu_info.htt.info.l2_hdr_type = vdev->pdev->htt_pkt_type;
@@ -363,6 +443,7 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 			TXRX_STATS_MSDU_LIST_INCR(vdev->pdev,
 						  tx.dropped.host_reject,
 						  msdu);
+			ol_tx_desc_bulk_put(pdev, &bulk);
 			return msdu;
 		}
 
@@ -422,7 +503,11 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 
 			pkt_download_len = ((struct htt_pdev_t *)
 					(pdev->htt_pdev))->download_len;
+			tx_desc = ol_tx_desc_bulk_get(pdev, vdev, &bulk,
+						      segments +
+						      msdus_pending);
 			tx_desc = ol_tx_prepare_ll_fast(pdev, vdev, msdu,
+							tx_desc,
 							&pkt_download_len,
 							ep_id, &msdu_info);
 
@@ -496,6 +581,7 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 					ol_tx_desc_frame_free_nonstd(pdev,
 						tx_desc,
 						htt_tx_status_download_fail);
+					ol_tx_desc_bulk_put(pdev, &bulk);
 					return msdu;
 				}
 				if (msdu_info.tso_info.curr_seg)
@@ -520,13 +606,16 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 				}
 				TXRX_STATS_MSDU_LIST_INCR(
 					pdev, tx.dropped.host_reject, msdu);
+				ol_tx_desc_bulk_put(pdev, &bulk);
 				/* the list of unaccepted MSDUs */
 				return msdu;
 			}
 		} /* while segments */
 
 		msdu = next;
+		msdus_pending--;
 	} /* while msdus */
+	ol_tx_desc_bulk_put(pdev, &bulk);
 	return NULL; /* all MSDUs were accepted */
 }
 #else
@@ -538,6 +627,8 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 	uint32_t pkt_download_len;
 	uint32_t ep_id = HTT_EPID_GET(pdev->htt_pdev);
 	struct ol_txrx_msdu_info_t msdu_info;
+	struct ol_tx_desc_bulk bulk = { .cnt = 0, .idx = 0 };
+	uint32_t msdus_pending = ol_tx_msdu_list_len(msdu_list);
 
 	msdu_info.htt.info.l2_hdr_type = vdev->pdev->htt_pkt_type;
 	msdu_info.htt.action.tx_comp_req = 0;
@@ -577,7 +668,9 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 
 		pkt_download_len = ((struct htt_pdev_t *)
 				(pdev->htt_pdev))->download_len;
-		tx_desc = ol_tx_prepare_ll_fast(pdev, vdev, msdu,
+		tx_desc = ol_tx_desc_bulk_get(pdev, vdev, &bulk,
+					      msdus_pending);
+		tx_desc = ol_tx_prepare_ll_fast(pdev, vdev, msdu, tx_desc,
 						&pkt_download_len, ep_id,
 						&msdu_info);
 
@@ -609,16 +702,20 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 				 * caller
 				 */
 				ol_tx_desc_free(pdev, tx_desc);
+				ol_tx_desc_bulk_put(pdev, &bulk);
 				return msdu;
 			}
 			msdu = next;
+			msdus_pending--;
 		} else {
 			TXRX_STATS_MSDU_LIST_INCR(
 				pdev, tx.dropped.host_reject, msdu);
+			ol_tx_desc_bulk_put(pdev, &bulk);
 			return msdu; /* the list of unaccepted MSDUs */
 		}
 	}
 
+	ol_tx_desc_bulk_put(pdev, &bulk);
 	return NULL; /* all MSDUs were accepted */
 }
 #endif /* FEATURE_TSO */
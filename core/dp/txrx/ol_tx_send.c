@@ -46,6 +46,7 @@
 
 #include <ol_cfg.h>             /* ol_cfg_is_high_latency */
 #include <ol_tx_sched.h>
+#include <ol_tx_latency.h>      /* ol_tx_lat_complete */
 #ifdef QCA_SUPPORT_SW_TXRX_ENCAP
 #include <ol_txrx_encap.h>      /* OL_TX_RESTORE_HDR, etc */
 #endif
@@ -168,6 +169,7 @@ ol_tx_send_base(struct ol_txrx_pdev_t *pdev,
 	msdu_credit_consumed = htt_tx_msdu_credit(msdu);
 	ol_tx_target_credit_decr_int(pdev, msdu_credit_consumed);
 	OL_TX_CREDIT_RECLAIM(pdev);
+	ol_tx_lat_download(tx_desc);
 
 	/*
 	 * When the tx frame is downloaded to the target, there are two
@@ -1017,6 +1019,7 @@ ol_tx_completion_handler(ol_txrx_pdev_handle pdev,
 	uint64_t tx_tsf64;
 	uint8_t tid;
 	uint8_t dp_status;
+	uint64_t lat_now = ol_tx_lat_now();
 
 	TAILQ_INIT(&tx_descs);
 
@@ -1049,6 +1052,7 @@ ol_tx_completion_handler(ol_txrx_pdev_handle pdev,
 		tx_desc = ol_tx_desc_find(pdev, tx_desc_id);
 		qdf_assert(tx_desc);
 		ol_tx_desc_update_comp_ts(tx_desc);
+		ol_tx_lat_complete(tx_desc, lat_now);
 		tx_desc->status = status;
 		netbuf = tx_desc->netbuf;
 
@@ -53,6 +53,8 @@
 #include <ol_rx_fwd.h>          /* ol_rx_fwd_check, etc. */
 #include <ol_rx_reorder_timeout.h>      /* OL_RX_REORDER_TIMEOUT_INIT, etc. */
 #include <ol_rx_reorder.h>
+#include <ol_rx_latency.h>      /* ol_rx_lat_hist_clear */
+#include <ol_tx_latency.h>      /* ol_tx_lat_hist_clear */
 #include <ol_tx_send.h>         /* ol_tx_discard_target_frms */
 #include <ol_tx_desc.h>         /* ol_tx_desc_frame_free */
 #include <ol_tx_queue.h>
@@ -1084,6 +1086,9 @@ static inline void ol_txrx_pdev_set_threshold(struct ol_txrx_pdev_t *pdev)
 }
 #endif
 
+static void
+ol_rx_data_cb(void *context, qdf_nbuf_t buf_list, uint16_t staid);
+
 /**
  * ol_txrx_pdev_post_attach() - attach txrx pdev
  * @soc_hdl: datapath soc handle
@@ -1550,6 +1555,8 @@ ol_txrx_pdev_post_attach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id)
 
 	ol_tx_register_flow_control(pdev);
 
+	cds_register_ol_rx_cb(ol_rx_data_cb, pdev);
+
 	return 0;            /* success */
 
 pn_trace_attach_fail:
@@ -1704,6 +1711,8 @@ static void ol_txrx_pdev_pre_detach(struct cdp_soc_t *soc_hdl, uint8_t pdev_id,
 	/* check that the pdev has no vdevs allocated */
 	TXRX_ASSERT1(TAILQ_EMPTY(&pdev->vdev_list));
 
+	cds_register_ol_rx_cb(NULL, NULL);
+
 #ifdef QCA_SUPPORT_TX_THROTTLE
 	/* Thermal Mitigation */
 	qdf_timer_stop(&pdev->tx_throttle.phase_timer);
@@ -3381,7 +3390,7 @@ int ol_txrx_peer_release_ref(ol_txrx_peer_handle peer,
 		    pdev->self_peer == peer)
 			pdev->self_peer = NULL;
 
-		qdf_mem_free(peer);
+		ol_txrx_peer_free(peer);
 	} else {
 		access_list = qdf_atomic_read(&peer->access_list[debug_id]);
 		qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
@@ -3855,6 +3864,27 @@ uint32_t ol_txrx_get_tx_pending(struct cdp_pdev *ppdev)
 	return total - ol_tx_get_total_free_desc(pdev);
 }
 
+#ifdef CDP_MISC_RX_RING_DEFICIT
+/**
+ * ol_txrx_rx_ring_deficit() - share of the rx ring waiting for buffers
+ * @soc_hdl: Datapath soc handle
+ * @pdev_id: id of data path pdev handle
+ *
+ * Return: rx buffers owed to the rx ring, in percent of its fill level
+ */
+static uint32_t ol_txrx_rx_ring_deficit(struct cdp_soc_t *soc_hdl,
+					uint8_t pdev_id)
+{
+	struct ol_txrx_soc_t *soc = cdp_soc_t_to_ol_txrx_soc_t(soc_hdl);
+	ol_txrx_pdev_handle pdev = ol_txrx_get_pdev_from_pdev_id(soc, pdev_id);
+
+	if (!pdev)
+		return 0;
+
+	return htt_rx_ring_deficit(pdev->htt_pdev);
+}
+#endif
+
 void ol_txrx_discard_tx_pending(ol_txrx_pdev_handle pdev_handle)
 {
 	ol_tx_desc_list tx_descs;
@@ -4835,6 +4865,7 @@ ol_txrx_display_stats(struct cdp_soc_t *soc_hdl, uint16_t value,
 		break;
 	case CDP_WLAN_RX_BUF_DEBUG_STATS:
 		htt_display_rx_buf_debug(pdev->htt_pdev);
+		htt_rx_hash_stats_display(pdev->htt_pdev);
 		break;
 #ifdef CONFIG_HL_SUPPORT
 	case CDP_SCHEDULER_STATS:
@@ -4887,6 +4918,8 @@ static QDF_STATUS ol_txrx_clear_stats(struct cdp_soc_t *soc_hdl,
 	switch (value) {
 	case CDP_TXRX_PATH_STATS:
 		ol_txrx_stats_clear(pdev);
+		ol_rx_lat_hist_clear(pdev);
+		ol_tx_lat_hist_clear(pdev);
 		break;
 	case CDP_TXRX_TSO_STATS:
 		ol_txrx_tso_stats_clear(pdev);
@@ -5038,7 +5071,7 @@ free_buf:
  *
  * Return: None
  */
-static inline void
+static void
 ol_rx_data_cb(void *context, qdf_nbuf_t buf_list, uint16_t staid)
 {
 	struct ol_txrx_pdev_t *pdev = context;
@@ -5124,11 +5157,12 @@ static QDF_STATUS ol_txrx_enqueue_rx_frames(
 /**
  * ol_rx_data_process() - process rx frame
  * @peer: peer
+ * @tid: TID of the frames
  * @rx_buf_list: rx buffer list
  *
  * Return: None
  */
-void ol_rx_data_process(struct ol_txrx_peer_t *peer,
+void ol_rx_data_process(struct ol_txrx_peer_t *peer, uint8_t tid,
 			qdf_nbuf_t rx_buf_list)
 {
 	struct ol_txrx_soc_t *soc = cds_get_context(QDF_MODULE_ID_SOC);
@@ -5181,20 +5215,17 @@ void ol_rx_data_process(struct ol_txrx_peer_t *peer,
 		} else {
 			p_cds_sched_context sched_ctx =
 				get_cds_sched_ctxt();
-			struct cds_ol_rx_pkt *pkt;
+			QDF_STATUS status;
 
 			if (unlikely(!sched_ctx))
 				goto drop_rx_buf;
 
-			pkt = cds_alloc_ol_rx_pkt(sched_ctx);
-			if (!pkt)
+			status = cds_indicate_rx_nbuf_list(sched_ctx,
+							   rx_buf_list,
+							   peer->local_id,
+							   tid);
+			if (QDF_IS_STATUS_ERROR(status))
 				goto drop_rx_buf;
-
-			pkt->callback = ol_rx_data_cb;
-			pkt->context = pdev;
-			pkt->Rxpkt = rx_buf_list;
-			pkt->staId = peer->local_id;
-			cds_indicate_rxpkt(sched_ctx, pkt);
 		}
 #else                           /* QCA_CONFIG_SMP */
 		ol_rx_data_handler(pdev, rx_buf_list, peer->local_id);
@@ -6164,6 +6195,9 @@ static struct cdp_misc_ops ol_ops_misc = {
 	.update_mac_id = ol_txrx_update_mac_id,
 	.flush_rx_frames = ol_txrx_wrapper_flush_rx_frames,
 	.get_intra_bss_fwd_pkts_count = ol_get_intra_bss_fwd_pkts_count,
+#ifdef CDP_MISC_RX_RING_DEFICIT
+	.get_rx_ring_deficit = ol_txrx_rx_ring_deficit,
+#endif
 	.pkt_log_init = htt_pkt_log_init,
 	.pkt_log_con_service = ol_txrx_pkt_log_con_service,
 	.register_pktdump_cb = ol_register_packetdump_callback,
@@ -83,6 +83,72 @@ ol_tx_deregister_global_mgmt_pool(struct ol_txrx_pdev_t *pdev)
 }
 #endif
 
+/**
+ * ol_tx_flow_pool_mag_init() - allocate the per-CPU magazines of a pool
+ * @pool: flow pool
+ *
+ * The magazines are activated by the first descriptor free which finds
+ * the pool unpaused with enough descriptors. The pool works without
+ * magazines if the allocation fails.
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_mag_init(struct ol_tx_flow_pool_t *pool)
+{
+	unsigned int cpu;
+
+	pool->mag_active = false;
+	pool->mag_disabled = false;
+	pool->mags = qdf_mem_malloc(nr_cpu_ids * sizeof(*pool->mags));
+	if (!pool->mags)
+		return;
+
+	for (cpu = 0; cpu < nr_cpu_ids; cpu++)
+		qdf_spinlock_create(&pool->mags[cpu].lock);
+}
+
+/**
+ * ol_tx_flow_pool_mag_deinit() - free the per-CPU magazines of a pool
+ * @pool: flow pool, with all magazines drained
+ *
+ * Return: none
+ */
+static void ol_tx_flow_pool_mag_deinit(struct ol_tx_flow_pool_t *pool)
+{
+	unsigned int cpu;
+
+	if (!pool->mags)
+		return;
+
+	for (cpu = 0; cpu < nr_cpu_ids; cpu++)
+		qdf_spinlock_destroy(&pool->mags[cpu].lock);
+
+	qdf_mem_free(pool->mags);
+	pool->mags = NULL;
+}
+
+/**
+ * ol_tx_flow_pool_mag_count() - free descriptors cached in magazines
+ * @pool: flow pool
+ *
+ * Lockless snapshot, for statistics and estimates only.
+ *
+ * Return: number of descriptors in the per-CPU magazines of the pool
+ */
+static uint32_t ol_tx_flow_pool_mag_count(struct ol_tx_flow_pool_t *pool)
+{
+	uint32_t count = 0;
+	unsigned int cpu;
+
+	if (!pool->mags)
+		return 0;
+
+	for (cpu = 0; cpu < nr_cpu_ids; cpu++)
+		count += READ_ONCE(pool->mags[cpu].cnt);
+
+	return count;
+}
+
 bool ol_txrx_fwd_desc_thresh_check(struct ol_txrx_vdev_t *txrx_vdev)
 {
 	struct ol_tx_flow_pool_t *pool;
@@ -97,8 +163,9 @@ bool ol_txrx_fwd_desc_thresh_check(struct ol_txrx_vdev_t *txrx_vdev)
 		return false;
 
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
-	enough_desc_flag = (pool->avail_desc < (pool->stop_th +
-				OL_TX_NON_FWD_RESERVE))
+	enough_desc_flag = (pool->avail_desc +
+			    ol_tx_flow_pool_mag_count(pool) <
+			    (pool->stop_th + OL_TX_NON_FWD_RESERVE))
 		? false : true;
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
 	return enough_desc_flag;
@@ -149,6 +216,7 @@ uint32_t ol_tx_get_total_free_desc(struct ol_txrx_pdev_t *pdev)
 		qdf_spin_lock_bh(&pool->flow_pool_lock);
 		free_desc += pool->avail_desc;
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
+		free_desc += ol_tx_flow_pool_mag_count(pool);
 	}
 	qdf_spin_unlock_bh(&pdev->tx_desc.flow_pool_list_lock);
 
@@ -244,6 +312,17 @@ static int ol_tx_delete_flow_pool(struct ol_tx_flow_pool_t *pool, bool force)
 		return -ENOMEM;
 	}
 
+	/*
+	 * Turn the magazines off for good before getting back the
+	 * descriptors cached in them, so that concurrent frees can not
+	 * reactivate and refill them once they are drained.
+	 */
+	qdf_spin_lock_bh(&pool->flow_pool_lock);
+	pool->mag_active = false;
+	pool->mag_disabled = true;
+	qdf_spin_unlock_bh(&pool->flow_pool_lock);
+	ol_tx_flow_pool_mag_drain(pdev, pool);
+
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
 	if (pool->avail_desc == pool->flow_pool_size || force == true)
 		pool->status = FLOW_POOL_INACTIVE;
@@ -259,6 +338,7 @@ static int ol_tx_delete_flow_pool(struct ol_tx_flow_pool_t *pool, bool force)
 	if (pool->status == FLOW_POOL_INACTIVE) {
 		qdf_spin_unlock_bh(&pool->flow_pool_lock);
 		/* Free flow_pool */
+		ol_tx_flow_pool_mag_deinit(pool);
 		qdf_spinlock_destroy(&pool->flow_pool_lock);
 		qdf_mem_free(pool);
 	} else { /* FLOW_POOL_INVALID case*/
@@ -476,6 +556,10 @@ void ol_tx_dump_flow_pool_info(struct cdp_soc_t *soc_hdl)
 			       tmp_pool.start_th, tmp_pool.stop_th,
 			       tmp_pool.start_priority_th,
 			       tmp_pool.stop_priority_th);
+		txrx_nofl_info("magazines: %s cached %u exchanges %u drains %u",
+			       tmp_pool.mag_active ? "active" : "inactive",
+			       ol_tx_flow_pool_mag_count(pool),
+			       tmp_pool.mag_xchg, tmp_pool.mag_drain);
 		pool_prev = pool;
 		qdf_spin_lock_bh(&pdev->tx_desc.flow_pool_list_lock);
 	}
@@ -681,6 +765,7 @@ struct ol_tx_flow_pool_t *ol_tx_create_flow_pool(uint8_t flow_pool_id,
 	qdf_spinlock_create(&pool->flow_pool_lock);
 	qdf_atomic_init(&pool->ref_cnt);
 	ol_tx_inc_pool_ref(pool);
+	ol_tx_flow_pool_mag_init(pool);
 
 	/* Take TX descriptor from global_pool and put it in temp_list*/
 	qdf_spin_lock_bh(&pdev->tx_mutex);
@@ -1195,6 +1280,9 @@ static void ol_tx_flow_pool_resize(struct ol_tx_flow_pool_t *pool,
 	}
 	qdf_spin_unlock_bh(&pool->flow_pool_lock);
 
+	/* resize accounting needs all free descriptors in the freelist */
+	ol_tx_flow_pool_mag_drain(pdev, pool);
+
 	/* Reduce pool size */
 	/* start_priority_th desc should available after reduction */
 	qdf_spin_lock_bh(&pool->flow_pool_lock);
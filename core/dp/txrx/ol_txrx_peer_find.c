@@ -23,6 +23,7 @@
 #include <qdf_types.h>          /* qdf_device_t, qdf_print */
 /* header files for utilities */
 #include "queue.h"         /* TAILQ */
+#include <linux/rcupdate.h>   /* rcu_read_lock, call_rcu */
 
 /* header files for configuration API */
 #include <ol_cfg.h>             /* ol_cfg_max_peer_id */
@@ -89,55 +90,81 @@ int ol_txrx_peer_get_ref(struct ol_txrx_peer_t *peer,
  * TXRX_PEER_HASH_LOAD_FACTOR:
  * Multiply by 2 and divide by 2^0 (shift by 0), then round up to a
  * power of two.
- * This provides at least twice as many bins in the peer hash table
- * as there will be entries.
- * Having substantially more bins than spaces minimizes the probability of
- * having to compare MAC addresses.
- * Because the MAC address comparison is fairly efficient, it is okay if the
- * hash table is sparsely loaded, but it's generally better to use extra mem
- * to keep the table sparse, to keep the lookups as fast as possible.
- * An optimization would be to apply a more conservative loading factor for
- * high latency, where the lookup happens during the tx classification of
- * every tx frame, than for low-latency, where the lookup only happens
- * during association, when the PEER_MAP message is received.
+ * This provides at least twice as many slots in the peer hash table
+ * as there will be entries, which keeps the linear probing sequences
+ * short; a lookup normally touches the home slot and maybe its
+ * neighbour, within one or two cache lines.
+ * The MAC address is stored in the slot next to the peer pointer, so the
+ * peer objects of colliding entries are not touched during a lookup.
  */
 #define TXRX_PEER_HASH_LOAD_MULT  2
 #define TXRX_PEER_HASH_LOAD_SHIFT 0
 
+/*
+ * Rebuild the table once live plus deleted slots exceed 3/4 of it, to
+ * bound the probing length and keep a free slot for every lookup.
+ */
+#define TXRX_PEER_HASH_REBUILD_NUM 3
+#define TXRX_PEER_HASH_REBUILD_SHIFT 2
+
+static struct ol_txrx_peer_hash_tbl *
+ol_txrx_peer_hash_tbl_alloc(unsigned int hash_elems, bool atomic)
+{
+	struct ol_txrx_peer_hash_tbl *tbl;
+	qdf_size_t size;
+	int log2;
+
+	log2 = ol_txrx_log2_ceil(hash_elems);
+	hash_elems = 1 << log2;
+	size = sizeof(*tbl) + hash_elems * sizeof(tbl->slots[0]);
+
+	if (atomic)
+		tbl = qdf_mem_malloc_atomic(size);
+	else
+		tbl = qdf_mem_malloc(size);
+	if (!tbl)
+		return NULL;
+
+	tbl->mask = hash_elems - 1;
+	tbl->idx_bits = log2;
+
+	return tbl;
+}
+
+static void ol_txrx_peer_hash_tbl_free_rcu(struct rcu_head *rcu)
+{
+	qdf_mem_free(container_of(rcu, struct ol_txrx_peer_hash_tbl, rcu));
+}
+
 static int ol_txrx_peer_find_hash_attach(struct ol_txrx_pdev_t *pdev)
 {
-	int i, hash_elems, log2;
+	struct ol_txrx_peer_hash_tbl *tbl;
+	int hash_elems;
 
 	/* allocate the peer MAC address -> peer object hash table */
 	hash_elems = ol_cfg_max_peer_id(pdev->ctrl_pdev) + 1;
 	hash_elems *= TXRX_PEER_HASH_LOAD_MULT;
 	hash_elems >>= TXRX_PEER_HASH_LOAD_SHIFT;
-	log2 = ol_txrx_log2_ceil(hash_elems);
-	hash_elems = 1 << log2;
 
-	pdev->peer_hash.mask = hash_elems - 1;
-	pdev->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
-	pdev->peer_hash.bins =
-		qdf_mem_malloc(hash_elems *
-			       sizeof(TAILQ_HEAD(anonymous_tail_q,
-						 ol_txrx_peer_t)));
-	if (!pdev->peer_hash.bins)
+	tbl = ol_txrx_peer_hash_tbl_alloc(hash_elems, false);
+	if (!tbl)
 		return 1;       /* failure */
 
-	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&pdev->peer_hash.bins[i]);
+	RCU_INIT_POINTER(pdev->peer_hash, tbl);
 
 	return 0;               /* success */
 }
 
 static void ol_txrx_peer_find_hash_detach(struct ol_txrx_pdev_t *pdev)
 {
-	qdf_mem_free(pdev->peer_hash.bins);
+	/* wait for deferred peer and table frees */
+	rcu_barrier();
+	qdf_mem_free(rcu_dereference_protected(pdev->peer_hash, true));
+	RCU_INIT_POINTER(pdev->peer_hash, NULL);
 }
 
 static inline unsigned int
-ol_txrx_peer_find_hash_index(struct ol_txrx_pdev_t *pdev,
+ol_txrx_peer_find_hash_index(struct ol_txrx_peer_hash_tbl *tbl,
 			     union ol_txrx_align_mac_addr_t *mac_addr)
 {
 	unsigned int index;
@@ -145,39 +172,182 @@ ol_txrx_peer_find_hash_index(struct ol_txrx_pdev_t *pdev,
 	index =
 		mac_addr->align2.bytes_ab ^
 		mac_addr->align2.bytes_cd ^ mac_addr->align2.bytes_ef;
-	index ^= index >> pdev->peer_hash.idx_bits;
-	index &= pdev->peer_hash.mask;
+	index ^= index >> tbl->idx_bits;
+	index &= tbl->mask;
 	return index;
 }
 
+/**
+ * ol_txrx_peer_hash_insert() - insert a peer into a peer hash table
+ * @tbl: peer hash table
+ * @peer: peer to be inserted
+ *
+ * A deleted slot is only reused if no other peer with the same MAC address
+ * is in the probing sequence, otherwise the peer goes to the first free
+ * slot after it. Together with lookups probing from the home slot, this
+ * ensures that if two entries with the same MAC address are stored, the
+ * one added first will be found first.
+ *
+ * Return: true if the peer is inserted, false if the table is full
+ */
+static bool ol_txrx_peer_hash_insert(struct ol_txrx_peer_hash_tbl *tbl,
+				     struct ol_txrx_peer_t *peer)
+{
+	struct ol_txrx_peer_hash_slot *slot, *target = NULL;
+	struct ol_txrx_peer_t *slot_peer;
+	unsigned int index, n;
+	bool dup = false;
+
+	index = ol_txrx_peer_find_hash_index(tbl, &peer->mac_addr);
+	for (n = 0; n <= tbl->mask; n++, index = (index + 1) & tbl->mask) {
+		slot = &tbl->slots[index];
+		slot_peer = slot->peer;
+		if (!slot_peer) {
+			if (dup || !target) {
+				target = slot;
+				tbl->used++;
+			}
+			break;
+		}
+		if (slot_peer == OL_TXRX_PEER_HASH_DELETED) {
+			if (!target)
+				target = slot;
+		} else if (ol_txrx_peer_find_mac_addr_cmp(&peer->mac_addr,
+							  &slot->mac_addr) == 0) {
+			dup = true;
+		}
+	}
+
+	/* no free slot, a deleted one is only usable without duplicates */
+	if (!target || (dup && target->peer))
+		return false;
+
+	target->mac_addr = peer->mac_addr;
+	/* publish the MAC address before the peer to lockless readers */
+	smp_store_release(&target->peer, peer);
+	tbl->live++;
+
+	return true;
+}
+
+/**
+ * ol_txrx_peer_hash_rebuild() - replace the peer hash table
+ * @pdev: pdev handle
+ * @old: current peer hash table
+ *
+ * Copies the live peers into a new table sized for them, which drops the
+ * deleted slots. The old table is freed once lockless readers are done
+ * with it. Called with peer_ref_mutex held.
+ *
+ * Return: new table, or @old if the allocation failed
+ */
+static struct ol_txrx_peer_hash_tbl *
+ol_txrx_peer_hash_rebuild(struct ol_txrx_pdev_t *pdev,
+			  struct ol_txrx_peer_hash_tbl *old)
+{
+	struct ol_txrx_peer_hash_tbl *tbl;
+	struct ol_txrx_peer_t *peer;
+	unsigned int hash_elems, start, index, n;
+
+	hash_elems = qdf_max(old->mask + 1,
+			     (old->live + 1) * TXRX_PEER_HASH_LOAD_MULT * 2);
+	tbl = ol_txrx_peer_hash_tbl_alloc(hash_elems, true);
+	if (!tbl) {
+		ol_txrx_err("peer hash rebuild failed, live %u used %u",
+			    old->live, old->used);
+		return old;
+	}
+
+	/*
+	 * Start right after a free slot, so that no probing sequence
+	 * wraps around and peers with the same MAC address keep their
+	 * order in the new table.
+	 */
+	for (start = 0; start <= old->mask; start++)
+		if (!old->slots[start].peer)
+			break;
+
+	for (n = 0; n <= old->mask; n++) {
+		index = (start + 1 + n) & old->mask;
+		peer = old->slots[index].peer;
+		if (peer && peer != OL_TXRX_PEER_HASH_DELETED)
+			ol_txrx_peer_hash_insert(tbl, peer);
+	}
+
+	rcu_assign_pointer(pdev->peer_hash, tbl);
+	call_rcu(&old->rcu, ol_txrx_peer_hash_tbl_free_rcu);
+
+	return tbl;
+}
+
 void
 ol_txrx_peer_find_hash_add(struct ol_txrx_pdev_t *pdev,
 			   struct ol_txrx_peer_t *peer)
 {
-	unsigned int index;
+	struct ol_txrx_peer_hash_tbl *tbl;
 
-	index = ol_txrx_peer_find_hash_index(pdev, &peer->mac_addr);
 	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
-	/*
-	 * It is important to add the new peer at the tail of the peer list
-	 * with the bin index.  Together with having the hash_find function
-	 * search from head to tail, this ensures that if two entries with
-	 * the same MAC address are stored, the one added first will be
-	 * found first.
-	 */
-	TAILQ_INSERT_TAIL(&pdev->peer_hash.bins[index], peer, hash_list_elem);
+	tbl = rcu_dereference_protected(pdev->peer_hash, true);
+	if ((tbl->used + 1) << TXRX_PEER_HASH_REBUILD_SHIFT >
+	    (tbl->mask + 1) * TXRX_PEER_HASH_REBUILD_NUM)
+		tbl = ol_txrx_peer_hash_rebuild(pdev, tbl);
+
+	if (!ol_txrx_peer_hash_insert(tbl, peer)) {
+		ol_txrx_err("peer hash full, peer %pK "QDF_MAC_ADDR_STR,
+			    peer, QDF_MAC_ADDR_ARRAY(peer->mac_addr.raw));
+		QDF_BUG(0);
+	}
 	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
 }
 
-struct ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
-						   struct ol_txrx_vdev_t *vdev,
-						   uint8_t *peer_mac_addr,
-						   int mac_addr_is_aligned,
-						   uint8_t check_valid)
+/**
+ * ol_txrx_peer_try_get_ref() - get a reference of a peer found locklessly
+ * @peer: peer found in the peer hash table
+ * @dbg_id: debug id to keep track of peer references
+ *
+ * A peer whose ref count dropped to 0 is being deleted and must not be
+ * revived; its memory stays valid until the end of the RCU read side.
+ *
+ * Return: true if the reference is taken
+ */
+static bool ol_txrx_peer_try_get_ref(struct ol_txrx_peer_t *peer,
+				     enum peer_debug_id_type dbg_id)
+{
+	if (dbg_id >= PEER_DEBUG_ID_MAX || dbg_id < 0) {
+		ol_txrx_err("incorrect debug_id %d ", dbg_id);
+		return false;
+	}
+
+	if (!qdf_atomic_inc_not_zero(&peer->ref_cnt))
+		return false;
+
+	qdf_atomic_inc(&peer->access_list[dbg_id]);
+
+	return true;
+}
+
+/**
+ * ol_txrx_peer_hash_find() - lockless lookup of a peer by MAC address
+ * @pdev: pdev handle
+ * @vdev: vdev the peer has to belong to, NULL for any vdev
+ * @peer_mac_addr: peer MAC address
+ * @mac_addr_is_aligned: @peer_mac_addr is aligned
+ * @check_valid: only return a peer which is not detached
+ * @dbg_id: debug id to keep track of peer references
+ *
+ * Return: peer with a reference taken, NULL if not found
+ */
+static struct ol_txrx_peer_t *
+ol_txrx_peer_hash_find(struct ol_txrx_pdev_t *pdev,
+		       struct ol_txrx_vdev_t *vdev,
+		       uint8_t *peer_mac_addr, int mac_addr_is_aligned,
+		       uint8_t check_valid, enum peer_debug_id_type dbg_id)
 {
 	union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
-	unsigned int index;
+	struct ol_txrx_peer_hash_tbl *tbl;
+	struct ol_txrx_peer_hash_slot *slot;
 	struct ol_txrx_peer_t *peer;
+	unsigned int index, n;
 
 	if (mac_addr_is_aligned) {
 		mac_addr = (union ol_txrx_align_mac_addr_t *)peer_mac_addr;
@@ -186,22 +356,52 @@ struct ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
 			     peer_mac_addr, QDF_MAC_ADDR_SIZE);
 		mac_addr = &local_mac_addr_aligned;
 	}
-	index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
-	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
-	TAILQ_FOREACH(peer, &pdev->peer_hash.bins[index], hash_list_elem) {
-		if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) ==
-		    0 && (check_valid == 0 || peer->valid)
-		    && peer->vdev == vdev) {
+
+	rcu_read_lock();
+	tbl = rcu_dereference(pdev->peer_hash);
+	index = ol_txrx_peer_find_hash_index(tbl, mac_addr);
+	for (n = 0; n <= tbl->mask; n++, index = (index + 1) & tbl->mask) {
+		slot = &tbl->slots[index];
+		peer = smp_load_acquire(&slot->peer);
+		if (!peer)
+			break;
+		if (peer == OL_TXRX_PEER_HASH_DELETED ||
+		    ol_txrx_peer_find_mac_addr_cmp(mac_addr,
+						   &slot->mac_addr) != 0)
+			continue;
+		/*
+		 * The slot may have been reused since the peer was read,
+		 * the peer object itself is stable within the RCU section.
+		 */
+		if (ol_txrx_peer_find_mac_addr_cmp(mac_addr,
+						   &peer->mac_addr) == 0 &&
+		    (check_valid == 0 || peer->valid) &&
+		    (!vdev || peer->vdev == vdev) &&
+		    ol_txrx_peer_try_get_ref(peer, dbg_id)) {
 			/* found it */
-			ol_txrx_peer_get_ref(peer, PEER_DEBUG_ID_OL_INTERNAL);
-			qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
+			rcu_read_unlock();
 			return peer;
 		}
 	}
-	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
+	rcu_read_unlock();
+
 	return NULL;            /* failure */
 }
 
+struct ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
+						   struct ol_txrx_vdev_t *vdev,
+						   uint8_t *peer_mac_addr,
+						   int mac_addr_is_aligned,
+						   uint8_t check_valid)
+{
+	if (!vdev)
+		return NULL;
+
+	return ol_txrx_peer_hash_find(pdev, vdev, peer_mac_addr,
+				      mac_addr_is_aligned, check_valid,
+				      PEER_DEBUG_ID_OL_INTERNAL);
+}
+
 struct ol_txrx_peer_t *
 	ol_txrx_peer_find_hash_find_get_ref
 				(struct ol_txrx_pdev_t *pdev,
@@ -210,39 +410,19 @@ struct ol_txrx_peer_t *
 				u8 check_valid,
 				enum peer_debug_id_type dbg_id)
 {
-	union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
-	unsigned int index;
-	struct ol_txrx_peer_t *peer;
-
-	if (mac_addr_is_aligned) {
-		mac_addr = (union ol_txrx_align_mac_addr_t *)peer_mac_addr;
-	} else {
-		qdf_mem_copy(&local_mac_addr_aligned.raw[0],
-			     peer_mac_addr, QDF_MAC_ADDR_SIZE);
-		mac_addr = &local_mac_addr_aligned;
-	}
-	index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
-	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
-	TAILQ_FOREACH(peer, &pdev->peer_hash.bins[index], hash_list_elem) {
-		if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) ==
-		    0 && (check_valid == 0 || peer->valid)) {
-			/* found it */
-			ol_txrx_peer_get_ref(peer, dbg_id);
-			qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
-			return peer;
-		}
-	}
-	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
-	return NULL;            /* failure */
+	return ol_txrx_peer_hash_find(pdev, NULL, peer_mac_addr,
+				      mac_addr_is_aligned, check_valid,
+				      dbg_id);
 }
 
 void
 ol_txrx_peer_find_hash_remove(struct ol_txrx_pdev_t *pdev,
 			      struct ol_txrx_peer_t *peer)
 {
-	unsigned int index;
+	struct ol_txrx_peer_hash_tbl *tbl;
+	struct ol_txrx_peer_hash_slot *slot;
+	unsigned int index, n;
 
-	index = ol_txrx_peer_find_hash_index(pdev, &peer->mac_addr);
 	/*
 	 * DO NOT take the peer_ref_mutex lock here - it needs to be taken
 	 * by the caller.
@@ -250,54 +430,76 @@ ol_txrx_peer_find_hash_remove(struct ol_txrx_pdev_t *pdev,
 	 * reference count is decremented and tested up through the time the
 	 * reference to the peer object is removed from the hash table, by
 	 * this function.
-	 * Holding the lock only while removing the peer object reference
-	 * from the hash table keeps the hash table consistent, but does not
-	 * protect against a new HL tx context starting to use the peer object
-	 * if it looks up the peer object from its MAC address just after the
-	 * peer ref count is decremented to zero, but just before the peer
-	 * object reference is removed from the hash table.
+	 * Lockless lookups do not take a reference of a peer whose
+	 * reference count already dropped to zero, and the peer object is
+	 * freed only after the lookups which may still see it are done,
+	 * see ol_txrx_peer_free().
+	 */
+	tbl = rcu_dereference_protected(pdev->peer_hash, true);
+	index = ol_txrx_peer_find_hash_index(tbl, &peer->mac_addr);
+	for (n = 0; n <= tbl->mask; n++, index = (index + 1) & tbl->mask) {
+		slot = &tbl->slots[index];
+		if (!slot->peer)
+			return;
+		if (slot->peer == peer)
+			break;
+	}
+	if (n > tbl->mask)
+		return;
+
+	WRITE_ONCE(slot->peer, OL_TXRX_PEER_HASH_DELETED);
+	tbl->live--;
+
+	/*
+	 * A deleted slot followed by a free slot ends every probing
+	 * sequence through it, so it can be freed as well, and so on
+	 * backwards.
 	 */
-	/* qdf_spin_lock_bh(&pdev->peer_ref_mutex); */
-	TAILQ_REMOVE(&pdev->peer_hash.bins[index], peer, hash_list_elem);
-	/* qdf_spin_unlock_bh(&pdev->peer_ref_mutex); */
+	while (!tbl->slots[(index + 1) & tbl->mask].peer &&
+	       tbl->slots[index].peer == OL_TXRX_PEER_HASH_DELETED) {
+		WRITE_ONCE(tbl->slots[index].peer, NULL);
+		tbl->used--;
+		index = (index - 1) & tbl->mask;
+	}
+}
+
+static void ol_txrx_peer_free_rcu(struct rcu_head *rcu)
+{
+	qdf_mem_free(container_of(rcu, struct ol_txrx_peer_t, rcu));
+}
+
+void ol_txrx_peer_free(struct ol_txrx_peer_t *peer)
+{
+	call_rcu(&peer->rcu, ol_txrx_peer_free_rcu);
 }
 
 void ol_txrx_peer_find_hash_erase(struct ol_txrx_pdev_t *pdev)
 {
+	struct ol_txrx_peer_hash_tbl *tbl;
+	struct ol_txrx_peer_t *peer;
 	unsigned int i;
 	/*
 	 * Not really necessary to take peer_ref_mutex lock - by this point,
 	 * it's known that the pdev is no longer in use.
 	 */
 
-	for (i = 0; i <= pdev->peer_hash.mask; i++) {
-		if (!TAILQ_EMPTY(&pdev->peer_hash.bins[i])) {
-			struct ol_txrx_peer_t *peer, *peer_next;
-
-			/*
-			 * TAILQ_FOREACH_SAFE must be used here to avoid any
-			 * memory access violation after peer is freed
-			 */
-			TAILQ_FOREACH_SAFE(peer, &pdev->peer_hash.bins[i],
-					   hash_list_elem, peer_next) {
-				/*
-				 * Don't remove the peer from the hash table -
-				 * that would modify the list we are currently
-				 * traversing,
-				 * and it's not necessary anyway.
-				 */
-				/*
-				 * Artificially adjust the peer's ref count to
-				 * 1, so it will get deleted by
-				 * ol_txrx_peer_release_ref.
-				 */
-				qdf_atomic_init(&peer->ref_cnt); /* set to 0 */
-				ol_txrx_peer_get_ref(peer,
-						     PEER_DEBUG_ID_OL_HASH_ERS);
-				ol_txrx_peer_release_ref(peer,
-						     PEER_DEBUG_ID_OL_HASH_ERS);
-			}
-		}
+	tbl = rcu_dereference_protected(pdev->peer_hash, true);
+	for (i = 0; i <= tbl->mask; i++) {
+		peer = tbl->slots[i].peer;
+		if (!peer || peer == OL_TXRX_PEER_HASH_DELETED)
+			continue;
+		/*
+		 * Releasing the peer removes it from the hash table, which
+		 * only modifies this and preceding slots.
+		 */
+		/*
+		 * Artificially adjust the peer's ref count to
+		 * 1, so it will get deleted by
+		 * ol_txrx_peer_release_ref.
+		 */
+		qdf_atomic_init(&peer->ref_cnt); /* set to 0 */
+		ol_txrx_peer_get_ref(peer, PEER_DEBUG_ID_OL_HASH_ERS);
+		ol_txrx_peer_release_ref(peer, PEER_DEBUG_ID_OL_HASH_ERS);
 	}
 }
 
@@ -809,6 +1011,8 @@ struct ol_txrx_peer_t *ol_txrx_assoc_peer_find(struct ol_txrx_vdev_t *vdev)
 #if defined(TXRX_DEBUG_LEVEL) && TXRX_DEBUG_LEVEL > 5
 void ol_txrx_peer_find_display(ol_txrx_pdev_handle pdev, int indent)
 {
+	struct ol_txrx_peer_hash_tbl *tbl;
+	struct ol_txrx_peer_t *peer;
 	int i, max_peers;
 
 	QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO_LOW,
@@ -824,19 +1028,16 @@ void ol_txrx_peer_find_display(ol_txrx_pdev_handle pdev, int indent)
 	}
 	QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO_LOW,
 		  "%*speer hash table:\n", indent, " ");
-	for (i = 0; i <= pdev->peer_hash.mask; i++) {
-		if (!TAILQ_EMPTY(&pdev->peer_hash.bins[i])) {
-			struct ol_txrx_peer_t *peer;
-
-			TAILQ_FOREACH(peer, &pdev->peer_hash.bins[i],
-				      hash_list_elem) {
-				QDF_TRACE(QDF_MODULE_ID_TXRX,
-					  QDF_TRACE_LEVEL_INFO_LOW,
-					  "%*shash idx %d -> %pK ("QDF_MAC_ADDR_STR")\n",
-					indent + 4, " ", i, peer,
-					QDF_MAC_ADDR_ARRAY(peer->mac_addr.raw));
-			}
-		}
+	tbl = rcu_dereference_protected(pdev->peer_hash, true);
+	for (i = 0; i <= tbl->mask; i++) {
+		peer = tbl->slots[i].peer;
+		if (!peer || peer == OL_TXRX_PEER_HASH_DELETED)
+			continue;
+
+		QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO_LOW,
+			  "%*shash idx %d -> %pK ("QDF_MAC_ADDR_STR")\n",
+			  indent + 4, " ", i, peer,
+			  QDF_MAC_ADDR_ARRAY(peer->mac_addr.raw));
 	}
 }
 
@@ -34,7 +34,8 @@
  *
  * The function increments the peer ref count. The ref count can be reduced by
  * caling ol_txrx_peer_release_ref function. Callers are responsible for
- * acquiring the peer_ref_mutex lock when needed.
+ * acquiring the peer_ref_mutex lock when needed, or for holding the peer
+ * through a path which keeps its ref count above zero.
  *
  * Return: peer debug id ref count or error
  */
@@ -113,6 +114,17 @@ void
 ol_txrx_peer_find_hash_remove(struct ol_txrx_pdev_t *pdev,
 			      struct ol_txrx_peer_t *peer);
 
+/**
+ * ol_txrx_peer_free() - free a peer object
+ * @peer: peer whose last reference is released
+ *
+ * The peer memory is freed only after lockless peer hash lookups which
+ * may still see the peer are done.
+ *
+ * Return: None
+ */
+void ol_txrx_peer_free(struct ol_txrx_peer_t *peer);
+
 void ol_txrx_peer_find_hash_erase(struct ol_txrx_pdev_t *pdev);
 
 struct ol_txrx_peer_t *ol_txrx_assoc_peer_find(struct ol_txrx_vdev_t *vdev);
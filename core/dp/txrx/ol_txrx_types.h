@@ -169,6 +169,12 @@ struct ol_tx_desc_t {
 	uint32_t entry_timestamp_ticks;
 #endif
 
+#ifdef WLAN_TX_LATENCY_HIST
+	uint64_t lat_start_ts;
+	uint64_t lat_ts;
+	uint8_t lat_ac;
+#endif
+
 #ifdef DESC_TIMESTAMP_DEBUG_INFO
 	struct {
 		uint64_t prev_tx_ts;
@@ -234,6 +240,44 @@ union ol_txrx_align_mac_addr_t {
 	} align4;
 };
 
+/*
+ * Marks a peer hash slot whose peer was removed, lookups have to probe
+ * past it.
+ */
+#define OL_TXRX_PEER_HASH_DELETED ((struct ol_txrx_peer_t *)-1)
+
+/**
+ * struct ol_txrx_peer_hash_slot - slot of the peer MAC address index
+ * @mac_addr: MAC address of @peer, compared before touching the peer
+ * @peer: peer object, NULL if the slot was never used or
+ *	  OL_TXRX_PEER_HASH_DELETED if the peer was removed
+ */
+struct ol_txrx_peer_hash_slot {
+	union ol_txrx_align_mac_addr_t mac_addr;
+	struct ol_txrx_peer_t *peer;
+};
+
+/**
+ * struct ol_txrx_peer_hash_tbl - open addressing peer MAC address index
+ * @rcu: deferred free of a replaced table
+ * @mask: number of slots - 1
+ * @idx_bits: log2 of the number of slots
+ * @used: number of slots which are not NULL, live and deleted peers
+ * @live: number of slots holding a peer
+ * @slots: linear probing slots
+ *
+ * Lookups walk the table without a lock under rcu_read_lock, updates are
+ * done with pdev->peer_ref_mutex held.
+ */
+struct ol_txrx_peer_hash_tbl {
+	struct rcu_head rcu;
+	unsigned int mask;
+	unsigned int idx_bits;
+	unsigned int used;
+	unsigned int live;
+	struct ol_txrx_peer_hash_slot slots[];
+};
+
 struct ol_rx_reorder_timeout_list_elem_t {
 	TAILQ_ENTRY(ol_rx_reorder_timeout_list_elem_t)
 	reorder_timeout_list_elem;
@@ -492,6 +536,23 @@ struct ol_txrx_pool_stats {
 	uint16_t pkt_drop_no_pool;
 };
 
+/* number of free tx descriptors a per-CPU flow pool magazine can cache */
+#define OL_TX_FLOW_POOL_MAG_SIZE 32
+/* descriptors moved between a magazine and its flow pool per exchange */
+#define OL_TX_FLOW_POOL_MAG_XCHG (OL_TX_FLOW_POOL_MAG_SIZE / 2)
+
+/**
+ * struct ol_tx_flow_pool_mag - per-CPU cache of free flow pool descriptors
+ * @lock: magazine lock, only contended by pool wide drains
+ * @cnt: number of descriptors in @descs
+ * @descs: free tx descriptors of the flow pool
+ */
+struct ol_tx_flow_pool_mag {
+	qdf_spinlock_t lock;
+	uint16_t cnt;
+	struct ol_tx_desc_t *descs[OL_TX_FLOW_POOL_MAG_SIZE];
+} ____cacheline_aligned_in_smp;
+
 /**
  * struct ol_tx_flow_pool_t - flow_pool info
  * @flow_pool_list_elem: flow_pool_list element
@@ -511,6 +572,14 @@ struct ol_txrx_pool_stats {
  * @ref_cnt: pool's ref count
  * @stop_priority_th: Threshold to stop priority queue
  * @start_priority_th: Threshold to start priority queue
+ * @mags: per-CPU magazines, indexed by CPU id
+ * @mag_active: magazines can be used, only set while the pool is
+ *	unpaused with enough descriptors above start_th and no overflow, so
+ *	the stop/start thresholds are always checked with empty magazines
+ * @mag_disabled: magazines are not activated any more, set when the pool
+ *	is being deleted
+ * @mag_xchg: number of magazine exchanges with the pool freelist
+ * @mag_drain: number of drains of all magazines back to the pool
  */
 struct ol_tx_flow_pool_t {
 	TAILQ_ENTRY(ol_tx_flow_pool_t) flow_pool_list_elem;
@@ -530,6 +599,11 @@ struct ol_tx_flow_pool_t {
 	qdf_atomic_t ref_cnt;
 	uint16_t stop_priority_th;
 	uint16_t start_priority_th;
+	struct ol_tx_flow_pool_mag *mags;
+	bool mag_active;
+	bool mag_disabled;
+	uint32_t mag_xchg;
+	uint32_t mag_drain;
 };
 #endif
 
@@ -733,12 +807,8 @@ struct ol_txrx_pdev_t {
 	/* peer ID to peer object map (array of pointers to peer objects) */
 	struct ol_txrx_peer_id_map *peer_id_to_obj_map;
 
-	struct {
-		unsigned int mask;
-		unsigned int idx_bits;
-
-		TAILQ_HEAD(, ol_txrx_peer_t) * bins;
-	} peer_hash;
+	/* peer MAC address -> peer object index, see ol_txrx_peer_find.c */
+	struct ol_txrx_peer_hash_tbl __rcu *peer_hash;
 
 	/* rx specific processing */
 	struct {
@@ -1180,6 +1250,71 @@ struct tcp_del_ack_hash_node {
 	struct tcp_stream_node *head;
 };
 
+/**
+ * enum ol_rx_lat_stage - rx latency instrumentation stages
+ * @OL_RX_LAT_STAGE_HTT: HTT T2H message receipt to in-order indication pop
+ * @OL_RX_LAT_STAGE_RXQ: in-order indication to the HDD rx callback, i.e.
+ *	the time spent queued for the rx thread
+ * @OL_RX_LAT_STAGE_HDD: HDD rx callback to network stack handoff
+ * @OL_RX_LAT_STAGE_STACK: time spent in the netif/GRO delivery call
+ * @OL_RX_LAT_STAGE_MAX: number of stages
+ */
+enum ol_rx_lat_stage {
+	OL_RX_LAT_STAGE_HTT,
+	OL_RX_LAT_STAGE_RXQ,
+	OL_RX_LAT_STAGE_HDD,
+	OL_RX_LAT_STAGE_STACK,
+	OL_RX_LAT_STAGE_MAX,
+};
+
+#ifdef WLAN_RX_LATENCY_HIST
+#define OL_RX_LAT_HIST_BUCKETS 16
+
+/**
+ * struct ol_rx_lat_hist - per vdev rx latency histograms
+ * @bucket: msdu count per stage, TID and log2 latency bucket. Bucket 0
+ *	holds sub-microsecond latencies, bucket n holds [2^(n-1), 2^n) us and
+ *	the last bucket holds everything above. Updated from the rx
+ *	threads and the HDD rx callbacks of all CPUs, hence atomic.
+ */
+struct ol_rx_lat_hist {
+	qdf_atomic_t bucket[OL_RX_LAT_STAGE_MAX][OL_TXRX_NUM_EXT_TIDS]
+		       [OL_RX_LAT_HIST_BUCKETS];
+};
+#endif
+
+/**
+ * enum ol_tx_lat_stage - tx latency instrumentation stages
+ * @OL_TX_LAT_STAGE_TXQ: txrx descriptor setup to download to the target,
+ *	i.e. the time spent in the HL tx queues. Not recorded for the LL
+ *	fast path, which downloads right after descriptor setup.
+ * @OL_TX_LAT_STAGE_FW: download to tx completion, i.e. target queuing
+ *	and air time
+ * @OL_TX_LAT_STAGE_TOTAL: txrx descriptor setup to tx completion
+ * @OL_TX_LAT_STAGE_MAX: number of stages
+ */
+enum ol_tx_lat_stage {
+	OL_TX_LAT_STAGE_TXQ,
+	OL_TX_LAT_STAGE_FW,
+	OL_TX_LAT_STAGE_TOTAL,
+	OL_TX_LAT_STAGE_MAX,
+};
+
+#ifdef WLAN_TX_LATENCY_HIST
+#define OL_TX_LAT_HIST_BUCKETS 16
+
+/**
+ * struct ol_tx_lat_hist - per vdev tx latency histograms
+ * @bucket: msdu count per stage, access category and log2 latency bucket,
+ *	laid out like struct ol_rx_lat_hist. Updated from the tx and the tx
+ *	completion contexts of all CPUs, hence atomic.
+ */
+struct ol_tx_lat_hist {
+	qdf_atomic_t bucket[OL_TX_LAT_STAGE_MAX][TXRX_NUM_WMM_AC]
+		       [OL_TX_LAT_HIST_BUCKETS];
+};
+#endif
+
 struct ol_txrx_vdev_t {
 	struct ol_txrx_pdev_t *pdev; /* pdev - the physical device that is
 				      * the parent of this virtual device
@@ -1361,6 +1496,12 @@ struct ol_txrx_vdev_t {
 		qdf_spinlock_t mutex;
 		qdf_timer_t timer;
 	} bundle_queue;
+#ifdef WLAN_RX_LATENCY_HIST
+	struct ol_rx_lat_hist rx_lat;
+#endif
+#ifdef WLAN_TX_LATENCY_HIST
+	struct ol_tx_lat_hist tx_lat;
+#endif
 };
 
 struct ol_rx_reorder_array_elem_t {
@@ -1461,8 +1602,8 @@ struct ol_txrx_peer_t {
 
 	/* node in the vdev's list of peers */
 	TAILQ_ENTRY(ol_txrx_peer_t) peer_list_elem;
-	/* node in the hash table bin's list of peers */
-	TAILQ_ENTRY(ol_txrx_peer_t) hash_list_elem;
+	/* deferred free, lockless peer hash readers may still access it */
+	struct rcu_head rcu;
 
 	/*
 	 * per TID info -
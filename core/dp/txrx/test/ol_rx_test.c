@@ -0,0 +1,795 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: ol_rx_test.c
+ *
+ * Unit tests for the rx PN check, rx reorder and rx defrag logic. The
+ * reorder suite also replays a synthetic block ack trace with reordering,
+ * loss and window/sequence number wrap, and reports the host cost per MPDU.
+ * The defrag suite checks the Michael MIC against the known answer vectors
+ * and times the MIC and recombine of a synthetic TKIP fragment train.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_nbuf.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "cds_api.h"
+#include "cds_ieee80211_common.h"
+#include "cds_utils.h"
+#include "ol_txrx_types.h"
+#include "ol_txrx_internal.h"
+#include "ol_txrx.h"
+#include "ol_rx_reorder.h"
+#include "ol_rx_pn.h"
+#include "ol_rx_defrag.h"
+#include "htt_internal.h"
+#include "ol_rx_test.h"
+
+#define OL_RX_TEST_TID		0
+#define OL_RX_TEST_WIN_SZ	64
+#define OL_RX_TEST_BLOCK_SZ	8
+#define OL_RX_TEST_POOL_SZ	(2 * OL_RX_TEST_WIN_SZ)
+#define OL_RX_TEST_LOSS_PERIOD	29
+/* enough MPDUs to wrap the 12 bit sequence number space four times */
+#define OL_RX_TEST_NUM_MPDUS	(4 * IEEE80211_SEQ_MAX)
+#define OL_RX_TEST_PN_ITERATIONS	100000
+#define OL_RX_TEST_BUF_SZ \
+	(sizeof(struct htt_host_rx_desc_base) + HTT_RX_DESC_ALIGN_MASK)
+
+typedef int (*ol_rx_pn_cmp_fn)(union htt_rx_pn_t *new_pn,
+			       union htt_rx_pn_t *old_pn, int is_unicast,
+			       int opmode, bool strict_chk);
+
+struct ol_rx_pn_test_case {
+	ol_rx_pn_cmp_fn cmp;
+	union htt_rx_pn_t new_pn;
+	union htt_rx_pn_t old_pn;
+	int is_unicast;
+	int opmode;
+	bool strict_chk;
+	int replay;
+};
+
+static const struct ol_rx_pn_test_case ol_rx_pn_test_cases[] = {
+	/* 24 bit PN, the PN wraps within the 24 bits */
+	{ ol_rx_pn_cmp24, { .pn24 = 2 }, { .pn24 = 1 }, 1, 0, false, 0 },
+	{ ol_rx_pn_cmp24, { .pn24 = 1 }, { .pn24 = 1 }, 1, 0, false, 1 },
+	{ ol_rx_pn_cmp24, { .pn24 = 0x1000000 }, { .pn24 = 0xffffff },
+	  1, 0, false, 1 },
+	{ ol_rx_pn_cmp24, { .pn24 = 3 }, { .pn24 = 1 }, 1, 0, true, 1 },
+	/* 48 bit PN */
+	{ ol_rx_pn_cmp48, { .pn48 = 5 }, { .pn48 = 4 }, 1, 0, false, 0 },
+	{ ol_rx_pn_cmp48, { .pn48 = 4 }, { .pn48 = 5 }, 1, 0, false, 1 },
+	{ ol_rx_pn_cmp48, { .pn48 = 4 }, { .pn48 = 4 }, 1, 0, false, 1 },
+	{ ol_rx_pn_cmp48, { .pn48 = 0x1000000000005ULL }, { .pn48 = 4 },
+	  1, 0, false, 0 },
+	{ ol_rx_pn_cmp48, { .pn48 = 0x100000000ULL }, { .pn48 = 0xffffffff },
+	  1, 0, true, 0 },
+	{ ol_rx_pn_cmp48, { .pn48 = 6 }, { .pn48 = 4 }, 1, 0, true, 1 },
+	/* WAPI: unicast PN is odd towards a STA and even towards an AP */
+	{ ol_rx_pn_wapi_cmp, { .pn128 = { 3, 0 } }, { .pn128 = { 1, 0 } },
+	  1, wlan_op_mode_sta, false, 0 },
+	{ ol_rx_pn_wapi_cmp, { .pn128 = { 4, 0 } }, { .pn128 = { 1, 0 } },
+	  1, wlan_op_mode_sta, false, 1 },
+	{ ol_rx_pn_wapi_cmp, { .pn128 = { 4, 0 } }, { .pn128 = { 2, 0 } },
+	  1, wlan_op_mode_ap, false, 0 },
+	{ ol_rx_pn_wapi_cmp, { .pn128 = { 0, 1 } }, { .pn128 = { 5, 0 } },
+	  0, wlan_op_mode_sta, false, 0 },
+	{ ol_rx_pn_wapi_cmp, { .pn128 = { 5, 0 } }, { .pn128 = { 0, 1 } },
+	  0, wlan_op_mode_sta, false, 1 },
+};
+
+static uint32_t ol_rx_pn_test_cmp(void)
+{
+	const struct ol_rx_pn_test_case *tc;
+	union htt_rx_pn_t new_pn, old_pn;
+	uint32_t errors = 0;
+	int i, replay;
+
+	for (i = 0; i < ARRAY_SIZE(ol_rx_pn_test_cases); i++) {
+		tc = &ol_rx_pn_test_cases[i];
+		new_pn = tc->new_pn;
+		old_pn = tc->old_pn;
+		replay = tc->cmp(&new_pn, &old_pn, tc->is_unicast, tc->opmode,
+				 tc->strict_chk);
+		if (!!replay != tc->replay) {
+			txrx_nofl_err("FAIL: PN case %d; expected %d, found %d",
+				      i, tc->replay, replay);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static uint32_t ol_rx_pn_test_bench(void)
+{
+	union htt_rx_pn_t new_pn, old_pn;
+	uint32_t errors = 0;
+	uint32_t replays = 0;
+	uint64_t start, elapsed;
+	int i;
+
+	old_pn.pn48 = 0xfffffff0ULL;
+	start = ktime_get_ns();
+	for (i = 0; i < OL_RX_TEST_PN_ITERATIONS; i++) {
+		new_pn.pn48 = old_pn.pn48 + 1;
+		replays += ol_rx_pn_cmp48(&new_pn, &old_pn, 1, 0, true);
+		old_pn = new_pn;
+	}
+	elapsed = ktime_get_ns() - start;
+
+	cds_test_expect(!replays, errors);
+
+	do_div(elapsed, OL_RX_TEST_PN_ITERATIONS);
+	txrx_nofl_info("ol_rx_pn: %d compares, %llu ns/compare",
+		       OL_RX_TEST_PN_ITERATIONS, elapsed);
+
+	return errors;
+}
+
+uint32_t ol_rx_pn_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += ol_rx_pn_test_cmp();
+	errors += ol_rx_pn_test_bench();
+
+	return errors;
+}
+
+/**
+ * struct ol_rx_test_ctx - reorder test context
+ * @pdev: txrx pdev used to parse the rx descriptors, NULL if unavailable
+ * @vdev: synthetic vdev attached to @pdev
+ * @peer: synthetic peer with a single block ack session
+ * @pool: free nbufs, linked through their next pointers
+ * @last_seq: sequence number of the last delivered MPDU
+ * @last_seq_valid: @last_seq is valid
+ * @delivered: number of delivered MPDUs
+ * @errors: number of ordering errors seen on delivery
+ */
+struct ol_rx_test_ctx {
+	struct ol_txrx_pdev_t *pdev;
+	struct ol_txrx_vdev_t *vdev;
+	struct ol_txrx_peer_t *peer;
+	qdf_nbuf_t pool;
+	uint16_t last_seq;
+	bool last_seq_valid;
+	uint32_t delivered;
+	uint32_t errors;
+};
+
+/* the rx_opt_proc callback has no context argument */
+static struct ol_rx_test_ctx *ol_rx_test_cur_ctx;
+
+static qdf_nbuf_t ol_rx_test_nbuf_get(struct ol_rx_test_ctx *ctx)
+{
+	qdf_nbuf_t nbuf = ctx->pool;
+
+	if (nbuf) {
+		ctx->pool = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+	}
+
+	return nbuf;
+}
+
+static void ol_rx_test_nbuf_put(struct ol_rx_test_ctx *ctx, qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_set_next(nbuf, ctx->pool);
+	ctx->pool = nbuf;
+}
+
+static void ol_rx_test_set_seq(struct htt_pdev_t *pdev, qdf_nbuf_t msdu,
+			       uint16_t seq_num)
+{
+	uint32_t *word = (uint32_t *)&htt_rx_desc(msdu)->mpdu_start;
+
+	*word = (*word & ~RX_MPDU_START_0_SEQ_NUM_MASK) |
+		((seq_num << RX_MPDU_START_0_SEQ_NUM_LSB) &
+		 RX_MPDU_START_0_SEQ_NUM_MASK);
+}
+
+static void ol_rx_test_deliver(struct ol_txrx_vdev_t *vdev,
+			       struct ol_txrx_peer_t *peer,
+			       unsigned int tid, qdf_nbuf_t msdu_list)
+{
+	struct ol_rx_test_ctx *ctx = ol_rx_test_cur_ctx;
+	htt_pdev_handle htt_pdev = vdev->pdev->htt_pdev;
+	qdf_nbuf_t msdu, next;
+	uint16_t seq_num, delta;
+
+	for (msdu = msdu_list; msdu; msdu = next) {
+		next = qdf_nbuf_next(msdu);
+		seq_num = htt_rx_mpdu_desc_seq_num(
+				htt_pdev,
+				htt_rx_msdu_desc_retrieve(htt_pdev, msdu),
+				false);
+		if (ctx->last_seq_valid) {
+			delta = (seq_num - ctx->last_seq) &
+				(IEEE80211_SEQ_MAX - 1);
+			if (!delta || delta > OL_RX_TEST_WIN_SZ) {
+				txrx_nofl_err("FAIL: seq %u delivered after %u",
+					      seq_num, ctx->last_seq);
+				ctx->errors++;
+			}
+		}
+		ctx->last_seq = seq_num;
+		ctx->last_seq_valid = true;
+		ctx->delivered++;
+		ol_rx_test_nbuf_put(ctx, msdu);
+	}
+}
+
+static uint32_t ol_rx_test_array_reclaim(struct ol_rx_test_ctx *ctx)
+{
+	struct ol_rx_reorder_t *rx_reorder;
+	qdf_nbuf_t msdu, next;
+	uint32_t busy = 0;
+	int i;
+
+	rx_reorder = &ctx->peer->tids_rx_reorder[OL_RX_TEST_TID];
+	for (i = 0; i < OL_RX_TEST_WIN_SZ; i++) {
+		if (!rx_reorder->array[i].head)
+			continue;
+
+		busy++;
+		for (msdu = rx_reorder->array[i].head; msdu; msdu = next) {
+			next = msdu == rx_reorder->array[i].tail ?
+				NULL : qdf_nbuf_next(msdu);
+			ol_rx_test_nbuf_put(ctx, msdu);
+		}
+		rx_reorder->array[i].head = NULL;
+		rx_reorder->array[i].tail = NULL;
+	}
+
+	return busy;
+}
+
+static void ol_rx_test_teardown(struct ol_rx_test_ctx *ctx)
+{
+	struct ol_rx_reorder_t *rx_reorder;
+	qdf_nbuf_t nbuf;
+
+	if (ctx->peer) {
+		rx_reorder = &ctx->peer->tids_rx_reorder[OL_RX_TEST_TID];
+		if (rx_reorder->array &&
+		    rx_reorder->array != &rx_reorder->base) {
+			ol_rx_test_array_reclaim(ctx);
+			qdf_mem_free(rx_reorder->array);
+		}
+		qdf_mem_free(ctx->peer);
+	}
+	qdf_mem_free(ctx->vdev);
+
+	while ((nbuf = ol_rx_test_nbuf_get(ctx)))
+		qdf_nbuf_free(nbuf);
+
+	ol_rx_test_cur_ctx = NULL;
+}
+
+static QDF_STATUS ol_rx_test_setup(struct ol_rx_test_ctx *ctx)
+{
+	struct ol_txrx_soc_t *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	struct ol_rx_reorder_t *rx_reorder;
+	qdf_nbuf_t nbuf;
+	int i;
+
+	qdf_mem_zero(ctx, sizeof(*ctx));
+
+	/* the trace replay parses LL rx descriptors through the htt pdev */
+	if (soc)
+		ctx->pdev = ol_txrx_get_pdev_from_pdev_id(soc,
+							  OL_TXRX_PDEV_ID);
+	if (ctx->pdev && ctx->pdev->cfg.is_high_latency)
+		ctx->pdev = NULL;
+
+	ctx->vdev = qdf_mem_malloc(sizeof(*ctx->vdev));
+	ctx->peer = qdf_mem_malloc(sizeof(*ctx->peer));
+	if (!ctx->vdev || !ctx->peer)
+		goto fail;
+
+	ctx->vdev->pdev = ctx->pdev;
+	ctx->peer->vdev = ctx->vdev;
+	ctx->peer->rx_opt_proc = ol_rx_test_deliver;
+	ctx->peer->tids_last_seq[OL_RX_TEST_TID] = IEEE80211_SEQ_MAX;
+
+	rx_reorder = &ctx->peer->tids_rx_reorder[OL_RX_TEST_TID];
+	ol_rx_reorder_init(rx_reorder, OL_RX_TEST_TID);
+	rx_reorder->array = qdf_mem_malloc(OL_RX_TEST_WIN_SZ *
+					   sizeof(*rx_reorder->array));
+	if (!rx_reorder->array)
+		goto fail;
+	rx_reorder->win_sz = OL_RX_TEST_WIN_SZ;
+	rx_reorder->win_sz_mask = OL_RX_TEST_WIN_SZ - 1;
+
+	for (i = 0; i < OL_RX_TEST_POOL_SZ; i++) {
+		nbuf = qdf_nbuf_alloc(NULL, OL_RX_TEST_BUF_SZ, 0, 4, false);
+		if (!nbuf)
+			goto fail;
+		qdf_mem_zero(qdf_nbuf_head(nbuf), OL_RX_TEST_BUF_SZ);
+		ol_rx_test_nbuf_put(ctx, nbuf);
+	}
+
+	ol_rx_test_cur_ctx = ctx;
+
+	return QDF_STATUS_SUCCESS;
+
+fail:
+	ol_rx_test_teardown(ctx);
+
+	return QDF_STATUS_E_NOMEM;
+}
+
+static uint32_t ol_rx_reorder_test_store(struct ol_rx_test_ctx *ctx)
+{
+	struct ol_rx_reorder_array_elem_t *elem;
+	qdf_nbuf_t first, second;
+	uint32_t errors = 0;
+	unsigned int idx = OL_RX_TEST_WIN_SZ + 3;
+
+	first = ol_rx_test_nbuf_get(ctx);
+	second = ol_rx_test_nbuf_get(ctx);
+	if (!first || !second) {
+		errors++;
+		goto out;
+	}
+
+	/* the index wraps into the window, a second store chains */
+	ol_rx_reorder_store(ctx->pdev, ctx->peer, OL_RX_TEST_TID, idx,
+			    first, first);
+	ol_rx_reorder_store(ctx->pdev, ctx->peer, OL_RX_TEST_TID, idx,
+			    second, second);
+
+	elem = &ctx->peer->tids_rx_reorder[OL_RX_TEST_TID].array[3];
+	cds_test_expect(elem->head == first, errors);
+	cds_test_expect(elem->tail == second, errors);
+	cds_test_expect(qdf_nbuf_next(first) == second, errors);
+
+	elem->head = NULL;
+	elem->tail = NULL;
+	qdf_nbuf_set_next(first, NULL);
+
+out:
+	if (first)
+		ol_rx_test_nbuf_put(ctx, first);
+	if (second)
+		ol_rx_test_nbuf_put(ctx, second);
+
+	return errors;
+}
+
+static const struct {
+	uint8_t first;
+	uint8_t last;
+	uint8_t idx_end;
+} ol_rx_test_hole_cases[] = {
+	{ 1, 5, 6 },
+	{ 3, 4, 5 },
+	{ 10, OL_RX_TEST_WIN_SZ - 1, 0 },
+	{ OL_RX_TEST_WIN_SZ - 2, OL_RX_TEST_WIN_SZ - 1, 0 },
+};
+
+static uint32_t ol_rx_reorder_test_first_hole(struct ol_rx_test_ctx *ctx)
+{
+	struct ol_rx_reorder_t *rx_reorder;
+	unsigned int idx_end;
+	qdf_nbuf_t marker;
+	uint32_t errors = 0;
+	int i, j;
+
+	rx_reorder = &ctx->peer->tids_rx_reorder[OL_RX_TEST_TID];
+	marker = ol_rx_test_nbuf_get(ctx);
+	if (!marker)
+		return 1;
+
+	/* an empty window has no present frames to bypass */
+	ol_rx_reorder_first_hole(ctx->peer, OL_RX_TEST_TID, &idx_end);
+	cds_test_expect(idx_end == 0, errors);
+
+	for (i = 0; i < ARRAY_SIZE(ol_rx_test_hole_cases); i++) {
+		for (j = ol_rx_test_hole_cases[i].first;
+		     j <= ol_rx_test_hole_cases[i].last; j++)
+			rx_reorder->array[j].head = marker;
+
+		ol_rx_reorder_first_hole(ctx->peer, OL_RX_TEST_TID, &idx_end);
+		if (idx_end != ol_rx_test_hole_cases[i].idx_end) {
+			txrx_nofl_err("FAIL: hole case %d; expected %u, found %u",
+				      i, ol_rx_test_hole_cases[i].idx_end,
+				      idx_end);
+			errors++;
+		}
+
+		for (j = ol_rx_test_hole_cases[i].first;
+		     j <= ol_rx_test_hole_cases[i].last; j++)
+			rx_reorder->array[j].head = NULL;
+	}
+
+	ol_rx_test_nbuf_put(ctx, marker);
+
+	return errors;
+}
+
+static const uint8_t ol_rx_test_block_order[][OL_RX_TEST_BLOCK_SZ] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7 },
+	{ 1, 0, 3, 2, 5, 4, 7, 6 },
+	{ 7, 6, 5, 4, 3, 2, 1, 0 },
+	{ 4, 5, 6, 7, 0, 1, 2, 3 },
+};
+
+static inline bool ol_rx_test_is_lost(uint32_t n)
+{
+	return (n % OL_RX_TEST_LOSS_PERIOD) == OL_RX_TEST_LOSS_PERIOD / 2;
+}
+
+/**
+ * ol_rx_reorder_test_trace() - replay a synthetic block ack trace
+ * @ctx: test context
+ *
+ * MPDUs arrive in blocks, each block permuted according to
+ * ol_rx_test_block_order and with a periodic MPDU lost. In-order runs at
+ * the head of the window are released as soon as they are complete, and a
+ * hole left by a lost MPDU is flushed at the end of its block the way a
+ * reorder timeout or a BAR would.
+ *
+ * Return: number of failures
+ */
+static uint32_t ol_rx_reorder_test_trace(struct ol_rx_test_ctx *ctx)
+{
+	struct ol_rx_reorder_array_elem_t *array;
+	const uint8_t *order;
+	uint32_t errors = 0, lost = 0;
+	uint32_t base, head, end, n, i;
+	uint64_t start, elapsed;
+	qdf_nbuf_t nbuf;
+
+	array = ctx->peer->tids_rx_reorder[OL_RX_TEST_TID].array;
+	head = 0;
+
+	start = ktime_get_ns();
+	for (base = 0; base < OL_RX_TEST_NUM_MPDUS;
+	     base += OL_RX_TEST_BLOCK_SZ) {
+		i = (base / OL_RX_TEST_BLOCK_SZ) %
+			ARRAY_SIZE(ol_rx_test_block_order);
+		order = ol_rx_test_block_order[i];
+		for (i = 0; i < OL_RX_TEST_BLOCK_SZ; i++) {
+			n = base + order[i];
+			if (ol_rx_test_is_lost(n)) {
+				lost++;
+				continue;
+			}
+
+			nbuf = ol_rx_test_nbuf_get(ctx);
+			if (!nbuf) {
+				txrx_nofl_err("FAIL: nbuf pool exhausted");
+				return errors + 1;
+			}
+
+			ol_rx_test_set_seq(ctx->pdev->htt_pdev, nbuf,
+					   n & (IEEE80211_SEQ_MAX - 1));
+			ol_rx_reorder_store(ctx->pdev, ctx->peer,
+					    OL_RX_TEST_TID, n, nbuf, nbuf);
+
+			end = head;
+			while (end < base + OL_RX_TEST_BLOCK_SZ &&
+			       array[end & (OL_RX_TEST_WIN_SZ - 1)].head)
+				end++;
+			if (end != head) {
+				ol_rx_reorder_release(ctx->vdev, ctx->peer,
+						      OL_RX_TEST_TID, head,
+						      end);
+				head = end;
+			}
+		}
+
+		if (head != base + OL_RX_TEST_BLOCK_SZ) {
+			ol_rx_reorder_flush(ctx->vdev, ctx->peer,
+					    OL_RX_TEST_TID, head,
+					    base + OL_RX_TEST_BLOCK_SZ,
+					    htt_rx_flush_release);
+			head = base + OL_RX_TEST_BLOCK_SZ;
+		}
+	}
+	elapsed = ktime_get_ns() - start;
+
+	cds_test_expect(!ctx->errors, errors);
+	cds_test_expect(ctx->delivered == OL_RX_TEST_NUM_MPDUS - lost, errors);
+	cds_test_expect(!ol_rx_test_array_reclaim(ctx), errors);
+
+	if (ctx->delivered)
+		do_div(elapsed, ctx->delivered);
+	txrx_nofl_info("ol_rx_reorder: %u mpdus, %u lost, %llu ns/mpdu",
+		       ctx->delivered, lost, elapsed);
+
+	return errors;
+}
+
+uint32_t ol_rx_reorder_unit_test(void)
+{
+	struct ol_rx_test_ctx ctx;
+	uint32_t errors = 0;
+
+	if (QDF_IS_STATUS_ERROR(ol_rx_test_setup(&ctx)))
+		return 1;
+
+	errors += ol_rx_reorder_test_store(&ctx);
+	errors += ol_rx_reorder_test_first_hole(&ctx);
+
+	if (ctx.pdev)
+		errors += ol_rx_reorder_test_trace(&ctx);
+	else
+		txrx_nofl_info("ol_rx_reorder: no LL pdev, trace skipped");
+
+	ol_rx_test_teardown(&ctx);
+
+	return errors;
+}
+
+#define OL_RX_TEST_FRAG_SZ		1500
+/* MSDU payload chosen so that the MIC straddles the last two fragments */
+#define OL_RX_TEST_MSDU_SZ		(8 * OL_RX_TEST_FRAG_SZ - 5)
+#define OL_RX_TEST_FRAME_SZ	(OL_RX_TEST_MSDU_SZ + IEEE80211_WEP_MICLEN)
+#define OL_RX_TEST_NUM_FRAGS \
+	((OL_RX_TEST_FRAME_SZ + OL_RX_TEST_FRAG_SZ - 1) / OL_RX_TEST_FRAG_SZ)
+#define OL_RX_TEST_DEFRAG_ITERATIONS	1000
+
+/* Michael test vectors, each key being the MIC of the previous vector */
+static const struct {
+	uint8_t key[DEFRAG_IEEE80211_KEY_LEN];
+	const char *msg;
+	uint8_t mic[IEEE80211_WEP_MICLEN];
+} ol_rx_michael_test_vectors[] = {
+	{ { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, "",
+	  { 0x82, 0x92, 0x5c, 0x1c, 0xa1, 0xd1, 0x30, 0xb8 } },
+	{ { 0x82, 0x92, 0x5c, 0x1c, 0xa1, 0xd1, 0x30, 0xb8 }, "M",
+	  { 0x43, 0x47, 0x21, 0xca, 0x40, 0x63, 0x9b, 0x3f } },
+	{ { 0x43, 0x47, 0x21, 0xca, 0x40, 0x63, 0x9b, 0x3f }, "Mi",
+	  { 0xe8, 0xf9, 0xbe, 0xca, 0xe9, 0x7e, 0x5d, 0x29 } },
+	{ { 0xe8, 0xf9, 0xbe, 0xca, 0xe9, 0x7e, 0x5d, 0x29 }, "Mic",
+	  { 0x90, 0x03, 0x8f, 0xc6, 0xcf, 0x13, 0xc1, 0xdb } },
+	{ { 0x90, 0x03, 0x8f, 0xc6, 0xcf, 0x13, 0xc1, 0xdb }, "Mich",
+	  { 0xd5, 0x5e, 0x10, 0x05, 0x10, 0x12, 0x89, 0x86 } },
+	{ { 0xd5, 0x5e, 0x10, 0x05, 0x10, 0x12, 0x89, 0x86 }, "Michael",
+	  { 0x0a, 0x94, 0x2b, 0x12, 0x4e, 0xca, 0xa5, 0x46 } },
+};
+
+static const uint8_t ol_rx_test_michael_key[DEFRAG_IEEE80211_KEY_LEN] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+};
+
+/* feed sizes used to split a buffer across Michael updates */
+static const uint32_t ol_rx_test_michael_splits[] = {
+	1, 2, 3, 5, 7, 64, 256, OL_RX_TEST_FRAG_SZ - 1
+};
+
+static uint32_t ol_rx_defrag_test_michael(void)
+{
+	struct ol_rx_michael m;
+	uint8_t mic[IEEE80211_WEP_MICLEN];
+	const char *msg;
+	uint32_t errors = 0;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(ol_rx_michael_test_vectors); i++) {
+		ol_rx_michael_init(&m, ol_rx_michael_test_vectors[i].key);
+		msg = ol_rx_michael_test_vectors[i].msg;
+		ol_rx_michael_update(&m, (const uint8_t *)msg, strlen(msg));
+		ol_rx_michael_final(&m, mic);
+		if (qdf_mem_cmp(mic, ol_rx_michael_test_vectors[i].mic,
+				sizeof(mic))) {
+			txrx_nofl_err("FAIL: Michael vector %d mismatch", i);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static uint32_t ol_rx_defrag_test_michael_split(uint8_t *data)
+{
+	struct ol_rx_michael m;
+	uint8_t ref[IEEE80211_WEP_MICLEN];
+	uint8_t mic[IEEE80211_WEP_MICLEN];
+	uint32_t errors = 0;
+	uint32_t off, chunk;
+	int i;
+
+	ol_rx_michael_init(&m, ol_rx_test_michael_key);
+	ol_rx_michael_update(&m, data, OL_RX_TEST_MSDU_SZ);
+	ol_rx_michael_final(&m, ref);
+
+	for (i = 0; i < ARRAY_SIZE(ol_rx_test_michael_splits); i++) {
+		ol_rx_michael_init(&m, ol_rx_test_michael_key);
+		for (off = 0; off < OL_RX_TEST_MSDU_SZ; off += chunk) {
+			chunk = qdf_min(ol_rx_test_michael_splits[i],
+					(uint32_t)OL_RX_TEST_MSDU_SZ - off);
+			ol_rx_michael_update(&m, data + off, chunk);
+		}
+		ol_rx_michael_final(&m, mic);
+		if (qdf_mem_cmp(mic, ref, sizeof(mic))) {
+			txrx_nofl_err("FAIL: Michael split %u mismatch",
+				      ol_rx_test_michael_splits[i]);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static void ol_rx_defrag_test_free(qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_t next;
+
+	while (nbuf) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+		qdf_nbuf_free(nbuf);
+		nbuf = next;
+	}
+}
+
+/**
+ * ol_rx_defrag_test_train() - build a decapped TKIP fragment train
+ * @frame: MSDU payload followed by its MIC
+ * @hdr: 802.11 header carried by every fragment
+ * @hdrsize: size of @hdr
+ *
+ * Return: fragments chained through next, NULL on allocation failure
+ */
+static qdf_nbuf_t ol_rx_defrag_test_train(const uint8_t *frame,
+					  const uint8_t *hdr, uint16_t hdrsize)
+{
+	qdf_nbuf_t head = NULL, tail = NULL, nbuf;
+	uint32_t off, len;
+
+	for (off = 0; off < OL_RX_TEST_FRAME_SZ; off += len) {
+		len = qdf_min((uint32_t)OL_RX_TEST_FRAG_SZ,
+			      (uint32_t)OL_RX_TEST_FRAME_SZ - off);
+		nbuf = qdf_nbuf_alloc(NULL, hdrsize + len, 0, 4, false);
+		if (!nbuf) {
+			ol_rx_defrag_test_free(head);
+			return NULL;
+		}
+		qdf_mem_copy(qdf_nbuf_put_tail(nbuf, hdrsize), hdr, hdrsize);
+		qdf_mem_copy(qdf_nbuf_put_tail(nbuf, len), frame + off, len);
+		if (tail)
+			qdf_nbuf_set_next(tail, nbuf);
+		else
+			head = nbuf;
+		tail = nbuf;
+	}
+
+	return head;
+}
+
+static uint32_t ol_rx_defrag_test_train_run(struct ol_txrx_pdev_t *pdev,
+					    uint8_t *frame)
+{
+	struct ieee80211_frame wh;
+	struct ol_rx_michael m;
+	uint8_t michdr[16];
+	uint64_t start, mic_ns = 0, join_ns = 0;
+	uint32_t errors = 0;
+	uint16_t hdrsize;
+	qdf_nbuf_t frags, msdu;
+	int i;
+
+	qdf_mem_zero(&wh, sizeof(wh));
+	wh.i_fc[0] = IEEE80211_FC0_TYPE_DATA;
+	wh.i_fc[1] = IEEE80211_FC1_DIR_TODS | IEEE80211_FC1_MORE_FRAG;
+	for (i = 0; i < QDF_MAC_ADDR_SIZE; i++) {
+		wh.i_addr1[i] = 0x10 + i;
+		wh.i_addr2[i] = 0x20 + i;
+		wh.i_addr3[i] = 0x30 + i;
+	}
+	hdrsize = ol_rx_frag_hdrsize(&wh);
+
+	ol_rx_defrag_michdr(&wh, michdr);
+	ol_rx_michael_init(&m, ol_rx_test_michael_key);
+	ol_rx_michael_update(&m, michdr, sizeof(michdr));
+	ol_rx_michael_update(&m, frame, OL_RX_TEST_MSDU_SZ);
+	ol_rx_michael_final(&m, frame + OL_RX_TEST_MSDU_SZ);
+
+	/* a corrupted last fragment must fail the MIC check */
+	frame[OL_RX_TEST_FRAME_SZ - 1] ^= 0x1;
+	frags = ol_rx_defrag_test_train(frame, (uint8_t *)&wh, hdrsize);
+	frame[OL_RX_TEST_FRAME_SZ - 1] ^= 0x1;
+	if (!frags)
+		return 1;
+	ol_rx_defrag_strip_hdrs(pdev->htt_pdev, frags, hdrsize);
+	cds_test_expect(!ol_rx_frag_tkip_demic(pdev, ol_rx_test_michael_key,
+					       frags, hdrsize), errors);
+	ol_rx_defrag_test_free(frags);
+
+	for (i = 0; i < OL_RX_TEST_DEFRAG_ITERATIONS; i++) {
+		frags = ol_rx_defrag_test_train(frame, (uint8_t *)&wh, hdrsize);
+		if (!frags)
+			return errors + 1;
+
+		start = ktime_get_ns();
+		ol_rx_defrag_strip_hdrs(pdev->htt_pdev, frags, hdrsize);
+		if (!ol_rx_frag_tkip_demic(pdev, ol_rx_test_michael_key,
+					   frags, hdrsize)) {
+			txrx_nofl_err("FAIL: TKIP demic of fragment train");
+			ol_rx_defrag_test_free(frags);
+			return errors + 1;
+		}
+		mic_ns += ktime_get_ns() - start;
+
+		start = ktime_get_ns();
+		msdu = ol_rx_defrag_join(pdev->htt_pdev, frags);
+		join_ns += ktime_get_ns() - start;
+		if (!msdu)
+			return errors + 1;
+
+		if (!i) {
+			cds_test_expect(qdf_nbuf_len(msdu) ==
+					hdrsize + OL_RX_TEST_MSDU_SZ, errors);
+			cds_test_expect(!qdf_mem_cmp(qdf_nbuf_data(msdu) +
+						     hdrsize, frame,
+						     OL_RX_TEST_MSDU_SZ),
+					errors);
+			cds_test_expect(!(((struct ieee80211_frame *)
+					   qdf_nbuf_data(msdu))->i_fc[1] &
+					  IEEE80211_FC1_MORE_FRAG), errors);
+		}
+		qdf_nbuf_free(msdu);
+	}
+
+	do_div(mic_ns, OL_RX_TEST_DEFRAG_ITERATIONS);
+	do_div(join_ns, OL_RX_TEST_DEFRAG_ITERATIONS);
+	txrx_nofl_info("ol_rx_defrag: %d x %d byte frags, %llu ns mic, %llu ns recombine",
+		       OL_RX_TEST_NUM_FRAGS, OL_RX_TEST_FRAG_SZ,
+		       mic_ns, join_ns);
+
+	return errors;
+}
+
+uint32_t ol_rx_defrag_unit_test(void)
+{
+	struct ol_txrx_soc_t *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	struct ol_txrx_pdev_t *pdev = NULL;
+	uint32_t errors = 0;
+	uint8_t *frame;
+	int i;
+
+	errors += ol_rx_defrag_test_michael();
+
+	frame = qdf_mem_malloc(OL_RX_TEST_FRAME_SZ);
+	if (!frame)
+		return errors + 1;
+	for (i = 0; i < OL_RX_TEST_MSDU_SZ; i++)
+		frame[i] = (uint8_t)(i * 7 + 3);
+
+	errors += ol_rx_defrag_test_michael_split(frame);
+
+	/* the fragment train is laid out as LL rx buffers */
+	if (soc)
+		pdev = ol_txrx_get_pdev_from_pdev_id(soc, OL_TXRX_PDEV_ID);
+	if (pdev && !pdev->cfg.is_high_latency)
+		errors += ol_rx_defrag_test_train_run(pdev, frame);
+	else
+		txrx_nofl_info("ol_rx_defrag: no LL pdev, train skipped");
+
+	qdf_mem_free(frame);
+
+	return errors;
+}
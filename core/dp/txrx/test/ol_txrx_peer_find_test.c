@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: ol_txrx_peer_find_test.c
+ *
+ * Unit tests for the peer MAC address hash. Tables of 1, 32 and 128 peers
+ * are checked for hits, misses, duplicate MAC addresses and removal, and
+ * the host cost of a lookup (including the peer reference get and
+ * release) is reported for each of them.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_trace.h"
+#include "qdf_types.h"
+#include "cds_utils.h"
+#include "ol_cfg.h"
+#include "ol_txrx_types.h"
+#include "ol_txrx_internal.h"
+#include "ol_txrx.h"
+#include "ol_txrx_peer_find.h"
+#include "ol_txrx_peer_find_test.h"
+
+#define OL_PEER_FIND_TEST_MAX_PEER_ID	255
+#define OL_PEER_FIND_TEST_ITERATIONS	100000
+#define OL_PEER_FIND_TEST_DBG_ID	PEER_DEBUG_ID_OL_INTERNAL
+
+static const uint32_t ol_peer_find_test_num_peers[] = { 1, 32, 128 };
+
+/**
+ * struct ol_peer_find_test_ctx - peer find test context
+ * @cfg: pdev config providing the peer id range
+ * @pdev: synthetic pdev holding the peer hash
+ * @vdev: synthetic vdev all the peers belong to
+ * @peers: peers added to the peer hash
+ * @num_peers: number of entries in @peers
+ */
+struct ol_peer_find_test_ctx {
+	struct txrx_pdev_cfg_t cfg;
+	struct ol_txrx_pdev_t *pdev;
+	struct ol_txrx_vdev_t *vdev;
+	struct ol_txrx_peer_t **peers;
+	uint32_t num_peers;
+};
+
+static void ol_peer_find_test_mac(union ol_txrx_align_mac_addr_t *mac_addr,
+				  uint32_t idx)
+{
+	qdf_mem_zero(mac_addr, sizeof(*mac_addr));
+	/* locally administered unicast address */
+	mac_addr->raw[0] = 0x02;
+	mac_addr->raw[3] = (idx >> 16) & 0xff;
+	mac_addr->raw[4] = (idx >> 8) & 0xff;
+	mac_addr->raw[5] = idx & 0xff;
+}
+
+static struct ol_txrx_peer_t *
+ol_peer_find_test_peer_add(struct ol_peer_find_test_ctx *ctx, uint32_t idx)
+{
+	struct ol_txrx_peer_t *peer;
+
+	peer = qdf_mem_malloc(sizeof(*peer));
+	if (!peer)
+		return NULL;
+
+	peer->vdev = ctx->vdev;
+	peer->valid = 1;
+	ol_peer_find_test_mac(&peer->mac_addr, idx);
+	qdf_atomic_init(&peer->ref_cnt);
+	qdf_atomic_inc(&peer->ref_cnt);
+	ol_txrx_peer_find_hash_add(ctx->pdev, peer);
+
+	return peer;
+}
+
+static void ol_peer_find_test_peer_del(struct ol_peer_find_test_ctx *ctx,
+				       struct ol_txrx_peer_t *peer)
+{
+	qdf_spin_lock_bh(&ctx->pdev->peer_ref_mutex);
+	ol_txrx_peer_find_hash_remove(ctx->pdev, peer);
+	qdf_spin_unlock_bh(&ctx->pdev->peer_ref_mutex);
+	ol_txrx_peer_free(peer);
+}
+
+static struct ol_txrx_peer_t *
+ol_peer_find_test_get(struct ol_peer_find_test_ctx *ctx,
+		      union ol_txrx_align_mac_addr_t *mac_addr)
+{
+	return ol_txrx_peer_find_hash_find_get_ref(ctx->pdev, mac_addr->raw,
+						   1, 1,
+						   OL_PEER_FIND_TEST_DBG_ID);
+}
+
+static uint32_t ol_peer_find_test_lookup(struct ol_peer_find_test_ctx *ctx)
+{
+	union ol_txrx_align_mac_addr_t mac_addr;
+	struct ol_txrx_peer_t *peer, *dup;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	for (i = 0; i < ctx->num_peers; i++) {
+		peer = ol_peer_find_test_get(ctx, &ctx->peers[i]->mac_addr);
+		cds_test_expect(peer == ctx->peers[i], errors);
+		if (peer)
+			ol_txrx_peer_release_ref(peer,
+						 OL_PEER_FIND_TEST_DBG_ID);
+	}
+
+	ol_peer_find_test_mac(&mac_addr, ctx->num_peers);
+	peer = ol_peer_find_test_get(ctx, &mac_addr);
+	cds_test_expect(!peer, errors);
+
+	/* the peer added first wins until it is removed */
+	dup = ol_peer_find_test_peer_add(ctx, 0);
+	if (!dup)
+		return errors + 1;
+
+	peer = ol_peer_find_test_get(ctx, &dup->mac_addr);
+	cds_test_expect(peer == ctx->peers[0], errors);
+	if (peer)
+		ol_txrx_peer_release_ref(peer, OL_PEER_FIND_TEST_DBG_ID);
+
+	ol_peer_find_test_peer_del(ctx, ctx->peers[0]);
+	ctx->peers[0] = dup;
+	peer = ol_peer_find_test_get(ctx, &dup->mac_addr);
+	cds_test_expect(peer == dup, errors);
+	if (peer)
+		ol_txrx_peer_release_ref(peer, OL_PEER_FIND_TEST_DBG_ID);
+
+	return errors;
+}
+
+static uint32_t ol_peer_find_test_bench(struct ol_peer_find_test_ctx *ctx)
+{
+	union ol_txrx_align_mac_addr_t mac_addr;
+	struct ol_txrx_peer_t *peer;
+	uint64_t start, hit_ns, miss_ns;
+	uint32_t errors = 0;
+	uint32_t misses = 0;
+	uint32_t i;
+
+	start = ktime_get_ns();
+	for (i = 0; i < OL_PEER_FIND_TEST_ITERATIONS; i++) {
+		peer = ol_peer_find_test_get(
+				ctx, &ctx->peers[i % ctx->num_peers]->mac_addr);
+		if (qdf_unlikely(!peer)) {
+			misses++;
+			continue;
+		}
+		ol_txrx_peer_release_ref(peer, OL_PEER_FIND_TEST_DBG_ID);
+	}
+	hit_ns = ktime_get_ns() - start;
+	cds_test_expect(!misses, errors);
+
+	ol_peer_find_test_mac(&mac_addr, ctx->num_peers);
+	misses = 0;
+	start = ktime_get_ns();
+	for (i = 0; i < OL_PEER_FIND_TEST_ITERATIONS; i++) {
+		if (!ol_peer_find_test_get(ctx, &mac_addr))
+			misses++;
+	}
+	miss_ns = ktime_get_ns() - start;
+	cds_test_expect(misses == OL_PEER_FIND_TEST_ITERATIONS, errors);
+
+	do_div(hit_ns, OL_PEER_FIND_TEST_ITERATIONS);
+	do_div(miss_ns, OL_PEER_FIND_TEST_ITERATIONS);
+	txrx_nofl_info("ol_txrx_peer_find: %u peers, %llu ns/hit, %llu ns/miss",
+		       ctx->num_peers, hit_ns, miss_ns);
+
+	return errors;
+}
+
+static uint32_t ol_peer_find_test_run(struct ol_peer_find_test_ctx *ctx,
+				      uint32_t num_peers)
+{
+	union ol_txrx_align_mac_addr_t mac_addr;
+	struct ol_txrx_peer_t *peer;
+	uint32_t errors = 0;
+	uint32_t i;
+
+	if (ol_txrx_peer_find_attach(ctx->pdev))
+		return 1;
+
+	ctx->num_peers = 0;
+	for (i = 0; i < num_peers; i++) {
+		ctx->peers[i] = ol_peer_find_test_peer_add(ctx, i);
+		if (!ctx->peers[i]) {
+			errors++;
+			goto del_peers;
+		}
+		ctx->num_peers++;
+	}
+
+	errors += ol_peer_find_test_lookup(ctx);
+	errors += ol_peer_find_test_bench(ctx);
+
+del_peers:
+	for (i = 0; i < ctx->num_peers; i++) {
+		mac_addr = ctx->peers[i]->mac_addr;
+		ol_peer_find_test_peer_del(ctx, ctx->peers[i]);
+		peer = ol_peer_find_test_get(ctx, &mac_addr);
+		cds_test_expect(!peer, errors);
+	}
+
+	/* waits for the peers freed through RCU */
+	ol_txrx_peer_find_detach(ctx->pdev);
+
+	return errors;
+}
+
+uint32_t ol_txrx_peer_find_unit_test(void)
+{
+	struct ol_peer_find_test_ctx ctx;
+	uint32_t errors = 0;
+	uint32_t max_peers = 0;
+	int i;
+
+	qdf_mem_zero(&ctx, sizeof(ctx));
+	for (i = 0; i < ARRAY_SIZE(ol_peer_find_test_num_peers); i++)
+		max_peers = qdf_max(max_peers, ol_peer_find_test_num_peers[i]);
+
+	ctx.cfg.max_peer_id = OL_PEER_FIND_TEST_MAX_PEER_ID;
+	ctx.pdev = qdf_mem_malloc(sizeof(*ctx.pdev));
+	ctx.vdev = qdf_mem_malloc(sizeof(*ctx.vdev));
+	ctx.peers = qdf_mem_malloc(max_peers * sizeof(*ctx.peers));
+	if (!ctx.pdev || !ctx.vdev || !ctx.peers) {
+		errors++;
+		goto free_ctx;
+	}
+
+	ctx.pdev->ctrl_pdev = (struct cdp_cfg *)&ctx.cfg;
+	qdf_spinlock_create(&ctx.pdev->peer_ref_mutex);
+	ctx.vdev->pdev = ctx.pdev;
+
+	for (i = 0; i < ARRAY_SIZE(ol_peer_find_test_num_peers); i++)
+		errors += ol_peer_find_test_run(&ctx,
+						ol_peer_find_test_num_peers[i]);
+
+	qdf_spinlock_destroy(&ctx.pdev->peer_ref_mutex);
+
+free_ctx:
+	qdf_mem_free(ctx.peers);
+	qdf_mem_free(ctx.vdev);
+	qdf_mem_free(ctx.pdev);
+
+	return errors;
+}
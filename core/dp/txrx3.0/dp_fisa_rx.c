@@ -21,6 +21,7 @@
 #include "dp_internal.h"
 #include <enet.h>
 #include <linux/skbuff.h>
+#include <net/tcp.h>
 
 #if defined(FISA_DEBUG_ENABLE)
 /**
@@ -308,6 +309,128 @@ dp_rx_flow_send_htt_operation_cmd(struct dp_pdev *pdev,
 	return dp_htt_rx_flow_fse_operation(pdev, &fse_op_cmd);
 }
 
+/**
+ * dp_rx_fisa_ft_idle() - Check if a flow entry is idle for the given time
+ * @sw_ft_entry: SW flow table entry
+ * @now: current time in ticks
+ * @idle_ms: idle time in ms
+ *
+ * Return: true if the flow received no packet for @idle_ms
+ */
+static inline bool dp_rx_fisa_ft_idle(struct dp_fisa_rx_sw_ft *sw_ft_entry,
+				      unsigned long now, uint32_t idle_ms)
+{
+	struct dp_fisa_rx_ft *ft_entry = dp_fisa_rx_sw_ft_to_ft(sw_ft_entry);
+
+	return (now - ft_entry->last_access) >=
+		qdf_system_msecs_to_ticks(idle_ms);
+}
+
+/**
+ * dp_rx_fisa_ft_evictable() - Check if a flow entry can be evicted
+ * @sw_ft_entry: SW flow table entry
+ * @reo_id: REO ring of the context which evicts the entry
+ * @now: current time in ticks
+ *
+ * Flow entries are only used from the REO ring context the flow is
+ * steered to. An entry of the own ring needs to be idle briefly, an entry
+ * of another ring must be idle for the aging timeout so that it is not
+ * evicted under the feet of that ring context.
+ *
+ * Return: true if the entry can be evicted
+ */
+static bool dp_rx_fisa_ft_evictable(struct dp_fisa_rx_sw_ft *sw_ft_entry,
+				    uint32_t reo_id, unsigned long now)
+{
+	if (sw_ft_entry->head_skb)
+		return false;
+
+	if (sw_ft_entry->napi_id == reo_id)
+		return dp_rx_fisa_ft_idle(sw_ft_entry, now,
+					  DP_FISA_RX_FT_LRU_MIN_IDLE_MS);
+
+	return dp_rx_fisa_ft_idle(sw_ft_entry, now,
+				  DP_FISA_RX_FT_AGING_TIMEOUT_MS);
+}
+
+/**
+ * dp_rx_fisa_evict_ft_entry() - Remove a flow from HW and SW FT
+ * @fisa_hdl: handle to FISA context
+ * @sw_ft_entry: SW flow table entry to be removed
+ *
+ * Called with dp_rx_fst_lock held, the caller has to invalidate the
+ * FSE cache afterwards. Until the invalidation is done, the FSE cache
+ * keeps returning the flow index for packets of the evicted flow, so the
+ * entry is marked for the lookup to check the flow tuple of its packets.
+ *
+ * Return: None
+ */
+static void dp_rx_fisa_evict_ft_entry(struct dp_rx_fst *fisa_hdl,
+				      struct dp_fisa_rx_sw_ft *sw_ft_entry)
+{
+	struct dp_fisa_rx_ft *ft_entry = dp_fisa_rx_sw_ft_to_ft(sw_ft_entry);
+
+	dp_fisa_debug("evict flow idx %d", sw_ft_entry->flow_id);
+	if (sw_ft_entry->hw_fse)
+		hal_rx_flow_delete_entry(fisa_hdl->hal_rx_fst,
+					 sw_ft_entry->hw_fse);
+
+	dp_fisa_rx_get_fst(fisa_hdl)->stats.hits += ft_entry->hits;
+	qdf_mem_zero(ft_entry, sizeof(*ft_entry));
+	ft_entry->recycled = true;
+	fisa_hdl->del_flow_count++;
+}
+
+/**
+ * dp_rx_fisa_setup_ft_entry() - Populate HW and SW FT entry for a new flow
+ * @fisa_hdl: handle to FISA context
+ * @sw_ft_entry: free SW flow table entry
+ * @hashed_flow_idx: index of @sw_ft_entry
+ * @flow_hash: flow hash of the new flow
+ * @vdev: Handle DP vdev to save in SW flow table
+ * @rx_flow_tuple_info: flow tuple of the new flow
+ * @reo_id: REO ring the flow is received on
+ * @is_flow_tcp: new flow is TCP
+ * @is_flow_udp: new flow is UDP
+ *
+ * Called with dp_rx_fst_lock held.
+ *
+ * Return: None
+ */
+static void
+dp_rx_fisa_setup_ft_entry(struct dp_rx_fst *fisa_hdl,
+			  struct dp_fisa_rx_sw_ft *sw_ft_entry,
+			  uint32_t hashed_flow_idx, uint32_t flow_hash,
+			  struct dp_vdev *vdev,
+			  struct cdp_rx_flow_tuple_info *rx_flow_tuple_info,
+			  uint32_t reo_id, bool is_flow_tcp, bool is_flow_udp)
+{
+	struct dp_fisa_rx_ft *ft_entry = dp_fisa_rx_sw_ft_to_ft(sw_ft_entry);
+
+	/* Add SW FT entry */
+	dp_rx_fisa_update_sw_ft_entry(sw_ft_entry, flow_hash, vdev,
+				      fisa_hdl->soc_hdl, hashed_flow_idx);
+
+	/* Add HW FT entry */
+	sw_ft_entry->hw_fse = dp_rx_fisa_setup_hw_fse(fisa_hdl,
+						      hashed_flow_idx,
+						      rx_flow_tuple_info,
+						      reo_id);
+	sw_ft_entry->is_populated = true;
+	sw_ft_entry->napi_id = reo_id;
+	qdf_mem_copy(&sw_ft_entry->rx_flow_tuple_info, rx_flow_tuple_info,
+		     sizeof(struct cdp_rx_flow_tuple_info));
+
+	sw_ft_entry->is_flow_tcp = is_flow_tcp;
+	sw_ft_entry->is_flow_udp = is_flow_udp;
+	qdf_mem_zero(&ft_entry->tcp, sizeof(struct dp_fisa_tcp_state));
+	ft_entry->last_access = qdf_system_ticks();
+	ft_entry->hits = 0;
+
+	fisa_hdl->add_flow_count++;
+	dp_fisa_rx_get_fst(fisa_hdl)->stats.misses++;
+}
+
 /**
  * dp_rx_fisa_add_ft_entry() - Add new flow to HW and SW FT if it is not added
  * @fisa_hdl: handle to FISA context
@@ -334,6 +457,9 @@ dp_rx_fisa_add_ft_entry(struct dp_rx_fst *fisa_hdl,
 	bool is_flow_tcp, is_flow_udp, is_flow_ipv6;
 	hal_soc_handle_t hal_soc_hdl = fisa_hdl->soc_hdl->hal_soc;
 	uint32_t reo_id = QDF_NBUF_CB_RX_CTX_ID(nbuf);
+	struct dp_fisa_rx_sw_ft *lru_ft_entry = NULL;
+	uint32_t lru_ft_entry_idx = 0;
+	unsigned long now;
 
 	is_flow_tcp = HAL_RX_TLV_GET_TCP_PROTO(rx_tlv_hdr);
 	is_flow_udp = HAL_RX_TLV_GET_UDP_PROTO(rx_tlv_hdr);
@@ -357,38 +483,22 @@ dp_rx_fisa_add_ft_entry(struct dp_rx_fst *fisa_hdl,
 	dp_fisa_debug("flow_hash 0x%x hashed_flow_idx 0x%x", flow_hash,
 		      hashed_flow_idx);
 	dp_fisa_debug("max_skid_length 0x%x", max_skid_length);
+	now = qdf_system_ticks();
 	qdf_spin_lock_bh(&fisa_hdl->dp_rx_fst_lock);
 	do {
-		sw_ft_entry = &(((struct dp_fisa_rx_sw_ft *)
-					fisa_hdl->base)[hashed_flow_idx]);
+		sw_ft_entry = dp_fisa_rx_get_sw_ft(fisa_hdl, hashed_flow_idx);
 		if (!sw_ft_entry->is_populated) {
-			/* Add SW FT entry */
-			dp_rx_fisa_update_sw_ft_entry(sw_ft_entry,
-						      flow_hash, vdev,
-						      fisa_hdl->soc_hdl,
-						      hashed_flow_idx);
 			if (!rx_flow_tuple_info.tuple_populated)
 				get_flow_tuple_from_nbuf(hal_soc_hdl,
 							 &rx_flow_tuple_info,
 							 nbuf, rx_tlv_hdr);
 
-			/* Add HW FT entry */
-			sw_ft_entry->hw_fse =
-				dp_rx_fisa_setup_hw_fse(fisa_hdl,
-							hashed_flow_idx,
-							&rx_flow_tuple_info,
-							reo_id);
-			sw_ft_entry->is_populated = true;
-			sw_ft_entry->napi_id = reo_id;
-			qdf_mem_copy(&sw_ft_entry->rx_flow_tuple_info,
-				     &rx_flow_tuple_info,
-				     sizeof(struct cdp_rx_flow_tuple_info));
-
-			sw_ft_entry->is_flow_tcp = is_flow_tcp;
-			sw_ft_entry->is_flow_udp = is_flow_udp;
-
+			dp_rx_fisa_setup_ft_entry(fisa_hdl, sw_ft_entry,
+						  hashed_flow_idx, flow_hash,
+						  vdev, &rx_flow_tuple_info,
+						  reo_id, is_flow_tcp,
+						  is_flow_udp);
 			is_fst_updated = true;
-			fisa_hdl->add_flow_count++;
 			break;
 		}
 		/* else */
@@ -400,6 +510,8 @@ dp_rx_fisa_add_ft_entry(struct dp_rx_fst *fisa_hdl,
 		if (is_same_flow(&sw_ft_entry->rx_flow_tuple_info,
 				 &rx_flow_tuple_info)) {
 			sw_ft_entry->vdev = vdev;
+			dp_fisa_rx_sw_ft_to_ft(sw_ft_entry)->last_access = now;
+			dp_fisa_rx_sw_ft_to_ft(sw_ft_entry)->hits++;
 			dp_fisa_debug("It is same flow fse entry idx %d",
 				      hashed_flow_idx);
 			/* Incoming flow tuple matches with existing
@@ -413,28 +525,39 @@ dp_rx_fisa_add_ft_entry(struct dp_rx_fst *fisa_hdl,
 		/* hash collision move to the next FT entry */
 		dp_fisa_debug("Hash collision %d", fisa_hdl->hash_collision_cnt);
 		fisa_hdl->hash_collision_cnt++;
-#ifdef NOT_YET /* assist Flow eviction algorithm */
-	/* uint32_t lru_ft_entry_time = 0xffffffff, lru_ft_entry_idx = 0; */
-		if (fisa_hdl->hw_ft_entry->timestamp < lru_ft_entry_time) {
-			lru_ft_entry_time = fisa_hdl->hw_ft_entry->timestamp;
+
+		/* remember the least recently used evictable entry */
+		if (dp_rx_fisa_ft_evictable(sw_ft_entry, reo_id, now) &&
+		    (!lru_ft_entry ||
+		     qdf_system_time_after(
+			dp_fisa_rx_sw_ft_to_ft(lru_ft_entry)->last_access,
+			dp_fisa_rx_sw_ft_to_ft(sw_ft_entry)->last_access))) {
+			lru_ft_entry = sw_ft_entry;
 			lru_ft_entry_idx = hashed_flow_idx;
 		}
-#endif
 		skid_count++;
 		hashed_flow_idx++;
 		hashed_flow_idx &= fisa_hdl->hash_mask;
 	} while (skid_count <= max_skid_length);
 
-	/*
-	 * fisa_hdl->flow_eviction_cnt++;
-	 * if (skid_count > max_skid_length)
-	 * Remove LRU flow from HW FT
-	 * Remove LRU flow from SW FT
-	 */
+	/* No free entry in the skid window, replace the LRU flow */
+	if (skid_count > max_skid_length && lru_ft_entry) {
+		dp_rx_fisa_evict_ft_entry(fisa_hdl, lru_ft_entry);
+		dp_fisa_rx_get_fst(fisa_hdl)->stats.evict_lru++;
+		sw_ft_entry = lru_ft_entry;
+		dp_rx_fisa_setup_ft_entry(fisa_hdl, sw_ft_entry,
+					  lru_ft_entry_idx, flow_hash, vdev,
+					  &rx_flow_tuple_info, reo_id,
+					  is_flow_tcp, is_flow_udp);
+		is_fst_updated = true;
+		skid_count = 0;
+	} else if (skid_count > max_skid_length) {
+		dp_fisa_rx_get_fst(fisa_hdl)->stats.add_fail++;
+	}
 	qdf_spin_unlock_bh(&fisa_hdl->dp_rx_fst_lock);
 
 	if (skid_count > max_skid_length) {
-		dp_fisa_debug("Max skid length reached flow cannot be added, evict exiting flow");
+		dp_fisa_debug("Max skid length reached, no idle flow to evict");
 		return NULL;
 	}
 
@@ -472,6 +595,28 @@ static bool is_flow_idx_valid(bool flow_invalid, bool flow_timeout)
 		return false;
 }
 
+/**
+ * dp_rx_fisa_ft_tuple_match() - Check if a msdu belongs to a flow entry
+ * @hal_soc_hdl: Handle to hal soc
+ * @sw_ft_entry: SW flow table entry the HW flow index points to
+ * @nbuf: incoming msdu
+ * @rx_tlv_hdr: Pointer to msdu TLVs
+ *
+ * Return: true if the flow tuple of @nbuf is the one of @sw_ft_entry
+ */
+static bool dp_rx_fisa_ft_tuple_match(hal_soc_handle_t hal_soc_hdl,
+				      struct dp_fisa_rx_sw_ft *sw_ft_entry,
+				      qdf_nbuf_t nbuf, uint8_t *rx_tlv_hdr)
+{
+	struct cdp_rx_flow_tuple_info rx_flow_tuple_info;
+
+	get_flow_tuple_from_nbuf(hal_soc_hdl, &rx_flow_tuple_info, nbuf,
+				 rx_tlv_hdr);
+
+	return is_same_flow(&sw_ft_entry->rx_flow_tuple_info,
+			    &rx_flow_tuple_info);
+}
+
 /**
  * dp_rx_get_fisa_flow() - Get FT entry corresponding to incoming nbuf
  * @fisa_hdl: handle to FISA context
@@ -488,13 +633,9 @@ dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
 	uint32_t flow_idx;
 	bool flow_invalid, flow_timeout, flow_idx_valid;
 	struct dp_fisa_rx_sw_ft *sw_ft_entry = NULL;
-	struct dp_fisa_rx_sw_ft *sw_ft_base = (struct dp_fisa_rx_sw_ft *)
-								fisa_hdl->base;
+	struct dp_fisa_rx_ft *ft_entry;
 	hal_soc_handle_t hal_soc_hdl = fisa_hdl->soc_hdl->hal_soc;
 
-	if (QDF_NBUF_CB_RX_TCP_PROTO(nbuf))
-		return sw_ft_entry;
-
 	rx_tlv_hdr = qdf_nbuf_data(nbuf);
 	hal_rx_msdu_get_flow_params(hal_soc_hdl, rx_tlv_hdr, &flow_invalid,
 				    &flow_timeout, &flow_idx);
@@ -506,8 +647,20 @@ dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
 	if (flow_idx_valid) {
 		dp_fisa_debug("flow_idx is valid 0x%x", flow_idx);
 		qdf_assert_always(flow_idx < fisa_hdl->max_entries);
-		sw_ft_entry = &sw_ft_base[flow_idx];
+		sw_ft_entry = dp_fisa_rx_get_sw_ft(fisa_hdl, flow_idx);
+		ft_entry = dp_fisa_rx_sw_ft_to_ft(sw_ft_entry);
+		/* FSE cache can still hold a flow evicted by the host */
+		if (qdf_unlikely(!sw_ft_entry->is_populated ||
+				 (ft_entry->recycled &&
+				  !dp_rx_fisa_ft_tuple_match(hal_soc_hdl,
+							     sw_ft_entry, nbuf,
+							     rx_tlv_hdr)))) {
+			dp_fisa_rx_get_fst(fisa_hdl)->stats.stale_idx++;
+			return NULL;
+		}
 		sw_ft_entry->vdev = vdev;
+		ft_entry->last_access = qdf_system_ticks();
+		ft_entry->hits++;
 
 		return sw_ft_entry;
 	}
@@ -519,58 +672,6 @@ dp_rx_get_fisa_flow(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
 	return sw_ft_entry;
 }
 
-#ifdef NOT_YET
-/**
- * dp_rx_fisa_aggr_tcp() - Aggregate incoming to TCP nbuf
- * @fisa_flow: Handle to SW flow entry, which holds the aggregated nbuf
- * @nbuf: Incoming nbuf
- *
- * Return: FISA_AGGR_DONE on successful aggregation
- */
-static enum fisa_aggr_ret
-dp_rx_fisa_aggr_tcp(struct dp_fisa_rx_sw_ft *fisa_flow,	qdf_nbuf_t nbuf)
-{
-	qdf_nbuf_t head_skb = fisa_flow->head_skb;
-	struct iphdr *iph;
-	uint32_t tcp_data_len;
-
-	fisa_flow->bytes_aggregated += qdf_nbuf_len(nbuf);
-	if (!head_skb) {
-		/* First nbuf for the flow */
-		dp_fisa_debug("first head skb");
-		fisa_flow->head_skb = nbuf;
-		return FISA_AGGR_DONE;
-	}
-
-	tcp_data_len = (ntohs(iph->tot_len) - sizeof(struct iphdr) -
-			sizeof(struct tcphdr));
-	qdf_nbuf_pull_head(nbuf, (nbuf->len - tcp_data_len));
-
-	if (qdf_nbuf_get_ext_list(head_skb)) {
-		/* this is 3rd skb after head skb, 2nd skb */
-		fisa_flow->last_skb->next = nbuf;
-	} else {
-		/* 1st skb after head skb */
-		qdf_nbuf_append_ext_list(head_skb, nbuf,
-					 fisa_flow->cumulative_ip_length);
-		qdf_nbuf_set_is_frag(head, 1);
-	}
-
-	fisa_flow->last_skb = nbuf;
-	fisa_flow->aggr_count++;
-
-	/* move it to while flushing the flow, that is update before flushing */
-	return FISA_AGGR_DONE;
-}
-#else
-static enum fisa_aggr_ret
-dp_rx_fisa_aggr_tcp(struct dp_rx_fst *fisa_hdl,
-		    struct dp_fisa_rx_sw_ft *fisa_flow,	qdf_nbuf_t nbuf)
-{
-	return FISA_AGGR_DONE;
-}
-#endif
-
 /**
  * get_transport_payload_offset() - Get offset to payload
  * @fisa_hdl: Handle to FISA context
@@ -829,41 +930,93 @@ out:
  * @vdev: handle to dp_vdev
  * @fisa_flow: Flow for which aggregates to be flushed
  *
+ * Rewrites the head segment headers to describe the whole aggregate and
+ * hands it to the stack as a TCPv4 GSO skb, the same way GRO completes a
+ * TCP aggregate.
+ *
  * Return: None
  */
 static void
 dp_rx_fisa_flush_tcp_flow(struct dp_vdev *vdev,
 			  struct dp_fisa_rx_sw_ft *fisa_flow)
 {
+	struct dp_fisa_tcp_state *tcp = &dp_fisa_rx_sw_ft_to_ft(fisa_flow)->tcp;
 	qdf_nbuf_t head_skb = fisa_flow->head_skb;
 	struct iphdr *head_skb_iph;
+	struct tcphdr *head_skb_tcph;
 	struct skb_shared_info *shinfo;
+	struct dp_vdev *fisa_flow_vdev;
+	uint32_t tcp_len;
+	__be32 *opt;
 
 	if (!head_skb) {
 		dp_fisa_debug("Already flushed");
 		return;
 	}
 
-	shinfo = skb_shinfo(head_skb);
-
-	/* Update the head_skb before flush */
 	head_skb->hash = fisa_flow->flow_hash;
 	head_skb->sw_hash = 1;
-	shinfo->gso_type = SKB_GSO_UDP_L4;
 
-	head_skb_iph = (struct iphdr *)(qdf_nbuf_data(head_skb) +
+	if (tcp->segs > 1) {
+		shinfo = skb_shinfo(head_skb);
+		head_skb_iph = (struct iphdr *)(qdf_nbuf_data(head_skb) +
 					fisa_flow->head_skb_ip_hdr_offset);
+		head_skb_tcph = (struct tcphdr *)((uint8_t *)head_skb_iph +
+					fisa_flow->head_skb_l4_hdr_offset);
+		tcp_len = tcp->thlen + tcp->payload_len;
 
-	head_skb_iph->tot_len = fisa_flow->adjusted_cumulative_ip_length;
-	head_skb_iph->check = ip_fast_csum((u8 *)head_skb_iph,
-					   head_skb_iph->ihl);
+		head_skb_iph->tot_len = qdf_htons(sizeof(struct iphdr) +
+						  tcp_len);
+		head_skb_iph->check = 0;
+		head_skb_iph->check = ip_fast_csum((u8 *)head_skb_iph,
+						   head_skb_iph->ihl);
 
-	qdf_nbuf_set_next(fisa_flow->head_skb, NULL);
+		/* report the latest timestamps to the stack for RTT */
+		if (tcp->has_ts) {
+			opt = (__be32 *)(head_skb_tcph + 1);
+			opt[1] = qdf_htonl(tcp->tsval);
+			opt[2] = qdf_htonl(tcp->tsecr);
+		}
+		if (tcp->psh)
+			tcp_flag_word(head_skb_tcph) |= TCP_FLAG_PSH;
+
+		head_skb_tcph->check = ~tcp_v4_check(tcp_len,
+						     head_skb_iph->saddr,
+						     head_skb_iph->daddr, 0);
+		head_skb->csum_start = (u8 *)head_skb_tcph - head_skb->head;
+		head_skb->csum_offset = offsetof(struct tcphdr, check);
+		head_skb->ip_summed = CHECKSUM_PARTIAL;
+
+		shinfo->gso_size = tcp->mss;
+		shinfo->gso_segs = tcp->segs;
+		shinfo->gso_type = SKB_GSO_TCPV4;
+
+		/* already aggregated, keep HDD from passing it through GRO */
+		QDF_NBUF_CB_RX_TCP_PROTO(head_skb) = 0;
+	}
+
+	qdf_nbuf_set_next(head_skb, NULL);
 	if (fisa_flow->last_skb)
 		qdf_nbuf_set_next(fisa_flow->last_skb, NULL);
-	vdev->osif_rx(vdev->osif_vdev, fisa_flow->head_skb);
 
+	fisa_flow_vdev = dp_get_vdev_from_soc_vdev_id_wifi3(fisa_flow->soc_hdl,
+				QDF_NBUF_CB_RX_VDEV_ID(head_skb));
+	if (qdf_unlikely(!fisa_flow_vdev ||
+			 (fisa_flow_vdev != fisa_flow->vdev))) {
+		qdf_nbuf_free(head_skb);
+		goto out;
+	}
+
+	if (!vdev->osif_rx || QDF_STATUS_SUCCESS !=
+	    vdev->osif_rx(vdev->osif_vdev, head_skb))
+		qdf_nbuf_free(head_skb);
+
+out:
 	fisa_flow->head_skb = NULL;
+	fisa_flow->last_skb = NULL;
+	tcp->segs = 0;
+	tcp->payload_len = 0;
+	tcp->psh = false;
 
 	fisa_flow->flush_count++;
 }
@@ -886,6 +1039,252 @@ static void dp_rx_fisa_flush_flow(struct dp_vdev *vdev,
 		dp_rx_fisa_flush_tcp_flow(vdev, flow);
 }
 
+/**
+ * dp_rx_fisa_deliver_nbuf() - Deliver a nbuf to the stack without FISA
+ * @vdev: handle to DP vdev
+ * @nbuf: nbuf with RX TLVs already skipped
+ *
+ * Return: None
+ */
+static void dp_rx_fisa_deliver_nbuf(struct dp_vdev *vdev, qdf_nbuf_t nbuf)
+{
+	qdf_nbuf_set_next(nbuf, NULL);
+	if (!vdev->osif_rx || QDF_STATUS_SUCCESS !=
+	    vdev->osif_rx(vdev->osif_vdev, nbuf))
+		qdf_nbuf_free(nbuf);
+}
+
+/* TCP flags which end a FISA TCP aggregate */
+#define DP_FISA_TCP_FLUSH_FLAGS (TCP_FLAG_FIN | TCP_FLAG_SYN | TCP_FLAG_RST | \
+				 TCP_FLAG_URG | TCP_FLAG_ECE | TCP_FLAG_CWR)
+
+/* First word of an aligned timestamp only TCP option block */
+#define DP_FISA_TCP_TS_OPT_WORD ((TCPOPT_NOP << 24) | (TCPOPT_NOP << 16) | \
+				 (TCPOPT_TIMESTAMP << 8) | TCPOLEN_TIMESTAMP)
+
+/**
+ * dp_rx_fisa_tcp_parse() - Check if a TCP segment can be aggregated
+ * @nbuf: nbuf pointing to the L2 header
+ * @ip_hdr_offset: offset of the IP header in the nbuf
+ * @iph: IP header of the segment
+ * @tcph: TCP header of the segment
+ * @payload_len: return argument, TCP payload length
+ * @has_ts: return argument, segment carries the timestamp option
+ * @tsval: return argument, timestamp value
+ * @tsecr: return argument, timestamp echo reply
+ *
+ * Only IPv4 segments without IP options or fragmentation, with a HW
+ * verified checksum, carrying data with ACK (and optionally PSH) and no
+ * TCP option other than the timestamp can be aggregated.
+ *
+ * Return: true if the segment is eligible for aggregation
+ */
+static bool dp_rx_fisa_tcp_parse(qdf_nbuf_t nbuf, uint32_t ip_hdr_offset,
+				 struct iphdr *iph, struct tcphdr *tcph,
+				 uint32_t *payload_len, bool *has_ts,
+				 uint32_t *tsval, uint32_t *tsecr)
+{
+	uint32_t ip_len, thlen;
+	__be32 *opt;
+
+	if (nbuf->ip_summed != CHECKSUM_UNNECESSARY)
+		return false;
+
+	if (iph->version != 4 || iph->ihl != 5 ||
+	    iph->protocol != IPPROTO_TCP ||
+	    (iph->frag_off & qdf_htons(IP_MF | IP_OFFSET)))
+		return false;
+
+	ip_len = qdf_ntohs(iph->tot_len);
+	if (ip_hdr_offset + ip_len > qdf_nbuf_len(nbuf))
+		return false;
+
+	thlen = tcph->doff * 4;
+	if (thlen < sizeof(struct tcphdr) ||
+	    sizeof(struct iphdr) + thlen >= ip_len)
+		return false;
+
+	if ((tcp_flag_word(tcph) & DP_FISA_TCP_FLUSH_FLAGS) ||
+	    !(tcp_flag_word(tcph) & TCP_FLAG_ACK))
+		return false;
+
+	*has_ts = false;
+	if (thlen != sizeof(struct tcphdr)) {
+		opt = (__be32 *)(tcph + 1);
+		if (thlen != sizeof(struct tcphdr) + TCPOLEN_TSTAMP_ALIGNED ||
+		    opt[0] != qdf_htonl(DP_FISA_TCP_TS_OPT_WORD))
+			return false;
+		*has_ts = true;
+		*tsval = qdf_ntohl(opt[1]);
+		*tsecr = qdf_ntohl(opt[2]);
+	}
+
+	*payload_len = ip_len - sizeof(struct iphdr) - thlen;
+
+	return true;
+}
+
+/**
+ * dp_rx_fisa_tcp_hdr_match() - Check if a segment matches the aggregate
+ * @tcp: TCP aggregation state of the flow
+ * @iph: IP header of the segment
+ * @tcph: TCP header of the segment
+ * @payload_len: TCP payload length of the segment
+ * @has_ts: segment carries the timestamp option
+ * @tsval: timestamp value of the segment
+ *
+ * Return: true if the segment headers allow it to join the aggregate
+ */
+static bool dp_rx_fisa_tcp_hdr_match(struct dp_fisa_tcp_state *tcp,
+				     struct iphdr *iph, struct tcphdr *tcph,
+				     uint32_t payload_len, bool has_ts,
+				     uint32_t tsval)
+{
+	if (qdf_ntohl(tcph->ack_seq) != tcp->ack_seq ||
+	    qdf_ntohs(tcph->window) != tcp->window ||
+	    tcph->doff * 4 != tcp->thlen || has_ts != tcp->has_ts ||
+	    iph->ttl != tcp->ttl || iph->tos != tcp->tos ||
+	    payload_len > tcp->mss)
+		return false;
+
+	/* timestamps must not go backwards within an aggregate */
+	if (has_ts && (int32_t)(tsval - tcp->tsval) < 0)
+		return false;
+
+	return true;
+}
+
+/**
+ * dp_rx_fisa_aggr_tcp() - Aggregate incoming TCP nbuf
+ * @fisa_hdl: handle to FISA context
+ * @vdev: handle to DP vdev
+ * @fisa_flow: Handle to SW flow entry, which holds the aggregated nbuf
+ * @nbuf: Incoming nbuf, pointing to the RX TLVs
+ *
+ * Unlike UDP, TCP aggregation is fully done in software: in-order
+ * segments with identical headers are chained into the frag_list of the
+ * head segment. Any segment which cannot be aggregated first flushes the
+ * ongoing aggregate and is then delivered as is, so ordering is kept.
+ *
+ * Return: FISA_AGGR_DONE, the nbuf is always consumed
+ */
+static enum fisa_aggr_ret
+dp_rx_fisa_aggr_tcp(struct dp_rx_fst *fisa_hdl, struct dp_vdev *vdev,
+		    struct dp_fisa_rx_sw_ft *fisa_flow, qdf_nbuf_t nbuf)
+{
+	struct dp_fisa_tcp_state *tcp = &dp_fisa_rx_sw_ft_to_ft(fisa_flow)->tcp;
+	uint8_t *rx_tlv_hdr = qdf_nbuf_data(nbuf);
+	uint32_t ip_hdr_offset = HAL_RX_TLV_GET_IP_OFFSET(rx_tlv_hdr);
+	uint32_t l4_hdr_offset = HAL_RX_TLV_GET_TCP_OFFSET(rx_tlv_hdr);
+	uint32_t l2_hdr_offset =
+		hal_rx_msdu_end_l3_hdr_padding_get(fisa_hdl->soc_hdl->hal_soc,
+						   rx_tlv_hdr);
+	qdf_nbuf_t head_skb;
+	struct iphdr *iph;
+	struct tcphdr *tcph;
+	uint32_t payload_len = 0, tsval = 0, tsecr = 0, seq;
+	bool has_ts = false, psh;
+
+	qdf_nbuf_pull_head(nbuf, RX_PKT_TLVS_LEN + l2_hdr_offset);
+	iph = (struct iphdr *)(qdf_nbuf_data(nbuf) + ip_hdr_offset);
+	tcph = (struct tcphdr *)((uint8_t *)iph + l4_hdr_offset);
+
+	if (!dp_rx_fisa_tcp_parse(nbuf, ip_hdr_offset, iph, tcph,
+				  &payload_len, &has_ts, &tsval, &tsecr)) {
+		if (fisa_flow->head_skb) {
+			if (tcp_flag_word(tcph) & DP_FISA_TCP_FLUSH_FLAGS)
+				tcp->flush_flags++;
+			else
+				tcp->flush_mismatch++;
+			dp_rx_fisa_flush_flow(vdev, fisa_flow);
+		}
+		tcp->not_eligible++;
+		dp_rx_fisa_deliver_nbuf(vdev, nbuf);
+		return FISA_AGGR_DONE;
+	}
+
+	seq = qdf_ntohl(tcph->seq);
+	psh = !!(tcp_flag_word(tcph) & TCP_FLAG_PSH);
+
+	if (fisa_flow->head_skb) {
+		if (seq != tcp->next_seq) {
+			tcp->flush_ooo++;
+			dp_rx_fisa_flush_flow(vdev, fisa_flow);
+		} else if (!dp_rx_fisa_tcp_hdr_match(tcp, iph, tcph,
+						     payload_len, has_ts,
+						     tsval)) {
+			tcp->flush_mismatch++;
+			dp_rx_fisa_flush_flow(vdev, fisa_flow);
+		} else if (tcp->segs >= DP_FISA_TCP_MAX_AGGR_SEGS ||
+			   tcp->payload_len + payload_len >
+			   DP_FISA_TCP_MAX_AGGR_LEN) {
+			tcp->flush_size++;
+			dp_rx_fisa_flush_flow(vdev, fisa_flow);
+		}
+	}
+
+	head_skb = fisa_flow->head_skb;
+	if (!head_skb) {
+		dp_fisa_debug("first tcp head skb nbuf %pK", nbuf);
+		/* drop L2 padding of short frames */
+		qdf_nbuf_set_pktlen(nbuf, ip_hdr_offset +
+				    qdf_ntohs(iph->tot_len));
+		fisa_flow->head_skb = nbuf;
+		fisa_flow->last_skb = NULL;
+		fisa_flow->head_skb_ip_hdr_offset = ip_hdr_offset;
+		fisa_flow->head_skb_l4_hdr_offset = l4_hdr_offset;
+		fisa_flow->cur_aggr = 0;
+
+		tcp->ack_seq = qdf_ntohl(tcph->ack_seq);
+		tcp->window = qdf_ntohs(tcph->window);
+		tcp->thlen = tcph->doff * 4;
+		tcp->ttl = iph->ttl;
+		tcp->tos = iph->tos;
+		tcp->has_ts = has_ts;
+		tcp->mss = payload_len;
+		tcp->payload_len = 0;
+		tcp->segs = 0;
+		tcp->psh = false;
+	} else {
+		/* keep TCP payload only */
+		qdf_nbuf_pull_head(nbuf, ip_hdr_offset + sizeof(struct iphdr) +
+				   tcp->thlen);
+		qdf_nbuf_set_pktlen(nbuf, payload_len);
+
+		if (qdf_nbuf_get_ext_list(head_skb)) {
+			qdf_nbuf_set_next(fisa_flow->last_skb, nbuf);
+		} else {
+			skb_shinfo(head_skb)->frag_list = nbuf;
+			qdf_nbuf_set_is_frag(nbuf, 1);
+		}
+		head_skb->data_len += payload_len;
+		head_skb->len += payload_len;
+		head_skb->truesize += nbuf->truesize;
+		fisa_flow->last_skb = nbuf;
+		fisa_flow->cur_aggr++;
+		tcp->aggr_segs++;
+	}
+
+	tcp->next_seq = seq + payload_len;
+	tcp->payload_len += payload_len;
+	tcp->segs++;
+	tcp->tsval = tsval;
+	tcp->tsecr = tsecr;
+	tcp->psh |= psh;
+	fisa_flow->aggr_count++;
+	fisa_flow->bytes_aggregated += payload_len;
+
+	/* PSH or a short segment ends the burst, do not hold it back */
+	if (psh) {
+		tcp->flush_flags++;
+		dp_rx_fisa_flush_flow(vdev, fisa_flow);
+	} else if (payload_len < tcp->mss) {
+		dp_rx_fisa_flush_flow(vdev, fisa_flow);
+	}
+
+	return FISA_AGGR_DONE;
+}
+
 /**
  * dp_add_nbuf_to_fisa_flow() - Aggregate incoming nbuf
  * @fisa_hdl: handle to fisa context
@@ -906,6 +1305,10 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 	uint16_t hal_cumultive_ip_len;
 	hal_soc_handle_t hal_soc_hdl = fisa_hdl->soc_hdl->hal_soc;
 
+	/* TCP does not use the HW cumulative length/continuation assist */
+	if (fisa_flow->is_flow_tcp)
+		return dp_rx_fisa_aggr_tcp(fisa_hdl, vdev, fisa_flow, nbuf);
+
 	dump_tlvs(hal_soc_hdl, rx_tlv_hdr, QDF_TRACE_LEVEL_ERROR);
 	dp_fisa_debug("nbuf: %pK nbuf->next:%pK nbuf->data:%pK len %d data_len %d",
 		      nbuf, qdf_nbuf_next(nbuf), qdf_nbuf_data(nbuf), nbuf->len,
@@ -993,16 +1396,29 @@ static int dp_add_nbuf_to_fisa_flow(struct dp_rx_fst *fisa_hdl,
 		qdf_assert(0);
 	}
 
-	if (fisa_flow->is_flow_udp) {
-		dp_rx_fisa_aggr_udp(fisa_hdl, fisa_flow, nbuf);
-	} else if (fisa_flow->is_flow_tcp) {
-		qdf_assert(0);
-		dp_rx_fisa_aggr_tcp(fisa_hdl, fisa_flow, nbuf);
-	}
+	dp_rx_fisa_aggr_udp(fisa_hdl, fisa_flow, nbuf);
 
 	return FISA_AGGR_DONE;
 }
 
+/**
+ * dp_rx_fisa_flow_supported() - Check if FISA handles the flow of a nbuf
+ * @rx_tlv_hdr: RX TLVs of the nbuf
+ *
+ * Only IPv4 TCP and UDP flows are added to the flow table, so the other
+ * frames skip the flow lookup altogether.
+ *
+ * Return: true if the nbuf flow can be added to the flow table
+ */
+static inline bool dp_rx_fisa_flow_supported(uint8_t *rx_tlv_hdr)
+{
+	if (HAL_RX_TLV_GET_IPV6(rx_tlv_hdr))
+		return false;
+
+	return HAL_RX_TLV_GET_TCP_PROTO(rx_tlv_hdr) ||
+	       HAL_RX_TLV_GET_UDP_PROTO(rx_tlv_hdr);
+}
+
 /**
  * dp_is_nbuf_bypass_fisa() - FISA bypass check for RX frame
  * @nbuf: RX nbuf pointer
@@ -1019,6 +1435,107 @@ static bool dp_is_nbuf_bypass_fisa(qdf_nbuf_t nbuf)
 	return false;
 }
 
+/**
+ * dp_rx_fisa_flush_flow_wrap() - flush fisa flow by invoking
+ *				  dp_rx_fisa_flush_flow()
+ * @sw_ft: fisa flow for which aggregates to be flushed
+ *
+ * Return: None.
+ */
+static void dp_rx_fisa_flush_flow_wrap(struct dp_fisa_rx_sw_ft *sw_ft)
+{
+	/* Save the ip_len and checksum as hardware assist is
+	 * always based on his start of aggregation
+	 */
+	sw_ft->napi_flush_cumulative_l4_checksum =
+				sw_ft->cumulative_l4_checksum;
+	sw_ft->napi_flush_cumulative_ip_length =
+				sw_ft->hal_cumultive_ip_len;
+	dp_fisa_debug("napi_flush_cumulative_ip_length 0x%x",
+		      sw_ft->napi_flush_cumulative_ip_length);
+
+	dp_rx_fisa_flush_flow(sw_ft->vdev,
+			      sw_ft);
+	sw_ft->cur_aggr = 0;
+}
+
+/**
+ * dp_rx_fisa_age_flows() - Evict idle flows of a REO ring from HW and SW FT
+ * @fisa_hdl: handle to FISA context
+ * @vdev: handle to DP vdev, used to reach the pdev for the HTT command
+ * @reo_id: REO ring of the calling RX context
+ *
+ * Runs lazily from the RX path at most once per aging period and REO
+ * ring, so that short lived flows do not keep the flow table full. Only
+ * the flows steered to @reo_id are aged: they are not used by any other
+ * RX context, so their pending aggregate can be flushed before the entry
+ * is cleared. One full FSE cache invalidation is sent for all flows
+ * evicted in a pass.
+ *
+ * Return: None
+ */
+static void dp_rx_fisa_age_flows(struct dp_rx_fst *fisa_hdl,
+				 struct dp_vdev *vdev, uint32_t reo_id)
+{
+	struct dp_fisa_rx_fst *host_fst = dp_fisa_rx_get_fst(fisa_hdl);
+	struct cdp_rx_flow_tuple_info rx_flow_tuple_info;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	unsigned long now = qdf_system_ticks();
+	uint32_t evicted = 0;
+	uint32_t i;
+	QDF_STATUS status;
+
+	if (qdf_unlikely(reo_id >= MAX_REO_DEST_RINGS))
+		return;
+
+	/* Only written from the RX context of @reo_id */
+	if (qdf_likely(!qdf_system_time_after(now,
+					      host_fst->next_aging[reo_id])))
+		return;
+
+	host_fst->next_aging[reo_id] = now +
+		qdf_system_msecs_to_ticks(DP_FISA_RX_FT_AGING_PERIOD_MS);
+
+	for (i = 0; i < fisa_hdl->max_entries; i++) {
+		sw_ft_entry = dp_fisa_rx_get_sw_ft(fisa_hdl, i);
+		if (!sw_ft_entry->is_populated ||
+		    sw_ft_entry->napi_id != reo_id ||
+		    !dp_rx_fisa_ft_idle(sw_ft_entry, now,
+					DP_FISA_RX_FT_AGING_TIMEOUT_MS))
+			continue;
+
+		if (sw_ft_entry->head_skb)
+			dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
+
+		qdf_spin_lock_bh(&fisa_hdl->dp_rx_fst_lock);
+		/* May have been replaced by another ring meanwhile */
+		if (!sw_ft_entry->is_populated ||
+		    sw_ft_entry->napi_id != reo_id) {
+			qdf_spin_unlock_bh(&fisa_hdl->dp_rx_fst_lock);
+			continue;
+		}
+
+		if (!evicted)
+			qdf_mem_copy(&rx_flow_tuple_info,
+				     &sw_ft_entry->rx_flow_tuple_info,
+				     sizeof(rx_flow_tuple_info));
+		dp_rx_fisa_evict_ft_entry(fisa_hdl, sw_ft_entry);
+		host_fst->stats.evict_aged++;
+		qdf_spin_unlock_bh(&fisa_hdl->dp_rx_fst_lock);
+		evicted++;
+	}
+
+	if (!evicted)
+		return;
+
+	dp_fisa_debug("reo %u aged out %u flows", reo_id, evicted);
+	status = dp_rx_flow_send_htt_operation_cmd(vdev->pdev,
+					DP_HTT_FST_CACHE_INVALIDATE_FULL,
+					&rx_flow_tuple_info);
+	if (QDF_STATUS_SUCCESS != status)
+		dp_err("Failed to send the cache invalidation");
+}
+
 /**
  * dp_fisa_rx() - Entry function to FISA to handle aggregation
  * @soc: core txrx main context
@@ -1036,6 +1553,9 @@ QDF_STATUS dp_fisa_rx(struct dp_soc *soc, struct dp_vdev *vdev,
 	struct dp_fisa_rx_sw_ft *fisa_flow;
 	int fisa_ret;
 
+	dp_rx_fisa_age_flows(dp_fisa_rx_hdl, vdev,
+			     QDF_NBUF_CB_RX_CTX_ID(nbuf_list));
+
 	head_nbuf = nbuf_list;
 
 	while (head_nbuf) {
@@ -1049,6 +1569,9 @@ QDF_STATUS dp_fisa_rx(struct dp_soc *soc, struct dp_vdev *vdev,
 		qdf_nbuf_push_head(head_nbuf, RX_PKT_TLVS_LEN +
 				   QDF_NBUF_CB_RX_PACKET_L3_HDR_PAD(head_nbuf));
 
+		if (!dp_rx_fisa_flow_supported(qdf_nbuf_data(head_nbuf)))
+			goto pull_nbuf;
+
 		/* Add new flow if the there is no ongoing flow */
 		fisa_flow = dp_rx_get_fisa_flow(dp_fisa_rx_hdl, vdev,
 						head_nbuf);
@@ -1093,8 +1616,8 @@ next_msdu:
 QDF_STATUS dp_rx_dump_fisa_stats(struct dp_soc *soc)
 {
 	struct dp_rx_fst *rx_fst = soc->rx_fst;
-	struct dp_fisa_rx_sw_ft *sw_ft_entry =
-		&((struct dp_fisa_rx_sw_ft *)rx_fst->base)[0];
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
+	struct dp_fisa_tcp_state *tcp;
 	int ft_size = rx_fst->max_entries;
 	int i;
 
@@ -1102,7 +1625,8 @@ QDF_STATUS dp_rx_dump_fisa_stats(struct dp_soc *soc)
 	dp_info("Num of flows evicted %d", rx_fst->del_flow_count);
 	dp_info("Hash collision count %d", rx_fst->hash_collision_cnt);
 
-	for (i = 0; i < ft_size; i++, sw_ft_entry++) {
+	for (i = 0; i < ft_size; i++) {
+		sw_ft_entry = dp_fisa_rx_get_sw_ft(rx_fst, i);
 		if (!sw_ft_entry->is_populated)
 			continue;
 
@@ -1116,49 +1640,32 @@ QDF_STATUS dp_rx_dump_fisa_stats(struct dp_soc *soc)
 		dp_info("avg aggregation %llu",
 			sw_ft_entry->bytes_aggregated / sw_ft_entry->flush_count
 			);
+		if (sw_ft_entry->is_flow_tcp) {
+			tcp = &dp_fisa_rx_sw_ft_to_ft(sw_ft_entry)->tcp;
+			dp_info("tcp segs aggr %llu flush(ooo %u flags %u mismatch %u size %u) not eligible %u",
+				tcp->aggr_segs, tcp->flush_ooo,
+				tcp->flush_flags, tcp->flush_mismatch,
+				tcp->flush_size, tcp->not_eligible);
+		}
 		print_flow_tuple(&sw_ft_entry->rx_flow_tuple_info);
 	}
 	return QDF_STATUS_SUCCESS;
 }
 
-/**
- * dp_rx_fisa_flush_flow_wrap() - flush fisa flow by invoking
- *				  dp_rx_fisa_flush_flow()
- * @sw_ft: fisa flow for which aggregates to be flushed
- *
- * Return: None.
- */
-static void dp_rx_fisa_flush_flow_wrap(struct dp_fisa_rx_sw_ft *sw_ft)
-{
-	/* Save the ip_len and checksum as hardware assist is
-	 * always based on his start of aggregation
-	 */
-	sw_ft->napi_flush_cumulative_l4_checksum =
-				sw_ft->cumulative_l4_checksum;
-	sw_ft->napi_flush_cumulative_ip_length =
-				sw_ft->hal_cumultive_ip_len;
-	dp_fisa_debug("napi_flush_cumulative_ip_length 0x%x",
-		      sw_ft->napi_flush_cumulative_ip_length);
-
-	dp_rx_fisa_flush_flow(sw_ft->vdev,
-			      sw_ft);
-	sw_ft->cur_aggr = 0;
-}
-
 QDF_STATUS dp_rx_fisa_flush_by_ctx_id(struct dp_soc *soc, int napi_id)
 {
 	struct dp_rx_fst *fisa_hdl = soc->rx_fst;
-	struct dp_fisa_rx_sw_ft *sw_ft_entry =
-		(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
 	int ft_size = fisa_hdl->max_entries;
 	int i;
 
 	for (i = 0; i < ft_size; i++) {
-		if (sw_ft_entry[i].napi_id == napi_id &&
-		    sw_ft_entry[i].is_populated) {
+		sw_ft_entry = dp_fisa_rx_get_sw_ft(fisa_hdl, i);
+		if (sw_ft_entry->napi_id == napi_id &&
+		    sw_ft_entry->is_populated) {
 			dp_fisa_debug("flushing %d %pK napi_id %d", i,
-				      &sw_ft_entry[i], napi_id);
-			dp_rx_fisa_flush_flow_wrap(&sw_ft_entry[i]);
+				      sw_ft_entry, napi_id);
+			dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
 		}
 	}
 
@@ -1168,8 +1675,7 @@ QDF_STATUS dp_rx_fisa_flush_by_ctx_id(struct dp_soc *soc, int napi_id)
 QDF_STATUS dp_rx_fisa_flush_by_vdev_id(struct dp_soc *soc, uint8_t vdev_id)
 {
 	struct dp_rx_fst *fisa_hdl = soc->rx_fst;
-	struct dp_fisa_rx_sw_ft *sw_ft_entry =
-		(struct dp_fisa_rx_sw_ft *)fisa_hdl->base;
+	struct dp_fisa_rx_sw_ft *sw_ft_entry;
 	int ft_size = fisa_hdl->max_entries;
 	int i;
 	struct dp_vdev *vdev;
@@ -1181,10 +1687,11 @@ QDF_STATUS dp_rx_fisa_flush_by_vdev_id(struct dp_soc *soc, uint8_t vdev_id)
 	}
 
 	for (i = 0; i < ft_size; i++) {
-		if (vdev == sw_ft_entry[i].vdev) {
+		sw_ft_entry = dp_fisa_rx_get_sw_ft(fisa_hdl, i);
+		if (vdev == sw_ft_entry->vdev) {
 			dp_fisa_debug("flushing %d %pk vdev %pK", i,
-				      &sw_ft_entry[i], vdev);
-			dp_rx_fisa_flush_flow_wrap(&sw_ft_entry[i]);
+				      sw_ft_entry, vdev);
+			dp_rx_fisa_flush_flow_wrap(sw_ft_entry);
 		}
 	}
 
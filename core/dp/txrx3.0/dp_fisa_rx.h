@@ -14,6 +14,9 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#ifndef __DP_FISA_RX_H
+#define __DP_FISA_RX_H
+
 #include <dp_types.h>
 #include <qdf_status.h>
 
@@ -26,6 +29,175 @@
 #endif
 
 #if defined(WLAN_SUPPORT_RX_FISA)
+/* Maximum number of TCP segments aggregated in one FISA TCP aggregate */
+#define DP_FISA_TCP_MAX_AGGR_SEGS 32
+
+/* Maximum IP payload of a FISA TCP aggregate */
+#define DP_FISA_TCP_MAX_AGGR_LEN (0xFFFF - 0x100)
+
+/**
+ * struct dp_fisa_tcp_state - software TCP aggregation state of a FISA flow
+ * @next_seq: sequence number expected from the next in-order segment
+ * @ack_seq: ACK sequence number of the aggregated segments
+ * @window: TCP window of the aggregated segments
+ * @tsval: latest timestamp value of the aggregated segments
+ * @tsecr: latest timestamp echo reply of the aggregated segments
+ * @mss: payload length of the head segment, used as gso_size
+ * @payload_len: total TCP payload length of the aggregate
+ * @thlen: TCP header length of the aggregated segments
+ * @segs: number of segments in the aggregate
+ * @ttl: IP TTL of the aggregated segments
+ * @tos: IP TOS of the aggregated segments
+ * @has_ts: aggregated segments carry the timestamp option
+ * @psh: PSH was set on one of the aggregated segments
+ * @aggr_segs: stats, segments merged into an aggregate
+ * @flush_ooo: stats, aggregates flushed on out of order segment
+ * @flush_flags: stats, aggregates flushed on PSH/FIN/SYN/RST/URG segment
+ * @flush_mismatch: stats, aggregates flushed on header mismatch
+ * @flush_size: stats, aggregates flushed on size or segment count limit
+ * @not_eligible: stats, segments delivered without aggregation
+ */
+struct dp_fisa_tcp_state {
+	uint32_t next_seq;
+	uint32_t ack_seq;
+	uint16_t window;
+	uint32_t tsval;
+	uint32_t tsecr;
+	uint16_t mss;
+	uint32_t payload_len;
+	uint8_t thlen;
+	uint8_t segs;
+	uint8_t ttl;
+	uint8_t tos;
+	bool has_ts;
+	bool psh;
+	uint64_t aggr_segs;
+	uint32_t flush_ooo;
+	uint32_t flush_flags;
+	uint32_t flush_mismatch;
+	uint32_t flush_size;
+	uint32_t not_eligible;
+};
+
+/* Flows idle for this long are evicted from the flow table */
+#define DP_FISA_RX_FT_AGING_TIMEOUT_MS 5000
+
+/* Interval of the flow table aging pass */
+#define DP_FISA_RX_FT_AGING_PERIOD_MS 1000
+
+/* Minimum idle time of a flow to be evicted on hash collision */
+#define DP_FISA_RX_FT_LRU_MIN_IDLE_MS 100
+
+/**
+ * struct dp_fisa_rx_ft - host FISA flow table entry
+ * @sw_ft: SW flow table entry shared with the HW flow search table
+ * @tcp: TCP aggregation state, valid for TCP flows only
+ * @last_access: time in ticks when the flow last received a packet
+ * @hits: number of packets looked up to this flow entry
+ * @recycled: the flow index was used by an evicted flow before, which the
+ *	      FSE cache can still return for packets of the old flow
+ *
+ * The host flow table (dp_rx_fst base) is an array of this structure,
+ * use dp_fisa_rx_get_ft() to index it.
+ */
+struct dp_fisa_rx_ft {
+	struct dp_fisa_rx_sw_ft sw_ft;
+	struct dp_fisa_tcp_state tcp;
+	unsigned long last_access;
+	uint64_t hits;
+	bool recycled;
+};
+
+/**
+ * struct dp_fisa_rx_fst_stats - host FISA flow table stats
+ * @hits: lookups hit by flow entries which are evicted already, hits of
+ *	  the live entries are kept in the entries
+ * @misses: lookups which needed a new flow entry
+ * @add_fail: new flows which did not get a flow entry
+ * @evict_aged: flows evicted by the aging pass
+ * @evict_lru: flows evicted on hash collision to make room for a new flow
+ * @stale_idx: packets whose HW flow index pointed to an evicted entry or
+ *	       to a flow which took over the entry of an evicted one
+ *
+ * All counters but hits of live entries are updated with dp_rx_fst_lock.
+ */
+struct dp_fisa_rx_fst_stats {
+	uint64_t hits;
+	uint64_t misses;
+	uint32_t add_fail;
+	uint32_t evict_aged;
+	uint32_t evict_lru;
+	uint32_t stale_idx;
+};
+
+/**
+ * struct dp_fisa_rx_fst - host FISA flow search table context
+ * @fst: flow search table context shared with the common DP layer
+ * @stats: flow table management stats
+ * @next_aging: time in ticks of the next aging pass, per REO ring
+ *
+ * soc->rx_fst points to @fst, use dp_fisa_rx_get_fst() to get the host
+ * context from it.
+ */
+struct dp_fisa_rx_fst {
+	struct dp_rx_fst fst;
+	struct dp_fisa_rx_fst_stats stats;
+	unsigned long next_aging[MAX_REO_DEST_RINGS];
+};
+
+/**
+ * dp_fisa_rx_get_fst() - get host FISA flow search table context
+ * @fst: FISA flow search table context
+ *
+ * Return: host flow search table context containing @fst
+ */
+static inline struct dp_fisa_rx_fst *
+dp_fisa_rx_get_fst(struct dp_rx_fst *fst)
+{
+	return qdf_container_of(fst, struct dp_fisa_rx_fst, fst);
+}
+
+/* Size of a host FISA flow table entry */
+#define DP_FISA_RX_FT_ENTRY_SIZE sizeof(struct dp_fisa_rx_ft)
+
+/**
+ * dp_fisa_rx_get_ft() - get host FISA flow table entry by flow index
+ * @fst: FISA flow search table context
+ * @flow_idx: flow index
+ *
+ * Return: host flow table entry
+ */
+static inline struct dp_fisa_rx_ft *
+dp_fisa_rx_get_ft(struct dp_rx_fst *fst, uint32_t flow_idx)
+{
+	return &((struct dp_fisa_rx_ft *)fst->base)[flow_idx];
+}
+
+/**
+ * dp_fisa_rx_get_sw_ft() - get SW FT entry by flow index
+ * @fst: FISA flow search table context
+ * @flow_idx: flow index
+ *
+ * Return: SW flow table entry
+ */
+static inline struct dp_fisa_rx_sw_ft *
+dp_fisa_rx_get_sw_ft(struct dp_rx_fst *fst, uint32_t flow_idx)
+{
+	return &dp_fisa_rx_get_ft(fst, flow_idx)->sw_ft;
+}
+
+/**
+ * dp_fisa_rx_sw_ft_to_ft() - get host FISA flow table entry of a SW FT entry
+ * @sw_ft: SW flow table entry
+ *
+ * Return: host flow table entry containing @sw_ft
+ */
+static inline struct dp_fisa_rx_ft *
+dp_fisa_rx_sw_ft_to_ft(struct dp_fisa_rx_sw_ft *sw_ft)
+{
+	return qdf_container_of(sw_ft, struct dp_fisa_rx_ft, sw_ft);
+}
+
 /**
  * dp_rx_dump_fisa_stats() - Dump fisa stats
  * @soc: core txrx main context
@@ -73,3 +245,4 @@ void dp_rx_dump_fisa_table(struct dp_soc *soc)
 {
 }
 #endif
+#endif /* __DP_FISA_RX_H */
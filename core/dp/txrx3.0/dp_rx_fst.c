@@ -23,12 +23,35 @@
 #include "hal_rx_flow.h"
 #include "dp_htt.h"
 #include "dp_internal.h"
+#include "dp_fisa_rx.h"
 
 #ifdef WLAN_SUPPORT_RX_FISA
 
 void dp_rx_dump_fisa_table(struct dp_soc *soc)
 {
-	hal_rx_dump_fse_table(soc->rx_fst->hal_rx_fst);
+	struct dp_rx_fst *fst = soc->rx_fst;
+	struct dp_fisa_rx_fst_stats *stats = &dp_fisa_rx_get_fst(fst)->stats;
+	struct dp_fisa_rx_ft *ft_entry;
+	uint64_t hits = stats->hits;
+	uint32_t active = 0;
+	uint32_t i;
+
+	for (i = 0; i < fst->max_entries; i++) {
+		ft_entry = dp_fisa_rx_get_ft(fst, i);
+		if (!ft_entry->sw_ft.is_populated)
+			continue;
+		active++;
+		hits += ft_entry->hits;
+	}
+
+	dp_info("FST active %u/%u hits %llu misses %llu add_fail %u",
+		active, fst->max_entries, hits, stats->misses,
+		stats->add_fail);
+	dp_info("FST collisions %u evicted %u (aged %u lru %u) stale idx %u",
+		fst->hash_collision_cnt, fst->del_flow_count,
+		stats->evict_aged, stats->evict_lru, stats->stale_idx);
+
+	hal_rx_dump_fse_table(fst->hal_rx_fst);
 }
 
 /**
@@ -40,9 +63,11 @@ void dp_rx_dump_fisa_table(struct dp_soc *soc)
  */
 QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 {
+	struct dp_fisa_rx_fst *host_fst;
 	struct dp_rx_fst *fst;
 	uint8_t *hash_key;
 	struct wlan_cfg_dp_soc_ctxt *cfg = soc->wlan_cfg_ctx;
+	int i;
 
 	/* Check if it is enabled in the INI */
 	if (!wlan_cfg_is_rx_fisa_enabled(cfg)) {
@@ -66,12 +91,13 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 		return QDF_STATUS_SUCCESS;
 	}
 
-	fst = qdf_mem_malloc(sizeof(struct dp_rx_fst));
-	if (!fst) {
+	host_fst = qdf_mem_malloc(sizeof(*host_fst));
+	if (!host_fst) {
 		QDF_TRACE(QDF_MODULE_ID_ANY, QDF_TRACE_LEVEL_ERROR,
 			  "RX FST allocation failed\n");
 		return QDF_STATUS_E_NOMEM;
 	}
+	fst = &host_fst->fst;
 
 	fst->max_skid_length = wlan_cfg_rx_fst_get_max_search(cfg);
 	fst->max_entries = wlan_cfg_get_rx_flow_search_table_size(cfg);
@@ -82,7 +108,7 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 	dp_err("FST setup params FT size %d, hash_mask 0x%x, skid_length %d",
 	       fst->max_entries, fst->hash_mask, fst->max_skid_length);
 
-	fst->base = (uint8_t *)qdf_mem_malloc(DP_RX_GET_SW_FT_ENTRY_SIZE *
+	fst->base = (uint8_t *)qdf_mem_malloc(DP_FISA_RX_FT_ENTRY_SIZE *
 					       fst->max_entries);
 
 	if (!fst->base) {
@@ -106,6 +132,9 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 	}
 
 	qdf_spinlock_create(&fst->dp_rx_fst_lock);
+	for (i = 0; i < MAX_REO_DEST_RINGS; i++)
+		host_fst->next_aging[i] = qdf_system_ticks() +
+		      qdf_system_msecs_to_ticks(DP_FISA_RX_FT_AGING_PERIOD_MS);
 
 	fst->soc_hdl = soc;
 	soc->rx_fst = fst;
@@ -119,7 +148,7 @@ QDF_STATUS dp_rx_fst_attach(struct dp_soc *soc, struct dp_pdev *pdev)
 out1:
 	qdf_mem_free(fst->base);
 out2:
-	qdf_mem_free(fst);
+	qdf_mem_free(host_fst);
 	return QDF_STATUS_E_NOMEM;
 }
 
@@ -170,7 +199,7 @@ void dp_rx_fst_detach(struct dp_soc *soc, struct dp_pdev *pdev)
 		hal_rx_fst_detach(dp_fst->hal_rx_fst, soc->osdev);
 		qdf_mem_free(dp_fst->base);
 		qdf_spinlock_destroy(&dp_fst->dp_rx_fst_lock);
-		qdf_mem_free(dp_fst);
+		qdf_mem_free(dp_fisa_rx_get_fst(dp_fst));
 	}
 	soc->rx_fst = NULL;
 	QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_DEBUG,
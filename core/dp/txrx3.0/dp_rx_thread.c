@@ -26,6 +26,12 @@
 /* Timeout in ms to wait for a DP rx thread */
 #define DP_RX_THREAD_WAIT_TIMEOUT 200
 
+/*
+ * Backlog difference in nbufs after which a drained flow bucket is moved
+ * from its current rx_thread to the least loaded one
+ */
+#define DP_RX_TM_FLOW_STEER_MOVE_THRESH 32
+
 #define DP_RX_TM_DEBUG 0
 #if DP_RX_TM_DEBUG
 /**
@@ -71,6 +77,410 @@ ol_txrx_soc_handle dp_rx_tm_get_soc_handle(struct dp_rx_tm_handle_cmn *rx_tm_han
 	return soc;
 }
 
+/**
+ * dp_rx_tm_thread_backlog() - number of nbufs pending in a rx_thread
+ * @rx_thread - rx_thread pointer
+ *
+ * The value is sampled without synchronization with the producers and the
+ * consumer of the thread and is only meant for load balancing and stats.
+ *
+ * Returns: number of nbufs queued but not yet taken out of the thread
+ */
+static inline uint32_t dp_rx_tm_thread_backlog(struct dp_rx_thread *rx_thread)
+{
+	uint32_t deq_seq;
+
+	/* deq_seq never passes enq_seq, read it first */
+	deq_seq = qdf_atomic_read(&rx_thread->deq_seq);
+	smp_rmb();
+
+	return (uint32_t)qdf_atomic_read(&rx_thread->enq_seq) - deq_seq;
+}
+
+/**
+ * dp_rx_thread_adjust_nbuf_list() - create an nbuf list from the frag list
+ * @head - nbuf list to be created
+ *
+ * Returns: void
+ */
+static void dp_rx_thread_adjust_nbuf_list(qdf_nbuf_t head)
+{
+	qdf_nbuf_t next_ptr_list, nbuf_list;
+
+	nbuf_list = head;
+	if (head && QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head) > 1) {
+		/* move ext list to ->next pointer */
+		next_ptr_list = qdf_nbuf_get_ext_list(head);
+		qdf_nbuf_append_ext_list(head, NULL, 0);
+		qdf_nbuf_set_next(nbuf_list, next_ptr_list);
+		dp_rx_tm_walk_skb_list(nbuf_list);
+	}
+}
+
+#ifdef WLAN_DP_RX_THREAD_SPSC
+/**
+ * dp_rx_thread_spsc_qlen() - number of nbuf_lists in the lock-free rings
+ * @rx_thread - rx_thread pointer
+ *
+ * Returns: nbuf_lists pending in all the rings of the thread
+ */
+static uint32_t dp_rx_thread_spsc_qlen(struct dp_rx_thread *rx_thread)
+{
+	struct dp_rx_spsc_ring *ring;
+	uint32_t qlen = 0;
+	int i;
+
+	if (!rx_thread->spsc_ring)
+		return 0;
+
+	for (i = 0; i < DP_RX_TM_MAX_REO_RINGS; i++) {
+		ring = &rx_thread->spsc_ring[i];
+		qlen += READ_ONCE(ring->prod_idx) - READ_ONCE(ring->cons_idx);
+	}
+
+	return qlen;
+}
+
+/**
+ * dp_rx_spsc_ring_push() - add a nbuf_list head to a lock-free ring
+ * @ring - ring to add to, called from the producer context only
+ * @head - nbuf_list head
+ *
+ * Returns: true if queued, false if the ring is full
+ */
+static inline bool dp_rx_spsc_ring_push(struct dp_rx_spsc_ring *ring,
+					qdf_nbuf_t head)
+{
+	uint32_t prod = ring->prod_idx;
+
+	if (qdf_unlikely(prod - smp_load_acquire(&ring->cons_idx) >=
+			 DP_RX_SPSC_RING_SIZE))
+		return false;
+
+	ring->slots[prod & DP_RX_SPSC_RING_MASK] = head;
+	/* publish the slot before the index */
+	smp_store_release(&ring->prod_idx, prod + 1);
+
+	return true;
+}
+
+/**
+ * dp_rx_spsc_ring_pop() - take a nbuf_list head out of a lock-free ring
+ * @ring - ring to take from, called from the rx_thread only
+ *
+ * Returns: nbuf_list head or NULL if the ring is empty
+ */
+static inline qdf_nbuf_t dp_rx_spsc_ring_pop(struct dp_rx_spsc_ring *ring)
+{
+	uint32_t cons = ring->cons_idx;
+	qdf_nbuf_t head;
+
+	if (cons == smp_load_acquire(&ring->prod_idx))
+		return NULL;
+
+	head = ring->slots[cons & DP_RX_SPSC_RING_MASK];
+	ring->slots[cons & DP_RX_SPSC_RING_MASK] = NULL;
+	/* release the slot only after it is read */
+	smp_store_release(&ring->cons_idx, cons + 1);
+
+	return head;
+}
+
+/**
+ * dp_rx_thread_queue_nbuf_list() - queue a nbuf_list head into rx_thread
+ * @rx_thread - rx_thread to queue to
+ * @reo_ring_num - REO ring the nbuf_list was received on
+ * @head - nbuf_list head, with the rest of the list in its ext list
+ *
+ * The nbuf_list goes to the lock-free ring of the REO ring. nbuf_queue is
+ * used when the ring is full or already being written from another
+ * context, and then for every subsequent list of the REO ring until the
+ * thread consumed the overflowed ones, so that the thread never sees the
+ * lists of a REO ring out of order.
+ *
+ * Returns: None
+ */
+static void dp_rx_thread_queue_nbuf_list(struct dp_rx_thread *rx_thread,
+					 uint8_t reo_ring_num, qdf_nbuf_t head)
+{
+	struct dp_rx_spsc_ring *ring;
+
+	if (qdf_unlikely(!rx_thread->spsc_ring)) {
+		qdf_nbuf_queue_head_enqueue_tail(&rx_thread->nbuf_queue, head);
+		return;
+	}
+
+	ring = &rx_thread->spsc_ring[reo_ring_num];
+	if (qdf_likely(qdf_atomic_inc_return(&ring->prod_busy) == 1)) {
+		if (!qdf_atomic_read(&ring->overflow_cnt) &&
+		    dp_rx_spsc_ring_push(ring, head)) {
+			qdf_atomic_dec(&ring->prod_busy);
+			rx_thread->stats.spsc_enqueued[reo_ring_num]++;
+			return;
+		}
+	}
+
+	qdf_atomic_inc(&ring->overflow_cnt);
+	qdf_nbuf_queue_head_enqueue_tail(&rx_thread->nbuf_queue, head);
+	qdf_atomic_dec(&ring->prod_busy);
+	rx_thread->stats.spsc_overflow[reo_ring_num]++;
+}
+
+/**
+ * dp_rx_thread_spsc_dequeue() - dequeue nbuf_list head from rx_thread
+ * @rx_thread - rx_thread to dequeue from
+ *
+ * The lock-free rings are drained first, then nbuf_queue, so a single
+ * dp_rx_thread_process_nbufq() pass empties both. A list coming from
+ * nbuf_queue is held back in the stash while the ring of its REO ring
+ * still has lists, since those were queued before it.
+ *
+ * Returns: nbuf_list head or NULL if the thread has nothing queued
+ */
+static qdf_nbuf_t dp_rx_thread_spsc_dequeue(struct dp_rx_thread *rx_thread)
+{
+	struct dp_rx_spsc_ring *ring;
+	qdf_nbuf_t head;
+	int i;
+
+	if (qdf_unlikely(!rx_thread->spsc_ring))
+		return qdf_nbuf_queue_head_dequeue(&rx_thread->nbuf_queue);
+
+	for (i = 0; i < DP_RX_TM_MAX_REO_RINGS; i++) {
+		head = dp_rx_spsc_ring_pop(&rx_thread->spsc_ring[i]);
+		if (head)
+			return head;
+	}
+
+	head = rx_thread->spsc_stash;
+	if (head) {
+		rx_thread->spsc_stash = NULL;
+	} else {
+		head = qdf_nbuf_queue_head_dequeue(&rx_thread->nbuf_queue);
+		if (!head)
+			return NULL;
+	}
+
+	ring = &rx_thread->spsc_ring[QDF_NBUF_CB_RX_CTX_ID(head)];
+	if (!rx_thread->spsc_stash && ring->cons_idx !=
+	    smp_load_acquire(&ring->prod_idx)) {
+		rx_thread->spsc_stash = head;
+		return dp_rx_spsc_ring_pop(ring);
+	}
+
+	qdf_atomic_dec(&ring->overflow_cnt);
+
+	return head;
+}
+
+/**
+ * dp_rx_thread_spsc_pending() - check if lock-free rings have nbuf_lists
+ * @rx_thread - rx_thread pointer
+ *
+ * Returns: true if the thread has nbuf_lists in the rings or the stash
+ */
+static bool dp_rx_thread_spsc_pending(struct dp_rx_thread *rx_thread)
+{
+	return rx_thread->spsc_stash || dp_rx_thread_spsc_qlen(rx_thread);
+}
+
+/**
+ * dp_rx_thread_post_wake_up() - wake up rx_thread after queueing packets
+ * @rx_thread - rx_thread pointer
+ * @reo_ring_num - REO ring the packets were received on
+ *
+ * The thread drains all its queues once woken up, so a producer only
+ * needs to wake it up when it is idle. Pairs with the barrier in
+ * dp_rx_thread_set_idle().
+ *
+ * Returns: None
+ */
+static void dp_rx_thread_post_wake_up(struct dp_rx_thread *rx_thread,
+				      uint8_t reo_ring_num)
+{
+	smp_mb();
+	if (!qdf_atomic_read(&rx_thread->idle)) {
+		rx_thread->stats.wakeups_skipped[reo_ring_num]++;
+		return;
+	}
+
+	rx_thread->stats.wakeups[reo_ring_num]++;
+	qdf_set_bit(RX_POST_EVENT, &rx_thread->event_flag);
+	qdf_wake_up_interruptible(&rx_thread->wait_q);
+}
+
+/**
+ * dp_rx_thread_set_idle() - mark the rx_thread idle or running
+ * @rx_thread - rx_thread pointer
+ * @idle - true before the thread waits for packets, false after wake up
+ *
+ * Returns: None
+ */
+static inline void dp_rx_thread_set_idle(struct dp_rx_thread *rx_thread,
+					 bool idle)
+{
+	qdf_atomic_set(&rx_thread->idle, idle);
+	if (idle)
+		smp_mb();
+}
+
+/**
+ * dp_rx_thread_spsc_flushed() - account a flushed nbuf_queue entry
+ * @rx_thread - rx_thread pointer
+ * @nbuf_list - nbuf_list unlinked from nbuf_queue
+ *
+ * Returns: None
+ */
+static inline void dp_rx_thread_spsc_flushed(struct dp_rx_thread *rx_thread,
+					     qdf_nbuf_t nbuf_list)
+{
+	if (rx_thread->spsc_ring)
+		qdf_atomic_dec(&rx_thread->spsc_ring[
+			QDF_NBUF_CB_RX_CTX_ID(nbuf_list)].overflow_cnt);
+}
+
+/**
+ * dp_rx_thread_spsc_init() - allocate lock-free rings of a rx_thread
+ * @rx_thread - rx_thread pointer
+ *
+ * On allocation failure the thread falls back to nbuf_queue only.
+ *
+ * Returns: None
+ */
+static void dp_rx_thread_spsc_init(struct dp_rx_thread *rx_thread)
+{
+	int i;
+
+	qdf_atomic_init(&rx_thread->idle);
+	rx_thread->spsc_stash = NULL;
+	rx_thread->spsc_ring = qdf_mem_malloc(DP_RX_TM_MAX_REO_RINGS *
+					      sizeof(*rx_thread->spsc_ring));
+	if (!rx_thread->spsc_ring) {
+		dp_err("thread %u: no lock-free rings, using nbuf_queue",
+		       rx_thread->id);
+		return;
+	}
+
+	for (i = 0; i < DP_RX_TM_MAX_REO_RINGS; i++) {
+		qdf_atomic_init(&rx_thread->spsc_ring[i].prod_busy);
+		qdf_atomic_init(&rx_thread->spsc_ring[i].overflow_cnt);
+	}
+}
+
+/**
+ * dp_rx_thread_spsc_deinit() - free lock-free rings of a rx_thread
+ * @rx_thread - rx_thread pointer, the thread must not be running
+ *
+ * Returns: None
+ */
+static void dp_rx_thread_spsc_deinit(struct dp_rx_thread *rx_thread)
+{
+	qdf_nbuf_t head;
+	int i;
+
+	if (!rx_thread->spsc_ring)
+		return;
+
+	for (i = 0; i < DP_RX_TM_MAX_REO_RINGS; i++) {
+		while ((head = dp_rx_spsc_ring_pop(&rx_thread->spsc_ring[i]))) {
+			dp_rx_thread_adjust_nbuf_list(head);
+			qdf_nbuf_list_free(head);
+		}
+	}
+
+	if (rx_thread->spsc_stash) {
+		dp_rx_thread_adjust_nbuf_list(rx_thread->spsc_stash);
+		qdf_nbuf_list_free(rx_thread->spsc_stash);
+		rx_thread->spsc_stash = NULL;
+	}
+
+	qdf_mem_free(rx_thread->spsc_ring);
+	rx_thread->spsc_ring = NULL;
+}
+#else
+static inline uint32_t dp_rx_thread_spsc_qlen(struct dp_rx_thread *rx_thread)
+{
+	return 0;
+}
+
+static inline void dp_rx_thread_queue_nbuf_list(struct dp_rx_thread *rx_thread,
+						uint8_t reo_ring_num,
+						qdf_nbuf_t head)
+{
+	qdf_nbuf_queue_head_enqueue_tail(&rx_thread->nbuf_queue, head);
+}
+
+static inline
+qdf_nbuf_t dp_rx_thread_spsc_dequeue(struct dp_rx_thread *rx_thread)
+{
+	return qdf_nbuf_queue_head_dequeue(&rx_thread->nbuf_queue);
+}
+
+static inline bool dp_rx_thread_spsc_pending(struct dp_rx_thread *rx_thread)
+{
+	return false;
+}
+
+static inline void dp_rx_thread_post_wake_up(struct dp_rx_thread *rx_thread,
+					     uint8_t reo_ring_num)
+{
+	qdf_set_bit(RX_POST_EVENT, &rx_thread->event_flag);
+	qdf_wake_up_interruptible(&rx_thread->wait_q);
+}
+
+static inline void dp_rx_thread_set_idle(struct dp_rx_thread *rx_thread,
+					 bool idle)
+{
+}
+
+static inline void dp_rx_thread_spsc_flushed(struct dp_rx_thread *rx_thread,
+					     qdf_nbuf_t nbuf_list)
+{
+}
+
+static inline void dp_rx_thread_spsc_init(struct dp_rx_thread *rx_thread)
+{
+}
+
+static inline void dp_rx_thread_spsc_deinit(struct dp_rx_thread *rx_thread)
+{
+}
+#endif /* WLAN_DP_RX_THREAD_SPSC */
+
+/**
+ * dp_rx_thread_nbufs_pending() - check if a rx_thread has nbuf_lists queued
+ * @rx_thread - rx_thread pointer
+ *
+ * Used as the wait predicate of the thread, so it covers nbuf_queue as
+ * well as the lock-free rings: a producer that overflowed into nbuf_queue
+ * does not wake up a thread that is still running, and the thread must
+ * not go to sleep on those lists.
+ *
+ * Returns: true if the thread has nbuf_lists to process
+ */
+static inline bool dp_rx_thread_nbufs_pending(struct dp_rx_thread *rx_thread)
+{
+	return dp_rx_thread_spsc_pending(rx_thread) ||
+	       qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue);
+}
+
+/**
+ * dp_rx_tm_stats_sum() - add up a rx_thread stat kept per reo ring
+ * @stat - per reo ring counters
+ *
+ * Returns: sum of the counters of all the reo rings
+ */
+static uint32_t dp_rx_tm_stats_sum(const unsigned int *stat)
+{
+	uint32_t sum = 0;
+	int i;
+
+	for (i = 0; i < DP_RX_TM_MAX_REO_RINGS; i++)
+		sum += stat[i];
+
+	return sum;
+}
+
 /**
  * dp_rx_tm_thread_dump_stats() - display stats for a rx_thread
  * @rx_thread - rx_thread pointer for which the stats need to be
@@ -104,9 +514,10 @@ static void dp_rx_tm_thread_dump_stats(struct dp_rx_thread *rx_thread)
 	if (!total_queued)
 		return;
 
-	dp_info("thread:%u - qlen:%u queued:(total:%u %s) dequeued:%u stack:%u gro_flushes: %u gro_flushes_by_vdev_del: %u rx_flushes: %u max_len:%u invalid(peer:%u vdev:%u rx-handle:%u others:%u)",
+	dp_info("thread:%u - qlen:%u queued:(total:%u %s) dequeued:%u stack:%u gro_flushes: %u gro_flushes_by_vdev_del: %u rx_flushes: %u max_len:%u invalid(peer:%u vdev:%u rx-handle:%u others:%u) load(backlog:%u steered_in:%u flow_moves:%u)",
 		rx_thread->id,
-		qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue),
+		qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue) +
+		dp_rx_thread_spsc_qlen(rx_thread),
 		total_queued,
 		nbuf_queued_string,
 		rx_thread->stats.nbuf_dequeued,
@@ -118,7 +529,16 @@ static void dp_rx_tm_thread_dump_stats(struct dp_rx_thread *rx_thread)
 		rx_thread->stats.dropped_invalid_peer,
 		rx_thread->stats.dropped_invalid_vdev,
 		rx_thread->stats.dropped_invalid_os_rx_handles,
-		rx_thread->stats.dropped_others);
+		rx_thread->stats.dropped_others,
+		dp_rx_tm_thread_backlog(rx_thread),
+		dp_rx_tm_stats_sum(rx_thread->stats.steered_in),
+		rx_thread->stats.steer_flow_moves);
+	dp_info("thread:%u - spsc(enqueued:%u overflow:%u) wakeups:%u wakeups_skipped:%u",
+		rx_thread->id,
+		dp_rx_tm_stats_sum(rx_thread->stats.spsc_enqueued),
+		dp_rx_tm_stats_sum(rx_thread->stats.spsc_overflow),
+		dp_rx_tm_stats_sum(rx_thread->stats.wakeups),
+		dp_rx_tm_stats_sum(rx_thread->stats.wakeups_skipped));
 }
 
 QDF_STATUS dp_rx_tm_dump_stats(struct dp_rx_tm_handle *rx_tm_hdl)
@@ -130,6 +550,14 @@ QDF_STATUS dp_rx_tm_dump_stats(struct dp_rx_tm_handle *rx_tm_hdl)
 			continue;
 		dp_rx_tm_thread_dump_stats(rx_tm_hdl->rx_thread[i]);
 	}
+
+	if (!rx_tm_hdl->flow_steer)
+		return QDF_STATUS_SUCCESS;
+
+	for (i = 0; i < DP_RX_TM_MAX_REO_RINGS; i++)
+		dp_info("flow steering reo[%u]: bucket collisions:%u", i,
+			rx_tm_hdl->flow_steer[i].collisions);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -176,6 +604,8 @@ static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
 
 	num_elements_in_nbuf = QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list);
 	nbuf_queued = num_elements_in_nbuf;
+	/* account before the consumer can see the packets */
+	qdf_atomic_add(nbuf_queued, &rx_thread->enq_seq);
 
 	dp_rx_tm_walk_skb_list(nbuf_list);
 
@@ -187,8 +617,8 @@ static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
 		num_elements_in_nbuf--;
 		next_ptr_list = head_ptr->next;
 		qdf_nbuf_set_next(head_ptr, NULL);
-		qdf_nbuf_queue_head_enqueue_tail(&rx_thread->nbuf_queue,
-						 head_ptr);
+		dp_rx_thread_queue_nbuf_list(rx_thread, reo_ring_num,
+					     head_ptr);
 		head_ptr = next_ptr_list;
 	}
 
@@ -208,10 +638,11 @@ static QDF_STATUS dp_rx_tm_thread_enqueue(struct dp_rx_thread *rx_thread,
 	}
 	qdf_nbuf_set_next(head_ptr, NULL);
 
-	qdf_nbuf_queue_head_enqueue_tail(&rx_thread->nbuf_queue, head_ptr);
+	dp_rx_thread_queue_nbuf_list(rx_thread, reo_ring_num, head_ptr);
 
 enq_done:
-	temp_qlen = qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue);
+	temp_qlen = qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue) +
+		    dp_rx_thread_spsc_qlen(rx_thread);
 
 	rx_thread->stats.nbuf_queued[reo_ring_num] += nbuf_queued;
 
@@ -219,11 +650,9 @@ enq_done:
 		rx_thread->stats.nbufq_max_len = temp_qlen;
 
 	dp_debug("enqueue packet thread %pK wait queue %pK qlen %u",
-		 rx_thread, wait_q_ptr,
-		 qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue));
+		 rx_thread, wait_q_ptr, temp_qlen);
 
-	qdf_set_bit(RX_POST_EVENT, &rx_thread->event_flag);
-	qdf_wake_up_interruptible(wait_q_ptr);
+	dp_rx_thread_post_wake_up(rx_thread, reo_ring_num);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -245,26 +674,6 @@ static QDF_STATUS dp_rx_tm_thread_gro_flush_ind(struct dp_rx_thread *rx_thread)
 	return QDF_STATUS_SUCCESS;
 }
 
-/**
- * dp_rx_thread_adjust_nbuf_list() - create an nbuf list from the frag list
- * @head - nbuf list to be created
- *
- * Returns: void
- */
-static void dp_rx_thread_adjust_nbuf_list(qdf_nbuf_t head)
-{
-	qdf_nbuf_t next_ptr_list, nbuf_list;
-
-	nbuf_list = head;
-	if (head && QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head) > 1) {
-		/* move ext list to ->next pointer */
-		next_ptr_list = qdf_nbuf_get_ext_list(head);
-		qdf_nbuf_append_ext_list(head, NULL, 0);
-		qdf_nbuf_set_next(nbuf_list, next_ptr_list);
-		dp_rx_tm_walk_skb_list(nbuf_list);
-	}
-}
-
 /**
  * dp_rx_tm_thread_dequeue() - dequeue nbuf list from rx_thread
  * @rx_thread - rx_thread from which the nbuf needs to be dequeued
@@ -275,20 +684,80 @@ static qdf_nbuf_t dp_rx_tm_thread_dequeue(struct dp_rx_thread *rx_thread)
 {
 	qdf_nbuf_t head;
 
-	head = qdf_nbuf_queue_head_dequeue(&rx_thread->nbuf_queue);
+	head = dp_rx_thread_spsc_dequeue(rx_thread);
 	dp_rx_thread_adjust_nbuf_list(head);
 
 	dp_debug("Dequeued %pK nbuf_list", head);
 	return head;
 }
 
+/**
+ * dp_rx_tm_flow_steer_enabled() - check if RX flow steering is enabled
+ * @rx_tm_handle_cmn - rx thread manager cmn handle
+ *
+ * Returns: true if rx_threads are selected per flow hash
+ */
+static inline bool
+dp_rx_tm_flow_steer_enabled(struct dp_rx_tm_handle_cmn *rx_tm_handle_cmn)
+{
+	return !!((struct dp_rx_tm_handle *)rx_tm_handle_cmn)->flow_steer;
+}
+
+/**
+ * dp_rx_thread_set_ctx_id() - mark nbuf list with the rx_thread id
+ * @rx_thread - rx_thread processing the nbuf list
+ * @nbuf_list - nbuf list dequeued from the rx_thread
+ *
+ * With flow steering a list received on a REO ring can be processed by
+ * any rx_thread. The RX context ID is used downstream to pick the GRO
+ * NAPI instance, so it has to point to the thread delivering the list.
+ *
+ * Returns: None
+ */
+static void dp_rx_thread_set_ctx_id(struct dp_rx_thread *rx_thread,
+				    qdf_nbuf_t nbuf_list)
+{
+	qdf_nbuf_t nbuf;
+
+	for (nbuf = nbuf_list; nbuf; nbuf = qdf_nbuf_next(nbuf))
+		QDF_NBUF_CB_RX_CTX_ID(nbuf) = rx_thread->id;
+}
+
+/**
+ * dp_rx_thread_gro_pending() - check if GRO holds packets of the thread
+ * @rx_thread - rx_thread whose napi is checked
+ *
+ * The napi is only used from the rx_thread itself, which is the caller.
+ *
+ * Returns: true if packets delivered via GRO have not reached the stack yet
+ */
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0))
+static inline bool dp_rx_thread_gro_pending(struct dp_rx_thread *rx_thread)
+{
+	return rx_thread->napi.gro_bitmask || rx_thread->napi.rx_count;
+}
+#elif (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 19, 0))
+static inline bool dp_rx_thread_gro_pending(struct dp_rx_thread *rx_thread)
+{
+	return !!rx_thread->napi.gro_bitmask;
+}
+#else
+static inline bool dp_rx_thread_gro_pending(struct dp_rx_thread *rx_thread)
+{
+	return !!rx_thread->napi.gro_count;
+}
+#endif
+
 /**
  * dp_rx_thread_process_nbufq() - process nbuf queue of a thread
  * @rx_thread - rx_thread whose nbuf queue needs to be processed
+ * @vdev_del - drop the packets of rx_thread->vdev_del_id instead of
+ *	       delivering them, as the vdev is being deleted
  *
  * Returns: 0 on success, error code on failure
  */
-static int dp_rx_thread_process_nbufq(struct dp_rx_thread *rx_thread)
+static int dp_rx_thread_process_nbufq(struct dp_rx_thread *rx_thread,
+				      bool vdev_del)
 {
 	qdf_nbuf_t nbuf_list;
 	uint8_t vdev_id;
@@ -318,7 +787,17 @@ static int dp_rx_thread_process_nbufq(struct dp_rx_thread *rx_thread)
 			QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list);
 		rx_thread->stats.nbuf_dequeued += num_list_elements;
 
+		if (dp_rx_tm_flow_steer_enabled(rx_thread->rtm_handle_cmn))
+			dp_rx_thread_set_ctx_id(rx_thread, nbuf_list);
+
 		vdev_id = QDF_NBUF_CB_RX_VDEV_ID(nbuf_list);
+		if (qdf_unlikely(vdev_del &&
+				 vdev_id == rx_thread->vdev_del_id)) {
+			rx_thread->stats.rx_flushed += num_list_elements;
+			qdf_nbuf_list_free(nbuf_list);
+			goto next;
+		}
+
 		cdp_get_os_rx_handles_from_vdev(soc, vdev_id, &stack_fn,
 						&osif_vdev);
 		dp_debug("rx_thread %pK sending packet %pK to stack",
@@ -332,9 +811,22 @@ static int dp_rx_thread_process_nbufq(struct dp_rx_thread *rx_thread)
 			rx_thread->stats.nbuf_sent_to_stack +=
 							num_list_elements;
 		}
+next:
+		rx_thread->deq_pending += num_list_elements;
 		nbuf_list = dp_rx_tm_thread_dequeue(rx_thread);
 	}
 
+	/*
+	 * Unless GRO holds some of them until the next flush indication, the
+	 * delivered packets have all reached the stack, so their flows may
+	 * be steered to another thread without reordering. This keeps the
+	 * backlog accurate with rx offload off or low tput GRO flush skipped.
+	 */
+	if (rx_thread->deq_pending && !dp_rx_thread_gro_pending(rx_thread)) {
+		qdf_atomic_add(rx_thread->deq_pending, &rx_thread->deq_seq);
+		rx_thread->deq_pending = 0;
+	}
+
 	dp_debug("exit: qlen  %u",
 		 qdf_nbuf_queue_head_qlen(&rx_thread->nbuf_queue));
 
@@ -356,6 +848,13 @@ static void dp_rx_thread_gro_flush(struct dp_rx_thread *rx_thread)
 	local_bh_enable();
 
 	rx_thread->stats.gro_flushes++;
+
+	/*
+	 * The delivered packets have now all reached the stack, so their
+	 * flows may be steered to another thread without reordering.
+	 */
+	qdf_atomic_add(rx_thread->deq_pending, &rx_thread->deq_seq);
+	rx_thread->deq_pending = 0;
 }
 
 /**
@@ -372,6 +871,8 @@ static void dp_rx_thread_gro_flush(struct dp_rx_thread *rx_thread)
  */
 static int dp_rx_thread_sub_loop(struct dp_rx_thread *rx_thread, bool *shutdown)
 {
+	bool vdev_del;
+
 	while (true) {
 		if (qdf_atomic_test_and_clear_bit(RX_SHUTDOWN_EVENT,
 						  &rx_thread->event_flag)) {
@@ -386,17 +887,25 @@ static int dp_rx_thread_sub_loop(struct dp_rx_thread *rx_thread, bool *shutdown)
 			break;
 		}
 
-		dp_rx_thread_process_nbufq(rx_thread);
+		/*
+		 * Sample the vdev delete request before draining the queues,
+		 * so that all the packets queued before it are dropped.
+		 * Pairs with the barrier in dp_rx_thread_flush_by_vdev_id().
+		 */
+		vdev_del = qdf_atomic_test_bit(RX_VDEV_DEL_EVENT,
+					       &rx_thread->event_flag);
+		smp_rmb();
+
+		dp_rx_thread_process_nbufq(rx_thread, vdev_del);
 
-		if (qdf_atomic_read(&rx_thread->gro_flush_ind) |
-		    qdf_atomic_test_bit(RX_VDEV_DEL_EVENT,
-					&rx_thread->event_flag)) {
+		if (qdf_atomic_read(&rx_thread->gro_flush_ind) | vdev_del) {
 			dp_rx_thread_gro_flush(rx_thread);
 			qdf_atomic_set(&rx_thread->gro_flush_ind, 0);
 		}
 
-		if (qdf_atomic_test_and_clear_bit(RX_VDEV_DEL_EVENT,
-						  &rx_thread->event_flag)) {
+		if (vdev_del) {
+			qdf_atomic_clear_bit(RX_VDEV_DEL_EVENT,
+					     &rx_thread->event_flag);
 			rx_thread->stats.gro_flushes_by_vdev_del++;
 			qdf_event_set(&rx_thread->vdev_del_event);
 		}
@@ -446,6 +955,7 @@ static int dp_rx_thread_loop(void *arg)
 	while (!shutdown) {
 		/* This implements the execution model algorithm */
 		dp_debug("sleeping");
+		dp_rx_thread_set_idle(rx_thread, true);
 		status =
 		    qdf_wait_queue_interruptible
 				(rx_thread->wait_q,
@@ -454,7 +964,9 @@ static int dp_rx_thread_loop(void *arg)
 				 qdf_atomic_test_bit(RX_SUSPEND_EVENT,
 						     &rx_thread->event_flag) ||
 				 qdf_atomic_test_bit(RX_VDEV_DEL_EVENT,
-						     &rx_thread->event_flag));
+						     &rx_thread->event_flag) ||
+				 dp_rx_thread_nbufs_pending(rx_thread));
+		dp_rx_thread_set_idle(rx_thread, false);
 		dp_debug("woken up");
 
 		if (status == -ERESTARTSYS) {
@@ -543,6 +1055,10 @@ static QDF_STATUS dp_rx_tm_thread_init(struct dp_rx_thread *rx_thread,
 	qdf_event_create(&rx_thread->shutdown_event);
 	qdf_event_create(&rx_thread->vdev_del_event);
 	qdf_atomic_init(&rx_thread->gro_flush_ind);
+	qdf_atomic_init(&rx_thread->enq_seq);
+	qdf_atomic_init(&rx_thread->deq_seq);
+	rx_thread->deq_pending = 0;
+	dp_rx_thread_spsc_init(rx_thread);
 	qdf_init_waitqueue_head(&rx_thread->wait_q);
 	qdf_scnprintf(thread_name, sizeof(thread_name), "dp_rx_thread_%u", id);
 	dp_info("%s %u", thread_name, id);
@@ -583,6 +1099,8 @@ static QDF_STATUS dp_rx_tm_thread_deinit(struct dp_rx_thread *rx_thread)
 	qdf_event_destroy(&rx_thread->shutdown_event);
 	qdf_event_destroy(&rx_thread->vdev_del_event);
 
+	dp_rx_thread_spsc_deinit(rx_thread);
+
 	if (cdp_cfg_get(dp_rx_tm_get_soc_handle(rx_thread->rtm_handle_cmn),
 			cfg_dp_gro_enable))
 		dp_rx_tm_thread_napi_deinit(rx_thread);
@@ -595,6 +1113,7 @@ QDF_STATUS dp_rx_tm_init(struct dp_rx_tm_handle *rx_tm_hdl,
 {
 	int i;
 	QDF_STATUS qdf_status = QDF_STATUS_SUCCESS;
+	struct dp_txrx_handle *ext_hdl;
 
 	if (num_dp_rx_threads > DP_MAX_RX_THREADS) {
 		dp_err("unable to initialize %u number of threads. MAX %u",
@@ -604,9 +1123,21 @@ QDF_STATUS dp_rx_tm_init(struct dp_rx_tm_handle *rx_tm_hdl,
 
 	rx_tm_hdl->num_dp_rx_threads = num_dp_rx_threads;
 	rx_tm_hdl->state = DP_RX_THREADS_INVALID;
+	rx_tm_hdl->flow_steer = NULL;
 
 	dp_info("initializing %u threads", num_dp_rx_threads);
 
+	ext_hdl = dp_txrx_get_ext_hdl_frm_cmn_hdl(rx_tm_hdl->txrx_handle_cmn);
+	if (ext_hdl->config.rx_flow_steering && num_dp_rx_threads > 1) {
+		rx_tm_hdl->flow_steer =
+			qdf_mem_malloc(DP_RX_TM_MAX_REO_RINGS *
+				       sizeof(*rx_tm_hdl->flow_steer));
+		if (!rx_tm_hdl->flow_steer)
+			dp_err("flow steering disabled, no memory");
+		else
+			dp_info("rx flow steering enabled");
+	}
+
 	/* allocate an array to contain the DP RX thread pointers */
 	rx_tm_hdl->rx_thread = qdf_mem_malloc(num_dp_rx_threads *
 					      sizeof(struct dp_rx_thread *));
@@ -707,7 +1238,10 @@ suspend_fail:
  *
  * The function will flush the RX packets by vdev_id in a particular
  * RX thead queue. And will notify and wait the TX thread to flush the
- * packets in the NAPI RX GRO hash list
+ * packets in the NAPI RX GRO hash list. Packets sitting in the lock-free
+ * rings cannot be unlinked from here, the thread drops the ones of the
+ * vdev while it drains the rings before acknowledging the GRO flush, so
+ * none of them reach the stack once this returns.
  *
  * Return: void
  */
@@ -725,15 +1259,21 @@ void dp_rx_thread_flush_by_vdev_id(struct dp_rx_thread *rx_thread,
 		if (QDF_NBUF_CB_RX_VDEV_ID(nbuf_list) == vdev_id) {
 			qdf_nbuf_unlink_no_lock(nbuf_list,
 						&rx_thread->nbuf_queue);
+			dp_rx_thread_spsc_flushed(rx_thread, nbuf_list);
 			dp_rx_thread_adjust_nbuf_list(nbuf_list);
 			num_list_elements =
 				QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(nbuf_list);
 			rx_thread->stats.rx_flushed += num_list_elements;
+			qdf_atomic_add(num_list_elements,
+				       &rx_thread->deq_seq);
 			qdf_nbuf_list_free(nbuf_list);
 		}
 	}
 	qdf_nbuf_queue_head_unlock(&rx_thread->nbuf_queue);
 
+	rx_thread->vdev_del_id = vdev_id;
+	/* the thread reads vdev_del_id once it sees RX_VDEV_DEL_EVENT */
+	smp_wmb();
 	qdf_set_bit(RX_VDEV_DEL_EVENT, &rx_thread->event_flag);
 	qdf_wake_up_interruptible(&rx_thread->wait_q);
 
@@ -872,6 +1412,9 @@ QDF_STATUS dp_rx_tm_deinit(struct dp_rx_tm_handle *rx_tm_hdl)
 	qdf_mem_free(rx_tm_hdl->rx_thread);
 	rx_tm_hdl->rx_thread = NULL;
 
+	qdf_mem_free(rx_tm_hdl->flow_steer);
+	rx_tm_hdl->flow_steer = NULL;
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -884,7 +1427,8 @@ QDF_STATUS dp_rx_tm_deinit(struct dp_rx_tm_handle *rx_tm_hdl)
  * The function relies on the presence of QDF_NBUF_CB_RX_CTX_ID passed to it
  * from the nbuf list. Depending on the RX_CTX (copy engine or reo
  * ring) on which the packet was received, the function selects
- * a corresponding rx_thread.
+ * a corresponding rx_thread. When flow steering is enabled this is only
+ * the default thread of the ring, see dp_rx_tm_steer_flow().
  *
  * Return: rx thread ID selected for the nbuf
  */
@@ -904,16 +1448,187 @@ static uint8_t dp_rx_tm_select_thread(struct dp_rx_tm_handle *rx_tm_hdl,
 	return selected_rx_thread;
 }
 
+/**
+ * dp_rx_tm_least_loaded_thread() - find the rx_thread with least backlog
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread
+ *            infrastructure
+ * @steer_ring: flow steering state of the REO ring looking for a thread
+ *
+ * The search starts at a round robin cursor, so that flows arriving while
+ * all threads are idle are spread over the threads instead of piling up
+ * on the first one.
+ *
+ * Return: rx thread ID with the smallest backlog
+ */
+static uint8_t
+dp_rx_tm_least_loaded_thread(struct dp_rx_tm_handle *rx_tm_hdl,
+			     struct dp_rx_tm_flow_steer_ring *steer_ring)
+{
+	uint8_t num_threads = rx_tm_hdl->num_dp_rx_threads;
+	uint8_t selected = steer_ring->rr_cursor % num_threads;
+	uint32_t min_backlog = UINT_MAX;
+	uint32_t backlog;
+	uint8_t id;
+	int i;
+
+	for (i = 0; i < num_threads; i++) {
+		id = (steer_ring->rr_cursor + i) % num_threads;
+		backlog = dp_rx_tm_thread_backlog(rx_tm_hdl->rx_thread[id]);
+		if (backlog < min_backlog) {
+			min_backlog = backlog;
+			selected = id;
+		}
+	}
+	steer_ring->rr_cursor = (selected + 1) % num_threads;
+
+	return selected;
+}
+
+/**
+ * dp_rx_tm_steer_flow() - select a DP RX thread for a nbuf by flow hash
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread
+ *            infrastructure
+ * @steer_ring: flow steering state of the REO ring the nbuf came from
+ * @nbuf: first nbuf of its flow bucket in the nbuf list being steered
+ *
+ * A flow bucket sticks to its rx_thread as long as the thread still holds
+ * packets of the bucket, including packets it delivered but has not GRO
+ * flushed yet. Once they have all reached the stack the bucket may move to
+ * a less loaded thread without reordering the flow.
+ *
+ * Return: flow steering bucket selected for the nbuf
+ */
+static struct dp_rx_tm_flow_steer_entry *
+dp_rx_tm_steer_flow(struct dp_rx_tm_handle *rx_tm_hdl,
+		    struct dp_rx_tm_flow_steer_ring *steer_ring,
+		    qdf_nbuf_t nbuf)
+{
+	uint32_t flow_hash = QDF_NBUF_CB_RX_FLOW_ID(nbuf);
+	struct dp_rx_tm_flow_steer_entry *entry;
+	struct dp_rx_thread *cur_thread;
+	uint8_t selected;
+
+	entry = &steer_ring->tbl[flow_hash & DP_RX_TM_FLOW_STEER_TBL_MASK];
+	if (qdf_likely(entry->valid)) {
+		if (entry->flow_hash != flow_hash) {
+			steer_ring->collisions++;
+			entry->flow_hash = flow_hash;
+		}
+
+		cur_thread = rx_tm_hdl->rx_thread[entry->thread_id];
+		/* packets of the bucket still queued, stay on the thread */
+		if ((int32_t)((uint32_t)qdf_atomic_read(&cur_thread->deq_seq) -
+			      entry->last_enq_seq) < 0)
+			return entry;
+
+		selected = dp_rx_tm_least_loaded_thread(rx_tm_hdl, steer_ring);
+		if (dp_rx_tm_thread_backlog(cur_thread) <=
+		    dp_rx_tm_thread_backlog(rx_tm_hdl->rx_thread[selected]) +
+		    DP_RX_TM_FLOW_STEER_MOVE_THRESH)
+			return entry;
+	} else {
+		selected = dp_rx_tm_least_loaded_thread(rx_tm_hdl, steer_ring);
+		entry->flow_hash = flow_hash;
+		entry->valid = true;
+	}
+
+	dp_debug("flow 0x%x steered to thread %u", flow_hash, selected);
+	entry->thread_id = selected;
+	rx_tm_hdl->rx_thread[selected]->stats.steer_flow_moves++;
+
+	return entry;
+}
+
+/**
+ * dp_rx_tm_steer_nbuf_list() - split a nbuf list by flow and queue the
+ * parts to the rx_threads of their flows
+ * @rx_tm_hdl: dp_rx_tm_handle containing the overall thread
+ *            infrastructure
+ * @reo_ring_num: REO ring the nbuf list was received on
+ * @nbuf_list: nbuf list to be steered, may hold nbufs of several flows
+ *
+ * A flow bucket is steered once per nbuf list, so all its nbufs go to the
+ * same rx_thread in order. The buckets steered by the list are chained
+ * through @next_steered until the list is queued, and then record the
+ * enq_seq of their thread.
+ *
+ * Return: None
+ */
+static void dp_rx_tm_steer_nbuf_list(struct dp_rx_tm_handle *rx_tm_hdl,
+				     uint8_t reo_ring_num,
+				     qdf_nbuf_t nbuf_list)
+{
+	struct dp_rx_tm_flow_steer_ring *steer_ring;
+	struct dp_rx_tm_flow_steer_entry *entry, *steered = NULL;
+	qdf_nbuf_t head[DP_MAX_RX_THREADS] = {NULL};
+	qdf_nbuf_t tail[DP_MAX_RX_THREADS] = {NULL};
+	uint32_t num_nbufs[DP_MAX_RX_THREADS] = {0};
+	uint32_t enq_seq[DP_MAX_RX_THREADS] = {0};
+	struct dp_rx_thread *rx_thread;
+	qdf_nbuf_t nbuf, next;
+	uint32_t flow_hash;
+	uint8_t id;
+
+	steer_ring = &rx_tm_hdl->flow_steer[reo_ring_num];
+	for (nbuf = nbuf_list; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+
+		flow_hash = QDF_NBUF_CB_RX_FLOW_ID(nbuf);
+		entry = &steer_ring->tbl[flow_hash &
+					 DP_RX_TM_FLOW_STEER_TBL_MASK];
+		if (!entry->steered) {
+			entry = dp_rx_tm_steer_flow(rx_tm_hdl, steer_ring, nbuf);
+			entry->steered = true;
+			entry->next_steered = steered;
+			steered = entry;
+		}
+
+		id = entry->thread_id;
+		if (head[id])
+			qdf_nbuf_set_next(tail[id], nbuf);
+		else
+			head[id] = nbuf;
+		tail[id] = nbuf;
+		num_nbufs[id]++;
+	}
+
+	for (id = 0; id < rx_tm_hdl->num_dp_rx_threads; id++) {
+		if (!head[id])
+			continue;
+
+		rx_thread = rx_tm_hdl->rx_thread[id];
+		if (id != reo_ring_num)
+			rx_thread->stats.steered_in[reo_ring_num]++;
+
+		QDF_NBUF_CB_RX_NUM_ELEMENTS_IN_LIST(head[id]) = num_nbufs[id];
+		dp_rx_tm_thread_enqueue(rx_thread, head[id]);
+		enq_seq[id] = qdf_atomic_read(&rx_thread->enq_seq);
+		steer_ring->thread_map |= BIT(id);
+	}
+
+	for (entry = steered; entry; entry = entry->next_steered) {
+		entry->last_enq_seq = enq_seq[entry->thread_id];
+		entry->steered = false;
+	}
+}
+
 QDF_STATUS dp_rx_tm_enqueue_pkt(struct dp_rx_tm_handle *rx_tm_hdl,
 				qdf_nbuf_t nbuf_list)
 {
 	uint8_t selected_thread_id;
+	uint8_t reo_ring_num = QDF_NBUF_CB_RX_CTX_ID(nbuf_list);
+
+	selected_thread_id = dp_rx_tm_select_thread(rx_tm_hdl, reo_ring_num);
+	if (!rx_tm_hdl->flow_steer ||
+	    qdf_unlikely(selected_thread_id != reo_ring_num)) {
+		dp_rx_tm_thread_enqueue(rx_tm_hdl->rx_thread[selected_thread_id],
+					nbuf_list);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	dp_rx_tm_steer_nbuf_list(rx_tm_hdl, reo_ring_num, nbuf_list);
 
-	selected_thread_id =
-		dp_rx_tm_select_thread(rx_tm_hdl,
-				       QDF_NBUF_CB_RX_CTX_ID(nbuf_list));
-	dp_rx_tm_thread_enqueue(rx_tm_hdl->rx_thread[selected_thread_id],
-				nbuf_list);
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -921,9 +1636,23 @@ QDF_STATUS
 dp_rx_tm_gro_flush_ind(struct dp_rx_tm_handle *rx_tm_hdl, int rx_ctx_id)
 {
 	uint8_t selected_thread_id;
+	struct dp_rx_tm_flow_steer_ring *steer_ring;
+	int i;
 
 	selected_thread_id = dp_rx_tm_select_thread(rx_tm_hdl, rx_ctx_id);
-	dp_rx_tm_thread_gro_flush_ind(rx_tm_hdl->rx_thread[selected_thread_id]);
+	if (!rx_tm_hdl->flow_steer || selected_thread_id != rx_ctx_id) {
+		dp_rx_tm_thread_gro_flush_ind(
+				rx_tm_hdl->rx_thread[selected_thread_id]);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	/* flush every thread the ring steered packets to */
+	steer_ring = &rx_tm_hdl->flow_steer[rx_ctx_id];
+	for (i = 0; i < rx_tm_hdl->num_dp_rx_threads; i++) {
+		if (steer_ring->thread_map & BIT(i))
+			dp_rx_tm_thread_gro_flush_ind(rx_tm_hdl->rx_thread[i]);
+	}
+	steer_ring->thread_map = 0;
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -29,6 +29,14 @@
 /* Number of DP RX threads supported */
 #define DP_MAX_RX_THREADS DP_RX_TM_MAX_REO_RINGS
 
+/* Number of nbuf_list slots in a lock-free REO ring to rx_thread ring */
+#define DP_RX_SPSC_RING_SIZE 256
+#define DP_RX_SPSC_RING_MASK (DP_RX_SPSC_RING_SIZE - 1)
+
+/* Number of flow hash buckets per REO ring used for RX flow steering */
+#define DP_RX_TM_FLOW_STEER_TBL_SIZE 256
+#define DP_RX_TM_FLOW_STEER_TBL_MASK (DP_RX_TM_FLOW_STEER_TBL_SIZE - 1)
+
 /*
  * struct dp_rx_tm_handle_cmn - Opaque handle for rx_threads to store
  * rx_tm_handle. This handle will be common for all the threads.
@@ -50,7 +58,19 @@ struct dp_rx_tm_handle_cmn;
  * @rx_flushed: packets flushed after vdev delete
  * @dropped_invalid_peer: packets(nbuf_list) dropped due to no peer
  * @dropped_others: packets dropped due to other reasons
-
+ * @steered_in: nbuf_lists steered into this thread per REO ring other
+ *		than the one the thread is paired with
+ * @steer_flow_moves: flow buckets moved to this thread by flow steering
+ * @spsc_enqueued: nbuf_lists queued through the lock-free rings per reo
+ *		   ring
+ * @spsc_overflow: nbuf_lists queued to nbuf_queue as the ring was full, per
+ *		   reo ring
+ * @wakeups: number of times the producers woke up the thread, per reo ring
+ * @wakeups_skipped: wakeups saved as the thread was already running, per
+ *		     reo ring
+ *
+ * The stats updated by the producers are kept per reo ring, so that each
+ * counter has a single writer.
  */
 struct dp_rx_thread_stats {
 	unsigned int nbuf_queued[DP_RX_TM_MAX_REO_RINGS];
@@ -64,6 +84,35 @@ struct dp_rx_thread_stats {
 	unsigned int dropped_invalid_peer;
 	unsigned int dropped_invalid_os_rx_handles;
 	unsigned int dropped_others;
+	unsigned int steered_in[DP_RX_TM_MAX_REO_RINGS];
+	unsigned int steer_flow_moves;
+	unsigned int spsc_enqueued[DP_RX_TM_MAX_REO_RINGS];
+	unsigned int spsc_overflow[DP_RX_TM_MAX_REO_RINGS];
+	unsigned int wakeups[DP_RX_TM_MAX_REO_RINGS];
+	unsigned int wakeups_skipped[DP_RX_TM_MAX_REO_RINGS];
+};
+
+/**
+ * struct dp_rx_spsc_ring - lock-free ring of nbuf_list heads between a REO
+ *			    ring context (producer) and a rx_thread (consumer)
+ * @prod_idx: free running producer index, only written by the REO ring
+ *	      context
+ * @cons_idx: free running consumer index, only written by the rx_thread
+ * @prod_busy: guards the producer side in case the REO ring is enqueued
+ *	       from more than one context at a time, the loser falls back
+ *	       to nbuf_queue
+ * @overflow_cnt: nbuf_lists of this REO ring which went to the rx_thread
+ *		  nbuf_queue because the ring was full or busy. The producer
+ *		  keeps using nbuf_queue until they are consumed, to keep
+ *		  ordering.
+ * @slots: nbuf_list heads
+ */
+struct dp_rx_spsc_ring {
+	uint32_t prod_idx ____cacheline_aligned_in_smp;
+	qdf_atomic_t prod_busy;
+	uint32_t cons_idx ____cacheline_aligned_in_smp;
+	qdf_atomic_t overflow_cnt;
+	qdf_nbuf_t slots[DP_RX_SPSC_RING_SIZE];
 };
 
 /**
@@ -77,6 +126,8 @@ struct dp_rx_thread_stats {
  * @vdev_del_event: handle of Event for vdev del thread to signal completion
  *		    for gro flush
  * @event_flag: event flag to post events to DP Rx thread
+ * @vdev_del_id: vdev whose packets the thread drops while RX_VDEV_DEL_EVENT
+ *		 is set
  * @nbuf_queue:nbuf queue used to store RX packets
  * @nbufq_len: length of the nbuf queue
  * @aff_mask: cuurent affinity mask of the DP Rx thread
@@ -85,6 +136,20 @@ struct dp_rx_thread_stats {
  *		    structures via APIs.
  * @napi: napi to deliver packet to stack via GRO
  * @netdev: dummy netdev to initialize the napi structure with
+ * @enq_seq: running count of nbufs enqueued into the thread
+ * @deq_seq: running count of nbufs that left the thread, either delivered
+ *	     to the stack with no GRO packet held back, or flushed at vdev
+ *	     delete. enq_seq - deq_seq is the thread backlog used by flow
+ *	     steering.
+ * @deq_pending: nbufs delivered to the stack by the thread while GRO still
+ *		 holds packets, added to @deq_seq once GRO is flushed
+ * @spsc_ring: per REO ring lock-free rings feeding the thread, NULL if the
+ *	       nbuf_queue is used for all the packets
+ * @spsc_stash: nbuf_list taken from nbuf_queue and held back until the
+ *		packets queued before it on the ring of its REO ring are
+ *		consumed
+ * @idle: set by the thread before it goes to wait for packets, producers
+ *	  only wake up the thread when it is idle
  */
 struct dp_rx_thread {
 	uint8_t id;
@@ -96,6 +161,7 @@ struct dp_rx_thread {
 	qdf_event_t vdev_del_event;
 	qdf_atomic_t gro_flush_ind;
 	unsigned long event_flag;
+	uint8_t vdev_del_id;
 	qdf_nbuf_queue_head_t nbuf_queue;
 	unsigned long aff_mask;
 	struct dp_rx_thread_stats stats;
@@ -103,6 +169,14 @@ struct dp_rx_thread {
 	struct napi_struct napi;
 	qdf_wait_queue_head_t wait_q;
 	struct net_device netdev;
+	qdf_atomic_t enq_seq;
+	qdf_atomic_t deq_seq;
+	uint32_t deq_pending;
+#ifdef WLAN_DP_RX_THREAD_SPSC
+	struct dp_rx_spsc_ring *spsc_ring;
+	qdf_nbuf_t spsc_stash;
+	qdf_atomic_t idle;
+#endif
 };
 
 /**
@@ -120,18 +194,59 @@ enum dp_rx_thread_state {
 	DP_RX_THREADS_SUSPENDED
 };
 
+/**
+ * struct dp_rx_tm_flow_steer_entry - flow bucket to rx_thread mapping
+ * @valid: bucket has been steered to a thread at least once
+ * @thread_id: rx_thread the bucket is currently steered to
+ * @flow_hash: flow hash of the last nbuf_list steered through the bucket
+ * @last_enq_seq: enq_seq of @thread_id after the last nbuf_list of the
+ *		  bucket was queued. The bucket can move to another thread
+ *		  only once @thread_id has dequeued past this point, which
+ *		  keeps packets of a flow in order.
+ * @steered: bucket has been steered for the nbuf list being queued
+ * @next_steered: next bucket steered for the nbuf list being queued
+ */
+struct dp_rx_tm_flow_steer_entry {
+	bool valid;
+	bool steered;
+	uint8_t thread_id;
+	uint32_t flow_hash;
+	uint32_t last_enq_seq;
+	struct dp_rx_tm_flow_steer_entry *next_steered;
+};
+
+/**
+ * struct dp_rx_tm_flow_steer_ring - RX flow steering state of a REO ring
+ * @tbl: flow bucket table indexed by the flow hash of the nbuf. A flow is
+ *	 always received on the same REO ring, so the table is only updated
+ *	 from the context servicing that ring and needs no locking.
+ * @thread_map: bitmap of rx_threads that got nbuf_lists from this ring
+ *		since the last GRO flush indication of the ring
+ * @rr_cursor: round robin start point used to spread flows over idle threads
+ * @collisions: number of times a bucket was shared by a different flow
+ */
+struct dp_rx_tm_flow_steer_ring {
+	struct dp_rx_tm_flow_steer_entry tbl[DP_RX_TM_FLOW_STEER_TBL_SIZE];
+	unsigned long thread_map;
+	uint8_t rr_cursor;
+	uint32_t collisions;
+};
+
 /**
  * struct dp_rx_tm_handle - DP RX thread infrastructure handle
  * @num_dp_rx_threads: number of DP RX threads initialized
  * @txrx_handle_cmn: opaque txrx handle to get to pdev and soc
  * @state: state of the rx_threads. All of them should be in the same state.
  * @rx_thread: array of pointers of type struct dp_rx_thread
+ * @flow_steer: per REO ring flow steering state, NULL if the rx_thread is
+ *		selected by REO ring number
  */
 struct dp_rx_tm_handle {
 	uint8_t num_dp_rx_threads;
 	struct dp_txrx_handle_cmn *txrx_handle_cmn;
 	enum dp_rx_thread_state state;
 	struct dp_rx_thread **rx_thread;
+	struct dp_rx_tm_flow_steer_ring *flow_steer;
 };
 
 /**
@@ -28,9 +28,12 @@
 /**
  * struct dp_txrx_config - dp txrx configuration passed to dp txrx modules
  * @enable_dp_rx_threads: enable DP rx threads or not
+ * @rx_flow_steering: select the DP rx thread per flow hash instead of
+ *		      per REO ring
  */
 struct dp_txrx_config {
 	bool enable_rx_threads;
+	bool rx_flow_steering;
 };
 
 struct dp_txrx_handle_cmn;
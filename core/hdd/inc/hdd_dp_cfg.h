@@ -694,6 +694,147 @@
 		false, \
 		"Control to enable latency critical clients")
 
+#ifdef WLAN_BUS_BW_GOVERNOR
+/*
+ * <ini>
+ * gBusBwGovernor - Enable the adaptive bus bandwidth governor
+ * @Default: false
+ *
+ * When enabled, the bus bandwidth vote is raised as soon as the traffic of
+ * a compute interval crosses a threshold, but only lowered once a smoothed
+ * traffic estimate stays below the lower threshold by the down hysteresis
+ * margin for gBusBwGovDownHoldCount intervals. The vote is also raised to
+ * the highest level when the rx ring is running short of buffers.
+ *
+ * Related: gBusBwGovEwmaShift, gBusBwGovDownHysteresis,
+ *	    gBusBwGovDownHoldCount, gBusBwGovRxRingRampPct
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOVERNOR \
+		CFG_INI_BOOL( \
+		"gBusBwGovernor", \
+		false, \
+		"Enable the adaptive bus bandwidth governor")
+
+/*
+ * <ini>
+ * gBusBwGovEwmaShift - Smoothing of the bus bandwidth governor load
+ * @Min: 0
+ * @Max: 4
+ * @Default: 2
+ *
+ * Each compute interval contributes 1 / 2^gBusBwGovEwmaShift of the
+ * smoothed load used to lower the bus bandwidth vote. 0 disables the
+ * smoothing.
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_EWMA_SHIFT \
+		CFG_INI_UINT( \
+		"gBusBwGovEwmaShift", \
+		0, \
+		4, \
+		2, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth governor EWMA shift")
+
+/*
+ * <ini>
+ * gBusBwGovDownHysteresis - Margin needed to lower the bus bandwidth vote
+ * @Min: 0
+ * @Max: 100
+ * @Default: 20
+ *
+ * Percentage by which the smoothed load must be below a bus bandwidth
+ * threshold before the governor lowers the vote past that threshold.
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_DOWN_HYSTERESIS \
+		CFG_INI_UINT( \
+		"gBusBwGovDownHysteresis", \
+		0, \
+		100, \
+		20, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth governor down hysteresis")
+
+/*
+ * <ini>
+ * gBusBwGovDownHoldCount - Intervals to hold before lowering the vote
+ * @Min: 1
+ * @Max: 50
+ * @Default: 3
+ *
+ * Number of consecutive compute intervals the load must allow a lower bus
+ * bandwidth level before the governor lowers the vote by one level.
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_DOWN_HOLD_CNT \
+		CFG_INI_UINT( \
+		"gBusBwGovDownHoldCount", \
+		1, \
+		50, \
+		3, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth governor down hold count")
+
+/*
+ * <ini>
+ * gBusBwGovRxRingRampPct - Rx ring deficit forcing the highest vote
+ * @Min: 0
+ * @Max: 100
+ * @Default: 25
+ *
+ * Percentage of the rx ring fill level waiting to be replenished at which
+ * the governor votes for the highest bus bandwidth level right away,
+ * instead of waiting for the packet counts to catch up. 0 disables the
+ * fast ramp. It has no effect unless the datapath reports its rx ring
+ * deficit through the cdp misc ops.
+ *
+ * Supported Feature: Bus bandwidth governor
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_BUS_BW_GOV_RX_RING_RAMP_PCT \
+		CFG_INI_UINT( \
+		"gBusBwGovRxRingRampPct", \
+		0, \
+		100, \
+		25, \
+		CFG_VALUE_OR_DEFAULT, \
+		"Bus bandwidth governor rx ring fast ramp")
+
+#define CFG_HDD_DP_BUS_BW_GOVERNOR \
+	CFG(CFG_DP_BUS_BW_GOVERNOR) \
+	CFG(CFG_DP_BUS_BW_GOV_EWMA_SHIFT) \
+	CFG(CFG_DP_BUS_BW_GOV_DOWN_HYSTERESIS) \
+	CFG(CFG_DP_BUS_BW_GOV_DOWN_HOLD_CNT) \
+	CFG(CFG_DP_BUS_BW_GOV_RX_RING_RAMP_PCT)
+#else
+#define CFG_HDD_DP_BUS_BW_GOVERNOR
+#endif /* WLAN_BUS_BW_GOVERNOR */
+
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
@@ -1142,6 +1283,55 @@
 	1, 4, 1, CFG_VALUE_OR_DEFAULT, \
 	"Control to set the number of dp rx threads")
 
+/*
+ * <ini>
+ * num_ol_rx_threads - Control to set the number of Rx threads
+ * @Min: 1
+ * @Max: 4
+ * @Default: 1
+ *
+ * Number of Rx threads used when rx_mode selects the Rx thread on
+ * non-lithium targets. Frames are steered to a thread by station and TID,
+ * so the frames of a TID stay in order. LRO/GRO is disabled when more than
+ * one thread is used, as their contexts are per copy engine.
+ *
+ * Related: rx_mode
+ *
+ * Supported Feature: Rx thread
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_NUM_OL_RX_THREADS \
+	CFG_INI_UINT("num_ol_rx_threads", \
+	1, 4, 1, CFG_VALUE_OR_DEFAULT, \
+	"Control to set the number of Rx threads")
+
+/*
+ * <ini>
+ * dp_rx_flow_steering - Control to steer RX flows across dp rx threads
+ * @Default: false
+ *
+ * By default a REO ring is serviced by a single dp rx thread. When this
+ * ini is enabled, the dp rx thread is selected per flow hash so that
+ * flows landing on the same REO ring are spread over all dp rx threads.
+ * A flow only moves to another thread once all its queued packets have
+ * been consumed, so per-flow ordering is preserved.
+ *
+ * Related: num_dp_rx_threads, rx_mode
+ *
+ * Supported Feature: DP RX threads
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RX_FLOW_STEERING \
+	CFG_INI_BOOL("dp_rx_flow_steering", \
+	false, \
+	"Control to steer RX flows across dp rx threads")
+
 /*
  * <ini>
  * ce_service_max_rx_ind_flush - Maximum number of HTT messages
@@ -1400,7 +1590,8 @@
 	CFG(CFG_DP_TCP_DELACK_TIMER_COUNT) \
 	CFG(CFG_DP_TCP_TX_HIGH_TPUT_THRESHOLD) \
 	CFG(CFG_DP_BUS_LOW_BW_CNT_THRESHOLD) \
-	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS)
+	CFG(CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS) \
+	CFG_HDD_DP_BUS_BW_GOVERNOR
 
 #else
 #define CFG_HDD_DP_BUS_BANDWIDTH
@@ -1417,6 +1608,43 @@
 #define CFG_DP_DRIVER_TCP_DELACK
 #endif
 
+#ifdef WLAN_HDD_TX_MULTI_QUEUE
+/*
+ * <ini>
+ * gTxQueuesPerAc - Number of netdev tx queues per access category
+ * @Min: 1
+ * @Max: 4
+ * @Default: 1
+ *
+ * This ini is used to expose more than one netdev tx queue per access
+ * category. Frames are spread over the queues of their AC by sending
+ * CPU, with a socket sticking to its queue while it has frames in
+ * flight, so that multi-threaded uploads do not serialise on the queue
+ * lock of one AC. WMM classification and flow control are unchanged and
+ * apply to all queues of an AC. Takes effect for interfaces created
+ * after it is set.
+ *
+ * Related: None
+ *
+ * Supported Feature: STA/SAP
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_TX_QUEUES_PER_AC \
+		CFG_INI_UINT("gTxQueuesPerAc", \
+		1, \
+		4, \
+		1, \
+		CFG_VALUE_OR_DEFAULT, "netdev tx queues per access category")
+
+#define CFG_DP_TX_QUEUES_PER_AC_ALL \
+			CFG(CFG_DP_TX_QUEUES_PER_AC)
+#else
+#define CFG_DP_TX_QUEUES_PER_AC_ALL
+#endif
+
 #ifdef WLAN_SUPPORT_TXRX_HL_BUNDLE
 #define CFG_DP_HL_BUNDLE \
 	CFG(CFG_DP_HL_BUNDLE_HIGH_TH) \
@@ -1444,6 +1672,8 @@
 	CFG(CFG_DP_FILTER_MULTICAST_REPLAY) \
 	CFG(CFG_DP_RX_WAKELOCK_TIMEOUT) \
 	CFG(CFG_DP_NUM_DP_RX_THREADS) \
+	CFG(CFG_DP_NUM_OL_RX_THREADS) \
+	CFG(CFG_DP_RX_FLOW_STEERING) \
 	CFG(CFG_DP_HTC_WMI_CREDIT_CNT) \
 	CFG_DP_ENABLE_FASTPATH_ALL \
 	CFG_HDD_DP_BUS_BANDWIDTH \
@@ -1451,5 +1681,6 @@
 	CFG_HDD_DP_LEGACY_TX_FLOW \
 	CFG_DP_ENABLE_NUD_TRACKING_ALL \
 	CFG_DP_CONFIG_DP_TRACE_ALL \
-	CFG_DP_HL_BUNDLE
+	CFG_DP_HL_BUNDLE \
+	CFG_DP_TX_QUEUES_PER_AC_ALL
 #endif
@@ -173,6 +173,13 @@ struct hdd_config {
 	bool     enable_tcp_param_update;
 	uint32_t bus_low_cnt_threshold;
 	bool enable_latency_crit_clients;
+#ifdef WLAN_BUS_BW_GOVERNOR
+	bool bus_bw_governor;
+	uint8_t bus_bw_gov_ewma_shift;
+	uint8_t bus_bw_gov_down_hysteresis;
+	uint8_t bus_bw_gov_down_hold_cnt;
+	uint8_t bus_bw_gov_rx_ring_ramp_pct;
+#endif
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef QCA_SUPPORT_TXRX_DRIVER_TCP_DEL_ACK
@@ -202,11 +209,16 @@ struct hdd_config {
 	bool multicast_replay_filter;
 	uint32_t rx_wakelock_timeout;
 	uint8_t num_dp_rx_threads;
+	uint8_t num_ol_rx_threads;
+	bool dp_rx_flow_steering;
 #ifdef CONFIG_DP_TRACE
 	bool enable_dp_trace;
 	uint8_t dp_trace_config[DP_TRACE_CONFIG_STRING_LENGTH];
 #endif
 	uint8_t enable_nud_tracking;
+#ifdef WLAN_HDD_TX_MULTI_QUEUE
+	uint8_t tx_queues_per_ac;
+#endif
 	uint32_t operating_chan_freq;
 	uint8_t num_vdevs;
 	uint8_t enable_concurrent_sta[CFG_CONCURRENT_IFACE_MAX_LEN];
@@ -26,6 +26,7 @@
  */
 
 #include <qdf_nbuf.h>
+#include <wlan_objmgr_pdev_obj.h>
 
 #ifdef IPA_OFFLOAD
 
@@ -41,6 +42,17 @@
  */
 void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev);
 
+/**
+ * hdd_ipa_reg_send_to_nw_list_cb() - Register the IPA Rx list delivery cb
+ * @pdev: pdev obj
+ *
+ * IPA Rx exception packets are delivered to the network stack in batches
+ * unless IPA LAN Rx uses NAPI.
+ *
+ * Return: None
+ */
+void hdd_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev);
+
 /**
  * hdd_ipa_set_tx_flow_info() - To set TX flow info if IPA is
  * enabled
@@ -67,6 +79,11 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t skb, qdf_netdev_t dev)
 {
 }
 
+static inline
+void hdd_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev)
+{
+}
+
 static inline void hdd_ipa_set_tx_flow_info(void)
 {
 }
@@ -154,6 +154,20 @@ struct hdd_apf_context {
 #define NUM_TX_QUEUES 4
 #endif
 
+/*
+ * With WLAN_HDD_TX_MULTI_QUEUE the NUM_TX_QUEUES AC queues can be
+ * replicated up to HDD_TX_QUEUES_PER_AC_MAX times, so that CPUs sending
+ * on the same AC do not serialise on one netdev queue lock. Netdev queue
+ * n serves the AC queue n % NUM_TX_QUEUES, so the first NUM_TX_QUEUES
+ * queues keep the single queue per AC layout.
+ */
+#ifdef WLAN_HDD_TX_MULTI_QUEUE
+#define HDD_TX_QUEUES_PER_AC_MAX 4
+#else
+#define HDD_TX_QUEUES_PER_AC_MAX 1
+#endif
+#define HDD_MAX_TX_QUEUES (NUM_TX_QUEUES * HDD_TX_QUEUES_PER_AC_MAX)
+
 /*
  * API in_compat_syscall() is introduced in 4.6 kernel to check whether we're
  * in a compat syscall or not. It is a new way to query the syscall type, which
@@ -430,6 +444,10 @@ enum hdd_auth_key_mgmt {
  *			last 100ms interval
  * @is_rx_pm_qos_high	Capture rx_pm_qos voting
  * @is_tx_pm_qos_high	Capture tx_pm_qos voting
+ * @gov_reason:		enum hdd_bus_bw_gov_reason of the bus bandwidth
+ *			governor decision behind @next_vote_level
+ * @gov_load:		smoothed load seen by the bus bandwidth governor,
+ *			in packets per interval
  * @qtime		timestamp when the record is added
  *
  * The structure keeps track of throughput requirements of wlan driver.
@@ -444,9 +462,47 @@ struct hdd_tx_rx_histogram {
 	uint32_t next_tx_level;
 	bool is_rx_pm_qos_high;
 	bool is_tx_pm_qos_high;
+	uint8_t gov_reason;
+	uint64_t gov_load;
 	uint64_t qtime;
 };
 
+/**
+ * enum hdd_bus_bw_gov_reason - bus bandwidth governor decisions
+ * @HDD_BUS_BW_GOV_NONE: governor not in use, fixed thresholds apply
+ * @HDD_BUS_BW_GOV_STAY: vote kept at the current level
+ * @HDD_BUS_BW_GOV_UP: vote raised on the load of the last interval
+ * @HDD_BUS_BW_GOV_RAMP: vote raised to the top on rx ring depletion
+ * @HDD_BUS_BW_GOV_DOWN: vote lowered after the hold period
+ * @HDD_BUS_BW_GOV_HOLD: lower vote deferred by the hold period
+ */
+enum hdd_bus_bw_gov_reason {
+	HDD_BUS_BW_GOV_NONE,
+	HDD_BUS_BW_GOV_STAY,
+	HDD_BUS_BW_GOV_UP,
+	HDD_BUS_BW_GOV_RAMP,
+	HDD_BUS_BW_GOV_DOWN,
+	HDD_BUS_BW_GOV_HOLD,
+};
+
+/**
+ * struct hdd_bus_bw_gov - adaptive bus bandwidth governor state
+ * @ewma_load: smoothed load, in packets per compute interval
+ * @down_cnt: consecutive intervals in which a lower level was allowed
+ * @ups: number of votes raised on the interval load
+ * @ramps: number of votes raised on rx ring depletion
+ * @downs: number of votes lowered
+ * @holds: number of intervals a lower vote was deferred
+ */
+struct hdd_bus_bw_gov {
+	uint64_t ewma_load;
+	uint32_t down_cnt;
+	uint32_t ups;
+	uint32_t ramps;
+	uint32_t downs;
+	uint32_t holds;
+};
+
 struct hdd_tx_rx_stats {
 	/* start_xmit stats */
 	__u32    tx_called;
@@ -1271,6 +1327,7 @@ struct hdd_adapter {
 	unsigned long prev_rx_packets;
 	unsigned long prev_tx_packets;
 	unsigned long prev_tx_bytes;
+	unsigned long prev_rx_bytes;
 	uint64_t prev_fwd_tx_packets;
 	uint64_t prev_fwd_rx_packets;
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
@@ -1741,6 +1798,9 @@ struct hdd_context {
 	uint64_t prev_tx;
 	qdf_atomic_t low_tput_gro_enable;
 	uint32_t bus_low_vote_cnt;
+#ifdef WLAN_BUS_BW_GOVERNOR
+	struct hdd_bus_bw_gov bus_bw_gov;
+#endif
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 	struct completion ready_to_suspend;
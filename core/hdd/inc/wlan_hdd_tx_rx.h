@@ -397,7 +397,93 @@ QDF_STATUS hdd_mon_rx_packet_cbk(void *context, qdf_nbuf_t rxbuf)
 
 void hdd_send_rps_ind(struct hdd_adapter *adapter);
 void hdd_send_rps_disable_ind(struct hdd_adapter *adapter);
-void wlan_hdd_classify_pkt(struct sk_buff *skb);
+
+/**
+ * struct hdd_tx_pkt_info - tx frame headers parsed by wlan_hdd_classify_pkt()
+ * @ether_type: ethertype of the frame, in network byte order
+ * @ip_proto: IPv4 protocol or IPv6 next header, 0 for non IP frames
+ * @subtype: EAPOL or DHCP message subtype, QDF_PROTO_INVALID otherwise
+ */
+struct hdd_tx_pkt_info {
+	__be16 ether_type;
+	uint8_t ip_proto;
+	enum qdf_proto_subtype subtype;
+};
+
+/**
+ * wlan_hdd_classify_pkt() - classify a tx frame in a single header walk
+ * @skb: frame to classify
+ * @info: filled with the parsed header fields, for later tx stages
+ *
+ * Resets the nbuf control block and records the broadcast/multicast flags
+ * and the special packet type in it.
+ *
+ * Return: None
+ */
+void wlan_hdd_classify_pkt(struct sk_buff *skb, struct hdd_tx_pkt_info *info);
+
+/**
+ * hdd_txq_to_linux_ac() - get the AC queue served by a netdev tx queue
+ * @queue: netdev tx queue index
+ *
+ * Return: AC queue, enum hdd_wmm_linuxac
+ */
+static inline uint16_t hdd_txq_to_linux_ac(uint16_t queue)
+{
+	return queue % NUM_TX_QUEUES;
+}
+
+/**
+ * hdd_netif_ac_stop() - stop all netdev tx queues serving an AC queue
+ * @dev: net device
+ * @linux_ac: AC queue, enum hdd_wmm_linuxac
+ *
+ * Return: None
+ */
+static inline void hdd_netif_ac_stop(struct net_device *dev,
+				     uint16_t linux_ac)
+{
+	uint16_t queue;
+
+	for (queue = linux_ac; queue < dev->real_num_tx_queues;
+	     queue += NUM_TX_QUEUES)
+		netif_stop_subqueue(dev, queue);
+}
+
+/**
+ * hdd_netif_ac_wake() - wake all netdev tx queues serving an AC queue
+ * @dev: net device
+ * @linux_ac: AC queue, enum hdd_wmm_linuxac
+ *
+ * Return: None
+ */
+static inline void hdd_netif_ac_wake(struct net_device *dev,
+				     uint16_t linux_ac)
+{
+	uint16_t queue;
+
+	for (queue = linux_ac; queue < dev->real_num_tx_queues;
+	     queue += NUM_TX_QUEUES)
+		netif_wake_subqueue(dev, queue);
+}
+
+#ifdef WLAN_HDD_TX_MULTI_QUEUE
+/**
+ * hdd_num_tx_queues() - number of netdev tx queues of a new interface
+ * @hdd_ctx: hdd context
+ *
+ * Return: number of netdev tx queues
+ */
+static inline unsigned int hdd_num_tx_queues(struct hdd_context *hdd_ctx)
+{
+	return NUM_TX_QUEUES * hdd_ctx->config->tx_queues_per_ac;
+}
+#else
+static inline unsigned int hdd_num_tx_queues(struct hdd_context *hdd_ctx)
+{
+	return NUM_TX_QUEUES;
+}
+#endif
 
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
 void hdd_reset_tcp_delack(struct hdd_context *hdd_ctx);
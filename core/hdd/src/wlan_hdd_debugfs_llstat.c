@@ -28,6 +28,7 @@
 #include <wlan_hdd_debugfs_llstat.h>
 #include <wlan_hdd_stats.h>
 #include <wma_api.h>
+#include "ol_tx_latency.h"
 
 struct ll_stats_buf {
 	ssize_t len;
@@ -38,6 +39,50 @@ static struct ll_stats_buf ll_stats;
 
 static DEFINE_MUTEX(llstats_mutex);
 
+#ifdef WLAN_TX_LATENCY_HIST
+/**
+ * hdd_debugfs_llstats_tx_lat() - append the host tx latency of an AC
+ * @adapter: hdd adapter
+ * @ac: access category, WMI AC numbering
+ * @buffer: in/out pointer to the output position of the previous line
+ * @len: in/out length of the previous line
+ *
+ * Lets the firmware contention time of an AC be compared with the time
+ * frames spent in the txrx queues and from download to completion.
+ *
+ * Return: none
+ */
+static void hdd_debugfs_llstats_tx_lat(struct hdd_adapter *adapter,
+				       uint32_t ac, uint8_t **buffer,
+				       ssize_t *len)
+{
+	uint8_t vdev_id = adapter->vdev_id;
+
+	*buffer += *len;
+	ll_stats.len += *len;
+	*len = scnprintf(*buffer, DEBUGFS_LLSTATS_BUF_SIZE - ll_stats.len,
+			 ", host tx latency(us) p50/p99: txq %u/%u, fw %u/%u, total %u/%u",
+			 ol_tx_lat_percentile(vdev_id, OL_TX_LAT_STAGE_TXQ,
+					      ac, 50),
+			 ol_tx_lat_percentile(vdev_id, OL_TX_LAT_STAGE_TXQ,
+					      ac, 99),
+			 ol_tx_lat_percentile(vdev_id, OL_TX_LAT_STAGE_FW,
+					      ac, 50),
+			 ol_tx_lat_percentile(vdev_id, OL_TX_LAT_STAGE_FW,
+					      ac, 99),
+			 ol_tx_lat_percentile(vdev_id, OL_TX_LAT_STAGE_TOTAL,
+					      ac, 50),
+			 ol_tx_lat_percentile(vdev_id, OL_TX_LAT_STAGE_TOTAL,
+					      ac, 99));
+}
+#else
+static inline void hdd_debugfs_llstats_tx_lat(struct hdd_adapter *adapter,
+					      uint32_t ac, uint8_t **buffer,
+					      ssize_t *len)
+{
+}
+#endif
+
 void hdd_debugfs_process_iface_stats(struct hdd_adapter *adapter,
 		void *data, uint32_t num_peers)
 {
@@ -127,6 +172,8 @@ void hdd_debugfs_process_iface_stats(struct hdd_adapter *adapter,
 				ac_stats->contention_time_avg,
 				ac_stats->contention_num_samples,
 				ac_stats->tx_pending_msdu);
+		hdd_debugfs_llstats_tx_lat(adapter, ac_stats->ac_type,
+					   &buffer, &len);
 	}
 
 	buffer += len;
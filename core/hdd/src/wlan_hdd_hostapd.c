@@ -3624,7 +3624,8 @@ struct hdd_adapter *hdd_wlan_create_ap_dev(struct hdd_context *hdd_ctx,
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(3, 17, 0)) || defined(WITH_BACKPORTS)
 					  name_assign_type,
 #endif
-					  ether_setup, NUM_TX_QUEUES);
+					  ether_setup,
+					  hdd_num_tx_queues(hdd_ctx));
 
 	if (!dev)
 		return NULL;
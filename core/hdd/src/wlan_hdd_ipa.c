@@ -400,12 +400,17 @@ static int hdd_ipa_aggregated_rx_ind(qdf_nbuf_t skb)
 	ret =  hdd_ipa_send_to_nw_stack(skb);
 	return ret;
 }
+
+static inline void hdd_ipa_rx_list_softirq_account(uint32_t num)
+{
+}
 #else
+static atomic_t softirq_mitigation_cntr =
+	ATOMIC_INIT(IPA_WLAN_RX_SOFTIRQ_THRESH);
+
 static int hdd_ipa_aggregated_rx_ind(qdf_nbuf_t skb)
 {
 	struct iphdr *ip_h;
-	static atomic_t softirq_mitigation_cntr =
-		ATOMIC_INIT(IPA_WLAN_RX_SOFTIRQ_THRESH);
 	int result;
 
 	ip_h = (struct iphdr *)(skb->data);
@@ -427,25 +432,37 @@ static int hdd_ipa_aggregated_rx_ind(qdf_nbuf_t skb)
 
 	return result;
 }
-#endif
 
-void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
+/**
+ * hdd_ipa_rx_list_softirq_account() - Account a list for softirq mitigation
+ * @num: number of packets delivered in the list
+ *
+ * Lists are delivered from bottom half context, where the softirqs raised
+ * by netif_rx for the packets queued ahead of them run on exit anyway.
+ * Count the packets against IPA_WLAN_RX_SOFTIRQ_THRESH all the same, so
+ * that the threshold keeps covering all packets delivered to the stack.
+ *
+ * Return: None
+ */
+static void hdd_ipa_rx_list_softirq_account(uint32_t num)
 {
-	struct hdd_adapter *adapter = (struct hdd_adapter *) netdev_priv(dev);
-	int result;
-	unsigned int cpu_index;
-	uint32_t enabled;
-
-	if (hdd_validate_adapter(adapter)) {
-		kfree_skb(nbuf);
-		return;
-	}
-
-	if (cds_is_driver_unloading()) {
-		kfree_skb(nbuf);
-		return;
-	}
+	if (atomic_sub_return(num, &softirq_mitigation_cntr) <= 0)
+		atomic_set(&softirq_mitigation_cntr,
+			   IPA_WLAN_RX_SOFTIRQ_THRESH);
+}
+#endif
 
+/**
+ * hdd_ipa_rx_prepare_nbuf() - Prepare an IPA Rx packet for the network stack
+ * @adapter: adapter the packet is received on
+ * @nbuf: network buffer
+ * @cpu_index: index of the current CPU, for the per CPU stats
+ *
+ * Return: None
+ */
+static void hdd_ipa_rx_prepare_nbuf(struct hdd_adapter *adapter,
+				    qdf_nbuf_t nbuf, unsigned int cpu_index)
+{
 	if ((adapter->device_mode == QDF_SAP_MODE) &&
 	    (qdf_nbuf_is_ipv4_dhcp_pkt(nbuf) == true)) {
 		/* Send DHCP Indication to FW */
@@ -466,20 +483,10 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
 				      QDF_DP_TRACE_RX_PACKET_RECORD, 0,
 				      QDF_RX));
 
-	/*
-	 * Set PF_WAKE_UP_IDLE flag in the task structure
-	 * This task and any task woken by this will be waken to idle CPU
-	 */
-	enabled = hdd_ipa_get_wake_up_idle();
-	if (!enabled)
-		hdd_ipa_set_wake_up_idle(true);
-
 	nbuf->dev = adapter->dev;
 	nbuf->protocol = eth_type_trans(nbuf, nbuf->dev);
 	nbuf->ip_summed = CHECKSUM_NONE;
 
-	cpu_index = wlan_hdd_get_cpu();
-
 	++adapter->hdd_stats.tx_rx_stats.rx_packets[cpu_index];
 
 	/*
@@ -489,6 +496,35 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
 
 	++adapter->stats.rx_packets;
 	adapter->stats.rx_bytes += nbuf->len;
+}
+
+void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
+{
+	struct hdd_adapter *adapter = (struct hdd_adapter *) netdev_priv(dev);
+	int result;
+	unsigned int cpu_index;
+	uint32_t enabled;
+
+	if (hdd_validate_adapter(adapter)) {
+		kfree_skb(nbuf);
+		return;
+	}
+
+	if (cds_is_driver_unloading()) {
+		kfree_skb(nbuf);
+		return;
+	}
+
+	/*
+	 * Set PF_WAKE_UP_IDLE flag in the task structure
+	 * This task and any task woken by this will be waken to idle CPU
+	 */
+	enabled = hdd_ipa_get_wake_up_idle();
+	if (!enabled)
+		hdd_ipa_set_wake_up_idle(true);
+
+	cpu_index = wlan_hdd_get_cpu();
+	hdd_ipa_rx_prepare_nbuf(adapter, nbuf, cpu_index);
 
 	result = hdd_ipa_aggregated_rx_ind(nbuf);
 	if (result == NET_RX_SUCCESS) {
@@ -507,6 +543,118 @@ void hdd_ipa_send_nbuf_to_network(qdf_nbuf_t nbuf, qdf_netdev_t dev)
 		hdd_ipa_set_wake_up_idle(false);
 }
 
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 19, 0)
+/**
+ * hdd_ipa_rx_deliver_list() - Deliver a list of IPA Rx packets to the stack
+ * @adapter: adapter all of @nbuf_list is received on
+ * @nbuf_list: network buffer list, linked with qdf_nbuf_next()
+ * @cpu_index: index of the current CPU, for the per CPU stats
+ *
+ * Return: number of packets in @nbuf_list
+ */
+static uint32_t hdd_ipa_rx_deliver_list(struct hdd_adapter *adapter,
+					qdf_nbuf_t nbuf_list,
+					unsigned int cpu_index)
+{
+	qdf_nbuf_t nbuf, next;
+	uint32_t num = 0;
+	LIST_HEAD(rx_list);
+
+	for (nbuf = nbuf_list; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		hdd_ipa_rx_prepare_nbuf(adapter, nbuf, cpu_index);
+		list_add_tail(&nbuf->list, &rx_list);
+		num++;
+	}
+
+	/* Called in bottom half context, the stack does not report drops */
+	netif_receive_skb_list(&rx_list);
+	adapter->hdd_stats.tx_rx_stats.rx_delivered[cpu_index] += num;
+
+	return num;
+}
+#else
+static uint32_t hdd_ipa_rx_deliver_list(struct hdd_adapter *adapter,
+					qdf_nbuf_t nbuf_list,
+					unsigned int cpu_index)
+{
+	qdf_nbuf_t nbuf, next;
+	uint32_t num = 0;
+
+	for (nbuf = nbuf_list; nbuf; nbuf = next) {
+		next = qdf_nbuf_next(nbuf);
+		qdf_nbuf_set_next(nbuf, NULL);
+		hdd_ipa_rx_prepare_nbuf(adapter, nbuf, cpu_index);
+		if (netif_receive_skb(nbuf) == NET_RX_SUCCESS)
+			++adapter->hdd_stats.tx_rx_stats.rx_delivered[cpu_index];
+		else
+			++adapter->hdd_stats.tx_rx_stats.rx_refused[cpu_index];
+		num++;
+	}
+
+	return num;
+}
+#endif
+
+/**
+ * hdd_ipa_send_nbuf_list_to_network() - Send a list of network buffers to
+ * kernel
+ * @nbuf_list: network buffer list, linked with qdf_nbuf_next()
+ * @dev: network adapter all of @nbuf_list is received on
+ *
+ * Called in bottom half context with a batch of IPA exception packets.
+ *
+ * Return: None
+ */
+static void hdd_ipa_send_nbuf_list_to_network(qdf_nbuf_t nbuf_list,
+					      qdf_netdev_t dev)
+{
+	struct hdd_adapter *adapter = (struct hdd_adapter *) netdev_priv(dev);
+	qdf_nbuf_t nbuf, next;
+	unsigned int cpu_index;
+	uint32_t enabled;
+	uint32_t num;
+
+	if (hdd_validate_adapter(adapter) || cds_is_driver_unloading()) {
+		for (nbuf = nbuf_list; nbuf; nbuf = next) {
+			next = qdf_nbuf_next(nbuf);
+			kfree_skb(nbuf);
+		}
+		return;
+	}
+
+	/*
+	 * Set PF_WAKE_UP_IDLE flag in the task structure
+	 * This task and any task woken by this will be waken to idle CPU
+	 */
+	enabled = hdd_ipa_get_wake_up_idle();
+	if (!enabled)
+		hdd_ipa_set_wake_up_idle(true);
+
+	cpu_index = wlan_hdd_get_cpu();
+	num = hdd_ipa_rx_deliver_list(adapter, nbuf_list, cpu_index);
+	hdd_ipa_rx_list_softirq_account(num);
+
+	/*
+	 * Restore PF_WAKE_UP_IDLE flag in the task structure
+	 */
+	if (!enabled)
+		hdd_ipa_set_wake_up_idle(false);
+}
+
+void hdd_ipa_reg_send_to_nw_list_cb(struct wlan_objmgr_pdev *pdev)
+{
+	/*
+	 * With IPA LAN Rx NAPI, exception packets are already delivered
+	 * from NAPI context with netif_receive_skb, so leave them unbatched.
+	 */
+	if (qdf_ipa_get_lan_rx_napi())
+		return;
+
+	ucfg_ipa_reg_send_to_nw_list_cb(pdev,
+					hdd_ipa_send_nbuf_list_to_network);
+}
+
 void hdd_ipa_set_mcc_mode(bool mcc_mode)
 {
 	struct hdd_context *hdd_ctx;
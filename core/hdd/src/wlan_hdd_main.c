@@ -3895,6 +3895,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 				 hdd_softap_ipa_start_xmit);
 	ucfg_ipa_reg_send_to_nw_cb(hdd_ctx->pdev,
 				   hdd_ipa_send_nbuf_to_network);
+	hdd_ipa_reg_send_to_nw_list_cb(hdd_ctx->pdev);
 
 	hdd_exit();
 
@@ -4798,7 +4799,7 @@ hdd_alloc_station_adapter(struct hdd_context *hdd_ctx, tSirMacAddr mac_addr,
 			      ((cds_get_conparam() == QDF_GLOBAL_MONITOR_MODE ||
 			       wlan_hdd_is_session_type_monitor(session_type)) ?
 			       hdd_mon_mode_ether_setup : ether_setup),
-			      NUM_TX_QUEUES);
+			      hdd_num_tx_queues(hdd_ctx));
 
 	if (!dev) {
 		hdd_err("Failed to allocate new net_device '%s'", name);
@@ -8970,11 +8971,200 @@ static inline void hdd_pm_qos_update_request(struct hdd_context *hdd_ctx,
 }
 #endif
 
+/**
+ * hdd_bus_bw_level() - bus bandwidth level for a packet count
+ * @hdd_ctx: handle to hdd context
+ * @pkts: tx + rx packets per compute interval
+ *
+ * Return: bus bandwidth level matching the configured thresholds
+ */
+static enum pld_bus_width_type hdd_bus_bw_level(struct hdd_context *hdd_ctx,
+						uint64_t pkts)
+{
+	if (pkts > hdd_ctx->config->bus_bw_very_high_threshold)
+		return PLD_BUS_WIDTH_VERY_HIGH;
+	else if (pkts > hdd_ctx->config->bus_bw_high_threshold)
+		return PLD_BUS_WIDTH_HIGH;
+	else if (pkts > hdd_ctx->config->bus_bw_medium_threshold)
+		return PLD_BUS_WIDTH_MEDIUM;
+	else if (pkts > hdd_ctx->config->bus_bw_low_threshold)
+		return PLD_BUS_WIDTH_LOW;
+	else
+		return PLD_BUS_WIDTH_IDLE;
+}
+
+#ifdef WLAN_BUS_BW_GOVERNOR
+/* bytes counted as one packet when turning the byte rate into a load */
+#define HDD_BUS_BW_GOV_BYTES_PER_PKT 1500
+
+/**
+ * hdd_bus_bw_gov_rx_ring_deficit() - share of the rx ring waiting for buffers
+ *
+ * The deficit is only reported by datapaths whose cdp misc ops provide it.
+ * CDP_MISC_RX_RING_DEFICIT is defined by the cdp layer along with the op.
+ *
+ * Return: rx buffers owed to the rx ring, in percent of its fill level, 0
+ *	   if unknown
+ */
+#ifdef CDP_MISC_RX_RING_DEFICIT
+static inline uint32_t hdd_bus_bw_gov_rx_ring_deficit(void)
+{
+	return cdp_get_rx_ring_deficit(cds_get_context(QDF_MODULE_ID_SOC),
+				       OL_TXRX_PDEV_ID);
+}
+#else
+static inline uint32_t hdd_bus_bw_gov_rx_ring_deficit(void)
+{
+	return 0;
+}
+#endif
+
+/**
+ * hdd_bus_bw_gov_level() - pick the bus bandwidth level in governor mode
+ * @hdd_ctx: handle to hdd context
+ * @total_pkts: tx + rx packets in the last compute interval
+ * @total_bytes: tx + rx bytes in the last compute interval
+ * @reason: filled with the enum hdd_bus_bw_gov_reason of the decision
+ *
+ * The load of an interval is the larger of its packet count and its byte
+ * count expressed in full sized packets. The vote is raised right away
+ * when the load of the last interval, or a depleted rx ring, asks for a
+ * higher level. It is lowered one level at a time, and only when the
+ * smoothed load plus the hysteresis margin has allowed a lower level for
+ * the configured number of intervals, so traffic hovering around a
+ * threshold does not make the vote oscillate.
+ *
+ * Return: bus bandwidth level to vote for
+ */
+static enum pld_bus_width_type
+hdd_bus_bw_gov_level(struct hdd_context *hdd_ctx, uint64_t total_pkts,
+		     uint64_t total_bytes, uint8_t *reason)
+{
+	struct hdd_config *cfg = hdd_ctx->config;
+	struct hdd_bus_bw_gov *gov = &hdd_ctx->bus_bw_gov;
+	enum pld_bus_width_type cur_level = hdd_ctx->cur_vote_level;
+	enum pld_bus_width_type level;
+	uint64_t load, down_load;
+	uint8_t shift = cfg->bus_bw_gov_ewma_shift;
+	uint32_t deficit;
+
+	load = qdf_do_div(total_bytes, HDD_BUS_BW_GOV_BYTES_PER_PKT);
+	load = qdf_max(load, total_pkts);
+	gov->ewma_load = gov->ewma_load - (gov->ewma_load >> shift) +
+			 (load >> shift);
+
+	if (cfg->bus_bw_gov_rx_ring_ramp_pct) {
+		deficit = hdd_bus_bw_gov_rx_ring_deficit();
+		if (deficit >= cfg->bus_bw_gov_rx_ring_ramp_pct) {
+			gov->down_cnt = 0;
+			if (cur_level >= PLD_BUS_WIDTH_VERY_HIGH) {
+				*reason = HDD_BUS_BW_GOV_STAY;
+				return cur_level;
+			}
+			gov->ramps++;
+			*reason = HDD_BUS_BW_GOV_RAMP;
+			return PLD_BUS_WIDTH_VERY_HIGH;
+		}
+	}
+
+	level = hdd_bus_bw_level(hdd_ctx, load);
+	if (level > cur_level) {
+		gov->down_cnt = 0;
+		gov->ups++;
+		*reason = HDD_BUS_BW_GOV_UP;
+		return level;
+	}
+
+	down_load = qdf_do_div(gov->ewma_load *
+			       (100 + cfg->bus_bw_gov_down_hysteresis), 100);
+	level = hdd_bus_bw_level(hdd_ctx, qdf_max(load, down_load));
+	if (level >= cur_level) {
+		gov->down_cnt = 0;
+		*reason = HDD_BUS_BW_GOV_STAY;
+		return cur_level;
+	}
+
+	if (++gov->down_cnt < cfg->bus_bw_gov_down_hold_cnt) {
+		gov->holds++;
+		*reason = HDD_BUS_BW_GOV_HOLD;
+		return cur_level;
+	}
+
+	gov->down_cnt = 0;
+	gov->downs++;
+	*reason = HDD_BUS_BW_GOV_DOWN;
+
+	return cur_level - 1;
+}
+
+/**
+ * hdd_bus_bw_next_level() - pick the bus bandwidth level to vote for
+ * @hdd_ctx: handle to hdd context
+ * @total_pkts: tx + rx packets in the last compute interval
+ * @total_bytes: tx + rx bytes in the last compute interval
+ * @reason: filled with the enum hdd_bus_bw_gov_reason of the decision
+ *
+ * Return: bus bandwidth level to vote for
+ */
+static enum pld_bus_width_type
+hdd_bus_bw_next_level(struct hdd_context *hdd_ctx, uint64_t total_pkts,
+		      uint64_t total_bytes, uint8_t *reason)
+{
+	if (hdd_ctx->config->bus_bw_governor)
+		return hdd_bus_bw_gov_level(hdd_ctx, total_pkts, total_bytes,
+					    reason);
+
+	*reason = HDD_BUS_BW_GOV_NONE;
+	return hdd_bus_bw_level(hdd_ctx, total_pkts);
+}
+
+/**
+ * hdd_bus_bw_gov_load() - smoothed load of the bus bandwidth governor
+ * @hdd_ctx: handle to hdd context
+ *
+ * Return: smoothed load in packets per compute interval
+ */
+static inline uint64_t hdd_bus_bw_gov_load(struct hdd_context *hdd_ctx)
+{
+	return hdd_ctx->bus_bw_gov.ewma_load;
+}
+
+/**
+ * hdd_bus_bw_gov_reset() - forget the traffic history of the governor
+ * @hdd_ctx: handle to hdd context
+ *
+ * Return: None
+ */
+static inline void hdd_bus_bw_gov_reset(struct hdd_context *hdd_ctx)
+{
+	hdd_ctx->bus_bw_gov.ewma_load = 0;
+	hdd_ctx->bus_bw_gov.down_cnt = 0;
+}
+#else
+static inline enum pld_bus_width_type
+hdd_bus_bw_next_level(struct hdd_context *hdd_ctx, uint64_t total_pkts,
+		      uint64_t total_bytes, uint8_t *reason)
+{
+	*reason = HDD_BUS_BW_GOV_NONE;
+	return hdd_bus_bw_level(hdd_ctx, total_pkts);
+}
+
+static inline uint64_t hdd_bus_bw_gov_load(struct hdd_context *hdd_ctx)
+{
+	return 0;
+}
+
+static inline void hdd_bus_bw_gov_reset(struct hdd_context *hdd_ctx)
+{
+}
+#endif /* WLAN_BUS_BW_GOVERNOR */
+
 /**
  * hdd_pld_request_bus_bandwidth() - Function to control bus bandwidth
  * @hdd_ctx - handle to hdd context
  * @tx_packets - transmit packet count
  * @rx_packets - receive packet count
+ * @total_bytes - transmit + receive byte count
  *
  * The function controls the bus bandwidth and dynamic control of
  * tcp delayed ack configuration
@@ -8984,7 +9174,8 @@ static inline void hdd_pm_qos_update_request(struct hdd_context *hdd_ctx,
 
 static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 					  const uint64_t tx_packets,
-					  const uint64_t rx_packets)
+					  const uint64_t rx_packets,
+					  const uint64_t total_bytes)
 {
 	uint16_t index = 0;
 	bool vote_level_change = false;
@@ -9006,19 +9197,12 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 	cpumask_t pm_qos_cpu_mask;
 	bool is_rx_pm_qos_high = false;
 	bool is_tx_pm_qos_high = false;
+	uint8_t gov_reason;
 
 	cpumask_clear(&pm_qos_cpu_mask);
 
-	if (total_pkts > hdd_ctx->config->bus_bw_very_high_threshold)
-		next_vote_level = PLD_BUS_WIDTH_VERY_HIGH;
-	else if (total_pkts > hdd_ctx->config->bus_bw_high_threshold)
-		next_vote_level = PLD_BUS_WIDTH_HIGH;
-	else if (total_pkts > hdd_ctx->config->bus_bw_medium_threshold)
-		next_vote_level = PLD_BUS_WIDTH_MEDIUM;
-	else if (total_pkts > hdd_ctx->config->bus_bw_low_threshold)
-		next_vote_level = PLD_BUS_WIDTH_LOW;
-	else
-		next_vote_level = PLD_BUS_WIDTH_IDLE;
+	next_vote_level = hdd_bus_bw_next_level(hdd_ctx, total_pkts,
+						total_bytes, &gov_reason);
 
 	dptrace_high_tput_req =
 			next_vote_level > PLD_BUS_WIDTH_IDLE ? true : false;
@@ -9032,8 +9216,8 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 	}
 
 	if (hdd_ctx->cur_vote_level != next_vote_level) {
-		hdd_debug("BW Vote level %d, tx_packets: %lld, rx_packets: %lld",
-			  next_vote_level, tx_packets, rx_packets);
+		hdd_debug("BW Vote level %d, tx_packets: %lld, rx_packets: %lld, gov: %u",
+			  next_vote_level, tx_packets, rx_packets, gov_reason);
 		hdd_ctx->cur_vote_level = next_vote_level;
 		vote_level_change = true;
 
@@ -9228,6 +9412,9 @@ static void hdd_pld_request_bus_bandwidth(struct hdd_context *hdd_ctx,
 		hdd_ctx->hdd_txrx_hist[index].is_tx_pm_qos_high =
 							is_tx_pm_qos_high;
 		hdd_ctx->hdd_txrx_hist[index].next_vote_level = next_vote_level;
+		hdd_ctx->hdd_txrx_hist[index].gov_reason = gov_reason;
+		hdd_ctx->hdd_txrx_hist[index].gov_load =
+						hdd_bus_bw_gov_load(hdd_ctx);
 		hdd_ctx->hdd_txrx_hist[index].interval_rx = rx_packets;
 		hdd_ctx->hdd_txrx_hist[index].interval_tx = tx_packets;
 		hdd_ctx->hdd_txrx_hist[index].qtime = qdf_get_log_timestamp();
@@ -9336,6 +9523,7 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 	bool connected = false;
 	uint32_t ipa_tx_packets = 0, ipa_rx_packets = 0;
 	uint64_t sta_tx_bytes = 0, sap_tx_bytes = 0;
+	uint64_t total_bytes = 0;
 
 	if (wlan_hdd_validate_context(hdd_ctx))
 		goto stop_work;
@@ -9372,6 +9560,9 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 					      adapter->prev_rx_packets);
 		tx_bytes = HDD_BW_GET_DIFF(adapter->stats.tx_bytes,
 					   adapter->prev_tx_bytes);
+		total_bytes += tx_bytes +
+			       HDD_BW_GET_DIFF(adapter->stats.rx_bytes,
+					       adapter->prev_rx_bytes);
 
 		if (adapter->device_mode == QDF_SAP_MODE ||
 		    adapter->device_mode == QDF_P2P_GO_MODE ||
@@ -9414,6 +9605,7 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 		adapter->prev_fwd_tx_packets = fwd_tx_packets;
 		adapter->prev_fwd_rx_packets = fwd_rx_packets;
 		adapter->prev_tx_bytes = adapter->stats.tx_bytes;
+		adapter->prev_rx_bytes = adapter->stats.rx_bytes;
 		qdf_spin_unlock_bh(&hdd_ctx->bus_bw_lock);
 		connected = true;
 	}
@@ -9437,7 +9629,8 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 		con_sap_adapter->stats.rx_packets += ipa_rx_packets;
 	}
 
-	hdd_pld_request_bus_bandwidth(hdd_ctx, tx_packets, rx_packets);
+	hdd_pld_request_bus_bandwidth(hdd_ctx, tx_packets, rx_packets,
+				      total_bytes);
 
 	return;
 
@@ -9619,6 +9812,59 @@ int hdd_wlan_clear_stats(struct hdd_adapter *adapter, int stats_id)
 	return 0;
 }
 
+/**
+ * hdd_bus_bw_gov_reason_to_str() - name of a bus bandwidth governor decision
+ * @reason: enum hdd_bus_bw_gov_reason value
+ *
+ * Return: printable name of @reason
+ */
+static const char *hdd_bus_bw_gov_reason_to_str(uint8_t reason)
+{
+	switch (reason) {
+	case HDD_BUS_BW_GOV_NONE:
+		return "-";
+	case HDD_BUS_BW_GOV_STAY:
+		return "STAY";
+	case HDD_BUS_BW_GOV_UP:
+		return "UP";
+	case HDD_BUS_BW_GOV_RAMP:
+		return "RAMP";
+	case HDD_BUS_BW_GOV_DOWN:
+		return "DOWN";
+	case HDD_BUS_BW_GOV_HOLD:
+		return "HOLD";
+	default:
+		return "INVAL";
+	}
+}
+
+#ifdef WLAN_BUS_BW_GOVERNOR
+/**
+ * hdd_display_bus_bw_gov() - print bus bandwidth governor settings and stats
+ * @hdd_ctx: hdd context
+ *
+ * Return: none
+ */
+static void hdd_display_bus_bw_gov(struct hdd_context *hdd_ctx)
+{
+	struct hdd_config *cfg = hdd_ctx->config;
+	struct hdd_bus_bw_gov *gov = &hdd_ctx->bus_bw_gov;
+
+	hdd_nofl_debug("BW governor: %d ewma shift: %u down hyst: %u%% hold: %u rx ring ramp: %u%%",
+		       cfg->bus_bw_governor, cfg->bus_bw_gov_ewma_shift,
+		       cfg->bus_bw_gov_down_hysteresis,
+		       cfg->bus_bw_gov_down_hold_cnt,
+		       cfg->bus_bw_gov_rx_ring_ramp_pct);
+	hdd_nofl_debug("BW governor load: %llu up: %u ramp: %u down: %u hold: %u",
+		       gov->ewma_load, gov->ups, gov->ramps, gov->downs,
+		       gov->holds);
+}
+#else
+static inline void hdd_display_bus_bw_gov(struct hdd_context *hdd_ctx)
+{
+}
+#endif /* WLAN_BUS_BW_GOVERNOR */
+
 void wlan_hdd_display_tx_rx_histogram(struct hdd_context *hdd_ctx)
 {
 	int i;
@@ -9638,17 +9884,18 @@ void wlan_hdd_display_tx_rx_histogram(struct hdd_context *hdd_ctx)
 		       hdd_ctx->config->tcp_delack_thres_low);
 	hdd_nofl_debug("TCP TX HIGH TP TH: %d (Use to set tcp_output_bytes_limit)",
 		       hdd_ctx->config->tcp_tx_high_tput_thres);
+	hdd_display_bus_bw_gov(hdd_ctx);
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 	hdd_nofl_debug("Total entries: %d Current index: %d",
 		       NUM_TX_RX_HISTOGRAM, hdd_ctx->hdd_txrx_hist_idx);
 
-	hdd_nofl_debug("[index][timestamp]: interval_rx, interval_tx, bus_bw_level, RX TP Level, TX TP Level, Rx:Tx pm_qos");
+	hdd_nofl_debug("[index][timestamp]: interval_rx, interval_tx, bus_bw_level, RX TP Level, TX TP Level, Rx:Tx pm_qos, gov:load");
 
 	for (i = 0; i < NUM_TX_RX_HISTOGRAM; i++) {
 		/* using hdd_log to avoid printing function name */
 		if (hdd_ctx->hdd_txrx_hist[i].qtime > 0)
-			hdd_nofl_debug("[%3d][%15llu]: %6llu, %6llu, %s, %s, %s, %s:%s",
+			hdd_nofl_debug("[%3d][%15llu]: %6llu, %6llu, %s, %s, %s, %s:%s, %s:%llu",
 				       i, hdd_ctx->hdd_txrx_hist[i].qtime,
 				       hdd_ctx->hdd_txrx_hist[i].interval_rx,
 				       hdd_ctx->hdd_txrx_hist[i].interval_tx,
@@ -9664,7 +9911,10 @@ void wlan_hdd_display_tx_rx_histogram(struct hdd_context *hdd_ctx)
 				hdd_ctx->hdd_txrx_hist[i].is_rx_pm_qos_high ?
 				"HIGH" : "LOW",
 				hdd_ctx->hdd_txrx_hist[i].is_tx_pm_qos_high ?
-				"HIGH" : "LOW");
+				"HIGH" : "LOW",
+				hdd_bus_bw_gov_reason_to_str(
+					hdd_ctx->hdd_txrx_hist[i].gov_reason),
+				hdd_ctx->hdd_txrx_hist[i].gov_load);
 	}
 }
 
@@ -11472,6 +11722,7 @@ static inline void hdd_txrx_populate_cds_config(struct cds_config_info
 		cfg_get(hdd_ctx->psoc, CFG_DP_TX_FLOW_START_QUEUE_OFFSET);
 	/* configuration for DP RX Threads */
 	cds_cfg->enable_dp_rx_threads = hdd_ctx->enable_dp_rx_threads;
+	cds_cfg->dp_rx_flow_steering = hdd_ctx->config->dp_rx_flow_steering;
 }
 #else
 static inline void hdd_txrx_populate_cds_config(struct cds_config_info
@@ -11547,11 +11798,14 @@ static int hdd_update_cds_config(struct hdd_context *hdd_ctx)
 	cds_cfg->uc_offload_enabled = ucfg_ipa_uc_is_enabled();
 
 	cds_cfg->enable_rxthread = hdd_ctx->enable_rxthread;
+	cds_cfg->num_ol_rx_threads = hdd_ctx->config->num_ol_rx_threads;
 	ucfg_mlme_get_sap_max_peers(hdd_ctx->psoc, &value);
 	cds_cfg->max_station = value;
 	cds_cfg->sub_20_channel_width = WLAN_SUB_20_CH_WIDTH_NONE;
 	cds_cfg->max_msdus_per_rxinorderind =
 		cfg_get(hdd_ctx->psoc, CFG_DP_MAX_MSDUS_PER_RXIND);
+	cds_cfg->rx_paddr_cookie =
+		cfg_get(hdd_ctx->psoc, CFG_DP_RX_PADDR_COOKIE);
 	cds_cfg->self_recovery_enabled = self_recovery;
 	cds_cfg->fw_timeout_crash = fw_timeout_crash;
 
@@ -14527,6 +14781,7 @@ exit:
 	if (!hdd_is_any_adapter_connected(hdd_ctx)) {
 		qdf_atomic_set(&hdd_ctx->num_latency_critical_clients, 0);
 		hdd_ctx->cur_vote_level = PLD_BUS_WIDTH_NONE;
+		hdd_bus_bw_gov_reset(hdd_ctx);
 		pld_request_bus_bandwidth(hdd_ctx->parent_dev,
 					  PLD_BUS_WIDTH_NONE);
 	}
@@ -14559,6 +14814,7 @@ void hdd_bus_bw_compute_prev_txrx_stats(struct hdd_adapter *adapter)
 	adapter->prev_tx_packets = adapter->stats.tx_packets;
 	adapter->prev_rx_packets = adapter->stats.rx_packets;
 	adapter->prev_tx_bytes = adapter->stats.tx_bytes;
+	adapter->prev_rx_bytes = adapter->stats.rx_bytes;
 	cdp_get_intra_bss_fwd_pkts_count(cds_get_context(QDF_MODULE_ID_SOC),
 					 adapter->vdev_id,
 					 &adapter->prev_fwd_tx_packets,
@@ -14576,6 +14832,7 @@ void hdd_bus_bw_compute_reset_prev_txrx_stats(struct hdd_adapter *adapter)
 	adapter->prev_fwd_tx_packets = 0;
 	adapter->prev_fwd_rx_packets = 0;
 	adapter->prev_tx_bytes = 0;
+	adapter->prev_rx_bytes = 0;
 	qdf_spin_unlock_bh(&hdd_ctx->bus_bw_lock);
 }
 
@@ -137,7 +137,7 @@ static void hdd_nud_stats_info(struct hdd_adapter *adapter)
 
 	hdd_debug("carrier state: %d", netif_carrier_ok(adapter->dev));
 
-	for (i = 0; i < NUM_TX_QUEUES; i++) {
+	for (i = 0; i < adapter->dev->real_num_tx_queues; i++) {
 		txq = netdev_get_tx_queue(adapter->dev, i);
 		hdd_debug("Queue: %d status: %d txq->trans_start: %lu",
 			  i, netif_tx_queue_stopped(txq), txq->trans_start);
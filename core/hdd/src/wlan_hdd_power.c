@@ -142,22 +142,14 @@ void wlan_hdd_rx_thread_resume(struct hdd_context *hdd_ctx)
 int wlan_hdd_rx_thread_suspend(struct hdd_context *hdd_ctx)
 {
 	p_cds_sched_context cds_sched_context = get_cds_sched_ctxt();
-	int rc;
+	QDF_STATUS status;
 
 	if (!cds_sched_context)
 		return 0;
 
-	/* Suspend tlshim rx thread */
-	set_bit(RX_SUSPEND_EVENT, &cds_sched_context->ol_rx_event_flag);
-	wake_up_interruptible(&cds_sched_context->ol_rx_wait_queue);
-	rc = wait_for_completion_timeout(&cds_sched_context->
-					 ol_suspend_rx_event,
-					 msecs_to_jiffies
-					 (HDD_RXTHREAD_SUSPEND_TIMEOUT)
-					);
-	if (!rc) {
-		clear_bit(RX_SUSPEND_EVENT,
-			  &cds_sched_context->ol_rx_event_flag);
+	/* Suspend tlshim rx threads */
+	status = cds_suspend_rx_thread(HDD_RXTHREAD_SUSPEND_TIMEOUT);
+	if (QDF_IS_STATUS_ERROR(status)) {
 		hdd_err("Failed to stop tl_shim rx thread");
 		return -EINVAL;
 	}
@@ -46,6 +46,7 @@
 #include <wma_types.h>
 #include "wlan_hdd_sta_info.h"
 #include "ol_defines.h"
+#include "ol_rx_latency.h"
 #include <wlan_hdd_sar_limits.h>
 
 /* Preprocessor definitions and constants */
@@ -164,8 +165,9 @@ void hdd_softap_tx_resume_cb(void *adapter_context, bool tx_resume)
 	hdd_softap_tx_resume_false(adapter, tx_resume);
 }
 
-static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
-		struct sk_buff *skb)
+static inline struct sk_buff *
+hdd_skb_orphan(struct hdd_adapter *adapter, struct sk_buff *skb,
+	       const struct hdd_tx_pkt_info *info)
 {
 	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
 	int need_orphan = 0;
@@ -191,8 +193,7 @@ static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
 			need_orphan = 1;
 #endif
 	} else if (hdd_ctx->config->tx_orphan_enable) {
-		if (qdf_nbuf_is_ipv4_tcp_pkt(skb) ||
-		    qdf_nbuf_is_ipv6_tcp_pkt(skb))
+		if (info->ip_proto == IPPROTO_TCP)
 			need_orphan = 1;
 	}
 
@@ -210,11 +211,14 @@ static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
  * hdd_skb_orphan() - skb_unshare a cloned packed else skb_orphan
  * @adapter: pointer to HDD adapter
  * @skb: pointer to skb data packet
+ * @info: headers parsed by wlan_hdd_classify_pkt()
  *
  * Return: pointer to skb structure
  */
-static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
-		struct sk_buff *skb) {
+static inline struct sk_buff *
+hdd_skb_orphan(struct hdd_adapter *adapter, struct sk_buff *skb,
+	       const struct hdd_tx_pkt_info *info)
+{
 
 	struct sk_buff *nskb;
 #if (LINUX_VERSION_CODE > KERNEL_VERSION(3, 19, 0))
@@ -526,6 +530,7 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
 	uint32_t num_seg;
 	struct hdd_station_info *sta_info = NULL;
+	struct hdd_tx_pkt_info pkt_info;
 
 	++adapter->hdd_stats.tx_rx_stats.tx_called;
 	adapter->hdd_stats.tx_rx_stats.cont_txtimeout_cnt = 0;
@@ -576,7 +581,7 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 		goto drop_pkt;
 	}
 
-	wlan_hdd_classify_pkt(skb);
+	wlan_hdd_classify_pkt(skb, &pkt_info);
 
 	dest_mac_addr = (struct qdf_mac_addr *)skb->data;
 
@@ -635,14 +640,14 @@ static void __hdd_softap_hard_start_xmit(struct sk_buff *skb,
 				WLAN_SAP_HDD_TX_FLOW_CONTROL_OS_Q_BLOCK_TIME);
 
 	/* Get TL AC corresponding to Qdisc queue index/AC. */
-	ac = hdd_qdisc_ac_to_tl_ac[skb->queue_mapping];
+	ac = hdd_qdisc_ac_to_tl_ac[hdd_txq_to_linux_ac(skb->queue_mapping)];
 	++adapter->hdd_stats.tx_rx_stats.tx_classified_ac[ac];
 
 #if defined(IPA_OFFLOAD)
 	if (!qdf_nbuf_ipa_owned_get(skb)) {
 #endif
 
-		skb = hdd_skb_orphan(adapter, skb);
+		skb = hdd_skb_orphan(adapter, skb, &pkt_info);
 		if (!skb)
 			goto drop_pkt_accounting;
 
@@ -792,7 +797,7 @@ static void __hdd_softap_tx_timeout(struct net_device *dev)
 
 	TX_TIMEOUT_TRACE(dev, QDF_MODULE_ID_HDD_SAP_DATA);
 
-	for (i = 0; i < NUM_TX_QUEUES; i++) {
+	for (i = 0; i < dev->real_num_tx_queues; i++) {
 		txq = netdev_get_tx_queue(dev, i);
 		QDF_TRACE(QDF_MODULE_ID_HDD_DATA,
 			  QDF_TRACE_LEVEL_DEBUG,
@@ -1051,6 +1056,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 	struct hdd_context *hdd_ctx = NULL;
 	struct qdf_mac_addr *src_mac;
 	struct hdd_station_info *sta_info;
+	uint64_t lat_ts;
+	int lat_tid;
 
 	/* Sanity check on inputs */
 	if (unlikely((!adapter_context) || (!rx_buf))) {
@@ -1082,6 +1089,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		next = skb->next;
 		skb->next = NULL;
 
+		ol_rx_lat_record(adapter->vdev_id, skb, OL_RX_LAT_STAGE_RXQ);
+
 /* Debug code, remove later */
 #if defined(QCA_WIFI_QCA6290) || defined(QCA_WIFI_QCA6390) || \
     defined(QCA_WIFI_QCA6490) || defined(QCA_WIFI_QCA6750)
@@ -1160,9 +1169,12 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		 */
 		qdf_net_buf_debug_release_skb(skb);
 
+		lat_tid = ol_rx_lat_handoff(adapter->vdev_id, skb, &lat_ts);
+
 		hdd_softap_tsf_timestamp_rx(hdd_ctx, skb);
 
 		qdf_status = hdd_rx_deliver_to_stack(adapter, skb);
+		ol_rx_lat_delivered(adapter->vdev_id, lat_tid, lat_ts);
 
 		if (QDF_IS_STATUS_SUCCESS(qdf_status)) {
 			++adapter->hdd_stats.tx_rx_stats.rx_delivered[cpu_index];
@@ -24,12 +24,37 @@
  */
 
 #include <wlan_hdd_includes.h>
+#include <linux/rculist.h>
 #include "wlan_hdd_sta_info.h"
 
 #define HDD_MAX_PEERS 32
 
+/**
+ * hdd_sta_info_hash() - get the hash bucket of a MAC address
+ * @sta_info_container: The station info container obj
+ * @mac_addr: MAC address
+ *
+ * The OUI carries little entropy between the stations of a SAP, hash the
+ * NIC specific bytes only.
+ *
+ * Return: hash bucket
+ */
+static inline struct hlist_head *
+hdd_sta_info_hash(struct hdd_sta_info_obj *sta_info_container,
+		  const uint8_t *mac_addr)
+{
+	uint32_t index;
+
+	index = mac_addr[3] ^ mac_addr[4] ^ mac_addr[5];
+
+	return &sta_info_container->sta_hash[index &
+					     (HDD_STA_INFO_HASH_SIZE - 1)];
+}
+
 QDF_STATUS hdd_sta_info_init(struct hdd_sta_info_obj *sta_info_container)
 {
+	uint32_t i;
+
 	if (!sta_info_container) {
 		hdd_err("Parameter null");
 		return QDF_STATUS_E_INVAL;
@@ -37,6 +62,8 @@ QDF_STATUS hdd_sta_info_init(struct hdd_sta_info_obj *sta_info_container)
 
 	qdf_spinlock_create(&sta_info_container->sta_obj_lock);
 	qdf_list_create(&sta_info_container->sta_obj, HDD_MAX_PEERS);
+	for (i = 0; i < HDD_STA_INFO_HASH_SIZE; i++)
+		INIT_HLIST_HEAD(&sta_info_container->sta_hash[i]);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -48,6 +75,8 @@ void hdd_sta_info_deinit(struct hdd_sta_info_obj *sta_info_container)
 		return;
 	}
 
+	/* wait for the deferred frees of the stations */
+	rcu_barrier();
 	qdf_list_destroy(&sta_info_container->sta_obj);
 	qdf_spinlock_destroy(&sta_info_container->sta_obj_lock);
 }
@@ -65,6 +94,9 @@ QDF_STATUS hdd_sta_info_attach(struct hdd_sta_info_obj *sta_info_container,
 	qdf_atomic_set(&sta_info->ref_cnt, 1);
 	qdf_list_insert_front(&sta_info_container->sta_obj,
 			      &sta_info->sta_node);
+	hlist_add_head_rcu(&sta_info->sta_hash_node,
+			   hdd_sta_info_hash(sta_info_container,
+					     sta_info->sta_mac.bytes));
 	sta_info->is_attached = true;
 
 	qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
@@ -103,30 +135,102 @@ struct hdd_station_info *hdd_get_sta_info_by_mac(
 				struct hdd_sta_info_obj *sta_info_container,
 				const uint8_t *mac_addr)
 {
-	struct hdd_station_info *sta_info = NULL;
+	struct hdd_station_info *sta_info;
 
 	if (!mac_addr || !sta_info_container) {
 		hdd_err("Parameter(s) null");
 		return NULL;
 	}
 
-	qdf_spin_lock_bh(&sta_info_container->sta_obj_lock);
-
-	qdf_list_for_each(&sta_info_container->sta_obj, sta_info, sta_node) {
-		if (qdf_is_macaddr_equal(&sta_info->sta_mac,
-					 (struct qdf_mac_addr *)mac_addr)) {
-			hdd_take_sta_info_ref(sta_info_container,
-					      sta_info, false);
-			qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+	rcu_read_lock();
+
+	hlist_for_each_entry_rcu(sta_info,
+				 hdd_sta_info_hash(sta_info_container,
+						   mac_addr),
+				 sta_hash_node) {
+		if (!qdf_is_macaddr_equal(&sta_info->sta_mac,
+					  (struct qdf_mac_addr *)mac_addr))
+			continue;
+		/*
+		 * A station whose ref count dropped to 0 is being freed and
+		 * must not be revived, its memory stays valid until the end
+		 * of the RCU read side.
+		 */
+		if (qdf_atomic_inc_not_zero(&sta_info->ref_cnt)) {
+			rcu_read_unlock();
 			return sta_info;
 		}
 	}
 
-	qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+	rcu_read_unlock();
 
 	return NULL;
 }
 
+struct hdd_station_info **
+hdd_sta_info_snapshot_get(struct hdd_sta_info_obj *sta_info_container,
+			  uint32_t *num_sta)
+{
+	struct hdd_station_info **sta_list = NULL;
+	struct hdd_station_info *sta_info;
+	uint32_t size = 0, n;
+
+	if (!sta_info_container || !num_sta) {
+		hdd_err("Parameter(s) null");
+		return NULL;
+	}
+
+	*num_sta = 0;
+
+	while (true) {
+		qdf_spin_lock_bh(&sta_info_container->sta_obj_lock);
+		n = qdf_list_size(&sta_info_container->sta_obj);
+		if (n && n <= size)
+			break;
+		qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+
+		qdf_mem_free(sta_list);
+		if (!n)
+			return NULL;
+
+		/* leave room for stations attached meanwhile */
+		size = n + n / 2;
+		sta_list = qdf_mem_malloc(size * sizeof(*sta_list));
+		if (!sta_list)
+			return NULL;
+	}
+
+	n = 0;
+	qdf_list_for_each(&sta_info_container->sta_obj, sta_info, sta_node) {
+		/* skip the stations being released */
+		if (!qdf_atomic_inc_not_zero(&sta_info->ref_cnt))
+			continue;
+		sta_list[n++] = sta_info;
+	}
+
+	qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+
+	*num_sta = n;
+
+	return sta_list;
+}
+
+void hdd_sta_info_snapshot_put(struct hdd_sta_info_obj *sta_info_container,
+			       struct hdd_station_info **sta_list,
+			       uint32_t num_sta)
+{
+	uint32_t i;
+
+	if (!sta_list)
+		return;
+
+	/* only the final release of a station takes the container lock */
+	for (i = 0; i < num_sta; i++)
+		hdd_put_sta_info_ref(sta_info_container, &sta_list[i], true);
+
+	qdf_mem_free(sta_list);
+}
+
 void hdd_take_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 			   struct hdd_station_info *sta_info,
 			   bool lock_required)
@@ -145,6 +249,17 @@ void hdd_take_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
 }
 
+/**
+ * hdd_sta_info_free_rcu() - free a station info once lookups are done
+ * @rcu: rcu head of the station info
+ *
+ * Return: None
+ */
+static void hdd_sta_info_free_rcu(struct rcu_head *rcu)
+{
+	qdf_mem_free(container_of(rcu, struct hdd_station_info, rcu));
+}
+
 void
 hdd_put_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		     struct hdd_station_info **sta_info, bool lock_required)
@@ -164,9 +279,6 @@ hdd_put_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		return;
 	}
 
-	if (lock_required)
-		qdf_spin_lock_bh(&sta_info_container->sta_obj_lock);
-
 	/*
 	 * In case the put_ref is called more than twice for a single take_ref,
 	 * this will result in either a BUG or page fault. In both the cases,
@@ -178,13 +290,16 @@ hdd_put_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 		QDF_BUG(0);
 	}
 
-	qdf_atomic_dec(&info->ref_cnt);
-
-	if (qdf_atomic_read(&info->ref_cnt)) {
-		if (lock_required)
-			qdf_spin_unlock_bh(&sta_info_container->sta_obj_lock);
+	if (!qdf_atomic_dec_and_test(&info->ref_cnt))
 		return;
-	}
+
+	/*
+	 * A station at ref count 0 is never revived: lookups use
+	 * qdf_atomic_inc_not_zero and list walks skip it. So only the final
+	 * release needs the lock, to unlink it.
+	 */
+	if (lock_required)
+		qdf_spin_lock_bh(&sta_info_container->sta_obj_lock);
 
 	qdf_copy_macaddr(&addr, &info->sta_mac);
 	if (info->assoc_req_ies.len) {
@@ -194,7 +309,8 @@ hdd_put_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
 	}
 
 	qdf_list_remove_node(&sta_info_container->sta_obj, &info->sta_node);
-	qdf_mem_free(info);
+	hlist_del_rcu(&info->sta_hash_node);
+	call_rcu(&info->rcu, hdd_sta_info_free_rcu);
 	*sta_info = NULL;
 
 	if (lock_required)
@@ -220,6 +336,39 @@ void hdd_clear_cached_sta_info(struct hdd_adapter *adapter)
 	}
 }
 
+/**
+ * hdd_sta_info_ref_live() - Take a ref on the first station not being released
+ * @sta_info_container: The station info container obj
+ * @node: list node to start from
+ *
+ * Stations whose ref count dropped to 0 stay in the list until their final
+ * release gets the container lock, and must not be revived meanwhile. The
+ * ref is taken with qdf_atomic_inc_not_zero() so that a final put racing
+ * with the walk cannot be undone.
+ *
+ * Return: station info with a ref taken, NULL if there is none left
+ */
+static struct hdd_station_info *
+hdd_sta_info_ref_live(struct hdd_sta_info_obj *sta_info_container,
+		      qdf_list_node_t *node)
+{
+	struct hdd_station_info *sta_info;
+
+	while (node) {
+		sta_info = qdf_container_of(node, struct hdd_station_info,
+					    sta_node);
+		if (qdf_atomic_inc_not_zero(&sta_info->ref_cnt))
+			return sta_info;
+
+		if (QDF_IS_STATUS_ERROR(
+			qdf_list_peek_next(&sta_info_container->sta_obj,
+					   node, &node)))
+			break;
+	}
+
+	return NULL;
+}
+
 QDF_STATUS
 hdd_get_front_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 			       struct hdd_station_info **out_sta_info)
@@ -234,8 +383,9 @@ hdd_get_front_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 	if (QDF_IS_STATUS_ERROR(status))
 		return status;
 
-	*out_sta_info =
-		qdf_container_of(node, struct hdd_station_info, sta_node);
+	*out_sta_info = hdd_sta_info_ref_live(sta_info_container, node);
+	if (!*out_sta_info)
+		return QDF_STATUS_E_EMPTY;
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -260,8 +410,9 @@ hdd_get_next_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 	if (QDF_IS_STATUS_ERROR(status))
 		return status;
 
-	*out_sta_info =
-		qdf_container_of(node, struct hdd_station_info, sta_node);
+	*out_sta_info = hdd_sta_info_ref_live(sta_info_container, node);
+	if (!*out_sta_info)
+		return QDF_STATUS_E_EMPTY;
 
 	return QDF_STATUS_SUCCESS;
 }
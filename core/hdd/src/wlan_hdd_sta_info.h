@@ -38,6 +38,9 @@
 /* Opaque handle for abstraction */
 #define hdd_sta_info_entry qdf_list_node_t
 
+/* Number of MAC address hash buckets per container, a power of 2 */
+#define HDD_STA_INFO_HASH_SIZE 64
+
 /**
  * struct dhcp_phase - Per Peer DHCP Phases
  * @DHCP_PHASE_ACK: upon receiving DHCP_ACK/NAK message in REQUEST phase or
@@ -125,6 +128,8 @@ enum dhcp_nego_status {
  * feature or not, if first bit is 1 it indicates that FW supports this
  * feature, if it is 0 it indicates FW doesn't support this feature
  * @sta_info: The sta_info node for the station info list maintained in adapter
+ * @sta_hash_node: The node in the MAC address hash bucket of the container
+ * @rcu: Deferred free once lockless lookups are done with the station
  * @assoc_req_ies: Assoc request IEs of the peer station
  * @ref_cnt: Reference count to synchronize sta_info access
  * @pending_eap_frm_type: EAP frame type in tx queue without tx completion
@@ -177,6 +182,8 @@ struct hdd_station_info {
 	uint32_t rx_retry_cnt;
 	uint32_t rx_mc_bc_cnt;
 	qdf_list_node_t sta_node;
+	struct hlist_node sta_hash_node;
+	struct rcu_head rcu;
 	struct wlan_ies assoc_req_ies;
 	qdf_atomic_t ref_cnt;
 	unsigned long pending_eap_frm_type;
@@ -187,10 +194,13 @@ struct hdd_station_info {
  * struct hdd_sta_info_obj - Station info container structure
  * @sta_obj: The sta info object that stores the sta_info
  * @sta_obj_lock: Lock to protect the sta_obj read/write access
+ * @sta_hash: MAC address index of the sta_info in @sta_obj. Updated with
+ *	      @sta_obj_lock held, walked under rcu_read_lock by lookups.
  */
 struct hdd_sta_info_obj {
 	qdf_list_t sta_obj;
 	qdf_spinlock_t sta_obj_lock;
+	struct hlist_head sta_hash[HDD_STA_INFO_HASH_SIZE];
 };
 
 /**
@@ -198,6 +208,10 @@ struct hdd_sta_info_obj {
  * @sta_info_container: The station info container obj that stores and maintains
  *                      the sta_info obj.
  * @sta_info: Station info structure to be released.
+ * @lock_required: false if the caller holds the container lock
+ *
+ * Only the release of the final reference unlinks the station, under the
+ * container lock, and frees it once lockless lookups are done with it.
  *
  * Return: None
  */
@@ -224,6 +238,8 @@ void hdd_take_sta_info_ref(struct hdd_sta_info_obj *sta_info_container,
  * hdd_get_front_sta_info_no_lock() - Get the first sta_info from the sta list
  * This API doesnot use any lock in it's implementation. It is the caller's
  * directive to ensure concurrency safety.
+ * A ref is taken on the returned sta_info; stations whose final ref is being
+ * released are skipped.
  *
  * @sta_info_container: The station info container obj that stores and maintains
  *                      the sta_info obj.
@@ -239,6 +255,8 @@ hdd_get_front_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
  * hdd_get_next_sta_info_no_lock() - Get the next sta_info from the sta list
  * This API doesnot use any lock in it's implementation. It is the caller's
  * directive to ensure concurrency safety.
+ * A ref is taken on the returned sta_info; stations whose final ref is being
+ * released are skipped.
  *
  * @sta_info_container: The station info container obj that stores and maintains
  *                      the sta_info obj.
@@ -264,8 +282,6 @@ hdd_get_next_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 #define __hdd_take_ref_and_fetch_front_sta_info(sta_info_container, sta_info) \
 	qdf_spin_lock_bh(&sta_info_container.sta_obj_lock), \
 	hdd_get_front_sta_info_no_lock(&sta_info_container, &sta_info), \
-	(sta_info) ? hdd_take_sta_info_ref(&sta_info_container, \
-					   sta_info, false) : (false), \
 	qdf_spin_unlock_bh(&sta_info_container.sta_obj_lock)
 
 /**
@@ -279,8 +295,6 @@ hdd_get_next_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 	qdf_spin_lock_bh(&sta_info_container.sta_obj_lock), \
 	hdd_get_next_sta_info_no_lock(&sta_info_container, sta_info, \
 				      &sta_info), \
-	(sta_info) ? hdd_take_sta_info_ref(&sta_info_container, \
-					   sta_info, false) : (false), \
 	qdf_spin_unlock_bh(&sta_info_container.sta_obj_lock)
 
 /**
@@ -323,13 +337,8 @@ hdd_get_next_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 						     sta_info, next_sta_info) \
 	qdf_spin_lock_bh(&sta_info_container.sta_obj_lock), \
 	hdd_get_front_sta_info_no_lock(&sta_info_container, &sta_info), \
-	(sta_info) ? hdd_take_sta_info_ref(&sta_info_container, \
-					   sta_info, false) : (false), \
 	hdd_get_next_sta_info_no_lock(&sta_info_container, sta_info, \
 				      &next_sta_info), \
-	(next_sta_info) ? hdd_take_sta_info_ref(&sta_info_container, \
-						next_sta_info, false) : \
-						(false), \
 	qdf_spin_unlock_bh(&sta_info_container.sta_obj_lock)
 
 /**
@@ -345,8 +354,6 @@ hdd_get_next_sta_info_no_lock(struct hdd_sta_info_obj *sta_info_container,
 	qdf_spin_lock_bh(&sta_info_container.sta_obj_lock), \
 	hdd_get_next_sta_info_no_lock(&sta_info_container, sta_info, \
 				      &next_sta_info), \
-	(next_sta_info) ? hdd_take_sta_info_ref(&sta_info_container, \
-					     next_sta_info, false) : (false), \
 	qdf_spin_unlock_bh(&sta_info_container.sta_obj_lock)
 
 /**
@@ -431,6 +438,9 @@ QDF_STATUS hdd_sta_info_attach(struct hdd_sta_info_obj *sta_info_container,
  *                      the sta_info obj.
  * @mac_addr: The mac addr by which the sta_info has to be fetched.
  *
+ * The lookup does not take the container lock, a reference is taken on
+ * the station found and must be released with hdd_put_sta_info_ref().
+ *
  * Return: Pointer to the hdd_station_info structure which contains the mac
  *         address passed
  */
@@ -438,6 +448,40 @@ struct hdd_station_info *hdd_get_sta_info_by_mac(
 				struct hdd_sta_info_obj *sta_info_container,
 				const uint8_t *mac_addr);
 
+/**
+ * hdd_sta_info_snapshot_get() - Take a reference on every station info
+ * @sta_info_container: The station info container obj that stores and maintains
+ *                      the sta_info obj.
+ * @num_sta: Filled with the number of stations in the snapshot
+ *
+ * Takes the references in a single hold of the container lock, so that
+ * long walks over the stations, like sysfs dumps, neither hold the lock
+ * nor retake it for every station. The snapshot must be released with
+ * hdd_sta_info_snapshot_put().
+ *
+ * Return: Array of @num_sta station info, NULL if there is no station or
+ *	   on allocation failure
+ */
+struct hdd_station_info **
+hdd_sta_info_snapshot_get(struct hdd_sta_info_obj *sta_info_container,
+			  uint32_t *num_sta);
+
+/**
+ * hdd_sta_info_snapshot_put() - Release a station info snapshot
+ * @sta_info_container: The station info container obj that stores and maintains
+ *                      the sta_info obj.
+ * @sta_list: Snapshot returned by hdd_sta_info_snapshot_get()
+ * @num_sta: Number of stations in @sta_list
+ *
+ * The container lock is only taken for the stations whose final reference
+ * is released.
+ *
+ * Return: None
+ */
+void hdd_sta_info_snapshot_put(struct hdd_sta_info_obj *sta_info_container,
+			       struct hdd_station_info **sta_list,
+			       uint32_t num_sta);
+
 /**
  * hdd_clear_cached_sta_info() - Clear the cached sta info from the container
  * @sta_info_container: The station info container obj that stores and maintains
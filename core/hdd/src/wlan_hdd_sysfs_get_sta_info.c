@@ -28,7 +28,8 @@ static ssize_t __show_sta_info(struct net_device *net_dev, char *buf)
 {
 	struct hdd_adapter *adapter = netdev_priv(net_dev);
 	struct hdd_context *hdd_ctx;
-	struct hdd_station_info *sta;
+	struct hdd_station_info *sta, **sta_list;
+	uint32_t num_sta, i;
 	int ret_val;
 
 	hdd_enter_dev(net_dev);
@@ -49,12 +50,12 @@ static ssize_t __show_sta_info(struct net_device *net_dev, char *buf)
 			    "%s    get_sta_info:\nstaAddress\n",
 			    net_dev->name);
 
-	hdd_for_each_sta_ref(adapter->sta_info_list, sta) {
-		if (QDF_IS_ADDR_BROADCAST(sta->sta_mac.bytes)) {
-			hdd_put_sta_info_ref(&adapter->sta_info_list, &sta,
-					     true);
+	sta_list = hdd_sta_info_snapshot_get(&adapter->sta_info_list,
+					     &num_sta);
+	for (i = 0; i < num_sta; i++) {
+		sta = sta_list[i];
+		if (QDF_IS_ADDR_BROADCAST(sta->sta_mac.bytes))
 			continue;
-		}
 		ret_val += scnprintf(buf + ret_val, PAGE_SIZE - ret_val,
 				     QDF_MAC_ADDR_STR " ecsa=%d\n",
 				     sta->sta_mac.bytes[0],
@@ -64,9 +65,8 @@ static ssize_t __show_sta_info(struct net_device *net_dev, char *buf)
 				     sta->sta_mac.bytes[4],
 				     sta->sta_mac.bytes[5],
 				     sta->ecsa_capable);
-
-		hdd_put_sta_info_ref(&adapter->sta_info_list, &sta, true);
 	}
+	hdd_sta_info_snapshot_put(&adapter->sta_info_list, sta_list, num_sta);
 
 exit:
 	hdd_exit();
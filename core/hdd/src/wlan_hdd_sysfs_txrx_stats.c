@@ -28,6 +28,8 @@
 #include "cds_api.h"
 #include "cdp_txrx_cmn_struct.h"
 #include "cdp_txrx_cmn.h"
+#include "ol_rx_latency.h"
+#include "ol_tx_latency.h"
 
 static ssize_t
 __hdd_sysfs_txrx_stats_store(struct net_device *net_dev,
@@ -133,8 +135,60 @@ hdd_sysfs_txrx_stats_store(struct device *dev,
 	return errno_size;
 }
 
+#if defined(WLAN_RX_LATENCY_HIST) || defined(WLAN_TX_LATENCY_HIST)
+static ssize_t
+__hdd_sysfs_txrx_stats_show(struct net_device *net_dev, char *buf)
+{
+	struct hdd_adapter *adapter = netdev_priv(net_dev);
+	struct hdd_context *hdd_ctx;
+	int ret, len;
+
+	if (hdd_validate_adapter(adapter)) {
+		hdd_err_rl("adapter validate fail");
+		return -EINVAL;
+	}
+
+	hdd_ctx = WLAN_HDD_GET_CTX(adapter);
+	ret = wlan_hdd_validate_context(hdd_ctx);
+	if (ret != 0)
+		return ret;
+
+	if (!wlan_hdd_validate_modules_state(hdd_ctx))
+		return -EINVAL;
+
+	len = ol_rx_lat_hist_print(adapter->vdev_id, buf, PAGE_SIZE);
+	len += ol_tx_lat_hist_print(adapter->vdev_id, buf + len,
+				    PAGE_SIZE - len);
+
+	return len;
+}
+
+static ssize_t
+hdd_sysfs_txrx_stats_show(struct device *dev,
+			  struct device_attribute *attr,
+			  char *buf)
+{
+	struct net_device *net_dev = container_of(dev, struct net_device, dev);
+	struct osif_vdev_sync *vdev_sync;
+	ssize_t errno_size;
+
+	errno_size = osif_vdev_sync_op_start(net_dev, &vdev_sync);
+	if (errno_size)
+		return errno_size;
+
+	errno_size = __hdd_sysfs_txrx_stats_show(net_dev, buf);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+
+	return errno_size;
+}
+
+static DEVICE_ATTR(txrx_stats, 0664,
+		   hdd_sysfs_txrx_stats_show, hdd_sysfs_txrx_stats_store);
+#else
 static DEVICE_ATTR(txrx_stats, 0220,
 		   NULL, hdd_sysfs_txrx_stats_store);
+#endif
 
 int hdd_sysfs_txrx_stats_create(struct hdd_adapter *adapter)
 {
@@ -33,6 +33,7 @@
  *                (wlanxx is adapter name)
  * usage:
  *      echo [arg_0] [arg_1] > txrx_stats
+ *      cat txrx_stats (rx/tx latency histograms, if enabled)
  *
  * Return: 0 on success and errno on failure
  */
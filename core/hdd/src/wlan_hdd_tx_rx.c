@@ -65,6 +65,7 @@
 #include <net/ieee80211_radiotap.h>
 #endif
 #include <ol_defines.h>
+#include "ol_rx_latency.h"
 #include "cfg_ucfg_api.h"
 #include "target_type.h"
 #include "wlan_hdd_object_manager.h"
@@ -231,8 +232,9 @@ hdd_tx_resume_false(struct hdd_adapter *adapter, bool tx_resume)
 	adapter->hdd_stats.tx_rx_stats.is_txflow_paused = true;
 }
 
-static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
-		struct sk_buff *skb)
+static inline struct sk_buff *
+hdd_skb_orphan(struct hdd_adapter *adapter, struct sk_buff *skb,
+	       const struct hdd_tx_pkt_info *info)
 {
 	struct hdd_context *hdd_ctx = WLAN_HDD_GET_CTX(adapter);
 	int need_orphan = 0;
@@ -258,8 +260,7 @@ static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
 			need_orphan = 1;
 #endif
 	} else if (hdd_ctx->config->tx_orphan_enable) {
-		if (qdf_nbuf_is_ipv4_tcp_pkt(skb) ||
-		    qdf_nbuf_is_ipv6_tcp_pkt(skb))
+		if (info->ip_proto == IPPROTO_TCP)
 			need_orphan = 1;
 	}
 
@@ -389,11 +390,14 @@ void hdd_get_tx_resource(struct hdd_adapter *adapter,
  * hdd_skb_orphan() - skb_unshare a cloned packed else skb_orphan
  * @adapter: pointer to HDD adapter
  * @skb: pointer to skb data packet
+ * @info: headers parsed by wlan_hdd_classify_pkt()
  *
  * Return: pointer to skb structure
  */
-static inline struct sk_buff *hdd_skb_orphan(struct hdd_adapter *adapter,
-		struct sk_buff *skb) {
+static inline struct sk_buff *
+hdd_skb_orphan(struct hdd_adapter *adapter, struct sk_buff *skb,
+	       const struct hdd_tx_pkt_info *info)
+{
 
 	struct sk_buff *nskb;
 #if (LINUX_VERSION_CODE > KERNEL_VERSION(3, 19, 0))
@@ -439,12 +443,14 @@ void hdd_event_eapol_log(struct sk_buff *skb, enum qdf_proto_dir dir)
 
 	WLAN_HOST_DIAG_EVENT_DEF(wlan_diag_event, struct host_event_wlan_eapol);
 
-	if ((dir == QDF_TX &&
-		(QDF_NBUF_CB_PACKET_TYPE_EAPOL !=
-		 QDF_NBUF_CB_GET_PACKET_TYPE(skb))))
-		return;
-	else if (!qdf_nbuf_is_ipv4_eapol_pkt(skb))
+	/* tx frames are already classified by wlan_hdd_classify_pkt() */
+	if (dir == QDF_TX) {
+		if (QDF_NBUF_CB_PACKET_TYPE_EAPOL !=
+		    QDF_NBUF_CB_GET_PACKET_TYPE(skb))
+			return;
+	} else if (!qdf_nbuf_is_ipv4_eapol_pkt(skb)) {
 		return;
+	}
 
 	eapol_key_info = (uint16_t)(*(uint16_t *)
 				(skb->data + EAPOL_KEY_INFO_OFFSET));
@@ -469,16 +475,49 @@ void hdd_event_eapol_log(struct sk_buff *skb, enum qdf_proto_dir dir)
 #endif /* FEATURE_WLAN_DIAG_SUPPORT */
 
 /**
- * wlan_hdd_classify_pkt() - classify packet
- * @skb - sk buff
+ * wlan_hdd_classify_ipv4() - classify the L4 payload of an IPv4 frame
+ * @skb: frame to classify
+ * @iph: IPv4 header of @skb
  *
- * Return: none
+ * Return: packet type, or 0 if the frame is not a special packet
  */
-void wlan_hdd_classify_pkt(struct sk_buff *skb)
+static uint8_t wlan_hdd_classify_ipv4(struct sk_buff *skb, struct iphdr *iph)
+{
+	struct udphdr *udph;
+	uint16_t sport, dport;
+
+	if (iph->protocol == IPPROTO_ICMP)
+		return QDF_NBUF_CB_PACKET_TYPE_ICMP;
+
+	if (iph->protocol != IPPROTO_UDP)
+		return 0;
+
+	udph = (struct udphdr *)((uint8_t *)iph + iph->ihl * 4);
+	if ((uint8_t *)(udph + 1) > skb_tail_pointer(skb))
+		return 0;
+
+	sport = ntohs(udph->source);
+	dport = ntohs(udph->dest);
+	if ((sport == QDF_NBUF_TRAC_DHCP_SRV_PORT &&
+	     dport == QDF_NBUF_TRAC_DHCP_CLI_PORT) ||
+	    (sport == QDF_NBUF_TRAC_DHCP_CLI_PORT &&
+	     dport == QDF_NBUF_TRAC_DHCP_SRV_PORT))
+		return QDF_NBUF_CB_PACKET_TYPE_DHCP;
+
+	return 0;
+}
+
+void wlan_hdd_classify_pkt(struct sk_buff *skb, struct hdd_tx_pkt_info *info)
 {
 	struct ethhdr *eh = (struct ethhdr *)skb->data;
+	struct iphdr *iph;
+	struct ipv6hdr *ip6h;
+	uint8_t type = 0;
 
 	qdf_mem_zero(skb->cb, sizeof(skb->cb));
+	info->ether_type = eh->h_proto;
+	info->ip_proto = 0;
+	info->subtype = QDF_PROTO_INVALID;
 
 	/* check destination mac address is broadcast/multicast */
 	if (is_broadcast_ether_addr((uint8_t *)eh))
@@ -486,24 +525,41 @@ void wlan_hdd_classify_pkt(struct sk_buff *skb)
 	else if (is_multicast_ether_addr((uint8_t *)eh))
 		QDF_NBUF_CB_GET_IS_MCAST(skb) = true;
 
-	if (qdf_nbuf_is_ipv4_arp_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_ARP;
-	else if (qdf_nbuf_is_ipv4_dhcp_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_DHCP;
-	else if (qdf_nbuf_is_ipv4_eapol_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_EAPOL;
-	else if (qdf_nbuf_is_ipv4_wapi_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_WAPI;
-	else if (qdf_nbuf_is_icmp_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_ICMP;
-	else if (qdf_nbuf_is_icmpv6_pkt(skb))
-		QDF_NBUF_CB_GET_PACKET_TYPE(skb) =
-			QDF_NBUF_CB_PACKET_TYPE_ICMPv6;
+	switch (eh->h_proto) {
+	case htons(ETH_P_IP):
+		iph = (struct iphdr *)(eh + 1);
+		if ((uint8_t *)(iph + 1) > skb_tail_pointer(skb))
+			break;
+		info->ip_proto = iph->protocol;
+		type = wlan_hdd_classify_ipv4(skb, iph);
+		if (type == QDF_NBUF_CB_PACKET_TYPE_DHCP)
+			info->subtype =
+				qdf_nbuf_data_get_dhcp_subtype(skb->data);
+		break;
+	case htons(ETH_P_IPV6):
+		ip6h = (struct ipv6hdr *)(eh + 1);
+		if ((uint8_t *)(ip6h + 1) > skb_tail_pointer(skb))
+			break;
+		info->ip_proto = ip6h->nexthdr;
+		if (ip6h->nexthdr == IPPROTO_ICMPV6)
+			type = QDF_NBUF_CB_PACKET_TYPE_ICMPv6;
+		break;
+	case htons(ETH_P_ARP):
+		type = QDF_NBUF_CB_PACKET_TYPE_ARP;
+		break;
+	case htons(ETH_P_PAE):
+		type = QDF_NBUF_CB_PACKET_TYPE_EAPOL;
+		info->subtype = qdf_nbuf_data_get_eapol_subtype(skb->data);
+		break;
+	case htons(ETH_P_WAI):
+		type = QDF_NBUF_CB_PACKET_TYPE_WAPI;
+		break;
+	default:
+		break;
+	}
+
+	if (type)
+		QDF_NBUF_CB_GET_PACKET_TYPE(skb) = type;
 }
 
 /**
@@ -921,6 +977,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 	struct hdd_station_ctx *sta_ctx = &adapter->session.station;
 	struct qdf_mac_addr *mac_addr;
 	struct qdf_mac_addr mac_addr_tx_allowed = QDF_MAC_ADDR_ZERO_INIT;
+	struct hdd_tx_pkt_info pkt_info;
 	uint8_t pkt_type = 0;
 	bool is_arp = false;
 	struct wlan_objmgr_vdev *vdev;
@@ -960,7 +1017,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 		goto drop_pkt;
 	}
 
-	wlan_hdd_classify_pkt(skb);
+	wlan_hdd_classify_pkt(skb, &pkt_info);
 	if (QDF_NBUF_CB_GET_PACKET_TYPE(skb) == QDF_NBUF_CB_PACKET_TYPE_ARP) {
 		if (qdf_nbuf_data_is_arp_req(skb) &&
 		    (adapter->track_arp_ip == qdf_nbuf_get_arp_tgt_ip(skb))) {
@@ -972,7 +1029,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 		}
 	} else if (QDF_NBUF_CB_GET_PACKET_TYPE(skb) ==
 		   QDF_NBUF_CB_PACKET_TYPE_EAPOL) {
-		subtype = qdf_nbuf_get_eapol_subtype(skb);
+		subtype = pkt_info.subtype;
 		if (subtype == QDF_PROTO_EAPOL_M2) {
 			++adapter->hdd_stats.hdd_eapol_stats.eapol_m2_count;
 			is_eapol = true;
@@ -982,7 +1039,7 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 		}
 	} else if (QDF_NBUF_CB_GET_PACKET_TYPE(skb) ==
 		   QDF_NBUF_CB_PACKET_TYPE_DHCP) {
-		subtype = qdf_nbuf_get_dhcp_subtype(skb);
+		subtype = pkt_info.subtype;
 		if (subtype == QDF_PROTO_DHCP_DISCOVER) {
 			++adapter->hdd_stats.hdd_dhcp_stats.dhcp_dis_count;
 			is_dhcp = true;
@@ -1007,10 +1064,10 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 			    WLAN_HDD_TX_FLOW_CONTROL_OS_Q_BLOCK_TIME);
 
 	/* Get TL AC corresponding to Qdisc queue index/AC. */
-	ac = hdd_qdisc_ac_to_tl_ac[skb->queue_mapping];
+	ac = hdd_qdisc_ac_to_tl_ac[hdd_txq_to_linux_ac(skb->queue_mapping)];
 
 	if (!qdf_nbuf_ipa_owned_get(skb)) {
-		skb = hdd_skb_orphan(adapter, skb);
+		skb = hdd_skb_orphan(adapter, skb, &pkt_info);
 		if (!skb)
 			goto drop_pkt_accounting;
 	}
@@ -1094,7 +1151,10 @@ static void __hdd_hard_start_xmit(struct sk_buff *skb,
 				break;
 		}
 		skb->priority = up;
-		skb->queue_mapping = hdd_linux_up_to_ac_map[up];
+		/* Stay on the same per-CPU slot of the lower AC */
+		skb->queue_mapping = skb->queue_mapping -
+				     hdd_txq_to_linux_ac(skb->queue_mapping) +
+				     hdd_linux_up_to_ac_map[up];
 	}
 
 	adapter->stats.tx_bytes += skb->len;
@@ -1266,7 +1326,7 @@ static void __hdd_tx_timeout(struct net_device *dev)
 	 * recovery here
 	 */
 
-	for (i = 0; i < NUM_TX_QUEUES; i++) {
+	for (i = 0; i < dev->real_num_tx_queues; i++) {
 		txq = netdev_get_tx_queue(dev, i);
 		hdd_debug("Queue: %d status: %d txq->trans_start: %lu",
 			  i, netif_tx_queue_stopped(txq), txq->trans_start);
@@ -1533,6 +1593,13 @@ static void hdd_resolve_rx_ol_mode(struct hdd_context *hdd_ctx)
 
 	soc = cds_get_context(QDF_MODULE_ID_SOC);
 
+	/* LRO/GRO contexts are per CE, they can't be shared by Rx threads */
+	if (hdd_ctx->enable_rxthread && hdd_ctx->config->num_ol_rx_threads > 1) {
+		hdd_debug("Multiple Rx threads, disabling Rx offload");
+		hdd_ctx->ol_enable = 0;
+		return;
+	}
+
 	if (!(cdp_cfg_get(soc, cfg_dp_lro_enable) ^
 	    cdp_cfg_get(soc, cfg_dp_gro_enable))) {
 		cdp_cfg_get(soc, cfg_dp_lro_enable) &&
@@ -2128,6 +2195,8 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 	enum qdf_proto_subtype subtype = QDF_PROTO_INVALID;
 	bool is_eapol;
 	bool is_dhcp;
+	uint64_t lat_ts;
+	int lat_tid;
 
 	/* Sanity check on inputs */
 	if (unlikely((!adapter_context) || (!rxBuf))) {
@@ -2162,6 +2231,8 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 		is_eapol = false;
 		is_dhcp = false;
 
+		ol_rx_lat_record(adapter->vdev_id, skb, OL_RX_LAT_STAGE_RXQ);
+
 		if (qdf_nbuf_is_ipv4_arp_pkt(skb)) {
 			if (qdf_nbuf_data_is_arp_rsp(skb) &&
 				(adapter->track_arp_ip ==
@@ -2278,9 +2349,12 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 		 */
 		qdf_net_buf_debug_release_skb(skb);
 
+		lat_tid = ol_rx_lat_handoff(adapter->vdev_id, skb, &lat_ts);
+
 		hdd_tsf_timestamp_rx(hdd_ctx, skb, ktime_to_us(skb->tstamp));
 
 		qdf_status = hdd_rx_deliver_to_stack(adapter, skb);
+		ol_rx_lat_delivered(adapter->vdev_id, lat_tid, lat_ts);
 
 		if (QDF_IS_STATUS_SUCCESS(qdf_status)) {
 			++adapter->hdd_stats.tx_rx_stats.
@@ -2454,7 +2528,7 @@ static void wlan_hdd_update_txq_timestamp(struct net_device *dev)
 	struct netdev_queue *txq;
 	int i;
 
-	for (i = 0; i < NUM_TX_QUEUES; i++) {
+	for (i = 0; i < dev->real_num_tx_queues; i++) {
 		txq = netdev_get_tx_queue(dev, i);
 
 		/*
@@ -2563,10 +2637,10 @@ wlan_hdd_update_queue_history_state(struct net_device *dev,
  */
 static inline void wlan_hdd_stop_non_priority_queue(struct hdd_adapter *adapter)
 {
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_VO);
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_VI);
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_BE);
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_BK);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_VO);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_VI);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_BE);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_BK);
 }
 
 /**
@@ -2577,10 +2651,10 @@ static inline void wlan_hdd_stop_non_priority_queue(struct hdd_adapter *adapter)
  */
 static inline void wlan_hdd_wake_non_priority_queue(struct hdd_adapter *adapter)
 {
-	netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_VO);
-	netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_VI);
-	netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_BE);
-	netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_BK);
+	hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_VO);
+	hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_VI);
+	hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_BE);
+	hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_BK);
 }
 
 /**
@@ -2644,14 +2718,14 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 		spin_lock_bh(&adapter->pause_map_lock);
 		temp_map = adapter->pause_map;
 		adapter->pause_map &= ~(1 << reason);
-		netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_HI_PRIO);
+		hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_HI_PRIO);
 		wlan_hdd_update_pause_time(adapter, temp_map);
 		spin_unlock_bh(&adapter->pause_map_lock);
 		break;
 
 	case WLAN_NETIF_PRIORITY_QUEUE_OFF:
 		spin_lock_bh(&adapter->pause_map_lock);
-		netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_HI_PRIO);
+		hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_HI_PRIO);
 		wlan_hdd_update_txq_timestamp(adapter->dev);
 		wlan_hdd_update_unpause_time(adapter);
 		adapter->pause_map |= (1 << reason);
@@ -2660,8 +2734,8 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 
 	case WLAN_NETIF_BE_BK_QUEUE_OFF:
 		spin_lock_bh(&adapter->pause_map_lock);
-		netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_BK);
-		netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_BE);
+		hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_BK);
+		hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_BE);
 		wlan_hdd_update_txq_timestamp(adapter->dev);
 		wlan_hdd_update_unpause_time(adapter);
 		adapter->pause_map |= (1 << reason);
@@ -2670,7 +2744,7 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 
 	case WLAN_NETIF_VI_QUEUE_OFF:
 		spin_lock_bh(&adapter->pause_map_lock);
-		netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_VI);
+		hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_VI);
 		wlan_hdd_update_txq_timestamp(adapter->dev);
 		wlan_hdd_update_unpause_time(adapter);
 		adapter->pause_map |= (1 << reason);
@@ -2681,14 +2755,14 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 		spin_lock_bh(&adapter->pause_map_lock);
 		temp_map = adapter->pause_map;
 		adapter->pause_map &= ~(1 << reason);
-		netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_VI);
+		hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_VI);
 		wlan_hdd_update_pause_time(adapter, temp_map);
 		spin_unlock_bh(&adapter->pause_map_lock);
 		break;
 
 	case WLAN_NETIF_VO_QUEUE_OFF:
 		spin_lock_bh(&adapter->pause_map_lock);
-		netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_VO);
+		hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_VO);
 		wlan_hdd_update_txq_timestamp(adapter->dev);
 		wlan_hdd_update_unpause_time(adapter);
 		adapter->pause_map |= (1 << reason);
@@ -2699,7 +2773,7 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 		spin_lock_bh(&adapter->pause_map_lock);
 		temp_map = adapter->pause_map;
 		adapter->pause_map &= ~(1 << reason);
-		netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_VO);
+		hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_VO);
 		wlan_hdd_update_pause_time(adapter, temp_map);
 		spin_unlock_bh(&adapter->pause_map_lock);
 		break;
@@ -3080,6 +3154,34 @@ static void hdd_ini_tx_flow_control(struct hdd_config *config,
 #endif
 
 #ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
+#ifdef WLAN_BUS_BW_GOVERNOR
+/**
+ * hdd_ini_bus_bw_governor() - Initialize INIs of the bus bandwidth governor
+ * @config: pointer to hdd config
+ * @psoc: pointer to psoc obj
+ *
+ * Return: none
+ */
+static void hdd_ini_bus_bw_governor(struct hdd_config *config,
+				    struct wlan_objmgr_psoc *psoc)
+{
+	config->bus_bw_governor = cfg_get(psoc, CFG_DP_BUS_BW_GOVERNOR);
+	config->bus_bw_gov_ewma_shift =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_EWMA_SHIFT);
+	config->bus_bw_gov_down_hysteresis =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_DOWN_HYSTERESIS);
+	config->bus_bw_gov_down_hold_cnt =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_DOWN_HOLD_CNT);
+	config->bus_bw_gov_rx_ring_ramp_pct =
+		cfg_get(psoc, CFG_DP_BUS_BW_GOV_RX_RING_RAMP_PCT);
+}
+#else
+static inline void hdd_ini_bus_bw_governor(struct hdd_config *config,
+					   struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif /* WLAN_BUS_BW_GOVERNOR */
+
 /**
  * hdd_ini_tx_flow_control() - Initialize INIs concerned about bus bandwidth
  * @config: pointer to hdd config
@@ -3104,6 +3206,7 @@ static void hdd_ini_bus_bandwidth(struct hdd_config *config,
 		cfg_get(psoc, CFG_DP_BUS_LOW_BW_CNT_THRESHOLD);
 	config->enable_latency_crit_clients =
 		cfg_get(psoc, CFG_DP_BUS_HANDLE_LATENCY_CRITICAL_CLIENTS);
+	hdd_ini_bus_bw_governor(config, psoc);
 }
 
 /**
@@ -3270,6 +3373,19 @@ static void hdd_dp_hl_bundle_cfg_update(struct hdd_config *config,
 }
 #endif
 
+#ifdef WLAN_HDD_TX_MULTI_QUEUE
+static void hdd_dp_tx_queues_cfg_update(struct hdd_config *config,
+					struct wlan_objmgr_psoc *psoc)
+{
+	config->tx_queues_per_ac = cfg_get(psoc, CFG_DP_TX_QUEUES_PER_AC);
+}
+#else
+static void hdd_dp_tx_queues_cfg_update(struct hdd_config *config,
+					struct wlan_objmgr_psoc *psoc)
+{
+}
+#endif
+
 void hdd_dp_cfg_update(struct wlan_objmgr_psoc *psoc,
 		       struct hdd_context *hdd_ctx)
 {
@@ -3303,9 +3419,12 @@ void hdd_dp_cfg_update(struct wlan_objmgr_psoc *psoc,
 	config->rx_wakelock_timeout =
 		cfg_get(psoc, CFG_DP_RX_WAKELOCK_TIMEOUT);
 	config->num_dp_rx_threads = cfg_get(psoc, CFG_DP_NUM_DP_RX_THREADS);
+	config->num_ol_rx_threads = cfg_get(psoc, CFG_DP_NUM_OL_RX_THREADS);
+	config->dp_rx_flow_steering = cfg_get(psoc, CFG_DP_RX_FLOW_STEERING);
 	config->cfg_wmi_credit_cnt = cfg_get(psoc, CFG_DP_HTC_WMI_CREDIT_CNT);
 	hdd_dp_dp_trace_cfg_update(config, psoc);
 	hdd_dp_nud_tracking_cfg_update(config, psoc);
+	hdd_dp_tx_queues_cfg_update(config, psoc);
 }
 
 bool wlan_hdd_rx_rpm_mark_last_busy(struct hdd_context *hdd_ctx,
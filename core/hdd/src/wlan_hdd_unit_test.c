@@ -34,6 +34,10 @@
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
 #include "wlan_dsc_test.h"
+#include "ol_rx_test.h"
+#include "ol_txrx_peer_find_test.h"
+#include "wma_mc_rate_test.h"
+#include "pe_session_test.h"
 #include "wlan_hdd_unit_test.h"
 
 typedef uint32_t (*hdd_ut_callback)(void);
@@ -45,6 +49,12 @@ struct hdd_ut_entry {
 
 struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "ol_rx_pn", .callback = ol_rx_pn_unit_test },
+	{ .name = "ol_rx_reorder", .callback = ol_rx_reorder_unit_test },
+	{ .name = "ol_rx_defrag", .callback = ol_rx_defrag_unit_test },
+	{ .name = "ol_txrx_peer_find",
+	  .callback = ol_txrx_peer_find_unit_test },
+	{ .name = "pe_session", .callback = pe_session_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
 	{ .name = "qdf_periodic_work",
@@ -54,6 +64,7 @@ struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "wma_mc_rate", .callback = wma_mc_rate_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
@@ -46,6 +46,7 @@
 #include <linux/ip.h>
 #include <linux/semaphore.h>
 #include <linux/ipv6.h>
+#include <net/sock.h>
 #include "osif_sync.h"
 #include "os_if_fwol.h"
 #include <wlan_hdd_tx_rx.h>
@@ -139,11 +140,11 @@ config_tspec_policy[QCA_WLAN_VENDOR_ATTR_CONFIG_TSPEC_MAX + 1] = {
 void wlan_hdd_process_peer_unauthorised_pause(struct hdd_adapter *adapter)
 {
 	/* Enable HI_PRIO queue */
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_VO);
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_VI);
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_BE);
-	netif_stop_subqueue(adapter->dev, HDD_LINUX_AC_BK);
-	netif_wake_subqueue(adapter->dev, HDD_LINUX_AC_HI_PRIO);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_VO);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_VI);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_BE);
+	hdd_netif_ac_stop(adapter->dev, HDD_LINUX_AC_BK);
+	hdd_netif_ac_wake(adapter->dev, HDD_LINUX_AC_HI_PRIO);
 
 }
 #else
@@ -1902,6 +1903,88 @@ uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
 }
 #endif
 
+#ifdef WLAN_HDD_TX_MULTI_QUEUE
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 1, 0))
+/**
+ * hdd_wmm_sk_txq_get() - get the tx queue a socket is sticking to
+ * @skb: os packet
+ *
+ * Return: netdev tx queue index, or -1 if none
+ */
+static int hdd_wmm_sk_txq_get(struct sk_buff *skb)
+{
+	if (!skb->sk || !sk_fullsock(skb->sk))
+		return -1;
+
+	return sk_tx_queue_get(skb->sk);
+}
+
+/**
+ * hdd_wmm_sk_txq_set() - make a socket stick to a tx queue
+ * @skb: os packet
+ * @queue: netdev tx queue index
+ *
+ * Return: None
+ */
+static void hdd_wmm_sk_txq_set(struct sk_buff *skb, uint16_t queue)
+{
+	if (skb->sk && sk_fullsock(skb->sk) &&
+	    rcu_access_pointer(skb->sk->sk_dst_cache))
+		sk_tx_queue_set(skb->sk, queue);
+}
+#else
+static int hdd_wmm_sk_txq_get(struct sk_buff *skb)
+{
+	return -1;
+}
+
+static void hdd_wmm_sk_txq_set(struct sk_buff *skb, uint16_t queue)
+{
+}
+#endif
+
+/**
+ * hdd_wmm_spread_queue() - pick one of the tx queues serving an AC queue
+ * @dev: net device
+ * @skb: os packet
+ * @index: AC queue selected by WMM classification
+ *
+ * Like XPS, each CPU sends on its own queue of the AC, and a socket keeps
+ * using the queue it was given until the stack reports that the socket
+ * has nothing in flight, so that its frames are not reordered.
+ *
+ * Return: netdev tx queue index
+ */
+static uint16_t hdd_wmm_spread_queue(struct net_device *dev,
+				     struct sk_buff *skb, uint16_t index)
+{
+	uint16_t per_ac = dev->real_num_tx_queues / NUM_TX_QUEUES;
+	uint16_t queue;
+	int sk_queue;
+
+	if (per_ac <= 1 || index == HDD_LINUX_AC_HI_PRIO)
+		return index;
+
+	sk_queue = hdd_wmm_sk_txq_get(skb);
+	if (sk_queue >= 0 && sk_queue < dev->real_num_tx_queues &&
+	    hdd_txq_to_linux_ac(sk_queue) == index && !skb->ooo_okay)
+		return sk_queue;
+
+	queue = index + NUM_TX_QUEUES * (raw_smp_processor_id() % per_ac);
+	if (queue != sk_queue)
+		hdd_wmm_sk_txq_set(skb, queue);
+
+	return queue;
+}
+#else
+static inline uint16_t hdd_wmm_spread_queue(struct net_device *dev,
+					    struct sk_buff *skb,
+					    uint16_t index)
+{
+	return index;
+}
+#endif
+
 /**
  * hdd_wmm_select_queue() - Function which will classify the packet
  *       according to linux qdisc expectation.
@@ -1951,7 +2034,7 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 	skb->priority = up;
 	index = hdd_get_queue_index(skb->priority, is_crtical);
 
-	return index;
+	return hdd_wmm_spread_queue(dev, skb, index);
 }
 
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0))
@@ -624,6 +624,10 @@ typedef struct sAniSirLim {
 	/* wsc info required to form the wsc IE */
 	tLimWscIeInfo wscIeInfo;
 	struct pe_session *gpSession;  /* Pointer to  session table */
+	/* Heads of the session chains indexed by BSSID, vdev id and peer */
+	uint8_t session_bssid_hash[PE_SESSION_HASH_SIZE];
+	uint8_t session_vdev_hash[PE_SESSION_HASH_SIZE];
+	uint8_t session_peer_hash[PE_PEER_HASH_SIZE];
 	uint8_t max_sta_of_pe_session;
 
 	qdf_mutex_t lim_frame_register_lock;
@@ -32,6 +32,7 @@
 #include "sch_api.h"
 #include "dph_global.h"
 #include "lim_api.h"
+#include "lim_session.h"
 #include "wma_if.h"
 #include "wlan_mlme_api.h"
 
@@ -40,6 +41,8 @@ void dph_hash_table_init(struct mac_context *mac,
 {
 	uint16_t i;
 
+	pe_session_index_flush_peers(mac, hash_table);
+
 	for (i = 0; i < hash_table->size; i++) {
 		hash_table->pHashTable[i] = 0;
 	}
@@ -267,6 +270,7 @@ tpDphHashNode dph_add_hash_entry(struct mac_context *mac, tSirMacAddr staAddr,
 			hash_table->pHashTable[index];
 		hash_table->pHashTable[index] =
 			&hash_table->pDphNodeArray[assocId];
+		pe_session_index_add_peer(mac, hash_table, staAddr);
 
 		node = hash_table->pHashTable[index];
 		return node;
@@ -325,6 +329,7 @@ QDF_STATUS dph_delete_hash_entry(struct mac_context *mac, tSirMacAddr staAddr,
 	if (ptr) {
 		/* / Delete the entry after invalidating it */
 		ptr->valid = 0;
+		pe_session_index_del_peer(mac, hash_table, staAddr);
 		memset(ptr->staAddr, 0, sizeof(ptr->staAddr));
 		if (prev == 0)
 			hash_table->pHashTable[index] = ptr->next;
@@ -45,6 +45,12 @@
 /* Deferred Message Queue Length */
 #define MAX_DEFERRED_QUEUE_LEN                  80
 
+/* Buckets of the PE session lookup indices, must be a power of 2 */
+#define PE_SESSION_HASH_SIZE             16
+#define PE_PEER_HASH_SIZE                32
+/* Terminates a PE session index chain */
+#define PE_SESSION_IDX_INVALID           0xFF
+
 #ifdef CHANNEL_HOPPING_ALL_BANDS
 #define CHAN_HOP_ALL_BANDS_ENABLE        1
 #else
@@ -229,6 +229,12 @@ struct pe_session {
 	uint32_t assocRspLen;
 	uint8_t *assocRsp;      /* Used to store association response received while associating */
 	tAniSirDph dph;
+	/* Links of the session lookup indices, see lim_session.c */
+	uint8_t bssid_hash_next;
+	uint8_t vdev_hash_next;
+	uint8_t peer_hash_next[PE_PEER_HASH_SIZE];
+	/* Number of peers of this session in each peer index bucket */
+	uint16_t peer_hash_cnt[PE_PEER_HASH_SIZE];
 	void **parsedAssocReq;  /* Used to store parsed assoc req from various requesting station */
 	uint32_t RICDataLen;    /* Used to store the Ric data received in the assoc response */
 	uint8_t *ricData;
@@ -622,6 +628,98 @@ struct pe_session *pe_create_session(struct mac_context *mac,
 				     uint16_t numSta, enum bss_type bssType,
 				     uint8_t vdev_id, enum QDF_OPMODE opmode);
 
+/**
+ * pe_init_session_index() - reset the PE session lookup indices
+ * @mac: pointer to global adapter context
+ *
+ * Must be called whenever the session table is cleared.
+ *
+ * Return: None
+ */
+void pe_init_session_index(struct mac_context *mac);
+
+/**
+ * pe_session_index_add() - index a new PE session by BSSID and vdev id
+ * @mac: pointer to global adapter context
+ * @session: PE session, with its BSSID and vdev id set
+ *
+ * Return: None
+ */
+void pe_session_index_add(struct mac_context *mac,
+			  struct pe_session *session);
+
+/**
+ * pe_session_index_del() - drop a deleted PE session from the indices
+ * @mac: pointer to global adapter context
+ * @session: PE session
+ *
+ * Return: None
+ */
+void pe_session_index_del(struct mac_context *mac,
+			  struct pe_session *session);
+
+/**
+ * pe_update_session_vdev_id() - change the vdev id of a PE session
+ * @mac: pointer to global adapter context
+ * @session: PE session
+ * @vdev_id: new vdev id of the session
+ *
+ * The vdev id of a session must only be changed through this function so
+ * that pe_find_session_by_vdev_id() keeps finding it.
+ *
+ * Return: None
+ */
+void pe_update_session_vdev_id(struct mac_context *mac,
+			       struct pe_session *session, uint8_t vdev_id);
+
+/**
+ * pe_update_session_bssid() - change the BSSID of a PE session
+ * @mac: pointer to global adapter context
+ * @session: PE session
+ * @bssid: new BSSID of the session
+ *
+ * The BSSID of a session must only be changed through this function so
+ * that pe_find_session_by_bssid() keeps finding it.
+ *
+ * Return: None
+ */
+void pe_update_session_bssid(struct mac_context *mac,
+			     struct pe_session *session, uint8_t *bssid);
+
+/**
+ * pe_session_index_add_peer() - index a peer added to a session
+ * @mac: pointer to global adapter context
+ * @hash_table: DPH hash table of the session
+ * @peer_addr: MAC address of the peer
+ *
+ * Return: None
+ */
+void pe_session_index_add_peer(struct mac_context *mac,
+			       struct dph_hash_table *hash_table,
+			       uint8_t *peer_addr);
+
+/**
+ * pe_session_index_del_peer() - drop a peer deleted from a session
+ * @mac: pointer to global adapter context
+ * @hash_table: DPH hash table of the session
+ * @peer_addr: MAC address of the peer
+ *
+ * Return: None
+ */
+void pe_session_index_del_peer(struct mac_context *mac,
+			       struct dph_hash_table *hash_table,
+			       uint8_t *peer_addr);
+
+/**
+ * pe_session_index_flush_peers() - drop all peers of a session
+ * @mac: pointer to global adapter context
+ * @hash_table: DPH hash table of the session
+ *
+ * Return: None
+ */
+void pe_session_index_flush_peers(struct mac_context *mac,
+				  struct dph_hash_table *hash_table);
+
 /**
  * pe_find_session_by_bssid() - looks up the PE session given the BSSID.
  *
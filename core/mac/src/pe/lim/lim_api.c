@@ -91,6 +91,7 @@ static void __lim_init_bss_vars(struct mac_context *mac)
 {
 	qdf_mem_zero((void *)mac->lim.gpSession,
 		    sizeof(*mac->lim.gpSession) * mac->lim.maxBssId);
+	pe_init_session_index(mac);
 
 	/* This is for testing purposes only, be default should always be off */
 	mac->lim.gpLimMlmSetKeysReq = NULL;
@@ -1747,7 +1747,8 @@ static void __lim_process_sme_reassoc_req(struct mac_context *mac_ctx,
 				goto end;
 			}
 
-			session_entry->vdev_id = vdev_id;
+			pe_update_session_vdev_id(mac_ctx, session_entry,
+						  vdev_id);
 			mlm_reassoc_req =
 				qdf_mem_malloc(sizeof(*mlm_reassoc_req));
 			if (!mlm_reassoc_req) {
@@ -2318,7 +2319,7 @@ static void __lim_process_sme_deauth_req(struct mac_context *mac_ctx,
 			session_entry, 0, sme_deauth_req.reasonCode);
 #endif /* FEATURE_WLAN_DIAG_SUPPORT */
 
-	session_entry->vdev_id = vdev_id;
+	pe_update_session_vdev_id(mac_ctx, session_entry, vdev_id);
 
 	switch (GET_LIM_SYSTEM_ROLE(session_entry)) {
 	case eLIM_STA_ROLE:
@@ -78,6 +78,229 @@ struct sDphHashNode *pe_get_session_dph_node_array(uint8_t session_id)
 }
 #endif /* WLAN_ALLOCATE_GLOBAL_BUFFERS_DYNAMICALLY */
 
+/*
+ * Sessions are chained per bucket of the BSSID, vdev id and peer indices
+ * by session ID, in ascending order so that a lookup returns the same
+ * session as a scan of the session table would.
+ */
+enum pe_session_index {
+	PE_SESSION_INDEX_BSSID,
+	PE_SESSION_INDEX_VDEV,
+	PE_SESSION_INDEX_PEER,
+};
+
+static inline uint8_t pe_session_addr_hash(const uint8_t *addr,
+					   uint8_t size)
+{
+	return (addr[3] ^ addr[4] ^ addr[5]) & (size - 1);
+}
+
+static inline uint8_t pe_session_vdev_hash(uint8_t vdev_id)
+{
+	return vdev_id & (PE_SESSION_HASH_SIZE - 1);
+}
+
+static uint8_t *pe_session_index_head(struct mac_context *mac,
+				      enum pe_session_index index,
+				      uint8_t bucket)
+{
+	switch (index) {
+	case PE_SESSION_INDEX_BSSID:
+		return &mac->lim.session_bssid_hash[bucket];
+	case PE_SESSION_INDEX_VDEV:
+		return &mac->lim.session_vdev_hash[bucket];
+	default:
+		return &mac->lim.session_peer_hash[bucket];
+	}
+}
+
+static uint8_t *pe_session_index_next(struct pe_session *session,
+				      enum pe_session_index index,
+				      uint8_t bucket)
+{
+	switch (index) {
+	case PE_SESSION_INDEX_BSSID:
+		return &session->bssid_hash_next;
+	case PE_SESSION_INDEX_VDEV:
+		return &session->vdev_hash_next;
+	default:
+		return &session->peer_hash_next[bucket];
+	}
+}
+
+/**
+ * pe_session_index_link() - add a session to a bucket of an index
+ * @mac: pointer to global adapter context
+ * @index: index to add the session to
+ * @bucket: bucket of the index
+ * @session: session to add
+ *
+ * Return: None
+ */
+static void pe_session_index_link(struct mac_context *mac,
+				  enum pe_session_index index, uint8_t bucket,
+				  struct pe_session *session)
+{
+	uint8_t *link = pe_session_index_head(mac, index, bucket);
+	uint8_t id = session->peSessionId;
+
+	while (*link != PE_SESSION_IDX_INVALID && *link < id)
+		link = pe_session_index_next(&mac->lim.gpSession[*link],
+					     index, bucket);
+
+	*pe_session_index_next(session, index, bucket) = *link;
+	*link = id;
+}
+
+/**
+ * pe_session_index_unlink() - remove a session from a bucket of an index
+ * @mac: pointer to global adapter context
+ * @index: index to remove the session from
+ * @bucket: bucket of the index
+ * @session: session to remove
+ *
+ * Return: None
+ */
+static void pe_session_index_unlink(struct mac_context *mac,
+				    enum pe_session_index index,
+				    uint8_t bucket, struct pe_session *session)
+{
+	uint8_t *link = pe_session_index_head(mac, index, bucket);
+	uint8_t *next = pe_session_index_next(session, index, bucket);
+
+	while (*link != PE_SESSION_IDX_INVALID) {
+		if (*link == session->peSessionId) {
+			*link = *next;
+			*next = PE_SESSION_IDX_INVALID;
+			return;
+		}
+		link = pe_session_index_next(&mac->lim.gpSession[*link],
+					     index, bucket);
+	}
+}
+
+void pe_init_session_index(struct mac_context *mac)
+{
+	qdf_mem_set(mac->lim.session_bssid_hash,
+		    sizeof(mac->lim.session_bssid_hash),
+		    PE_SESSION_IDX_INVALID);
+	qdf_mem_set(mac->lim.session_vdev_hash,
+		    sizeof(mac->lim.session_vdev_hash),
+		    PE_SESSION_IDX_INVALID);
+	qdf_mem_set(mac->lim.session_peer_hash,
+		    sizeof(mac->lim.session_peer_hash),
+		    PE_SESSION_IDX_INVALID);
+}
+
+void pe_session_index_add(struct mac_context *mac,
+			  struct pe_session *session)
+{
+	pe_session_index_link(mac, PE_SESSION_INDEX_BSSID,
+			      pe_session_addr_hash(session->bssId,
+						   PE_SESSION_HASH_SIZE),
+			      session);
+	pe_session_index_link(mac, PE_SESSION_INDEX_VDEV,
+			      pe_session_vdev_hash(session->vdev_id),
+			      session);
+}
+
+void pe_session_index_del(struct mac_context *mac,
+			  struct pe_session *session)
+{
+	pe_session_index_unlink(mac, PE_SESSION_INDEX_BSSID,
+				pe_session_addr_hash(session->bssId,
+						     PE_SESSION_HASH_SIZE),
+				session);
+	pe_session_index_unlink(mac, PE_SESSION_INDEX_VDEV,
+				pe_session_vdev_hash(session->vdev_id),
+				session);
+}
+
+void pe_update_session_vdev_id(struct mac_context *mac,
+			       struct pe_session *session, uint8_t vdev_id)
+{
+	if (session->vdev_id == vdev_id)
+		return;
+
+	pe_session_index_unlink(mac, PE_SESSION_INDEX_VDEV,
+				pe_session_vdev_hash(session->vdev_id),
+				session);
+	session->vdev_id = vdev_id;
+	pe_session_index_link(mac, PE_SESSION_INDEX_VDEV,
+			      pe_session_vdev_hash(session->vdev_id),
+			      session);
+}
+
+void pe_update_session_bssid(struct mac_context *mac,
+			     struct pe_session *session, uint8_t *bssid)
+{
+	pe_session_index_unlink(mac, PE_SESSION_INDEX_BSSID,
+				pe_session_addr_hash(session->bssId,
+						     PE_SESSION_HASH_SIZE),
+				session);
+	sir_copy_mac_addr(session->bssId, bssid);
+	pe_session_index_link(mac, PE_SESSION_INDEX_BSSID,
+			      pe_session_addr_hash(session->bssId,
+						   PE_SESSION_HASH_SIZE),
+			      session);
+}
+
+static inline struct pe_session *
+pe_session_of_dph_table(struct dph_hash_table *hash_table)
+{
+	return qdf_container_of(hash_table, struct pe_session,
+				dph.dphHashTable);
+}
+
+void pe_session_index_add_peer(struct mac_context *mac,
+			       struct dph_hash_table *hash_table,
+			       uint8_t *peer_addr)
+{
+	struct pe_session *session = pe_session_of_dph_table(hash_table);
+	uint8_t bucket = pe_session_addr_hash(peer_addr, PE_PEER_HASH_SIZE);
+
+	if (!session->valid)
+		return;
+
+	if (!session->peer_hash_cnt[bucket]++)
+		pe_session_index_link(mac, PE_SESSION_INDEX_PEER, bucket,
+				      session);
+}
+
+void pe_session_index_del_peer(struct mac_context *mac,
+			       struct dph_hash_table *hash_table,
+			       uint8_t *peer_addr)
+{
+	struct pe_session *session = pe_session_of_dph_table(hash_table);
+	uint8_t bucket = pe_session_addr_hash(peer_addr, PE_PEER_HASH_SIZE);
+
+	if (!session->valid || !session->peer_hash_cnt[bucket])
+		return;
+
+	if (!--session->peer_hash_cnt[bucket])
+		pe_session_index_unlink(mac, PE_SESSION_INDEX_PEER, bucket,
+					session);
+}
+
+void pe_session_index_flush_peers(struct mac_context *mac,
+				  struct dph_hash_table *hash_table)
+{
+	struct pe_session *session = pe_session_of_dph_table(hash_table);
+	uint8_t bucket;
+
+	if (!session->valid)
+		return;
+
+	for (bucket = 0; bucket < PE_PEER_HASH_SIZE; bucket++) {
+		if (!session->peer_hash_cnt[bucket])
+			continue;
+
+		session->peer_hash_cnt[bucket] = 0;
+		pe_session_index_unlink(mac, PE_SESSION_INDEX_PEER, bucket,
+					session);
+	}
+}
+
 /*--------------------------------------------------------------------------
 
    \brief pe_init_beacon_params() - Initialize the beaconParams structure
@@ -657,6 +880,8 @@ struct pe_session *pe_create_session(struct mac_context *mac,
 	/* following is invalid value since seq number is 12 bit */
 	session_ptr->prev_auth_seq_num = 0xFFFF;
 
+	pe_session_index_add(mac, session_ptr);
+
 	return &mac->lim.gpSession[i];
 
 free_session_attrs:
@@ -700,14 +925,16 @@ struct pe_session *pe_find_session_by_bssid(struct mac_context *mac, uint8_t *bs
 				     uint8_t *sessionId)
 {
 	uint8_t i;
+	struct pe_session *session;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
+	i = mac->lim.session_bssid_hash[pe_session_addr_hash(
+						bssid, PE_SESSION_HASH_SIZE)];
+	for (; i != PE_SESSION_IDX_INVALID; i = session->bssid_hash_next) {
+		session = &mac->lim.gpSession[i];
 		/* If BSSID matches return corresponding tables address */
-		if ((mac->lim.gpSession[i].valid)
-		    && (sir_compare_mac_addr(mac->lim.gpSession[i].bssId,
-					    bssid))) {
+		if (sir_compare_mac_addr(session->bssId, bssid)) {
 			*sessionId = i;
-			return &mac->lim.gpSession[i];
+			return session;
 		}
 	}
 
@@ -719,12 +946,13 @@ struct pe_session *pe_find_session_by_vdev_id(struct mac_context *mac,
 					      uint8_t vdev_id)
 {
 	uint8_t i;
+	struct pe_session *session;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
-		/* If BSSID matches return corresponding tables address */
-		if ((mac->lim.gpSession[i].valid) &&
-		    (mac->lim.gpSession[i].vdev_id == vdev_id))
-			return &mac->lim.gpSession[i];
+	i = mac->lim.session_vdev_hash[pe_session_vdev_hash(vdev_id)];
+	for (; i != PE_SESSION_IDX_INVALID; i = session->vdev_hash_next) {
+		session = &mac->lim.gpSession[i];
+		if (session->vdev_id == vdev_id)
+			return session;
 	}
 	pe_debug("Session lookup fails for vdev_id: %d", vdev_id);
 
@@ -737,12 +965,14 @@ struct pe_session
 				      enum eLimMlmStates lim_state)
 {
 	uint8_t i;
-
-	for (i = 0; i < mac->lim.maxBssId; i++) {
-		if (mac->lim.gpSession[i].valid &&
-		    mac->lim.gpSession[i].vdev_id == vdev_id &&
-		    mac->lim.gpSession[i].limMlmState == lim_state)
-			return &mac->lim.gpSession[i];
+	struct pe_session *session;
+
+	i = mac->lim.session_vdev_hash[pe_session_vdev_hash(vdev_id)];
+	for (; i != PE_SESSION_IDX_INVALID; i = session->vdev_hash_next) {
+		session = &mac->lim.gpSession[i];
+		if (session->vdev_id == vdev_id &&
+		    session->limMlmState == lim_state)
+			return session;
 	}
 	pe_debug("Session lookup fails for vdev_id: %d, mlm state: %d",
 		 vdev_id, lim_state);
@@ -956,6 +1186,8 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 		session->add_ie_params.probeRespBCNDataLen = 0;
 	}
 	pe_delete_fils_info(session);
+	pe_session_index_del(mac_ctx, session);
+	pe_session_index_flush_peers(mac_ctx, &session->dph.dphHashTable);
 	session->valid = false;
 
 	session->mac_ctx = NULL;
@@ -995,20 +1227,22 @@ void pe_delete_session(struct mac_context *mac_ctx, struct pe_session *session)
 struct pe_session *pe_find_session_by_peer_sta(struct mac_context *mac, uint8_t *sa,
 					uint8_t *sessionId)
 {
-	uint8_t i;
+	uint8_t i, bucket;
+	struct pe_session *session;
 	tpDphHashNode pSta;
 	uint16_t aid;
 
-	for (i = 0; i < mac->lim.maxBssId; i++) {
-		if ((mac->lim.gpSession[i].valid)) {
-			pSta =
-				dph_lookup_hash_entry(mac, sa, &aid,
-						      &mac->lim.gpSession[i].dph.
-						      dphHashTable);
-			if (pSta) {
-				*sessionId = i;
-				return &mac->lim.gpSession[i];
-			}
+	/* Only the sessions with a peer in the bucket of sa are chained */
+	bucket = pe_session_addr_hash(sa, PE_PEER_HASH_SIZE);
+	i = mac->lim.session_peer_hash[bucket];
+	for (; i != PE_SESSION_IDX_INVALID;
+	     i = session->peer_hash_next[bucket]) {
+		session = &mac->lim.gpSession[i];
+		pSta = dph_lookup_hash_entry(mac, sa, &aid,
+					     &session->dph.dphHashTable);
+		if (pSta) {
+			*sessionId = i;
+			return session;
 		}
 	}
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: pe_session_test.c
+ *
+ * Unit tests for the PE session lookup indices. A private session table
+ * is indexed and the BSSID and vdev id lookups are checked as sessions
+ * change their vdev id or BSSID, share a vdev id and are deleted.
+ */
+
+#include "qdf_mem.h"
+#include "ani_global.h"
+#include "cds_utils.h"
+#include "lim_session.h"
+#include "pe_session_test.h"
+
+#define PE_SESSION_TEST_NUM	4
+
+/**
+ * pe_session_test_bssid() - BSSID of a test session
+ * @bssid: filled with the BSSID
+ * @id: distinguishes the BSSID
+ *
+ * Return: None
+ */
+static void pe_session_test_bssid(tSirMacAddr bssid, uint8_t id)
+{
+	static const tSirMacAddr base = { 0x00, 0x03, 0x7f, 0x10, 0x20, 0x00 };
+
+	qdf_mem_copy(bssid, base, sizeof(tSirMacAddr));
+	bssid[5] = id;
+}
+
+/**
+ * pe_session_test_vdev() - find a session by vdev id
+ * @mac: test mac context
+ * @vdev_id: vdev id
+ *
+ * Return: index of the session in the table, -1 if none is found
+ */
+static int pe_session_test_vdev(struct mac_context *mac, uint8_t vdev_id)
+{
+	struct pe_session *session = pe_find_session_by_vdev_id(mac, vdev_id);
+
+	return session ? session - mac->lim.gpSession : -1;
+}
+
+/**
+ * pe_session_test_bssid_find() - find a session by BSSID
+ * @mac: test mac context
+ * @id: BSSID id, see pe_session_test_bssid()
+ *
+ * Return: index of the session in the table, -1 if none is found
+ */
+static int pe_session_test_bssid_find(struct mac_context *mac, uint8_t id)
+{
+	struct pe_session *session;
+	tSirMacAddr bssid;
+	uint8_t session_id;
+
+	pe_session_test_bssid(bssid, id);
+	session = pe_find_session_by_bssid(mac, bssid, &session_id);
+	if (!session)
+		return -1;
+	if (session_id != session->peSessionId)
+		return -2;
+
+	return session - mac->lim.gpSession;
+}
+
+static uint32_t pe_session_test_index(struct mac_context *mac)
+{
+	struct pe_session *sessions = mac->lim.gpSession;
+	uint32_t errors = 0;
+	tSirMacAddr bssid;
+	uint8_t i;
+
+	pe_init_session_index(mac);
+	for (i = 0; i < PE_SESSION_TEST_NUM; i++) {
+		sessions[i].valid = true;
+		sessions[i].peSessionId = i;
+		sessions[i].vdev_id = i;
+		pe_session_test_bssid(sessions[i].bssId, i);
+		pe_session_index_add(mac, &sessions[i]);
+	}
+
+	for (i = 0; i < PE_SESSION_TEST_NUM; i++) {
+		cds_test_expect(pe_session_test_vdev(mac, i) == i, errors);
+		cds_test_expect(pe_session_test_bssid_find(mac, i) == i,
+				errors);
+	}
+
+	/* vdev id moving to another bucket */
+	pe_update_session_vdev_id(mac, &sessions[0], 5);
+	cds_test_expect(pe_session_test_vdev(mac, 5) == 0, errors);
+	cds_test_expect(pe_session_test_vdev(mac, 0) == -1, errors);
+
+	/* vdev id staying in the same bucket */
+	pe_update_session_vdev_id(mac, &sessions[1],
+				  1 + PE_SESSION_HASH_SIZE);
+	cds_test_expect(
+		pe_session_test_vdev(mac, 1 + PE_SESSION_HASH_SIZE) == 1,
+		errors);
+	cds_test_expect(pe_session_test_vdev(mac, 1) == -1, errors);
+
+	/* unchanged vdev id */
+	pe_update_session_vdev_id(mac, &sessions[2], 2);
+	cds_test_expect(pe_session_test_vdev(mac, 2) == 2, errors);
+
+	/* a shared vdev id finds the lowest session id, like a table scan */
+	pe_update_session_vdev_id(mac, &sessions[3], 2);
+	cds_test_expect(pe_session_test_vdev(mac, 2) == 2, errors);
+	pe_update_session_vdev_id(mac, &sessions[2], 9);
+	cds_test_expect(pe_session_test_vdev(mac, 2) == 3, errors);
+	cds_test_expect(pe_session_test_vdev(mac, 9) == 2, errors);
+	pe_update_session_vdev_id(mac, &sessions[2], 2);
+	cds_test_expect(pe_session_test_vdev(mac, 2) == 2, errors);
+
+	/* BSSID update */
+	pe_session_test_bssid(bssid, 0x80);
+	pe_update_session_bssid(mac, &sessions[0], bssid);
+	cds_test_expect(pe_session_test_bssid_find(mac, 0x80) == 0, errors);
+	cds_test_expect(pe_session_test_bssid_find(mac, 0) == -1, errors);
+
+	/* deleted sessions are not found any more */
+	pe_session_index_del(mac, &sessions[2]);
+	sessions[2].valid = false;
+	cds_test_expect(pe_session_test_vdev(mac, 2) == 3, errors);
+	cds_test_expect(pe_session_test_bssid_find(mac, 2) == -1, errors);
+	pe_session_index_del(mac, &sessions[3]);
+	sessions[3].valid = false;
+	cds_test_expect(pe_session_test_vdev(mac, 2) == -1, errors);
+
+	for (i = 0; i < 2; i++)
+		pe_session_index_del(mac, &sessions[i]);
+	cds_test_expect(pe_session_test_vdev(mac, 5) == -1, errors);
+	cds_test_expect(pe_session_test_bssid_find(mac, 0x80) == -1, errors);
+
+	return errors;
+}
+
+uint32_t pe_session_unit_test(void)
+{
+	struct mac_context *mac;
+	uint32_t errors = 0;
+
+	mac = qdf_mem_valloc(sizeof(*mac));
+	if (!mac)
+		return 1;
+
+	mac->lim.maxBssId = PE_SESSION_TEST_NUM;
+	mac->lim.gpSession = qdf_mem_malloc(PE_SESSION_TEST_NUM *
+					    sizeof(*mac->lim.gpSession));
+	if (!mac->lim.gpSession) {
+		qdf_mem_vfree(mac);
+		return 1;
+	}
+
+	errors += pe_session_test_index(mac);
+
+	qdf_mem_free(mac->lim.gpSession);
+	qdf_mem_vfree(mac);
+
+	return errors;
+}
@@ -425,6 +425,14 @@ static bool sap_chan_sel_init(mac_handle_t mac_handle,
 	if (!pSpectCh)
 		return false;
 
+	pSpectInfoParams->rank_key =
+		qdf_mem_malloc(pSpectInfoParams->numSpectChans *
+			       sizeof(*pSpectInfoParams->rank_key));
+	if (!pSpectInfoParams->rank_key) {
+		qdf_mem_free(pSpectCh);
+		return false;
+	}
+
 	/* Initialize the pointers in the DfsParams to the allocated memory */
 	pSpectInfoParams->pSpectCh = pSpectCh;
 
@@ -1256,6 +1264,47 @@ sap_upd_chan_spec_params(struct scan_cache_node *scan_entry,
 	}
 }
 
+/**
+ * sap_find_spect_ch() - find the spectrum channel of a frequency
+ * @spect_info: Pointer to the tSapChSelSpectInfo structure
+ * @chan_freq: channel frequency of a scan result
+ * @sorted: spectrum channels are in ascending order of frequency
+ *
+ * The spectrum is built from the base channel list, which is in ascending
+ * order of frequency, so a scan result is bucketed into its channel with a
+ * binary search. A linear search is kept for an unordered channel list.
+ *
+ * Return: spectrum channel of @chan_freq, or NULL if it is not in the
+ * spectrum
+ */
+static tSapSpectChInfo *sap_find_spect_ch(tSapChSelSpectInfo *spect_info,
+					  uint32_t chan_freq, bool sorted)
+{
+	tSapSpectChInfo *spect_ch = spect_info->pSpectCh;
+	uint32_t lo = 0, hi = spect_info->numSpectChans, mid;
+
+	if (!sorted) {
+		for (mid = 0; mid < hi; mid++)
+			if (spect_ch[mid].chan_freq == chan_freq)
+				return &spect_ch[mid];
+		return NULL;
+	}
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (spect_ch[mid].chan_freq < chan_freq)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (lo < spect_info->numSpectChans &&
+	    spect_ch[lo].chan_freq == chan_freq)
+		return &spect_ch[lo];
+
+	return NULL;
+}
+
 /**
  * sap_compute_spect_weight() - Compute spectrum weight
  * @pSpectInfoParams: Pointer to the tSpectInfoParams structure
@@ -1294,16 +1343,25 @@ static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
 	struct acs_weight_range *range_list =
 				mac->mlme_cfg->acs.normalize_weight_range;
 	bool freq_present_in_list = false;
+	bool sorted = true;
 
 	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_INFO_HIGH,
 		  "In %s, Computing spectral weight", __func__);
 
+	for (chn_num = 1; chn_num < pSpectInfoParams->numSpectChans;
+	     chn_num++) {
+		if (pSpectCh[chn_num - 1].chan_freq >=
+		    pSpectCh[chn_num].chan_freq) {
+			sorted = false;
+			break;
+		}
+	}
+
 	if (scan_list)
 		qdf_list_peek_front(scan_list, &cur_lst);
 	while (cur_lst) {
 		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
 					    node);
-		pSpectCh = pSpectInfoParams->pSpectCh;
 		/* Defining the default values, so that any value will hold the default values */
 
 		secondaryChannelOffset = PHY_SINGLE_CHANNEL_CENTERED;
@@ -1313,18 +1371,13 @@ static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
 		chan_freq =
 		    util_scan_entry_channel_frequency(cur_node->entry);
 
-		sap_upd_chan_spec_params(cur_node, &ch_width,
-					 &secondaryChannelOffset,
-					 &center_freq0, &center_freq1);
-
 		/* Processing for each tCsrScanResultInfo in the tCsrScanResult DLink list */
-		for (chn_num = 0; chn_num < pSpectInfoParams->numSpectChans;
-		     chn_num++) {
-
-			if (chan_freq != pSpectCh->chan_freq) {
-				pSpectCh++;
-				continue;
-			}
+		pSpectCh = sap_find_spect_ch(pSpectInfoParams, chan_freq,
+					     sorted);
+		if (pSpectCh) {
+			sap_upd_chan_spec_params(cur_node, &ch_width,
+						 &secondaryChannelOffset,
+						 &center_freq0, &center_freq1);
 
 			if (pSpectCh->rssiAgr < cur_node->entry->rssi_raw)
 				pSpectCh->rssiAgr = cur_node->entry->rssi_raw;
@@ -1339,10 +1392,6 @@ static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
 				    pSpectCh, ch_width, secondaryChannelOffset,
 				    center_freq0, center_freq1, chan_freq,
 				    spectch_start, spectch_end);
-
-			pSpectCh++;
-			break;
-
 		}
 
 		qdf_list_peek_next(scan_list, cur_lst, &next_lst);
@@ -1490,6 +1539,53 @@ static void sap_chan_sel_exit(tSapChSelSpectInfo *pSpectInfoParams)
 {
 	/* Free all the allocated memory */
 	qdf_mem_free(pSpectInfoParams->pSpectCh);
+	qdf_mem_free(pSpectInfoParams->rank_key);
+}
+
+/**
+ * sap_ch_rank_less() - compare the sort keys of two channels
+ * @a: first key
+ * @b: second key
+ *
+ * Channels are ranked by weight, then by BSS count. The spectrum index
+ * breaks the remaining ties so that equal channels keep their order.
+ *
+ * Return: true if @a ranks before @b
+ */
+static inline bool sap_ch_rank_less(const struct sap_ch_rank_key *a,
+				    const struct sap_ch_rank_key *b)
+{
+	if (a->weight != b->weight)
+		return a->weight < b->weight;
+	if (a->bss_count != b->bss_count)
+		return a->bss_count < b->bss_count;
+	return a->idx < b->idx;
+}
+
+/**
+ * sap_ch_rank_sift_down() - restore the max heap property below a node
+ * @key: heap of channel sort keys
+ * @root: node to sift down
+ * @num: number of keys in the heap
+ *
+ * Return: none
+ */
+static void sap_ch_rank_sift_down(struct sap_ch_rank_key *key,
+				  uint32_t root, uint32_t num)
+{
+	struct sap_ch_rank_key tmp = key[root];
+	uint32_t child;
+
+	while ((child = 2 * root + 1) < num) {
+		if (child + 1 < num &&
+		    sap_ch_rank_less(&key[child], &key[child + 1]))
+			child++;
+		if (!sap_ch_rank_less(&tmp, &key[child]))
+			break;
+		key[root] = key[child];
+		root = child;
+	}
+	key[root] = tmp;
 }
 
 /*==========================================================================
@@ -1514,31 +1610,48 @@ static void sap_chan_sel_exit(tSapChSelSpectInfo *pSpectInfoParams)
 static void sap_sort_chl_weight(tSapChSelSpectInfo *pSpectInfoParams)
 {
 	tSapSpectChInfo temp;
+	tSapSpectChInfo *pSpectCh = pSpectInfoParams->pSpectCh;
+	struct sap_ch_rank_key *key = pSpectInfoParams->rank_key;
+	struct sap_ch_rank_key tmp_key;
+	uint32_t num = pSpectInfoParams->numSpectChans;
+	uint32_t i, j, k;
 
-	tSapSpectChInfo *pSpectCh = NULL;
-	uint32_t i = 0, j = 0, minWeightIndex = 0;
+	if (num < 2)
+		return;
 
-	pSpectCh = pSpectInfoParams->pSpectCh;
-	for (i = 0; i < pSpectInfoParams->numSpectChans; i++) {
-		minWeightIndex = i;
-		for (j = i + 1; j < pSpectInfoParams->numSpectChans; j++) {
-			if (pSpectCh[j].weight <
-			    pSpectCh[minWeightIndex].weight) {
-				minWeightIndex = j;
-			} else if (pSpectCh[j].weight ==
-				   pSpectCh[minWeightIndex].weight) {
-				if (pSpectCh[j].bssCount <
-				    pSpectCh[minWeightIndex].bssCount)
-					minWeightIndex = j;
-			}
-		}
-		if (minWeightIndex != i) {
-			qdf_mem_copy(&temp, &pSpectCh[minWeightIndex],
-				     sizeof(*pSpectCh));
-			qdf_mem_copy(&pSpectCh[minWeightIndex], &pSpectCh[i],
+	for (i = 0; i < num; i++) {
+		key[i].weight = pSpectCh[i].weight;
+		key[i].bss_count = pSpectCh[i].bssCount;
+		key[i].idx = i;
+	}
+
+	/* Heap sort the keys, the channel entries themselves stay in place */
+	for (i = num / 2; i-- > 0;)
+		sap_ch_rank_sift_down(key, i, num);
+
+	for (i = num - 1; i > 0; i--) {
+		tmp_key = key[0];
+		key[0] = key[i];
+		key[i] = tmp_key;
+		sap_ch_rank_sift_down(key, 0, i);
+	}
+
+	/* Move every channel entry once by following the permutation cycles */
+	for (i = 0; i < num; i++) {
+		if (key[i].idx == i)
+			continue;
+
+		qdf_mem_copy(&temp, &pSpectCh[i], sizeof(*pSpectCh));
+		j = i;
+		while (key[j].idx != i) {
+			k = key[j].idx;
+			qdf_mem_copy(&pSpectCh[j], &pSpectCh[k],
 				     sizeof(*pSpectCh));
-			qdf_mem_copy(&pSpectCh[i], &temp, sizeof(*pSpectCh));
+			key[j].idx = j;
+			j = k;
 		}
+		qdf_mem_copy(&pSpectCh[j], &temp, sizeof(*pSpectCh));
+		key[j].idx = j;
 	}
 }
 
@@ -2229,7 +2342,7 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 			   qdf_list_t *scan_list)
 {
 	/* DFS param object holding all the data req by the algo */
-	tSapChSelSpectInfo spect_info_obj = { NULL, 0 };
+	tSapChSelSpectInfo spect_info_obj = { NULL, 0, NULL };
 	tSapChSelSpectInfo *spect_info = &spect_info_obj;
 	uint8_t best_ch_num = SAP_CHANNEL_NOT_SELECTED;
 	uint32_t best_ch_weight = SAP_ACS_WEIGHT_MAX;
@@ -2240,23 +2353,29 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	uint32_t operating_band = 0;
 	struct mac_context *mac_ctx;
 	uint32_t best_chan_freq = 0;
+	/* Phase timestamps in us: start, init, weight, avoid IE, sort */
+	uint64_t ts[5];
 
 	mac_ctx = MAC_CONTEXT(mac_handle);
 
+	ts[0] = qdf_get_monotonic_boottime();
 	/* Initialize the structure pointed by spect_info */
 	if (sap_chan_sel_init(mac_handle, spect_info, sap_ctx) != true) {
 		QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_ERROR,
 			  FL("Ch Select initialization failed"));
 		return SAP_CHANNEL_NOT_SELECTED;
 	}
+	ts[1] = qdf_get_monotonic_boottime();
 
 	/* Compute the weight of the entire spectrum in the operating band */
 	sap_compute_spect_weight(spect_info, mac_handle, scan_list, sap_ctx);
+	ts[2] = qdf_get_monotonic_boottime();
 
 #ifdef FEATURE_AP_MCC_CH_AVOIDANCE
 	/* process avoid channel IE to collect all channels to avoid */
 	sap_process_avoid_ie(mac_handle, sap_ctx, scan_list, spect_info);
 #endif /* FEATURE_AP_MCC_CH_AVOIDANCE */
+	ts[3] = qdf_get_monotonic_boottime();
 
 	wlan_reg_read_current_country(mac_ctx->psoc, country);
 	wlan_reg_get_domain_from_country_code(&domain, country, SOURCE_DRIVER);
@@ -2266,6 +2385,7 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	/* Sort the ch lst as per the computed weights, lesser weight first. */
 	sap_sort_chl_weight_all(mac_ctx, sap_ctx, spect_info, operating_band,
 				domain);
+	ts[4] = qdf_get_monotonic_boottime();
 
 	/*Loop till get the best channel in the given range */
 	for (count = 0; count < spect_info->numSpectChans; count++) {
@@ -2388,6 +2508,11 @@ uint32_t sap_select_channel(mac_handle_t mac_handle,
 	sap_ctx->sec_ch_freq = sap_ctx->acs_cfg->ht_sec_ch_freq;
 
 sap_ch_sel_end:
+	sap_debug("ACS %u chans us: init %llu weight %llu avoid %llu sort %llu select %llu",
+		  spect_info->numSpectChans, ts[1] - ts[0], ts[2] - ts[1],
+		  ts[3] - ts[2], ts[4] - ts[3],
+		  qdf_get_monotonic_boottime() - ts[4]);
+
 	/* Free all the allocated memory */
 	sap_chan_sel_exit(spect_info);
 
@@ -112,6 +112,18 @@ typedef struct {
 	bool weight_calc_done;
 } tSapSpectChInfo;              /* tDfsSpectChInfo; */
 
+/**
+ * struct sap_ch_rank_key - sort key of a channel in the spectrum
+ * @weight: weight of the channel
+ * @bss_count: number of BSSes found on the channel
+ * @idx: index of the channel in the spectrum array
+ */
+struct sap_ch_rank_key {
+	uint32_t weight;
+	uint16_t bss_count;
+	uint8_t idx;
+};
+
 /**
  * Structure holding all the information required to make a
  * decision for the best operating channel based on dfs formula
@@ -120,6 +132,7 @@ typedef struct {
 typedef struct {
 	tSapSpectChInfo *pSpectCh;      /* tDfsSpectChInfo *pSpectCh;  // Ptr to the channels in the entire spectrum band */
 	uint8_t numSpectChans;  /* Total num of channels in the spectrum */
+	struct sap_ch_rank_key *rank_key;       /* Scratch keys for ranking */
 } tSapChSelSpectInfo;           /* tDfsChSelParams; */
 
 #endif /* if !defined __SAP_CH_SELECT_H */
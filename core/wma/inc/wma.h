@@ -423,6 +423,23 @@ enum wma_rx_exec_ctx {
 	WMA_RX_SERIALIZER_CTX = WMI_RX_SERIALIZER_CTX,
 };
 
+/**
+ * struct wma_hi_prio_event_stats - high priority WMI event statistics
+ * @processed: events run in the MC thread
+ * @flushed: events dropped by a flush of the MC thread queues or at close
+ * @post_fail: events that could not be copied or handed over to the MC
+ *   thread
+ * @total_dwell_us: total time events waited for the MC thread, in us
+ * @max_dwell_us: longest time an event waited for the MC thread, in us
+ */
+struct wma_hi_prio_event_stats {
+	uint32_t processed;
+	uint32_t flushed;
+	uint32_t post_fail;
+	uint64_t total_dwell_us;
+	uint64_t max_dwell_us;
+};
+
 /**
  * struct beacon_info - structure to store beacon template
  * @buf: skb ptr
@@ -816,6 +833,10 @@ struct wma_wlm_stats_data {
  * @pdev: physical device global object
  * @target_suspend: target suspend event
  * @recovery_event: wma FW recovery event
+ * @hi_prio_stats: high priority WMI event statistics
+ * @hi_prio_event_list: high priority WMI events waiting for the MC thread,
+ *   oldest first
+ * @hi_prio_event_lock: lock for @hi_prio_event_list
  * @max_station: max stations
  * @max_bssid: max bssid
  * @myaddr: current mac address
@@ -943,6 +964,9 @@ typedef struct {
 	qdf_event_t target_suspend;
 	qdf_event_t runtime_suspend;
 	qdf_event_t recovery_event;
+	struct wma_hi_prio_event_stats hi_prio_stats;
+	qdf_list_t hi_prio_event_list;
+	qdf_spinlock_t hi_prio_event_lock;
 	uint16_t max_station;
 	uint16_t max_bssid;
 	uint8_t myaddr[QDF_MAC_ADDR_SIZE];
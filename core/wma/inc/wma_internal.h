@@ -69,6 +69,7 @@
 
 #define MAX_ENTRY_HOLD_REQ_QUEUE 2
 #define MAX_ENTRY_VDEV_RESP_QUEUE 10
+#define WMA_HI_PRIO_EVENT_LIST_SIZE 64
 
 /**
  * struct index_data_rate_type - non vht data rate type
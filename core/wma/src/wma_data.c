@@ -80,214 +80,7 @@
 #include <wlan_crypto_global_api.h>
 #include <wlan_mlme_main.h>
 #include "wlan_pkt_capture_ucfg_api.h"
-
-struct wma_search_rate {
-	int32_t rate;
-	uint8_t flag;
-};
-
-#define WMA_MAX_OFDM_CCK_RATE_TBL_SIZE 12
-/* In ofdm_cck_rate_tbl->flag, if bit 7 is 1 it's CCK, otherwise it ofdm.
- * Lower bit carries the ofdm/cck index for encoding the rate
- */
-static struct wma_search_rate ofdm_cck_rate_tbl[WMA_MAX_OFDM_CCK_RATE_TBL_SIZE] = {
-	{540, 4},               /* 4: OFDM 54 Mbps */
-	{480, 0},               /* 0: OFDM 48 Mbps */
-	{360, 5},               /* 5: OFDM 36 Mbps */
-	{240, 1},               /* 1: OFDM 24 Mbps */
-	{180, 6},               /* 6: OFDM 18 Mbps */
-	{120, 2},               /* 2: OFDM 12 Mbps */
-	{110, (1 << 7)},        /* 0: CCK 11 Mbps Long */
-	{90, 7},                /* 7: OFDM 9 Mbps  */
-	{60, 3},                /* 3: OFDM 6 Mbps  */
-	{55, ((1 << 7) | 1)},   /* 1: CCK 5.5 Mbps Long */
-	{20, ((1 << 7) | 2)},   /* 2: CCK 2 Mbps Long   */
-	{10, ((1 << 7) | 3)} /* 3: CCK 1 Mbps Long   */
-};
-
-#define WMA_MAX_VHT20_RATE_TBL_SIZE 9
-/* In vht20_400ns_rate_tbl flag carries the mcs index for encoding the rate */
-static struct wma_search_rate vht20_400ns_rate_tbl[WMA_MAX_VHT20_RATE_TBL_SIZE] = {
-	{867, 8},               /* MCS8 1SS short GI */
-	{722, 7},               /* MCS7 1SS short GI */
-	{650, 6},               /* MCS6 1SS short GI */
-	{578, 5},               /* MCS5 1SS short GI */
-	{433, 4},               /* MCS4 1SS short GI */
-	{289, 3},               /* MCS3 1SS short GI */
-	{217, 2},               /* MCS2 1SS short GI */
-	{144, 1},               /* MCS1 1SS short GI */
-	{72, 0} /* MCS0 1SS short GI */
-};
-
-/* In vht20_800ns_rate_tbl flag carries the mcs index for encoding the rate */
-static struct wma_search_rate vht20_800ns_rate_tbl[WMA_MAX_VHT20_RATE_TBL_SIZE] = {
-	{780, 8},               /* MCS8 1SS long GI */
-	{650, 7},               /* MCS7 1SS long GI */
-	{585, 6},               /* MCS6 1SS long GI */
-	{520, 5},               /* MCS5 1SS long GI */
-	{390, 4},               /* MCS4 1SS long GI */
-	{260, 3},               /* MCS3 1SS long GI */
-	{195, 2},               /* MCS2 1SS long GI */
-	{130, 1},               /* MCS1 1SS long GI */
-	{65, 0} /* MCS0 1SS long GI */
-};
-
-#define WMA_MAX_VHT40_RATE_TBL_SIZE 10
-/* In vht40_400ns_rate_tbl flag carries the mcs index for encoding the rate */
-static struct wma_search_rate vht40_400ns_rate_tbl[WMA_MAX_VHT40_RATE_TBL_SIZE] = {
-	{2000, 9},              /* MCS9 1SS short GI */
-	{1800, 8},              /* MCS8 1SS short GI */
-	{1500, 7},              /* MCS7 1SS short GI */
-	{1350, 6},              /* MCS6 1SS short GI */
-	{1200, 5},              /* MCS5 1SS short GI */
-	{900, 4},               /* MCS4 1SS short GI */
-	{600, 3},               /* MCS3 1SS short GI */
-	{450, 2},               /* MCS2 1SS short GI */
-	{300, 1},               /* MCS1 1SS short GI */
-	{150, 0},               /* MCS0 1SS short GI */
-};
-
-static struct wma_search_rate vht40_800ns_rate_tbl[WMA_MAX_VHT40_RATE_TBL_SIZE] = {
-	{1800, 9},              /* MCS9 1SS long GI */
-	{1620, 8},              /* MCS8 1SS long GI */
-	{1350, 7},              /* MCS7 1SS long GI */
-	{1215, 6},              /* MCS6 1SS long GI */
-	{1080, 5},              /* MCS5 1SS long GI */
-	{810, 4},               /* MCS4 1SS long GI */
-	{540, 3},               /* MCS3 1SS long GI */
-	{405, 2},               /* MCS2 1SS long GI */
-	{270, 1},               /* MCS1 1SS long GI */
-	{135, 0} /* MCS0 1SS long GI */
-};
-
-#define WMA_MAX_VHT80_RATE_TBL_SIZE 10
-static struct wma_search_rate vht80_400ns_rate_tbl[WMA_MAX_VHT80_RATE_TBL_SIZE] = {
-	{4333, 9},              /* MCS9 1SS short GI */
-	{3900, 8},              /* MCS8 1SS short GI */
-	{3250, 7},              /* MCS7 1SS short GI */
-	{2925, 6},              /* MCS6 1SS short GI */
-	{2600, 5},              /* MCS5 1SS short GI */
-	{1950, 4},              /* MCS4 1SS short GI */
-	{1300, 3},              /* MCS3 1SS short GI */
-	{975, 2},               /* MCS2 1SS short GI */
-	{650, 1},               /* MCS1 1SS short GI */
-	{325, 0} /* MCS0 1SS short GI */
-};
-
-static struct wma_search_rate vht80_800ns_rate_tbl[WMA_MAX_VHT80_RATE_TBL_SIZE] = {
-	{3900, 9},              /* MCS9 1SS long GI */
-	{3510, 8},              /* MCS8 1SS long GI */
-	{2925, 7},              /* MCS7 1SS long GI */
-	{2633, 6},              /* MCS6 1SS long GI */
-	{2340, 5},              /* MCS5 1SS long GI */
-	{1755, 4},              /* MCS4 1SS long GI */
-	{1170, 3},              /* MCS3 1SS long GI */
-	{878, 2},               /* MCS2 1SS long GI */
-	{585, 1},               /* MCS1 1SS long GI */
-	{293, 0} /* MCS0 1SS long GI */
-};
-
-#define WMA_MAX_HT20_RATE_TBL_SIZE 8
-static struct wma_search_rate ht20_400ns_rate_tbl[WMA_MAX_HT20_RATE_TBL_SIZE] = {
-	{722, 7},               /* MCS7 1SS short GI */
-	{650, 6},               /* MCS6 1SS short GI */
-	{578, 5},               /* MCS5 1SS short GI */
-	{433, 4},               /* MCS4 1SS short GI */
-	{289, 3},               /* MCS3 1SS short GI */
-	{217, 2},               /* MCS2 1SS short GI */
-	{144, 1},               /* MCS1 1SS short GI */
-	{72, 0} /* MCS0 1SS short GI */
-};
-
-static struct wma_search_rate ht20_800ns_rate_tbl[WMA_MAX_HT20_RATE_TBL_SIZE] = {
-	{650, 7},               /* MCS7 1SS long GI */
-	{585, 6},               /* MCS6 1SS long GI */
-	{520, 5},               /* MCS5 1SS long GI */
-	{390, 4},               /* MCS4 1SS long GI */
-	{260, 3},               /* MCS3 1SS long GI */
-	{195, 2},               /* MCS2 1SS long GI */
-	{130, 1},               /* MCS1 1SS long GI */
-	{65, 0} /* MCS0 1SS long GI */
-};
-
-#define WMA_MAX_HT40_RATE_TBL_SIZE 8
-static struct wma_search_rate ht40_400ns_rate_tbl[WMA_MAX_HT40_RATE_TBL_SIZE] = {
-	{1500, 7},              /* MCS7 1SS short GI */
-	{1350, 6},              /* MCS6 1SS short GI */
-	{1200, 5},              /* MCS5 1SS short GI */
-	{900, 4},               /* MCS4 1SS short GI */
-	{600, 3},               /* MCS3 1SS short GI */
-	{450, 2},               /* MCS2 1SS short GI */
-	{300, 1},               /* MCS1 1SS short GI */
-	{150, 0} /* MCS0 1SS short GI */
-};
-
-static struct wma_search_rate ht40_800ns_rate_tbl[WMA_MAX_HT40_RATE_TBL_SIZE] = {
-	{1350, 7},              /* MCS7 1SS long GI */
-	{1215, 6},              /* MCS6 1SS long GI */
-	{1080, 5},              /* MCS5 1SS long GI */
-	{810, 4},               /* MCS4 1SS long GI */
-	{540, 3},               /* MCS3 1SS long GI */
-	{405, 2},               /* MCS2 1SS long GI */
-	{270, 1},               /* MCS1 1SS long GI */
-	{135, 0} /* MCS0 1SS long GI */
-};
-
-/**
- * wma_bin_search_rate() - binary search function to find rate
- * @tbl: rate table
- * @tbl_size: table size
- * @mbpsx10_rate: return mbps rate
- * @ret_flag: return flag
- *
- * Return: none
- */
-static void wma_bin_search_rate(struct wma_search_rate *tbl, int32_t tbl_size,
-				int32_t *mbpsx10_rate, uint8_t *ret_flag)
-{
-	int32_t upper, lower, mid;
-
-	/* the table is descenting. index holds the largest value and the
-	 * bottom index holds the smallest value
-	 */
-
-	upper = 0;              /* index 0 */
-	lower = tbl_size - 1;   /* last index */
-
-	if (*mbpsx10_rate >= tbl[upper].rate) {
-		/* use the largest rate */
-		*mbpsx10_rate = tbl[upper].rate;
-		*ret_flag = tbl[upper].flag;
-		return;
-	} else if (*mbpsx10_rate <= tbl[lower].rate) {
-		/* use the smallest rate */
-		*mbpsx10_rate = tbl[lower].rate;
-		*ret_flag = tbl[lower].flag;
-		return;
-	}
-	/* now we do binery search to get the floor value */
-	while (lower - upper > 1) {
-		mid = (upper + lower) >> 1;
-		if (*mbpsx10_rate == tbl[mid].rate) {
-			/* found the exact match */
-			*mbpsx10_rate = tbl[mid].rate;
-			*ret_flag = tbl[mid].flag;
-			return;
-		}
-		/* not found. if mid's rate is larger than input move
-		 * upper to mid. If mid's rate is larger than input
-		 * move lower to mid.
-		 */
-		if (*mbpsx10_rate > tbl[mid].rate)
-			lower = mid;
-		else
-			upper = mid;
-	}
-	/* after the bin search the index is the ceiling of rate */
-	*mbpsx10_rate = tbl[upper].rate;
-	*ret_flag = tbl[upper].flag;
-	return;
-}
+#include "wma_mc_rate.h"
 
 /**
  * wma_fill_ofdm_cck_mcast_rate() - fill ofdm cck mcast rate
@@ -302,8 +95,8 @@ static QDF_STATUS wma_fill_ofdm_cck_mcast_rate(int32_t mbpsx10_rate,
 {
 	uint8_t idx = 0;
 
-	wma_bin_search_rate(ofdm_cck_rate_tbl, WMA_MAX_OFDM_CCK_RATE_TBL_SIZE,
-			    &mbpsx10_rate, &idx);
+	wma_mc_rate_tbl_lookup(wma_mc_legacy_rate_tbl_get(), mbpsx10_rate,
+			       &idx);
 
 	/* if bit 7 is set it uses CCK */
 	if (idx & 0x80)
@@ -314,272 +107,10 @@ static QDF_STATUS wma_fill_ofdm_cck_mcast_rate(int32_t mbpsx10_rate,
 }
 
 /**
- * wma_set_ht_vht_mcast_rate() - set ht/vht mcast rate
- * @shortgi: short gaurd interval
- * @mbpsx10_rate: mbps rates
- * @sgi_idx: shortgi index
- * @sgi_rate: shortgi rate
- * @lgi_idx: longgi index
- * @lgi_rate: longgi rate
- * @premable: preamble
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: none
- */
-static void wma_set_ht_vht_mcast_rate(uint32_t shortgi, int32_t mbpsx10_rate,
-				      uint8_t sgi_idx, int32_t sgi_rate,
-				      uint8_t lgi_idx, int32_t lgi_rate,
-				      uint8_t premable, uint8_t *rate,
-				      int32_t *streaming_rate)
-{
-	if (shortgi == 0) {
-		*rate |= (premable << 6) | (lgi_idx & 0xF);
-		*streaming_rate = lgi_rate;
-	} else {
-		*rate |= (premable << 6) | (sgi_idx & 0xF);
-		*streaming_rate = sgi_rate;
-	}
-}
-
-/**
- * wma_fill_ht20_mcast_rate() - fill ht20 mcast rate
- * @shortgi: short gaurd interval
- * @mbpsx10_rate: mbps rates
- * @nss: nss
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: QDF status
- */
-static QDF_STATUS wma_fill_ht20_mcast_rate(uint32_t shortgi,
-					   int32_t mbpsx10_rate, uint8_t nss,
-					   uint8_t *rate,
-					   int32_t *streaming_rate)
-{
-	uint8_t sgi_idx = 0, lgi_idx = 0;
-	int32_t sgi_rate, lgi_rate;
-
-	if (nss == 1)
-		mbpsx10_rate = mbpsx10_rate >> 1;
-
-	sgi_rate = mbpsx10_rate;
-	lgi_rate = mbpsx10_rate;
-	if (shortgi)
-		wma_bin_search_rate(ht20_400ns_rate_tbl,
-				    WMA_MAX_HT20_RATE_TBL_SIZE, &sgi_rate,
-				    &sgi_idx);
-	else
-		wma_bin_search_rate(ht20_800ns_rate_tbl,
-				    WMA_MAX_HT20_RATE_TBL_SIZE, &lgi_rate,
-				    &lgi_idx);
-
-	wma_set_ht_vht_mcast_rate(shortgi, mbpsx10_rate, sgi_idx, sgi_rate,
-				  lgi_idx, lgi_rate, 2, rate, streaming_rate);
-	if (nss == 1)
-		*streaming_rate = *streaming_rate << 1;
-	return QDF_STATUS_SUCCESS;
-}
-
-/**
- * wma_fill_ht40_mcast_rate() - fill ht40 mcast rate
- * @shortgi: short gaurd interval
- * @mbpsx10_rate: mbps rates
- * @nss: nss
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: QDF status
- */
-static QDF_STATUS wma_fill_ht40_mcast_rate(uint32_t shortgi,
-					   int32_t mbpsx10_rate, uint8_t nss,
-					   uint8_t *rate,
-					   int32_t *streaming_rate)
-{
-	uint8_t sgi_idx = 0, lgi_idx = 0;
-	int32_t sgi_rate, lgi_rate;
-
-	/* for 2x2 divide the rate by 2 */
-	if (nss == 1)
-		mbpsx10_rate = mbpsx10_rate >> 1;
-
-	sgi_rate = mbpsx10_rate;
-	lgi_rate = mbpsx10_rate;
-	if (shortgi)
-		wma_bin_search_rate(ht40_400ns_rate_tbl,
-				    WMA_MAX_HT40_RATE_TBL_SIZE, &sgi_rate,
-				    &sgi_idx);
-	else
-		wma_bin_search_rate(ht40_800ns_rate_tbl,
-				    WMA_MAX_HT40_RATE_TBL_SIZE, &lgi_rate,
-				    &lgi_idx);
-
-	wma_set_ht_vht_mcast_rate(shortgi, mbpsx10_rate, sgi_idx, sgi_rate,
-				  lgi_idx, lgi_rate, 2, rate, streaming_rate);
-
-	return QDF_STATUS_SUCCESS;
-}
-
-/**
- * wma_fill_vht20_mcast_rate() - fill vht20 mcast rate
- * @shortgi: short gaurd interval
- * @mbpsx10_rate: mbps rates
- * @nss: nss
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: QDF status
- */
-static QDF_STATUS wma_fill_vht20_mcast_rate(uint32_t shortgi,
-					    int32_t mbpsx10_rate, uint8_t nss,
-					    uint8_t *rate,
-					    int32_t *streaming_rate)
-{
-	uint8_t sgi_idx = 0, lgi_idx = 0;
-	int32_t sgi_rate, lgi_rate;
-
-	/* for 2x2 divide the rate by 2 */
-	if (nss == 1)
-		mbpsx10_rate = mbpsx10_rate >> 1;
-
-	sgi_rate = mbpsx10_rate;
-	lgi_rate = mbpsx10_rate;
-	if (shortgi)
-		wma_bin_search_rate(vht20_400ns_rate_tbl,
-				    WMA_MAX_VHT20_RATE_TBL_SIZE, &sgi_rate,
-				    &sgi_idx);
-	else
-		wma_bin_search_rate(vht20_800ns_rate_tbl,
-				    WMA_MAX_VHT20_RATE_TBL_SIZE, &lgi_rate,
-				    &lgi_idx);
-
-	wma_set_ht_vht_mcast_rate(shortgi, mbpsx10_rate, sgi_idx, sgi_rate,
-				  lgi_idx, lgi_rate, 3, rate, streaming_rate);
-	if (nss == 1)
-		*streaming_rate = *streaming_rate << 1;
-	return QDF_STATUS_SUCCESS;
-}
-
-/**
- * wma_fill_vht40_mcast_rate() - fill vht40 mcast rate
- * @shortgi: short gaurd interval
- * @mbpsx10_rate: mbps rates
- * @nss: nss
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: QDF status
- */
-static QDF_STATUS wma_fill_vht40_mcast_rate(uint32_t shortgi,
-					    int32_t mbpsx10_rate, uint8_t nss,
-					    uint8_t *rate,
-					    int32_t *streaming_rate)
-{
-	uint8_t sgi_idx = 0, lgi_idx = 0;
-	int32_t sgi_rate, lgi_rate;
-
-	/* for 2x2 divide the rate by 2 */
-	if (nss == 1)
-		mbpsx10_rate = mbpsx10_rate >> 1;
-
-	sgi_rate = mbpsx10_rate;
-	lgi_rate = mbpsx10_rate;
-	if (shortgi)
-		wma_bin_search_rate(vht40_400ns_rate_tbl,
-				    WMA_MAX_VHT40_RATE_TBL_SIZE, &sgi_rate,
-				    &sgi_idx);
-	else
-		wma_bin_search_rate(vht40_800ns_rate_tbl,
-				    WMA_MAX_VHT40_RATE_TBL_SIZE, &lgi_rate,
-				    &lgi_idx);
-
-	wma_set_ht_vht_mcast_rate(shortgi, mbpsx10_rate,
-				  sgi_idx, sgi_rate, lgi_idx, lgi_rate,
-				  3, rate, streaming_rate);
-	if (nss == 1)
-		*streaming_rate = *streaming_rate << 1;
-	return QDF_STATUS_SUCCESS;
-}
-
-/**
- * wma_fill_vht80_mcast_rate() - fill vht80 mcast rate
- * @shortgi: short gaurd interval
- * @mbpsx10_rate: mbps rates
- * @nss: nss
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: QDF status
- */
-static QDF_STATUS wma_fill_vht80_mcast_rate(uint32_t shortgi,
-					    int32_t mbpsx10_rate, uint8_t nss,
-					    uint8_t *rate,
-					    int32_t *streaming_rate)
-{
-	uint8_t sgi_idx = 0, lgi_idx = 0;
-	int32_t sgi_rate, lgi_rate;
-
-	/* for 2x2 divide the rate by 2 */
-	if (nss == 1)
-		mbpsx10_rate = mbpsx10_rate >> 1;
-
-	sgi_rate = mbpsx10_rate;
-	lgi_rate = mbpsx10_rate;
-	if (shortgi)
-		wma_bin_search_rate(vht80_400ns_rate_tbl,
-				    WMA_MAX_VHT80_RATE_TBL_SIZE, &sgi_rate,
-				    &sgi_idx);
-	else
-		wma_bin_search_rate(vht80_800ns_rate_tbl,
-				    WMA_MAX_VHT80_RATE_TBL_SIZE, &lgi_rate,
-				    &lgi_idx);
-
-	wma_set_ht_vht_mcast_rate(shortgi, mbpsx10_rate, sgi_idx, sgi_rate,
-				  lgi_idx, lgi_rate, 3, rate, streaming_rate);
-	if (nss == 1)
-		*streaming_rate = *streaming_rate << 1;
-	return QDF_STATUS_SUCCESS;
-}
-
-/**
- * wma_fill_ht_mcast_rate() - fill ht mcast rate
- * @shortgi: short gaurd interval
- * @chwidth: channel width
- * @chanmode: channel mode
- * @mhz: frequency
- * @mbpsx10_rate: mbps rates
- * @nss: nss
- * @rate: rate
- * @streaming_rate: streaming rate
- *
- * Return: QDF status
- */
-static QDF_STATUS wma_fill_ht_mcast_rate(uint32_t shortgi,
-					 uint32_t chwidth, int32_t mbpsx10_rate,
-					 uint8_t nss, uint8_t *rate,
-					 int32_t *streaming_rate)
-{
-	int32_t ret = 0;
-
-	*streaming_rate = 0;
-	if (chwidth == 0)
-		ret = wma_fill_ht20_mcast_rate(shortgi, mbpsx10_rate,
-					       nss, rate, streaming_rate);
-	else if (chwidth == 1)
-		ret = wma_fill_ht40_mcast_rate(shortgi, mbpsx10_rate,
-					       nss, rate, streaming_rate);
-	else
-		WMA_LOGE("%s: Error, Invalid chwidth enum %d", __func__,
-			 chwidth);
-	return (*streaming_rate != 0) ? QDF_STATUS_SUCCESS : QDF_STATUS_E_INVAL;
-}
-
-/**
- * wma_fill_vht_mcast_rate() - fill vht mcast rate
+ * wma_fill_ht_vht_mcast_rate() - fill ht/vht mcast rate
+ * @phy: WMA_MC_PHY_HT or WMA_MC_PHY_VHT
  * @shortgi: short gaurd interval
  * @chwidth: channel width
- * @chanmode: channel mode
- * @mhz: frequency
  * @mbpsx10_rate: mbps rates
  * @nss: nss
  * @rate: rate
@@ -587,28 +118,28 @@ static QDF_STATUS wma_fill_ht_mcast_rate(uint32_t shortgi,
  *
  * Return: QDF status
  */
-static QDF_STATUS wma_fill_vht_mcast_rate(uint32_t shortgi,
-					  uint32_t chwidth,
-					  int32_t mbpsx10_rate, uint8_t nss,
-					  uint8_t *rate,
-					  int32_t *streaming_rate)
+static QDF_STATUS wma_fill_ht_vht_mcast_rate(enum wma_mc_phy phy,
+					     uint32_t shortgi,
+					     uint32_t chwidth,
+					     int32_t mbpsx10_rate, uint8_t nss,
+					     uint8_t *rate,
+					     int32_t *streaming_rate)
 {
-	int32_t ret = 0;
+	uint8_t preamble = (phy == WMA_MC_PHY_HT) ? 2 : 3;
+	uint8_t mcs = 0;
+
+	*streaming_rate = wma_mc_rate_lookup(phy, chwidth,
+					     shortgi ? WMA_MC_GI_400NS :
+						       WMA_MC_GI_800NS,
+					     nss, mbpsx10_rate, &mcs);
+	if (!*streaming_rate) {
+		WMA_LOGE("%s: chwidth enum %d not supported for phy %d",
+			 __func__, chwidth, phy);
+		return QDF_STATUS_E_INVAL;
+	}
 
-	*streaming_rate = 0;
-	if (chwidth == 0)
-		ret = wma_fill_vht20_mcast_rate(shortgi, mbpsx10_rate, nss,
-						rate, streaming_rate);
-	else if (chwidth == 1)
-		ret = wma_fill_vht40_mcast_rate(shortgi, mbpsx10_rate, nss,
-						rate, streaming_rate);
-	else if (chwidth == 2)
-		ret = wma_fill_vht80_mcast_rate(shortgi, mbpsx10_rate, nss,
-						rate, streaming_rate);
-	else
-		WMA_LOGE("%s: chwidth enum %d not supported",
-			 __func__, chwidth);
-	return (*streaming_rate != 0) ? QDF_STATUS_SUCCESS : QDF_STATUS_E_INVAL;
+	*rate |= (preamble << 6) | (mcs & 0xF);
+	return QDF_STATUS_SUCCESS;
 }
 
 #define WMA_MCAST_1X1_CUT_OFF_RATE 2000
@@ -667,9 +198,9 @@ static QDF_STATUS wma_encode_mc_rate(uint32_t shortgi, uint32_t chwidth,
 		int32_t stream_rate_vht = 0;
 		int32_t stream_rate = 0;
 
-		ret = wma_fill_ht_mcast_rate(shortgi, chwidth, mbpsx10_rate,
-					     nss, &rate_ht,
-					     &stream_rate_ht);
+		ret = wma_fill_ht_vht_mcast_rate(WMA_MC_PHY_HT, shortgi,
+						 chwidth, mbpsx10_rate, nss,
+						 &rate_ht, &stream_rate_ht);
 		if (ret != QDF_STATUS_SUCCESS)
 			stream_rate_ht = 0;
 		if (mhz < WMA_2_4_GHZ_MAX_FREQ) {
@@ -679,9 +210,9 @@ static QDF_STATUS wma_encode_mc_rate(uint32_t shortgi, uint32_t chwidth,
 			goto ht_vht_done;
 		}
 		/* capable doing 11AC mcast so that search vht tables */
-		ret = wma_fill_vht_mcast_rate(shortgi, chwidth, mbpsx10_rate,
-					      nss, &rate_vht,
-					      &stream_rate_vht);
+		ret = wma_fill_ht_vht_mcast_rate(WMA_MC_PHY_VHT, shortgi,
+						 chwidth, mbpsx10_rate, nss,
+						 &rate_vht, &stream_rate_vht);
 		if (ret != QDF_STATUS_SUCCESS) {
 			if (stream_rate_ht != 0)
 				ret = QDF_STATUS_SUCCESS;
@@ -1849,6 +1849,14 @@ static void wma_state_info_dump(char **buf_ptr, uint16_t *size)
 		wlan_objmgr_vdev_release_ref(vdev, WLAN_LEGACY_WMA_ID);
 	}
 
+	len += qdf_scnprintf(buf + len, *size - len,
+			     "\nhi prio events %u flushed %u post_fail %u dwell total %llu max %llu us",
+			     wma->hi_prio_stats.processed,
+			     wma->hi_prio_stats.flushed,
+			     wma->hi_prio_stats.post_fail,
+			     wma->hi_prio_stats.total_dwell_us,
+			     wma->hi_prio_stats.max_dwell_us);
+
 	*size -= len;
 	*buf_ptr += len;
 }
@@ -2814,6 +2822,237 @@ wma_register_pkt_capture_callbacks(tp_wma_handle wma_handle)
 }
 #endif
 
+/**
+ * struct wma_hi_prio_event - WMI event handed over to the MC thread
+ * @node: entry in wma->hi_prio_event_list
+ * @handler: WMI event handler to run in the MC thread
+ * @event: copy of the event, owned by this structure
+ * @len: length of @event
+ * @rx_us: time the event was handed over, in us
+ */
+struct wma_hi_prio_event {
+	qdf_list_node_t node;
+	int (*handler)(void *scn, uint8_t *event, uint32_t len);
+	uint8_t *event;
+	uint32_t len;
+	uint64_t rx_us;
+};
+
+/**
+ * wma_hi_prio_event_dequeue() - remove the oldest high priority event
+ * @wma: wma handle
+ *
+ * High priority messages are posted to the head of the MC thread queue,
+ * so the scheduler runs them newest first. Each message therefore runs
+ * the oldest event in wma->hi_prio_event_list rather than the event it
+ * was posted for, which keeps the events in arrival order.
+ *
+ * Return: oldest high priority event, or NULL if there is none
+ */
+static struct wma_hi_prio_event *
+wma_hi_prio_event_dequeue(tp_wma_handle wma)
+{
+	qdf_list_node_t *node = NULL;
+	QDF_STATUS status;
+
+	qdf_spin_lock_bh(&wma->hi_prio_event_lock);
+	status = qdf_list_remove_front(&wma->hi_prio_event_list, &node);
+	qdf_spin_unlock_bh(&wma->hi_prio_event_lock);
+	if (QDF_IS_STATUS_ERROR(status))
+		return NULL;
+
+	return qdf_container_of(node, struct wma_hi_prio_event, node);
+}
+
+static QDF_STATUS wma_hi_prio_event_process(struct scheduler_msg *msg)
+{
+	tp_wma_handle wma = cds_get_context(QDF_MODULE_ID_WMA);
+	struct wma_hi_prio_event *hp_event;
+	uint64_t dwell_us;
+
+	if (!wma)
+		return QDF_STATUS_E_INVAL;
+
+	hp_event = wma_hi_prio_event_dequeue(wma);
+	if (!hp_event)
+		return QDF_STATUS_E_EMPTY;
+
+	dwell_us = qdf_get_monotonic_boottime() - hp_event->rx_us;
+	wma->hi_prio_stats.processed++;
+	wma->hi_prio_stats.total_dwell_us += dwell_us;
+	if (dwell_us > wma->hi_prio_stats.max_dwell_us)
+		wma->hi_prio_stats.max_dwell_us = dwell_us;
+
+	hp_event->handler(wma, hp_event->event, hp_event->len);
+	qdf_mem_free(hp_event);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static QDF_STATUS wma_hi_prio_event_flush(struct scheduler_msg *msg)
+{
+	tp_wma_handle wma = cds_get_context(QDF_MODULE_ID_WMA);
+	struct wma_hi_prio_event *hp_event;
+
+	if (!wma)
+		return QDF_STATUS_E_INVAL;
+
+	hp_event = wma_hi_prio_event_dequeue(wma);
+	if (!hp_event)
+		return QDF_STATUS_E_EMPTY;
+
+	wma->hi_prio_stats.flushed++;
+	qdf_mem_free(hp_event);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * wma_hi_prio_event_cleanup() - drop the high priority events left queued
+ * @wma: wma handle
+ *
+ * Return: None
+ */
+static void wma_hi_prio_event_cleanup(tp_wma_handle wma)
+{
+	struct wma_hi_prio_event *hp_event;
+
+	while ((hp_event = wma_hi_prio_event_dequeue(wma))) {
+		wma->hi_prio_stats.flushed++;
+		qdf_mem_free(hp_event);
+	}
+}
+
+/**
+ * wma_hi_prio_event_post() - queue a copied WMI event ahead of the events
+ * queued to the MC thread
+ * @wma: wma handle
+ * @hp_event: event to queue, freed by this function on failure
+ *
+ * Only events whose handler does not depend on state that another message
+ * still queued to the MC thread would set up may use this, because they
+ * overtake every event registered with WMA_RX_SERIALIZER_CTX, including
+ * those for the same vdev. The WMI context is never blocked: @hp_event
+ * carries its own copy of the event.
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS wma_hi_prio_event_post(tp_wma_handle wma,
+					 struct wma_hi_prio_event *hp_event)
+{
+	struct scheduler_msg msg = {0};
+	qdf_list_node_t *node = NULL;
+	QDF_STATUS status;
+
+	hp_event->rx_us = qdf_get_monotonic_boottime();
+
+	qdf_spin_lock_bh(&wma->hi_prio_event_lock);
+	if (qdf_list_size(&wma->hi_prio_event_list) >=
+	    WMA_HI_PRIO_EVENT_LIST_SIZE)
+		status = QDF_STATUS_E_RESOURCES;
+	else
+		status = qdf_list_insert_back(&wma->hi_prio_event_list,
+					      &hp_event->node);
+	qdf_spin_unlock_bh(&wma->hi_prio_event_lock);
+	if (QDF_IS_STATUS_ERROR(status))
+		goto free_event;
+
+	msg.callback = wma_hi_prio_event_process;
+	msg.flush_callback = wma_hi_prio_event_flush;
+	status = scheduler_post_msg_by_priority(QDF_MODULE_ID_TARGET_IF,
+						&msg, true);
+	if (QDF_IS_STATUS_SUCCESS(status))
+		return status;
+
+	/*
+	 * Messages only ever dequeue the oldest event, so the event left
+	 * without a message is the newest one.
+	 */
+	qdf_spin_lock_bh(&wma->hi_prio_event_lock);
+	qdf_list_remove_back(&wma->hi_prio_event_list, &node);
+	qdf_spin_unlock_bh(&wma->hi_prio_event_lock);
+	hp_event = qdf_container_of(node, struct wma_hi_prio_event, node);
+
+free_event:
+	WMA_LOGE("%s: failed to post event, status %d", __func__, status);
+	wma->hi_prio_stats.post_fail++;
+	qdf_mem_free(hp_event);
+
+	return status;
+}
+
+/**
+ * struct wma_link_status_event - copy of a vdev rate stats event
+ * @param_buf: TLVs passed to wma_link_status_event_handler()
+ * @fixed_param: copy of the fixed param TLV
+ * @ht_info: copy of the ht info TLV array
+ */
+struct wma_link_status_event {
+	WMI_UPDATE_VDEV_RATE_STATS_EVENTID_param_tlvs param_buf;
+	wmi_vdev_rate_stats_event_fixed_param fixed_param;
+	wmi_vdev_rate_ht_info ht_info[];
+};
+
+/**
+ * wma_link_status_event_handler_hi_prio() - queue a vdev rate stats event
+ * ahead of the events queued to the MC thread
+ * @scn: wma handle
+ * @event: vdev rate stats event TLVs
+ * @len: length of @event
+ *
+ * The event answers a link status request that the MC thread has already
+ * stored in wma->interfaces before sending it to the firmware, so it does
+ * not depend on anything still queued to the MC thread. The TLVs point
+ * into a WMI buffer that is released when this function returns, so they
+ * are copied into a flat buffer first.
+ *
+ * Return: 0 on success, errno on failure
+ */
+static int wma_link_status_event_handler_hi_prio(void *scn, uint8_t *event,
+						 uint32_t len)
+{
+	tp_wma_handle wma = scn;
+	WMI_UPDATE_VDEV_RATE_STATS_EVENTID_param_tlvs *param_buf;
+	struct wma_hi_prio_event *hp_event;
+	struct wma_link_status_event *copy;
+	uint32_t num_ht_info, copy_len;
+
+	param_buf = (WMI_UPDATE_VDEV_RATE_STATS_EVENTID_param_tlvs *)event;
+	if (!param_buf || !param_buf->fixed_param || !param_buf->ht_info) {
+		WMA_LOGE("%s: Invalid stats event", __func__);
+		return -EINVAL;
+	}
+
+	num_ht_info = param_buf->num_ht_info;
+	if (num_ht_info > (WMI_SVC_MSG_MAX_SIZE -
+			   sizeof(*param_buf->fixed_param)) /
+			  sizeof(*param_buf->ht_info)) {
+		WMA_LOGE("%s: excess num_ht_info %u", __func__, num_ht_info);
+		return -EINVAL;
+	}
+
+	copy_len = sizeof(*copy) + num_ht_info * sizeof(copy->ht_info[0]);
+	hp_event = qdf_mem_malloc(sizeof(*hp_event) + copy_len);
+	if (!hp_event) {
+		wma->hi_prio_stats.post_fail++;
+		return -ENOMEM;
+	}
+
+	copy = (struct wma_link_status_event *)(hp_event + 1);
+	copy->fixed_param = *param_buf->fixed_param;
+	qdf_mem_copy(copy->ht_info, param_buf->ht_info,
+		     num_ht_info * sizeof(copy->ht_info[0]));
+	copy->param_buf.fixed_param = &copy->fixed_param;
+	copy->param_buf.ht_info = copy->ht_info;
+	copy->param_buf.num_ht_info = num_ht_info;
+
+	hp_event->handler = wma_link_status_event_handler;
+	hp_event->event = (uint8_t *)&copy->param_buf;
+	hp_event->len = copy_len;
+
+	return qdf_status_to_os_return(wma_hi_prio_event_post(wma, hp_event));
+}
+
 /**
  * wma_open() - Allocate wma context and initialize it.
  * @cds_context:  cds context
@@ -3094,6 +3333,9 @@ QDF_STATUS wma_open(struct wlan_objmgr_psoc *psoc,
 	qdf_list_create(&wma_handle->wma_hold_req_queue,
 		      MAX_ENTRY_HOLD_REQ_QUEUE);
 	qdf_spinlock_create(&wma_handle->wma_hold_req_q_lock);
+	qdf_list_create(&wma_handle->hi_prio_event_list,
+			WMA_HI_PRIO_EVENT_LIST_SIZE);
+	qdf_spinlock_create(&wma_handle->hi_prio_event_lock);
 	qdf_atomic_init(&wma_handle->is_wow_bus_suspended);
 
 	/* register for STA kickout function */
@@ -3161,8 +3403,8 @@ QDF_STATUS wma_open(struct wlan_objmgr_psoc *psoc,
 
 	wmi_unified_register_event_handler(wma_handle->wmi_handle,
 					   wmi_update_vdev_rate_stats_event_id,
-					   wma_link_status_event_handler,
-					   WMA_RX_SERIALIZER_CTX);
+					   wma_link_status_event_handler_hi_prio,
+					   WMA_RX_WORK_CTX);
 
 	wmi_unified_register_event_handler(wma_handle->wmi_handle,
 					   wmi_roam_scan_stats_event_id,
@@ -3231,6 +3473,12 @@ QDF_STATUS wma_open(struct wlan_objmgr_psoc *psoc,
 
 	WMA_LOGD("%s: Exit", __func__);
 
+	/*
+	 * The roam events stay in the serializer context: their handlers rely
+	 * on vdev and peer state set up by messages that may still be queued
+	 * to the MC thread, and the scheduler queue is not visible to WMA to
+	 * tell whether one is pending for the vdev.
+	 */
 #ifdef WLAN_FEATURE_ROAM_OFFLOAD
 	wmi_unified_register_event_handler(wma_handle->wmi_handle,
 					   wmi_roam_synch_event_id,
@@ -3386,6 +3634,9 @@ err_dbglog_init:
 	qdf_runtime_lock_deinit(&wma_handle->sap_prevent_runtime_pm_lock);
 	qdf_runtime_lock_deinit(&wma_handle->wmi_cmd_rsp_runtime_lock);
 	qdf_spinlock_destroy(&wma_handle->wma_hold_req_q_lock);
+	wma_hi_prio_event_cleanup(wma_handle);
+	qdf_spinlock_destroy(&wma_handle->hi_prio_event_lock);
+	qdf_list_destroy(&wma_handle->hi_prio_event_list);
 err_event_init:
 	wmi_unified_unregister_event_handler(wma_handle->wmi_handle,
 					     wmi_debug_print_event_id);
@@ -4434,6 +4685,9 @@ QDF_STATUS wma_close(void)
 	qdf_runtime_lock_deinit(&wma_handle->sap_prevent_runtime_pm_lock);
 	qdf_runtime_lock_deinit(&wma_handle->wmi_cmd_rsp_runtime_lock);
 	qdf_spinlock_destroy(&wma_handle->wma_hold_req_q_lock);
+	wma_hi_prio_event_cleanup(wma_handle);
+	qdf_spinlock_destroy(&wma_handle->hi_prio_event_lock);
+	qdf_list_destroy(&wma_handle->hi_prio_event_list);
 
 	if (wma_handle->pGetRssiReq) {
 		qdf_mem_free(wma_handle->pGetRssiReq);
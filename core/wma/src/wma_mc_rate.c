@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wma_mc_rate.c
+ *
+ * Multicast/broadcast data rate tables and lookup.
+ *
+ * The bucket index tables are derived from the rate tables: with buckets
+ * no wider than the gap between two neighbouring rates, a bucket holds at
+ * most one rate, so the entry of the bucket of the requested rate is the
+ * answer or the one right below it. Rates of the same MCS in different phy modes
+ * are kept as separate tables so that each bucket table matches its rate
+ * table one to one. The legacy table is bucketed by 0.4 Mbps because of
+ * the 5.5/6 Mbps pair, all others by 6.4 Mbps.
+ */
+
+#include "qdf_util.h"
+#include "wma_mc_rate.h"
+
+#define WMA_MC_LEGACY_SHIFT	2
+#define WMA_MC_SHIFT		6
+
+static const uint16_t wma_mc_legacy_rate[] = {
+	10, 20, 55, 60, 90, 110, 120, 180, 240, 360, 480, 540
+};
+
+/* bit 7 set is CCK, OFDM otherwise; low bits are the OFDM/CCK index */
+static const uint8_t wma_mc_legacy_code[] = {
+	0x83, 0x82, 0x81, 0x03, 0x07, 0x80, 0x02, 0x06, 0x01, 0x05, 0x00, 0x04
+};
+
+static const uint8_t wma_mc_legacy_idx[] = {
+	[0 ... 2] = 0, [3 ... 5] = 1, [6 ... 13] = 2, [14 ... 15] = 3,
+	[16 ... 22] = 4, [23 ... 27] = 5, [28 ... 30] = 6, [31 ... 45] = 7,
+	[46 ... 60] = 8, [61 ... 90] = 9, [91 ... 120] = 10, [121 ... 135] = 11
+};
+
+static const uint16_t wma_mc_ht20_400ns_rate[] = {
+	72, 144, 217, 289, 433, 578, 650, 722
+};
+
+static const uint8_t wma_mc_ht20_400ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3] = 2, [4] = 3, [5 ... 6] = 4, [7 ... 9] = 5,
+	[10] = 6, [11] = 7
+};
+
+static const uint16_t wma_mc_ht20_800ns_rate[] = {
+	65, 130, 195, 260, 390, 520, 585, 650
+};
+
+static const uint8_t wma_mc_ht20_800ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3] = 2, [4] = 3, [5 ... 6] = 4, [7 ... 8] = 5,
+	[9] = 6, [10] = 7
+};
+
+static const uint16_t wma_mc_ht40_400ns_rate[] = {
+	150, 300, 450, 600, 900, 1200, 1350, 1500
+};
+
+static const uint8_t wma_mc_ht40_400ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 4] = 1, [5 ... 7] = 2, [8 ... 9] = 3,
+	[10 ... 14] = 4, [15 ... 18] = 5, [19 ... 21] = 6, [22 ... 23] = 7
+};
+
+static const uint16_t wma_mc_ht40_800ns_rate[] = {
+	135, 270, 405, 540, 810, 1080, 1215, 1350
+};
+
+static const uint8_t wma_mc_ht40_800ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 4] = 1, [5 ... 6] = 2, [7 ... 8] = 3,
+	[9 ... 12] = 4, [13 ... 16] = 5, [17 ... 18] = 6, [19 ... 21] = 7
+};
+
+static const uint16_t wma_mc_vht20_400ns_rate[] = {
+	72, 144, 217, 289, 433, 578, 650, 722, 867
+};
+
+static const uint8_t wma_mc_vht20_400ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3] = 2, [4] = 3, [5 ... 6] = 4, [7 ... 9] = 5,
+	[10] = 6, [11] = 7, [12 ... 13] = 8
+};
+
+static const uint16_t wma_mc_vht20_800ns_rate[] = {
+	65, 130, 195, 260, 390, 520, 585, 650, 780
+};
+
+static const uint8_t wma_mc_vht20_800ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3] = 2, [4] = 3, [5 ... 6] = 4, [7 ... 8] = 5,
+	[9] = 6, [10] = 7, [11 ... 12] = 8
+};
+
+static const uint16_t wma_mc_vht40_400ns_rate[] = {
+	150, 300, 450, 600, 900, 1200, 1350, 1500, 1800, 2000
+};
+
+static const uint8_t wma_mc_vht40_400ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 4] = 1, [5 ... 7] = 2, [8 ... 9] = 3,
+	[10 ... 14] = 4, [15 ... 18] = 5, [19 ... 21] = 6, [22 ... 23] = 7,
+	[24 ... 28] = 8, [29 ... 31] = 9
+};
+
+static const uint16_t wma_mc_vht40_800ns_rate[] = {
+	135, 270, 405, 540, 810, 1080, 1215, 1350, 1620, 1800
+};
+
+static const uint8_t wma_mc_vht40_800ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 4] = 1, [5 ... 6] = 2, [7 ... 8] = 3,
+	[9 ... 12] = 4, [13 ... 16] = 5, [17 ... 18] = 6, [19 ... 21] = 7,
+	[22 ... 25] = 8, [26 ... 28] = 9
+};
+
+static const uint16_t wma_mc_vht80_400ns_rate[] = {
+	325, 650, 975, 1300, 1950, 2600, 2925, 3250, 3900, 4333
+};
+
+static const uint8_t wma_mc_vht80_400ns_idx[] = {
+	[0 ... 5] = 0, [6 ... 10] = 1, [11 ... 15] = 2, [16 ... 20] = 3,
+	[21 ... 30] = 4, [31 ... 40] = 5, [41 ... 45] = 6, [46 ... 50] = 7,
+	[51 ... 60] = 8, [61 ... 67] = 9
+};
+
+static const uint16_t wma_mc_vht80_800ns_rate[] = {
+	293, 585, 878, 1170, 1755, 2340, 2633, 2925, 3510, 3900
+};
+
+static const uint8_t wma_mc_vht80_800ns_idx[] = {
+	[0 ... 4] = 0, [5 ... 9] = 1, [10 ... 13] = 2, [14 ... 18] = 3,
+	[19 ... 27] = 4, [28 ... 36] = 5, [37 ... 41] = 6, [42 ... 45] = 7,
+	[46 ... 54] = 8, [55 ... 60] = 9
+};
+
+static const uint16_t wma_mc_he20_800ns_rate[] = {
+	86, 172, 258, 344, 516, 688, 774, 860, 1032, 1147, 1290, 1434
+};
+
+static const uint8_t wma_mc_he20_800ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3 ... 4] = 2, [5] = 3, [6 ... 8] = 4,
+	[9 ... 10] = 5, [11 ... 12] = 6, [13] = 7, [14 ... 16] = 8, [17] = 9,
+	[18 ... 20] = 10, [21 ... 22] = 11
+};
+
+static const uint16_t wma_mc_he20_1600ns_rate[] = {
+	81, 163, 244, 325, 488, 650, 731, 813, 975, 1083, 1219, 1354
+};
+
+static const uint8_t wma_mc_he20_1600ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3] = 2, [4 ... 5] = 3, [6 ... 7] = 4,
+	[8 ... 10] = 5, [11] = 6, [12] = 7, [13 ... 15] = 8, [16] = 9,
+	[17 ... 19] = 10, [20 ... 21] = 11
+};
+
+static const uint16_t wma_mc_he20_3200ns_rate[] = {
+	73, 146, 219, 293, 439, 585, 658, 731, 878, 975, 1097, 1219
+};
+
+static const uint8_t wma_mc_he20_3200ns_idx[] = {
+	[0 ... 1] = 0, [2] = 1, [3] = 2, [4] = 3, [5 ... 6] = 4, [7 ... 9] = 5,
+	[10] = 6, [11] = 7, [12 ... 13] = 8, [14 ... 15] = 9, [16 ... 17] = 10,
+	[18 ... 19] = 11
+};
+
+static const uint16_t wma_mc_he40_800ns_rate[] = {
+	172, 344, 516, 688, 1032, 1376, 1549, 1721, 2065, 2294, 2581, 2868
+};
+
+static const uint8_t wma_mc_he40_800ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 5] = 1, [6 ... 8] = 2, [9 ... 10] = 3,
+	[11 ... 16] = 4, [17 ... 21] = 5, [22 ... 24] = 6, [25 ... 26] = 7,
+	[27 ... 32] = 8, [33 ... 35] = 9, [36 ... 40] = 10, [41 ... 44] = 11
+};
+
+static const uint16_t wma_mc_he40_1600ns_rate[] = {
+	163, 325, 488, 650, 975, 1300, 1463, 1625, 1950, 2167, 2438, 2708
+};
+
+static const uint8_t wma_mc_he40_1600ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 5] = 1, [6 ... 7] = 2, [8 ... 10] = 3,
+	[11 ... 15] = 4, [16 ... 20] = 5, [21 ... 22] = 6, [23 ... 25] = 7,
+	[26 ... 30] = 8, [31 ... 33] = 9, [34 ... 38] = 10, [39 ... 42] = 11
+};
+
+static const uint16_t wma_mc_he40_3200ns_rate[] = {
+	146, 293, 439, 585, 878, 1170, 1316, 1463, 1755, 1950, 2194, 2438
+};
+
+static const uint8_t wma_mc_he40_3200ns_idx[] = {
+	[0 ... 2] = 0, [3 ... 4] = 1, [5 ... 6] = 2, [7 ... 9] = 3,
+	[10 ... 13] = 4, [14 ... 18] = 5, [19 ... 20] = 6, [21 ... 22] = 7,
+	[23 ... 27] = 8, [28 ... 30] = 9, [31 ... 34] = 10, [35 ... 38] = 11
+};
+
+static const uint16_t wma_mc_he80_800ns_rate[] = {
+	360, 721, 1081, 1441, 2162, 2882, 3243, 3603, 4324, 4804, 5404, 6005
+};
+
+static const uint8_t wma_mc_he80_800ns_idx[] = {
+	[0 ... 5] = 0, [6 ... 11] = 1, [12 ... 16] = 2, [17 ... 22] = 3,
+	[23 ... 33] = 4, [34 ... 45] = 5, [46 ... 50] = 6, [51 ... 56] = 7,
+	[57 ... 67] = 8, [68 ... 75] = 9, [76 ... 84] = 10, [85 ... 93] = 11
+};
+
+static const uint16_t wma_mc_he80_1600ns_rate[] = {
+	340, 681, 1021, 1361, 2042, 2722, 3063, 3403, 4083, 4537, 5104, 5671
+};
+
+static const uint8_t wma_mc_he80_1600ns_idx[] = {
+	[0 ... 5] = 0, [6 ... 10] = 1, [11 ... 15] = 2, [16 ... 21] = 3,
+	[22 ... 31] = 4, [32 ... 42] = 5, [43 ... 47] = 6, [48 ... 53] = 7,
+	[54 ... 63] = 8, [64 ... 70] = 9, [71 ... 79] = 10, [80 ... 88] = 11
+};
+
+static const uint16_t wma_mc_he80_3200ns_rate[] = {
+	306, 613, 919, 1225, 1838, 2450, 2756, 3063, 3675, 4083, 4594, 5104
+};
+
+static const uint8_t wma_mc_he80_3200ns_idx[] = {
+	[0 ... 4] = 0, [5 ... 9] = 1, [10 ... 14] = 2, [15 ... 19] = 3,
+	[20 ... 28] = 4, [29 ... 38] = 5, [39 ... 43] = 6, [44 ... 47] = 7,
+	[48 ... 57] = 8, [58 ... 63] = 9, [64 ... 71] = 10, [72 ... 79] = 11
+};
+
+#define WMA_MC_RATE_TBL(_name) { \
+	.rate = wma_mc_##_name##_rate, \
+	.code = NULL, \
+	.idx = wma_mc_##_name##_idx, \
+	.num_rates = QDF_ARRAY_SIZE(wma_mc_##_name##_rate), \
+	.num_idx = QDF_ARRAY_SIZE(wma_mc_##_name##_idx), \
+	.shift = WMA_MC_SHIFT, \
+}
+
+static const struct wma_mc_rate_tbl wma_mc_legacy_tbl = {
+	.rate = wma_mc_legacy_rate,
+	.code = wma_mc_legacy_code,
+	.idx = wma_mc_legacy_idx,
+	.num_rates = QDF_ARRAY_SIZE(wma_mc_legacy_rate),
+	.num_idx = QDF_ARRAY_SIZE(wma_mc_legacy_idx),
+	.shift = WMA_MC_LEGACY_SHIFT,
+};
+
+static const struct wma_mc_rate_tbl
+wma_mc_rate_tbls[WMA_MC_PHY_MAX][WMA_MC_BW_MAX][WMA_MC_GI_MAX] = {
+	[WMA_MC_PHY_HT] = {
+		[WMA_MC_BW_20] = {
+			[WMA_MC_GI_400NS] = WMA_MC_RATE_TBL(ht20_400ns),
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(ht20_800ns),
+		},
+		[WMA_MC_BW_40] = {
+			[WMA_MC_GI_400NS] = WMA_MC_RATE_TBL(ht40_400ns),
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(ht40_800ns),
+		},
+	},
+	[WMA_MC_PHY_VHT] = {
+		[WMA_MC_BW_20] = {
+			[WMA_MC_GI_400NS] = WMA_MC_RATE_TBL(vht20_400ns),
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(vht20_800ns),
+		},
+		[WMA_MC_BW_40] = {
+			[WMA_MC_GI_400NS] = WMA_MC_RATE_TBL(vht40_400ns),
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(vht40_800ns),
+		},
+		[WMA_MC_BW_80] = {
+			[WMA_MC_GI_400NS] = WMA_MC_RATE_TBL(vht80_400ns),
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(vht80_800ns),
+		},
+	},
+	[WMA_MC_PHY_HE] = {
+		[WMA_MC_BW_20] = {
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(he20_800ns),
+			[WMA_MC_GI_1600NS] = WMA_MC_RATE_TBL(he20_1600ns),
+			[WMA_MC_GI_3200NS] = WMA_MC_RATE_TBL(he20_3200ns),
+		},
+		[WMA_MC_BW_40] = {
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(he40_800ns),
+			[WMA_MC_GI_1600NS] = WMA_MC_RATE_TBL(he40_1600ns),
+			[WMA_MC_GI_3200NS] = WMA_MC_RATE_TBL(he40_3200ns),
+		},
+		[WMA_MC_BW_80] = {
+			[WMA_MC_GI_800NS] = WMA_MC_RATE_TBL(he80_800ns),
+			[WMA_MC_GI_1600NS] = WMA_MC_RATE_TBL(he80_1600ns),
+			[WMA_MC_GI_3200NS] = WMA_MC_RATE_TBL(he80_3200ns),
+		},
+	},
+};
+
+const struct wma_mc_rate_tbl *wma_mc_rate_tbl_get(enum wma_mc_phy phy,
+						  enum wma_mc_bw bw,
+						  enum wma_mc_gi gi)
+{
+	const struct wma_mc_rate_tbl *tbl;
+
+	if (phy >= WMA_MC_PHY_MAX || bw >= WMA_MC_BW_MAX ||
+	    gi >= WMA_MC_GI_MAX)
+		return NULL;
+
+	tbl = &wma_mc_rate_tbls[phy][bw][gi];
+	if (!tbl->num_rates)
+		return NULL;
+
+	return tbl;
+}
+
+const struct wma_mc_rate_tbl *wma_mc_legacy_rate_tbl_get(void)
+{
+	return &wma_mc_legacy_tbl;
+}
+
+int32_t wma_mc_rate_tbl_lookup(const struct wma_mc_rate_tbl *tbl,
+			       int32_t mbpsx10_rate, uint8_t *code)
+{
+	uint32_t bucket = 0;
+	uint8_t i;
+
+	if (mbpsx10_rate > 0)
+		bucket = (uint32_t)mbpsx10_rate >> tbl->shift;
+	if (bucket >= tbl->num_idx)
+		bucket = tbl->num_idx - 1;
+
+	/* the bucket holds at most one rate, step over it if it is lower */
+	i = tbl->idx[bucket];
+	if (mbpsx10_rate > tbl->rate[i] && i < tbl->num_rates - 1)
+		i++;
+
+	*code = tbl->code ? tbl->code[i] : i;
+
+	return tbl->rate[i];
+}
+
+int32_t wma_mc_rate_lookup(enum wma_mc_phy phy, enum wma_mc_bw bw,
+			   enum wma_mc_gi gi, uint8_t nss,
+			   int32_t mbpsx10_rate, uint8_t *mcs)
+{
+	const struct wma_mc_rate_tbl *tbl;
+	int32_t ss = nss + 1;
+
+	tbl = wma_mc_rate_tbl_get(phy, bw, gi);
+	if (!tbl)
+		return 0;
+
+	return wma_mc_rate_tbl_lookup(tbl, mbpsx10_rate / ss, mcs) * ss;
+}
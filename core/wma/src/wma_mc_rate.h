@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wma_mc_rate.h
+ *
+ * Multicast/broadcast data rate tables. Every table lists the 1SS rates
+ * of one (phy mode, bandwidth, guard interval) in mbps x10, ascending by
+ * MCS, together with a bucket index generated from it so that the rate
+ * closest to a requested one is found with a single compare.
+ */
+
+#ifndef __WMA_MC_RATE_H
+#define __WMA_MC_RATE_H
+
+#include <qdf_types.h>
+
+/**
+ * enum wma_mc_phy - phy modes with multicast rate tables
+ * @WMA_MC_PHY_HT: 802.11n
+ * @WMA_MC_PHY_VHT: 802.11ac
+ * @WMA_MC_PHY_HE: 802.11ax
+ * @WMA_MC_PHY_MAX: number of phy modes
+ */
+enum wma_mc_phy {
+	WMA_MC_PHY_HT,
+	WMA_MC_PHY_VHT,
+	WMA_MC_PHY_HE,
+	WMA_MC_PHY_MAX
+};
+
+/**
+ * enum wma_mc_bw - bandwidths with multicast rate tables, laid out as the
+ *	vdev chwidth config
+ * @WMA_MC_BW_20: 20 MHz
+ * @WMA_MC_BW_40: 40 MHz
+ * @WMA_MC_BW_80: 80 MHz
+ * @WMA_MC_BW_MAX: number of bandwidths
+ */
+enum wma_mc_bw {
+	WMA_MC_BW_20,
+	WMA_MC_BW_40,
+	WMA_MC_BW_80,
+	WMA_MC_BW_MAX
+};
+
+/**
+ * enum wma_mc_gi - guard intervals with multicast rate tables
+ * @WMA_MC_GI_400NS: HT/VHT short GI
+ * @WMA_MC_GI_800NS: HT/VHT long GI, HE 0.8 us GI
+ * @WMA_MC_GI_1600NS: HE 1.6 us GI
+ * @WMA_MC_GI_3200NS: HE 3.2 us GI
+ * @WMA_MC_GI_MAX: number of guard intervals
+ */
+enum wma_mc_gi {
+	WMA_MC_GI_400NS,
+	WMA_MC_GI_800NS,
+	WMA_MC_GI_1600NS,
+	WMA_MC_GI_3200NS,
+	WMA_MC_GI_MAX
+};
+
+/**
+ * struct wma_mc_rate_tbl - multicast rate table
+ * @rate: 1SS rates in mbps x10, ascending
+ * @code: rate code of each @rate entry, NULL if the index is the MCS
+ * @idx: for bucket b, the index of the lowest @rate >= (b << @shift)
+ * @num_rates: number of @rate entries, 0 if the table does not exist
+ * @num_idx: number of @idx buckets
+ * @shift: log2 of the bucket width, no wider than the closest two @rate
+ */
+struct wma_mc_rate_tbl {
+	const uint16_t *rate;
+	const uint8_t *code;
+	const uint8_t *idx;
+	uint8_t num_rates;
+	uint8_t num_idx;
+	uint8_t shift;
+};
+
+/**
+ * wma_mc_rate_tbl_get() - get the HT/VHT/HE multicast rate table
+ * @phy: phy mode
+ * @bw: bandwidth
+ * @gi: guard interval
+ *
+ * Return: rate table, NULL if the combination has none
+ */
+const struct wma_mc_rate_tbl *wma_mc_rate_tbl_get(enum wma_mc_phy phy,
+						  enum wma_mc_bw bw,
+						  enum wma_mc_gi gi);
+
+/**
+ * wma_mc_legacy_rate_tbl_get() - get the OFDM/CCK multicast rate table
+ *
+ * The rate codes carry the OFDM/CCK index in the low bits and have bit 7
+ * set for CCK.
+ *
+ * Return: rate table
+ */
+const struct wma_mc_rate_tbl *wma_mc_legacy_rate_tbl_get(void);
+
+/**
+ * wma_mc_rate_tbl_lookup() - find the closest rate in a rate table
+ * @tbl: rate table
+ * @mbpsx10_rate: requested rate in mbps x10
+ * @code: filled with the rate code of the selected entry
+ *
+ * Selects the lowest rate not below @mbpsx10_rate, or the highest rate of
+ * the table if @mbpsx10_rate exceeds it.
+ *
+ * Return: selected rate in mbps x10
+ */
+int32_t wma_mc_rate_tbl_lookup(const struct wma_mc_rate_tbl *tbl,
+			       int32_t mbpsx10_rate, uint8_t *code);
+
+/**
+ * wma_mc_rate_lookup() - find the closest HT/VHT/HE multicast rate
+ * @phy: phy mode
+ * @bw: bandwidth
+ * @gi: guard interval
+ * @nss: number of spatial streams minus one
+ * @mbpsx10_rate: requested rate in mbps x10, over all spatial streams
+ * @mcs: filled with the selected MCS
+ *
+ * Return: selected rate in mbps x10 over all spatial streams, 0 if there
+ *	   is no table for @phy/@bw/@gi
+ */
+int32_t wma_mc_rate_lookup(enum wma_mc_phy phy, enum wma_mc_bw bw,
+			   enum wma_mc_gi gi, uint8_t nss,
+			   int32_t mbpsx10_rate, uint8_t *mcs);
+
+#endif /* __WMA_MC_RATE_H */
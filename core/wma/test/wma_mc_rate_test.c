@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2021 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wma_mc_rate_test.c
+ *
+ * Unit tests for the multicast rate tables. Every table is checked for
+ * consistency between its rates and bucket index, and the lookup is
+ * compared for every requested rate up to twice the table maximum with
+ * the binary search over descending tables that it replaces. The cost of
+ * both is reported per lookup.
+ */
+
+#include "qdf_types.h"
+#include "qdf_util.h"
+#include "cds_utils.h"
+#include "wma.h"
+#include "wma_mc_rate.h"
+#include "wma_mc_rate_test.h"
+
+#define WMA_MC_TEST_MAX_RATES	16
+#define WMA_MC_TEST_ITERATIONS	100000
+
+struct wma_search_rate {
+	int32_t rate;
+	uint8_t flag;
+};
+
+/**
+ * wma_mc_test_bin_search() - the binary search used before the bucket
+ *	index, kept as the reference for the lookup
+ * @tbl: rate table, descending
+ * @tbl_size: table size
+ * @mbpsx10_rate: requested rate in, selected rate out
+ * @ret_flag: selected flag
+ *
+ * Return: None
+ */
+static void wma_mc_test_bin_search(struct wma_search_rate *tbl,
+				   int32_t tbl_size, int32_t *mbpsx10_rate,
+				   uint8_t *ret_flag)
+{
+	int32_t upper, lower, mid;
+
+	upper = 0;
+	lower = tbl_size - 1;
+
+	if (*mbpsx10_rate >= tbl[upper].rate) {
+		*mbpsx10_rate = tbl[upper].rate;
+		*ret_flag = tbl[upper].flag;
+		return;
+	} else if (*mbpsx10_rate <= tbl[lower].rate) {
+		*mbpsx10_rate = tbl[lower].rate;
+		*ret_flag = tbl[lower].flag;
+		return;
+	}
+
+	while (lower - upper > 1) {
+		mid = (upper + lower) >> 1;
+		if (*mbpsx10_rate == tbl[mid].rate) {
+			*mbpsx10_rate = tbl[mid].rate;
+			*ret_flag = tbl[mid].flag;
+			return;
+		}
+		if (*mbpsx10_rate > tbl[mid].rate)
+			lower = mid;
+		else
+			upper = mid;
+	}
+
+	*mbpsx10_rate = tbl[upper].rate;
+	*ret_flag = tbl[upper].flag;
+}
+
+static int32_t wma_mc_test_to_search(const struct wma_mc_rate_tbl *tbl,
+				     struct wma_search_rate *search)
+{
+	int32_t n = tbl->num_rates;
+	int32_t i;
+
+	for (i = 0; i < n; i++) {
+		search[n - 1 - i].rate = tbl->rate[i];
+		search[n - 1 - i].flag = tbl->code ? tbl->code[i] : i;
+	}
+
+	return n;
+}
+
+static uint32_t wma_mc_test_tbl(const struct wma_mc_rate_tbl *tbl,
+				const char *name)
+{
+	struct wma_search_rate search[WMA_MC_TEST_MAX_RATES];
+	int32_t n, req, max, ref_rate, rate;
+	uint8_t ref_code, code;
+	uint32_t errors = 0;
+	uint32_t bucket;
+	uint8_t i;
+
+	cds_test_expect(tbl->num_rates <= WMA_MC_TEST_MAX_RATES, errors);
+	if (errors)
+		return errors;
+
+	/* rates ascend, at most one rate per bucket */
+	for (i = 1; i < tbl->num_rates; i++)
+		cds_test_expect(tbl->rate[i] - tbl->rate[i - 1] >=
+				(1 << tbl->shift), errors);
+
+	/* the last bucket holds the highest rate */
+	cds_test_expect(tbl->num_idx ==
+			(tbl->rate[tbl->num_rates - 1] >> tbl->shift) + 1,
+			errors);
+
+	for (bucket = 0; bucket < tbl->num_idx; bucket++) {
+		i = tbl->idx[bucket];
+		cds_test_expect(i < tbl->num_rates, errors);
+		if (i >= tbl->num_rates)
+			continue;
+		cds_test_expect(tbl->rate[i] >= bucket << tbl->shift, errors);
+		if (i)
+			cds_test_expect(tbl->rate[i - 1] <
+					bucket << tbl->shift, errors);
+	}
+	if (errors)
+		return errors;
+
+	n = wma_mc_test_to_search(tbl, search);
+	max = tbl->rate[tbl->num_rates - 1];
+	for (req = -1; req <= 2 * max; req++) {
+		ref_rate = req;
+		ref_code = 0;
+		wma_mc_test_bin_search(search, n, &ref_rate, &ref_code);
+		rate = wma_mc_rate_tbl_lookup(tbl, req, &code);
+		if (rate != ref_rate || code != ref_code) {
+			wma_nofl_err("FAIL: %s: rate %d; expected %d/0x%x, found %d/0x%x",
+				     name, req, ref_rate, ref_code,
+				     rate, code);
+			errors++;
+		}
+	}
+
+	return errors;
+}
+
+static uint32_t wma_mc_test_tbls(void)
+{
+	const struct wma_mc_rate_tbl *tbl;
+	uint32_t errors = 0;
+	uint32_t tbls = 0;
+	char name[16];
+	int phy, bw, gi;
+
+	errors += wma_mc_test_tbl(wma_mc_legacy_rate_tbl_get(), "legacy");
+
+	for (phy = 0; phy < WMA_MC_PHY_MAX; phy++) {
+		for (bw = 0; bw < WMA_MC_BW_MAX; bw++) {
+			for (gi = 0; gi < WMA_MC_GI_MAX; gi++) {
+				tbl = wma_mc_rate_tbl_get(phy, bw, gi);
+				if (!tbl)
+					continue;
+				qdf_scnprintf(name, sizeof(name),
+					      "phy%d bw%d gi%d", phy, bw, gi);
+				errors += wma_mc_test_tbl(tbl, name);
+				tbls++;
+			}
+		}
+	}
+
+	/* HT 20/40, VHT 20/40/80 with two GIs, HE 20/40/80 with three */
+	cds_test_expect(tbls == 4 + 6 + 9, errors);
+	cds_test_expect(!wma_mc_rate_tbl_get(WMA_MC_PHY_HT, WMA_MC_BW_80,
+					     WMA_MC_GI_400NS), errors);
+	cds_test_expect(!wma_mc_rate_tbl_get(WMA_MC_PHY_HE, WMA_MC_BW_20,
+					     WMA_MC_GI_400NS), errors);
+	cds_test_expect(!wma_mc_rate_tbl_get(WMA_MC_PHY_MAX, WMA_MC_BW_20,
+					     WMA_MC_GI_800NS), errors);
+
+	return errors;
+}
+
+/**
+ * struct wma_mc_test_case - multicast rate lookup known answer
+ * @phy: phy mode
+ * @bw: bandwidth
+ * @gi: guard interval
+ * @nss: number of spatial streams minus one
+ * @req: requested rate in mbps x10
+ * @rate: expected rate in mbps x10
+ * @mcs: expected MCS
+ */
+struct wma_mc_test_case {
+	enum wma_mc_phy phy;
+	enum wma_mc_bw bw;
+	enum wma_mc_gi gi;
+	uint8_t nss;
+	int32_t req;
+	int32_t rate;
+	uint8_t mcs;
+};
+
+static const struct wma_mc_test_case wma_mc_test_cases[] = {
+	{ WMA_MC_PHY_HT, WMA_MC_BW_20, WMA_MC_GI_800NS, 0, 100, 130, 1 },
+	{ WMA_MC_PHY_HT, WMA_MC_BW_20, WMA_MC_GI_400NS, 0, 722, 722, 7 },
+	{ WMA_MC_PHY_HT, WMA_MC_BW_40, WMA_MC_GI_800NS, 1, 2000, 2160, 5 },
+	{ WMA_MC_PHY_VHT, WMA_MC_BW_20, WMA_MC_GI_800NS, 0, 1000, 780, 8 },
+	{ WMA_MC_PHY_VHT, WMA_MC_BW_40, WMA_MC_GI_400NS, 0, 1900, 2000, 9 },
+	{ WMA_MC_PHY_VHT, WMA_MC_BW_80, WMA_MC_GI_400NS, 1, 8000, 8666, 9 },
+	{ WMA_MC_PHY_VHT, WMA_MC_BW_80, WMA_MC_GI_800NS, 0, 600, 878, 2 },
+	{ WMA_MC_PHY_HE, WMA_MC_BW_20, WMA_MC_GI_800NS, 0, 1434, 1434, 11 },
+	{ WMA_MC_PHY_HE, WMA_MC_BW_40, WMA_MC_GI_3200NS, 0, 1200, 1316, 6 },
+	{ WMA_MC_PHY_HE, WMA_MC_BW_80, WMA_MC_GI_1600NS, 1, 5000, 5444, 5 },
+	{ WMA_MC_PHY_HE, WMA_MC_BW_80, WMA_MC_GI_800NS, 0, 9000, 6005, 11 },
+};
+
+static uint32_t wma_mc_test_known(void)
+{
+	const struct wma_mc_test_case *tc;
+	uint32_t errors = 0;
+	int32_t rate;
+	uint8_t mcs;
+	int i;
+
+	for (i = 0; i < QDF_ARRAY_SIZE(wma_mc_test_cases); i++) {
+		tc = &wma_mc_test_cases[i];
+		mcs = 0xff;
+		rate = wma_mc_rate_lookup(tc->phy, tc->bw, tc->gi, tc->nss,
+					  tc->req, &mcs);
+		if (rate != tc->rate || mcs != tc->mcs) {
+			wma_nofl_err("FAIL: rate case %d; expected %d/%u, found %d/%u",
+				     i, tc->rate, tc->mcs, rate, mcs);
+			errors++;
+		}
+	}
+
+	rate = wma_mc_rate_lookup(WMA_MC_PHY_HT, WMA_MC_BW_80,
+				  WMA_MC_GI_800NS, 0, 1000, &mcs);
+	cds_test_expect(!rate, errors);
+
+	return errors;
+}
+
+static uint32_t wma_mc_test_bench(void)
+{
+	struct wma_search_rate search[WMA_MC_TEST_MAX_RATES];
+	const struct wma_mc_rate_tbl *tbl;
+	uint64_t start, search_ns, lookup_ns;
+	int32_t n, max, req, rate;
+	uint32_t errors = 0;
+	uint32_t sum = 0;
+	uint8_t code;
+	int i;
+
+	tbl = wma_mc_rate_tbl_get(WMA_MC_PHY_HE, WMA_MC_BW_80,
+				  WMA_MC_GI_800NS);
+	cds_test_expect(tbl, errors);
+	if (!tbl)
+		return errors;
+
+	n = wma_mc_test_to_search(tbl, search);
+	max = tbl->rate[tbl->num_rates - 1];
+
+	start = ktime_get_ns();
+	for (i = 0; i < WMA_MC_TEST_ITERATIONS; i++) {
+		rate = i % max;
+		wma_mc_test_bin_search(search, n, &rate, &code);
+		sum += rate;
+	}
+	search_ns = ktime_get_ns() - start;
+
+	start = ktime_get_ns();
+	for (i = 0; i < WMA_MC_TEST_ITERATIONS; i++) {
+		req = i % max;
+		sum -= wma_mc_rate_tbl_lookup(tbl, req, &code);
+	}
+	lookup_ns = ktime_get_ns() - start;
+
+	cds_test_expect(!sum, errors);
+
+	do_div(search_ns, WMA_MC_TEST_ITERATIONS);
+	do_div(lookup_ns, WMA_MC_TEST_ITERATIONS);
+	wma_nofl_info("wma_mc_rate: %d lookups, %llu ns search, %llu ns lookup",
+		      WMA_MC_TEST_ITERATIONS, search_ns, lookup_ns);
+
+	return errors;
+}
+
+uint32_t wma_mc_rate_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += wma_mc_test_tbls();
+	errors += wma_mc_test_known();
+	errors += wma_mc_test_bench();
+
+	return errors;
+}